@@ -38,6 +38,7 @@
 THandle IpcSta_Create(const PS8 device_name);
 VOID IpcSta_Destroy(THandle hIpcSta);
 S32 IPC_STA_Private_Send(THandle hIpcSta, U32 ioctl_cmd, PVOID bufIn, U32 sizeIn, PVOID bufOut, U32 sizeOut);
+S32 IPC_STA_Private_Send_Batch(THandle hIpcSta, PVOID pBatch, U32 bNoWait);
 S32 IPC_STA_Wext_Send(THandle hIpcSta, U32 wext_request_id, PVOID p_iwreq_data, U32 len);
 #endif  /* _IPC_STA_H_ */
 
@@ -180,6 +180,33 @@ S32 IPC_STA_Private_Send(THandle hIpcSta, U32 ioctl_cmd, PVOID bufIn, U32 sizeIn
     return OK;
 }
 
+/* Send a batch of private commands (ti_private_cmd_batch_t) in one IOCTL (if bNoWait, completion is reported by IPC_EVENT_CMD_BATCH_DONE) */
+S32 IPC_STA_Private_Send_Batch(THandle hIpcSta, PVOID pBatch, U32 bNoWait)
+{
+    IpcSta_t* pIpcSta = (IpcSta_t*)hIpcSta;
+    S32 res;
+
+    pIpcSta ->private_cmd.cmd = 0;
+    pIpcSta ->private_cmd.flags = PRIVATE_CMD_BATCH_FLAG | (bNoWait ? PRIVATE_CMD_NOWAIT_FLAG : 0);
+    pIpcSta ->private_cmd.in_buffer = pBatch;
+    pIpcSta ->private_cmd.in_buffer_len = sizeof(ti_private_cmd_batch_t);
+    pIpcSta ->private_cmd.out_buffer = NULL;
+    pIpcSta ->private_cmd.out_buffer_len = 0;
+
+    pIpcSta->wext_req.u.data.pointer = &pIpcSta->private_cmd;
+    pIpcSta->wext_req.u.data.length = sizeof(ti_private_cmd_t);
+    pIpcSta->wext_req.u.data.flags = 0;
+
+    res = ioctl(pIpcSta->STA_socket, SIOCIWFIRSTPRIV, &pIpcSta->wext_req);     
+    if(res != OK)
+    {
+        os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IPC_STA_Private_Send_Batch - error sending Wext private IOCTL to STA driver (num cmds = %d, res = %d, errno = %d)\n", ((ti_private_cmd_batch_t *)pBatch)->uNumCmds,res,errno);
+        return EOALERR_IPC_STA_ERROR_SENDING_WEXT;
+    }
+
+    return OK;
+}
+
 S32 IPC_STA_Wext_Send(THandle hIpcSta, U32 wext_request_id, PVOID p_iwreq_data, U32 len)
 {
     IpcSta_t* pIpcSta = (IpcSta_t*)hIpcSta;
@@ -61,8 +61,12 @@ static TI_STATUS    cmdQueue_Push (TI_HANDLE  hCmdQueue,
                                    void       *fCb, 
                                    TI_HANDLE  hCb, 
                                    void       *pCb);
+static TI_STATUS    cmdQueue_SendHead (TCmdQueue *pCmdQueue);
+static void         cmdQueue_StageNext (TCmdQueue *pCmdQueue);
+static void         cmdQueue_GetTxnLengths (TCmdQueueNode *pNode, TI_UINT32 *pWriteLen, TI_UINT32 *pReadLen);
 #ifdef TI_DBG
 static void         cmdQueue_PrintQueue(TCmdQueue  *pCmdQueue);
+static void         cmdQueue_UpdateLatency (TCmdQueue *pCmdQueue, TCmdQueueNode *pNode, TI_UINT16 uMboxStatus);
 #endif /* TI_DBG */
 
 
@@ -158,6 +162,9 @@ TI_STATUS cmdQueue_Init   (TI_HANDLE hCmdQueue,
     pCmdQueue->bErrorFlag = TI_FALSE;
     pCmdQueue->bMboxEnabled = TI_FALSE;
     pCmdQueue->bAwake = TI_FALSE;
+    pCmdQueue->bPipeline = TI_TRUE;
+    pCmdQueue->uStagedNode = CMDQUEUE_NO_STAGED_NODE;
+    pCmdQueue->bHeadStaged = TI_FALSE;
 
     /* Configure Command Mailbox */
     cmdMbox_Init (hCmdMbox, hReport, hTwIf,
@@ -191,7 +198,6 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
     TI_BOOL        bBreakWhile = TI_FALSE;
     TI_STATUS      rc = TI_OK, status;
     TCmdQueueNode *pHead;
-    TI_UINT32      uReadLen, uWriteLen;
 
     while(!bBreakWhile)
     {
@@ -203,8 +209,6 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
                     case CMDQUEUE_EVENT_RUN:
                         pCmdQueue->state = CMDQUEUE_STATE_WAIT_FOR_COMPLETION;
 
-                        pHead = &pCmdQueue->aCmdQueue[pCmdQueue->head];
-                
                         #ifdef TI_DBG
                             pCmdQueue->uCmdSendCounter++;
                         #endif 
@@ -221,32 +225,8 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
                             pCmdQueue->bAwake = TI_TRUE;
                         }
 
-                        if (pHead->cmdType == CMD_INTERROGATE)
-                        {
-                            uWriteLen = CMDQUEUE_INFO_ELEM_HEADER_LEN;
-                            /* Will be updated by CmdMbox to count the status response */
-                            uReadLen = pHead->uParamsLen;
-                        }
-                        else if(pHead->cmdType == CMD_TEST)
-                        {
-                            /* CMD_TEST has configure & interrogate abillities together */
-                            uWriteLen = pHead->uParamsLen;
-                            /* Will be updated by CmdMbox to count the status response */
-                            uReadLen = pHead->uParamsLen;
-                        }
-                        else /* CMD_CONFIGURE or others */
-                        {
-                            uWriteLen = pHead->uParamsLen;
-                            /* Will be updated by CmdMbox to count the status response */
-                            uReadLen = 0;
-
-                        }
                         /* send the command to TNET */
-                        rc = cmdMbox_SendCommand (pCmdQueue->hCmdMBox, 
-                                              pHead->cmdType, 
-                                              pHead->aParamsBuf, 
-                                              uWriteLen,
-                                              uReadLen);
+                        rc = cmdQueue_SendHead (pCmdQueue);
 
                         bBreakWhile = TI_TRUE;
 
@@ -276,6 +256,7 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
                             TI_UINT16        uParam;
                             void *fCb, *hCb, *pCb;
                             CommandStatus_e cmdStatus;
+                            TI_BOOL bNextSent = TI_FALSE;
 
                             pHead = &pCmdQueue->aCmdQueue[pCmdQueue->head];
             
@@ -295,12 +276,13 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
                                 pCmdQueue->head = 0;                
                             pCmdQueue->uNumberOfCommandInQueue --;                
                 
+                            /* Read the latest command return status */
+                            status = cmdMbox_GetStatus (pCmdQueue->hCmdMBox, &cmdStatus);
+
                         #ifdef TI_DBG
                             pCmdQueue->uCmdCompltCounter++;
+                            cmdQueue_UpdateLatency (pCmdQueue, pHead, (TI_UINT16)cmdStatus);
                         #endif 
-
-                            /* Read the latest command return status */
-                            status = cmdMbox_GetStatus (pCmdQueue->hCmdMBox, &cmdStatus);
                             if (status != TI_OK)
                             {
                                 if (cmdStatus == CMD_STATUS_REJECT_MEAS_SG_ACTIVE)
@@ -319,13 +301,33 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
                                 pCmdQueue->bErrorFlag = TI_FALSE;
                             }
 
+                            /* 
+                             * If pInterrogateBuf isn't NULL we need to copy the results.
+                             * Done before sending the next command, which overrides the result length.
+                             */
+                            if (fCb && pCb)
+                            {
+                                cmdMbox_GetCmdParams(pCmdQueue->hCmdMBox, pCb);
+                            }
+
+                            /* 
+                             * In pipeline mode send the next (usually already staged) command 
+                             * before calling the callback, so the FW executes it meanwhile
+                             */
+                            if (pCmdQueue->bPipeline && pCmdQueue->uNumberOfCommandInQueue > 0)
+                            {
+                            #ifdef TI_DBG
+                                pCmdQueue->uCmdSendCounter++;
+                            #endif
+                                rc = cmdQueue_SendHead (pCmdQueue);
+                                bNextSent = TI_TRUE;
+                            }
+
                             /* If the command had a CB, then call it with the proper results buffer */
                             if (fCb)
                             {   
                                 if (pCb)
                                 {
-                                    /* If pInterrogateBuf isn't NULL we need to copy the results */
-                                    cmdMbox_GetCmdParams(pCmdQueue->hCmdMBox, pCb);
                                     /* Call the CB with the result buffer and the returned status */
                                     ((TCmdQueueInterrogateCb)fCb) (hCb, status, pCb); 
                                 }
@@ -345,7 +347,12 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
                             }
 
                             /* Check if there are any more commands in queue */
-                            if (pCmdQueue->uNumberOfCommandInQueue > 0)               
+                            if (bNextSent)
+                            {
+                                /* The next command was already sent, wait for its completion */
+                                bBreakWhile = TI_TRUE;
+                            }
+                            else if (pCmdQueue->uNumberOfCommandInQueue > 0)               
                             {
                                 /* If queue isn't empty, send the next command */
                                 pCmdQueue->state = CMDQUEUE_STATE_IDLE;
@@ -502,11 +509,143 @@ static TI_STATUS cmdQueue_Push (TI_HANDLE  hCmdQueue,
 	}
 	else
     {
+        /* Prepare the next command while the current one is executed */
+        cmdQueue_StageNext (pCmdQueue);
+
         return TI_OK;            
     }
 }
 
 
+/*
+ * \brief	Send the command at the queue head to the cmdMbox
+ * 
+ * \param  pCmdQueue - Pointer to TCmdQueue
+ * \return TI_PENDING on success or TI_NOK on failure
+ * 
+ * \par Description
+ * Sends the staged mailbox image if it belongs to the head command,
+ * otherwise builds it from the queue node. Then stages the following command.
+ * 
+ * \sa cmdQueue_SM, cmdQueue_StageNext
+ */
+static TI_STATUS cmdQueue_SendHead (TCmdQueue *pCmdQueue)
+{
+    TCmdQueueNode *pHead = &pCmdQueue->aCmdQueue[pCmdQueue->head];
+    TI_UINT32      uReadLen, uWriteLen;
+    TI_STATUS      rc;
+
+#ifdef TI_DBG
+    pCmdQueue->uSendTimeUs = os_timeStampUs (pCmdQueue->hOs);
+    if (pCmdQueue->uCompleteTimeUs != 0)
+    {
+        /* Sent after the previous command completed with this one already queued */
+        pCmdQueue->uGapUs = pCmdQueue->uSendTimeUs - pCmdQueue->uCompleteTimeUs;
+        pCmdQueue->uBackToBackCmds++;
+        pCmdQueue->uBackToBackGapUs += pCmdQueue->uGapUs;
+    }
+    else
+    {
+        pCmdQueue->uGapUs = 0;
+    }
+#endif
+
+    if (pCmdQueue->uStagedNode == pCmdQueue->head)
+    {
+        pCmdQueue->uStagedNode = CMDQUEUE_NO_STAGED_NODE;
+        pCmdQueue->bHeadStaged = TI_TRUE;
+
+        rc = cmdMbox_SendStagedCommand (pCmdQueue->hCmdMBox);
+    }
+    else
+    {
+        pCmdQueue->bHeadStaged = TI_FALSE;
+
+        cmdQueue_GetTxnLengths (pHead, &uWriteLen, &uReadLen);
+        rc = cmdMbox_SendCommand (pCmdQueue->hCmdMBox, 
+                                  pHead->cmdType, 
+                                  pHead->aParamsBuf, 
+                                  uWriteLen,
+                                  uReadLen);
+    }
+
+    cmdQueue_StageNext (pCmdQueue);
+
+    return rc;
+}
+
+
+/*
+ * \brief	Stage the command following the queue head in the cmdMbox
+ * 
+ * \param  pCmdQueue - Pointer to TCmdQueue
+ * \return void
+ * 
+ * \par Description
+ * Builds the mailbox image of the next command in host memory while the FW
+ * executes the current one, so it can be sent right on command complete.
+ * Nothing is done if pipelining is disabled or a command is already staged.
+ * 
+ * \sa cmdQueue_SendHead, cmdMbox_StageCommand
+ */
+static void cmdQueue_StageNext (TCmdQueue *pCmdQueue)
+{
+    TCmdQueueNode *pNext;
+    TI_UINT32      uNext;
+    TI_UINT32      uReadLen, uWriteLen;
+
+    if (!pCmdQueue->bPipeline || 
+        pCmdQueue->uStagedNode != CMDQUEUE_NO_STAGED_NODE ||
+        pCmdQueue->uNumberOfCommandInQueue < 2)
+    {
+        return;
+    }
+
+    uNext = pCmdQueue->head + 1;
+    if (uNext == CMDQUEUE_QUEUE_DEPTH)
+        uNext = 0;
+    pNext = &pCmdQueue->aCmdQueue[uNext];
+
+    cmdQueue_GetTxnLengths (pNext, &uWriteLen, &uReadLen);
+    cmdMbox_StageCommand (pCmdQueue->hCmdMBox, pNext->cmdType, pNext->aParamsBuf, uWriteLen, uReadLen);
+    pCmdQueue->uStagedNode = uNext;
+}
+
+
+/*
+ * \brief	Get the mailbox write & read lengths of a command
+ * 
+ * \param  pNode - The command queue node
+ * \param  pWriteLen - Returns the length to write to the mailbox
+ * \param  pReadLen - Returns the length to read from the mailbox on complete
+ * \return void
+ * 
+ * \par Description
+ * The read length will be updated by CmdMbox to count the status response.
+ * 
+ * \sa cmdQueue_SendHead, cmdQueue_StageNext
+ */
+static void cmdQueue_GetTxnLengths (TCmdQueueNode *pNode, TI_UINT32 *pWriteLen, TI_UINT32 *pReadLen)
+{
+    if (pNode->cmdType == CMD_INTERROGATE)
+    {
+        *pWriteLen = CMDQUEUE_INFO_ELEM_HEADER_LEN;
+        *pReadLen = pNode->uParamsLen;
+    }
+    else if(pNode->cmdType == CMD_TEST)
+    {
+        /* CMD_TEST has configure & interrogate abillities together */
+        *pWriteLen = pNode->uParamsLen;
+        *pReadLen = pNode->uParamsLen;
+    }
+    else /* CMD_CONFIGURE or others */
+    {
+        *pWriteLen = pNode->uParamsLen;
+        *pReadLen = 0;
+    }
+}
+
+
 /*
  * \brief	Notify the CmdQueue SM on the result received.
  * 
@@ -551,6 +690,10 @@ TI_STATUS cmdQueue_Restart (TI_HANDLE hCmdQueue)
     */
     pCmdQueue->state = CMDQUEUE_STATE_IDLE;
     pCmdQueue->bAwake = TI_FALSE;
+    pCmdQueue->uStagedNode = CMDQUEUE_NO_STAGED_NODE;
+#ifdef TI_DBG
+    pCmdQueue->uCompleteTimeUs = 0;
+#endif
 
     
 	/*
@@ -753,6 +896,28 @@ TI_STATUS cmdQueue_Error (TI_HANDLE hCmdQueue, TI_UINT32 command, TI_UINT32 stat
 }
 
 
+/*
+ * \brief	Enable or disable mailbox commands pipelining
+ * 
+ * \param  hCmdQueue - Handle to CmdQueue
+ * \param  bEnable - TI_TRUE to stage the next command while the current one executes
+ * \return TI_OK
+ * 
+ * \par Description
+ * An already staged command is still sent from the staged buffer.
+ * 
+ * \sa cmdQueue_StageNext
+ */
+TI_STATUS cmdQueue_SetPipeline (TI_HANDLE hCmdQueue, TI_BOOL bEnable)
+{
+    TCmdQueue* pCmdQueue = (TCmdQueue*)hCmdQueue;
+
+    pCmdQueue->bPipeline = bEnable;
+
+    return TI_OK;
+}
+
+
 /*
  * \brief	Returns maximum number of commands (ever) in TCmdQueue queue
  * 
@@ -793,6 +958,35 @@ TI_UINT32 cmdQueue_GetMaxNumberOfCommands (TI_HANDLE hCmdQueue)
 void cmdQueue_Print (TI_HANDLE hCmdQueue)
 {
     TCmdQueue* pCmdQueue = (TCmdQueue*)hCmdQueue; 
+    TI_UINT32  uBin;
+
+    WLAN_OS_REPORT(("------------- cmdQueue Info -------------\n"));
+    WLAN_OS_REPORT(("State          = %d\n", pCmdQueue->state));
+    WLAN_OS_REPORT(("Commands       = %d (max %d)\n", pCmdQueue->uNumberOfCommandInQueue, pCmdQueue->uMaxNumberOfCommandInQueue));
+    WLAN_OS_REPORT(("Sent           = %d\n", pCmdQueue->uCmdSendCounter));
+    WLAN_OS_REPORT(("Completed      = %d\n", pCmdQueue->uCmdCompltCounter));
+    WLAN_OS_REPORT(("Pipeline       = %d\n", pCmdQueue->bPipeline));
+    WLAN_OS_REPORT(("Sent staged    = %d\n", pCmdQueue->uStagedCmds));
+    WLAN_OS_REPORT(("Back to back   = %d, avg gap %d us\n", 
+                    pCmdQueue->uBackToBackCmds,
+                    pCmdQueue->uBackToBackCmds ? pCmdQueue->uBackToBackGapUs / pCmdQueue->uBackToBackCmds : 0));
+    WLAN_OS_REPORT(("Latency        = avg %d us, max %d us\n", 
+                    pCmdQueue->uCmdCompltCounter ? pCmdQueue->uLatencyTotalUs / pCmdQueue->uCmdCompltCounter : 0,
+                    pCmdQueue->uLatencyMaxUs));
+
+    for (uBin = 0; uBin < CMDQUEUE_LATENCY_HIST_BINS; uBin++)
+    {
+        if (uBin < CMDQUEUE_LATENCY_HIST_BINS - 1)
+        {
+            WLAN_OS_REPORT(("  < %6d us : %d\n", 
+                            (1 << (uBin + CMDQUEUE_LATENCY_HIST_SHIFT)), pCmdQueue->aLatencyHist[uBin]));
+        }
+        else
+        {
+            WLAN_OS_REPORT((" >= %6d us : %d\n", 
+                            (1 << (uBin - 1 + CMDQUEUE_LATENCY_HIST_SHIFT)), pCmdQueue->aLatencyHist[uBin]));
+        }
+    }
 
     cmdQueue_PrintQueue (pCmdQueue);
 }
@@ -820,6 +1014,13 @@ static void cmdQueue_PrintQueue (TCmdQueue *pCmdQueue)
     {
         pHead = &pCmdQueue->aCmdQueue[first];
 
+        WLAN_OS_REPORT(("%3d: Cmd=%2d IE=0x%04x Len=%3d%s\n", 
+                        first, 
+                        pHead->cmdType, 
+                        *(TI_UINT16 *)pHead->aParamsBuf, 
+                        pHead->uParamsLen,
+                        (first == pCmdQueue->uStagedNode) ? " (staged)" : ""));
+
         first++;
         if (first == CMDQUEUE_QUEUE_DEPTH)
         {
@@ -829,6 +1030,60 @@ static void cmdQueue_PrintQueue (TCmdQueue *pCmdQueue)
 }
 
 
+/*
+ * \brief	Update the latency statistics of the completed command
+ * 
+ * \param  pCmdQueue - Pointer to TCmdQueue
+ * \param  pNode - The completed command queue node
+ * \param  uMboxStatus - The command status returned by the FW
+ * \return void
+ * 
+ * \par Description
+ * Called on command complete, before the next command is sent.
+ *
+ * \sa cmdQueue_PrintHistory
+ */
+static void cmdQueue_UpdateLatency (TCmdQueue *pCmdQueue, TCmdQueueNode *pNode, TI_UINT16 uMboxStatus)
+{
+    TCmdQueueHistoryNode *pHistory = &pCmdQueue->aHistory[pCmdQueue->uHistoryIndex];
+    TI_UINT32 uNow = os_timeStampUs (pCmdQueue->hOs);
+    TI_UINT32 uLatency = uNow - pCmdQueue->uSendTimeUs;
+    TI_UINT32 uBin = 0;
+
+    while ((uBin < CMDQUEUE_LATENCY_HIST_BINS - 1) && 
+           (uLatency >= (TI_UINT32)(1 << (uBin + CMDQUEUE_LATENCY_HIST_SHIFT))))
+    {
+        uBin++;
+    }
+    pCmdQueue->aLatencyHist[uBin]++;
+    pCmdQueue->uLatencyTotalUs += uLatency;
+    if (uLatency > pCmdQueue->uLatencyMaxUs)
+    {
+        pCmdQueue->uLatencyMaxUs = uLatency;
+    }
+    if (pCmdQueue->bHeadStaged)
+    {
+        pCmdQueue->uStagedCmds++;
+    }
+
+    pHistory->cmdType     = pNode->cmdType;
+    pHistory->uParam      = *(TI_UINT16 *)pNode->aParamsBuf;
+    pHistory->uMboxStatus = uMboxStatus;
+    pHistory->uLatencyUs  = uLatency;
+    pHistory->uGapUs      = pCmdQueue->uGapUs;
+    pHistory->bStaged     = pCmdQueue->bHeadStaged;
+
+    pCmdQueue->uHistoryIndex++;
+    if (pCmdQueue->uHistoryIndex == CMDQUEUE_HISTORY_DEPTH)
+    {
+        pCmdQueue->uHistoryIndex = 0;
+    }
+
+    /* The gap of the next command is measured only if it is already waiting (head was popped) */
+    pCmdQueue->uCompleteTimeUs = (pCmdQueue->uNumberOfCommandInQueue > 0) ? uNow : 0;
+}
+
+
 /*
  * \brief	print the last uNumOfCmd commands
  * 
@@ -837,7 +1092,9 @@ static void cmdQueue_PrintQueue (TCmdQueue *pCmdQueue)
  * \return void
  * 
  * \par Description
- * Used for debugging purposes
+ * Used for debugging purposes.
+ * Prints the latest completed commands (newest first) with their latency
+ * and the mailbox idle gap before they were sent.
  *
  * \sa cmdQueue_Error
  */
@@ -845,22 +1102,40 @@ void cmdQueue_PrintHistory (TI_HANDLE hCmdQueue, TI_UINT32 uNumOfCmd)
 {
     TCmdQueue* pCmdQueue = (TCmdQueue*)hCmdQueue; 
     TI_UINT32 uCurrentCmdIndex;
-    TI_UINT32 first  = pCmdQueue->head;
-    TCmdQueueNode* pHead;
+    TI_UINT32 first  = pCmdQueue->uHistoryIndex;
+    TCmdQueueHistoryNode* pHistory;
 
+    if (uNumOfCmd > CMDQUEUE_HISTORY_DEPTH)
+    {
+        uNumOfCmd = CMDQUEUE_HISTORY_DEPTH;
+    }
+    if (uNumOfCmd > pCmdQueue->uCmdCompltCounter)
+    {
+        uNumOfCmd = pCmdQueue->uCmdCompltCounter;
+    }
+
+    WLAN_OS_REPORT(("Last %d commands:  Cmd  IE      Status  Latency(us)  Gap(us)  Staged\n", uNumOfCmd));
     
     for (uCurrentCmdIndex = 0; uCurrentCmdIndex < uNumOfCmd; uCurrentCmdIndex++)
     {
-        pHead  =  &pCmdQueue->aCmdQueue[first];
-
         if (first == 0)
         {
-            first = CMDQUEUE_QUEUE_DEPTH - 1;
+            first = CMDQUEUE_HISTORY_DEPTH - 1;
         }
 		else
         {
 			first--;
         }
+
+        pHistory  =  &pCmdQueue->aHistory[first];
+
+        WLAN_OS_REPORT(("                   %3d  0x%04x  %6d  %11d  %7d  %d\n", 
+                        pHistory->cmdType,
+                        pHistory->uParam,
+                        pHistory->uMboxStatus,
+                        pHistory->uLatencyUs,
+                        pHistory->uGapUs,
+                        pHistory->bStaged));
 	}
 }
 
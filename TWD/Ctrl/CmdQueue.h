@@ -48,7 +48,10 @@
  **         Defines                                                         **
  *****************************************************************************/
 #define CMDQUEUE_QUEUE_DEPTH          100
-#define CMDQUEUE_HISTORY_DEPTH        5
+#define CMDQUEUE_HISTORY_DEPTH        16
+#define CMDQUEUE_LATENCY_HIST_BINS    12    /* log2 bins of 64us: <64us, <128us ... >=65ms */
+#define CMDQUEUE_LATENCY_HIST_SHIFT   6
+#define CMDQUEUE_NO_STAGED_NODE       CMDQUEUE_QUEUE_DEPTH
 #define CMDQUEUE_INFO_ELEM_HEADER_LEN 4
 
 
@@ -106,6 +109,21 @@ typedef struct
 } TCmdQueueRecoveryNode;
 
 
+#ifdef TI_DBG
+/*  Completed command record, for debug history */
+typedef struct
+{
+    Command_e               cmdType;
+    TI_UINT16               uParam;         /* IE ID for configure & interrogate */
+    TI_UINT16               uMboxStatus;
+    TI_UINT32               uLatencyUs;     /* From trigger to command complete */
+    TI_UINT32               uGapUs;         /* Mailbox idle time before this command was sent */
+    TI_BOOL                 bStaged;        /* Sent from the staged buffer */
+
+} TCmdQueueHistoryNode;
+#endif
+
+
 typedef void (*TCmdQueueCb) (TI_HANDLE handle, TI_UINT16 uMboxStatus);
 
 
@@ -149,6 +167,26 @@ typedef struct
         TI_UINT32               uCmdCompltCounter;
     #endif
 
+    /* Pipelining: the next command is staged while the current one executes */
+    TI_BOOL                 bPipeline;
+    TI_UINT32               uStagedNode;    /* Queue index of the staged command, or CMDQUEUE_NO_STAGED_NODE */
+    TI_BOOL                 bHeadStaged;    /* The command in progress was sent from the staged buffer */
+
+    #ifdef TI_DBG
+        /* Latency statistics */
+        TI_UINT32               uSendTimeUs;
+        TI_UINT32               uCompleteTimeUs;
+        TI_UINT32               uGapUs;
+        TI_UINT32               aLatencyHist [CMDQUEUE_LATENCY_HIST_BINS];
+        TI_UINT32               uLatencyMaxUs;
+        TI_UINT32               uLatencyTotalUs;
+        TI_UINT32               uBackToBackCmds;
+        TI_UINT32               uBackToBackGapUs;
+        TI_UINT32               uStagedCmds;
+        TCmdQueueHistoryNode    aHistory [CMDQUEUE_HISTORY_DEPTH];
+        TI_UINT32               uHistoryIndex;
+    #endif
+
     /* Error handling */
     TI_BOOL                 bErrorFlag;
     /* Mbox status */
@@ -259,6 +259,23 @@ TI_STATUS cmdQueue_DisableMbox (TI_HANDLE hCmdQueue);
 TI_STATUS cmdQueue_Error (TI_HANDLE hCmdQueue, TI_UINT32 command, TI_UINT32 status, void *param);
 
 
+/*
+ * \brief	Enable or disable mailbox commands pipelining
+ * 
+ * \param  hCmdQueue - Handle to CmdQueue
+ * \param  bEnable - TI_TRUE to stage the next command while the current one executes
+ * \return TI_OK
+ * 
+ * \par Description
+ * When enabled, the next queued command is built in host memory while the FW
+ * executes the current one, and is sent as soon as the current command completes,
+ * before the completed command's callback is called.
+ * 
+ * \sa cmdQueue_Init
+ */
+TI_STATUS cmdQueue_SetPipeline (TI_HANDLE hCmdQueue, TI_BOOL bEnable);
+
+
 #ifdef TI_DBG
 
 /*
@@ -50,6 +50,7 @@ TI_STATUS	txCtrlBlk_Destroy   (TI_HANDLE hTxCtrlBlk);
 TI_STATUS   txCtrlBlk_Init      (TI_HANDLE hTxCtrlBlk, TI_HANDLE hReport, TI_HANDLE hContext);
 TTxCtrlBlk *txCtrlBlk_Alloc     (TI_HANDLE hTxCtrlBlk);
 void		txCtrlBlk_Free      (TI_HANDLE hTxCtrlBlk, TTxCtrlBlk *pCurrentEntry);
+void		txCtrlBlk_FreeBatch (TI_HANDLE hTxCtrlBlk, TTxCtrlBlk **apEntries, TI_UINT32 uNumEntries);
 TTxCtrlBlk *txCtrlBlk_GetPointer(TI_HANDLE hTxCtrlBlk, TI_UINT8 descId);
 #ifdef TI_DBG
 void		txCtrlBlk_PrintTable(TI_HANDLE hTxCtrlBlk);
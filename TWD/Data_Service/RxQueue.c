@@ -44,11 +44,13 @@
 #include "RxBuf.h"
 #include "TWDriver.h"
 #include "public_descriptors.h"
+#include "timer.h"
 
 /************************ static definition declaration *****************************/
-#define RX_QUEUE_ARRAY_SIZE		                            8
-#define RX_QUEUE_ARRAY_SIZE_BIT_MASK                        0x7 /* RX_QUEUE_ARRAY_SIZE -1 */
+#define RX_QUEUE_ARRAY_SIZE		                            64
+#define RX_QUEUE_ARRAY_SIZE_BIT_MASK                        0x3F /* RX_QUEUE_ARRAY_SIZE -1 */
 #define RX_QUEUE_WIN_SIZE		                            RX_QUEUE_ARRAY_SIZE
+#define RX_QUEUE_WIN_SIZE_DEF                               8   /* Until the FW BA receiver window is configured */
 
 #define BA_SESSION_IS_A_BIGGER_THAN_B(A,B)       (((((A)-(B)) & 0xFFF) < 0x7FF) && ((A)!=(B)))
 #define BA_SESSION_IS_A_BIGGER_EQUAL_THAN_B(A,B) (((((A)-(B)) & 0xFFF) < 0x7FF))
@@ -78,6 +80,15 @@ typedef struct
     TI_UINT32	        aTidWinSize;
 	/* expected sequence number (ESN) */ 
     TI_UINT16	        aTidExpectedSn;
+    /* max windows size accepted in ADDBA (as configured to the FW BA receiver) */
+    TI_UINT32           uMaxWinSize;
+    /* number of packets saved in the array */
+    TI_UINT32           uSavedPackets;
+    /* reorder flush timer, started while packets are saved in the array */
+    TI_HANDLE           hReorderTimer;
+    TI_BOOL             bReorderTimerRunning;
+    /* the RxQueue object (for the timer callback) */
+    TI_HANDLE           hRxQueue;
 } TRxQueueTidDataBase;	
 
 /* structure describe set of data that assist of manage one SA RxQueue arrays */
@@ -86,19 +97,38 @@ typedef struct
     TRxQueueTidDataBase tSa1ArrayMng [MAX_NUM_OF_802_1d_TAGS];
 } TRxQueueArraysMng;	
 
+/* RxQueue reordering statistics */
+typedef struct 
+{
+    TI_UINT32           uInOrderPackets;            /* passed as soon as received (SN is the expected one) */
+    TI_UINT32           uReorderedPackets;          /* saved in the array and passed later */
+    TI_UINT32           uTimeoutPackets;            /* saved in the array and passed on reorder timeout */
+    TI_UINT32           uTimeoutEvents;             /* reorder timer expiries that passed packets */
+    TI_UINT32           uDuplicatePackets;          /* dropped since SN is below the window or already saved */
+} TRxQueueDbgCount;
+
 /* main RxQueue structure in order to management the packets disordered array. */
 typedef struct 
 {
     TI_HANDLE           hOs;                        /* OS handler */
     TI_HANDLE           hReport;                    /* Report handler */
+    TI_HANDLE           hTimer;                     /* Timer module handler */
     TRxQueueArraysMng   tRxQueueArraysMng;          /* manage each Source Address RxQueue arrays */
     TPacketReceiveCb    tReceivePacketCB;           /* Receive packets CB address */
     TI_HANDLE           hReceivePacketCB_handle;    /* Receive packets CB handler */
+    TI_UINT32           uReorderTimeout;            /* Time [msec] to hold packets waiting for a missing SN (0 = no timeout) */
+
+#ifdef TI_DBG
+    TRxQueueDbgCount    tDbgCount;                  /* Reordering statistics */
+#endif /* TI_DBG */
 
 } TRxQueue;	
 
 /************************ static function declaration *****************************/
 static TI_STATUS RxQueue_PassPacket (TI_HANDLE hRxQueue, TI_STATUS tStatus, const void *pBuffer);
+static void      RxQueue_PassSavedPacket (TRxQueue *pRxQueue, TRxQueueTidDataBase *pTidDataBase, TI_BOOL bTimeout);
+static void      RxQueue_UpdateReorderTimer (TRxQueue *pRxQueue, TRxQueueTidDataBase *pTidDataBase);
+static void      RxQueue_ReorderTimeout (TI_HANDLE hTidDataBase, TI_BOOL bTwdInitOccured);
 
 /** 
  * \fn     RxQueue_Create() 
@@ -143,6 +173,16 @@ TI_HANDLE RxQueue_Create (TI_HANDLE hOs)
 TI_STATUS RxQueue_Destroy (TI_HANDLE hRxQueue)
 {
     TRxQueue *pRxQueue = (TRxQueue *)hRxQueue;
+    TI_UINT32 uTid;
+
+    /* free the reorder timers */
+    for (uTid = 0; uTid < MAX_NUM_OF_802_1d_TAGS; uTid++)
+    {
+        if (pRxQueue->tRxQueueArraysMng.tSa1ArrayMng[uTid].hReorderTimer)
+        {
+            tmr_DestroyTimer (pRxQueue->tRxQueueArraysMng.tSa1ArrayMng[uTid].hReorderTimer);
+        }
+    }
 
     /* free module object */
 	os_memoryFree (pRxQueue->hOs, pRxQueue, sizeof(TRxQueue));
@@ -156,23 +196,91 @@ TI_STATUS RxQueue_Destroy (TI_HANDLE hRxQueue)
  * \brief  Init required handles 
  * 
  * Init required handles and module variables.
+ * Create the per TID reorder timers.
  * 
  * \note    
  * \param  hRxQueue - The module object
  * \param  hReport - Report module Handles
+ * \param  hTimer - Timer module Handles
  * \return TI_OK on success or TI_NOK on failure  
  * \sa     
  */ 
-TI_STATUS RxQueue_Init (TI_HANDLE hRxQueue, TI_HANDLE hReport)
+TI_STATUS RxQueue_Init (TI_HANDLE hRxQueue, TI_HANDLE hReport, TI_HANDLE hTimer)
 {
-	TRxQueue *pRxQueue = (TRxQueue *)hRxQueue;
+	TRxQueue            *pRxQueue = (TRxQueue *)hRxQueue;
+    TRxQueueTidDataBase *pTidDataBase;
+    TI_UINT32            uTid;
     
     pRxQueue->hReport   = hReport;
+    pRxQueue->hTimer    = hTimer;
+
+    for (uTid = 0; uTid < MAX_NUM_OF_802_1d_TAGS; uTid++)
+    {
+        pTidDataBase = &(pRxQueue->tRxQueueArraysMng.tSa1ArrayMng[uTid]);
+
+        pTidDataBase->uMaxWinSize = RX_QUEUE_WIN_SIZE_DEF;
+        pTidDataBase->hRxQueue    = hRxQueue;
+        pTidDataBase->hReorderTimer = tmr_CreateTimer (hTimer);
+        if (pTidDataBase->hReorderTimer == NULL)
+        {
+            return TI_NOK;
+        }
+    }
 
 	return TI_OK;
 }
 
 
+/** 
+ * \fn     RxQueue_SetDefaults() 
+ * \brief  Set module defaults 
+ * 
+ * \note    
+ * \param  hRxQueue    - The module object
+ * \param  pInitParams - The TWD init parameters
+ * \return void  
+ * \sa     
+ */ 
+void RxQueue_SetDefaults (TI_HANDLE hRxQueue, TTwdInitParams *pInitParams)
+{
+	TRxQueue *pRxQueue = (TRxQueue *)hRxQueue;
+
+    pRxQueue->uReorderTimeout = pInitParams->tGeneral.uRxBaReorderTimeout;
+}
+
+
+/** 
+ * \fn     RxQueue_SetBaWinSize() 
+ * \brief  Set the max BA window accepted for a TID 
+ * 
+ * Called when the FW BA receiver (responder) is configured for the TID, so the 
+ *   window taken from the ADDBA request is limited to what the FW responds.
+ * 
+ * \note    
+ * \param  hRxQueue - The module object
+ * \param  uTid     - The TID
+ * \param  uWinSize - The BA receiver window size
+ * \return void  
+ * \sa     
+ */ 
+void RxQueue_SetBaWinSize (TI_HANDLE hRxQueue, TI_UINT8 uTid, TI_UINT16 uWinSize)
+{
+	TRxQueue *pRxQueue = (TRxQueue *)hRxQueue;
+
+    if (uTid >= MAX_NUM_OF_802_1d_TAGS)
+    {
+        return;
+    }
+
+    if ((uWinSize == 0) || (uWinSize > RX_QUEUE_WIN_SIZE))
+    {
+        uWinSize = RX_QUEUE_WIN_SIZE;
+    }
+
+    pRxQueue->tRxQueueArraysMng.tSa1ArrayMng[uTid].uMaxWinSize = uWinSize;
+}
+
+
 /** 
  * \fn     RxQueue_Register_CB()
  * \brief  Register the function to be called for received Rx.
@@ -232,22 +340,17 @@ void RxQueue_CloseBaSession(TI_HANDLE hRxQueue, TI_UINT8 uFrameTid)
         pTidDataBase->aTidBaEstablished = TI_FALSE;
 
         /* pass all valid entries at the array */ 
-        for (i = 0; (i < RX_QUEUE_ARRAY_SIZE) && (i < RX_QUEUE_WIN_SIZE); i++)
+        for (i = 0; (i < RX_QUEUE_ARRAY_SIZE) && (pTidDataBase->uSavedPackets > 0); i++)
         {
-            if (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL)
-            {
-                RxQueue_PassPacket (pRxQueue, 
-                                    pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].tStatus,
-                                    pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket);
-
-                pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket = NULL;
-            }
+            RxQueue_PassSavedPacket (pRxQueue, pTidDataBase, TI_FALSE);
 
             pTidDataBase->aWinStartArrayInex ++;
 
             /* aWinStartArrayInex % RX_QUEUE_ARRAY_SIZE */
             pTidDataBase->aWinStartArrayInex &= RX_QUEUE_ARRAY_SIZE_BIT_MASK;
         }
+
+        RxQueue_UpdateReorderTimer (pRxQueue, pTidDataBase);
     }
 }
 
@@ -298,6 +401,136 @@ static TI_STATUS RxQueue_PassPacket (TI_HANDLE hRxQueue, TI_STATUS tStatus, cons
 }
 
 
+/** 
+ * \fn     RxQueue_PassSavedPacket()
+ * \brief  Pass the packet saved in the window start entry (if any) to upper layer.
+ *
+ * \note   The caller is responsible for advancing the window start.
+ * \param  pRxQueue     - RxQueue object.
+ * \param  pTidDataBase - The TID data base.
+ * \param  bTimeout     - Indicates if passed due to reorder timeout (for statistics).
+ * \return None 
+ * \sa     
+ */ 
+static void RxQueue_PassSavedPacket (TRxQueue *pRxQueue, TRxQueueTidDataBase *pTidDataBase, TI_BOOL bTimeout)
+{
+    TRxQueuePacketEntry *pEntry = &(pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex]);
+
+    if (pEntry->pPacket == NULL)
+    {
+        return;
+    }
+
+    RxQueue_PassPacket (pRxQueue, pEntry->tStatus, pEntry->pPacket);
+
+    pEntry->pPacket = NULL;
+    pTidDataBase->uSavedPackets--;
+
+#ifdef TI_DBG
+    if (bTimeout)
+    {
+        pRxQueue->tDbgCount.uTimeoutPackets++;
+    }
+    else
+    {
+        pRxQueue->tDbgCount.uReorderedPackets++;
+    }
+#endif /* TI_DBG */
+}
+
+
+/** 
+ * \fn     RxQueue_UpdateReorderTimer()
+ * \brief  Start or stop the TID reorder timer according to the saved packets.
+ *
+ * The timer runs while packets are saved waiting for a missing SN, so a lost packet 
+ *   doesn't stall the TID until the next BAR or packet beyond the window.
+ *
+ * \note   
+ * \param  pRxQueue     - RxQueue object.
+ * \param  pTidDataBase - The TID data base.
+ * \return None 
+ * \sa     RxQueue_ReorderTimeout
+ */ 
+static void RxQueue_UpdateReorderTimer (TRxQueue *pRxQueue, TRxQueueTidDataBase *pTidDataBase)
+{
+    if (pTidDataBase->uSavedPackets > 0)
+    {
+        if (!pTidDataBase->bReorderTimerRunning && (pRxQueue->uReorderTimeout > 0))
+        {
+            tmr_StartTimer (pTidDataBase->hReorderTimer,
+                            RxQueue_ReorderTimeout,
+                            (TI_HANDLE)pTidDataBase,
+                            pRxQueue->uReorderTimeout,
+                            TI_FALSE);
+            pTidDataBase->bReorderTimerRunning = TI_TRUE;
+        }
+    }
+    else if (pTidDataBase->bReorderTimerRunning)
+    {
+        tmr_StopTimer (pTidDataBase->hReorderTimer);
+        pTidDataBase->bReorderTimerRunning = TI_FALSE;
+    }
+}
+
+
+/** 
+ * \fn     RxQueue_ReorderTimeout()
+ * \brief  TID reorder timer expiry.
+ *
+ * Give up waiting for the missing packets at the window start: move the window start 
+ *   to the first saved packet and pass all sequential saved packets from there.
+ * If packets are still saved (after another missing SN) the timer is restarted.
+ *
+ * \note   
+ * \param  hTidDataBase    - The TID data base.
+ * \param  bTwdInitOccured - Indicates if TWDriver recovery occured since timer started.
+ * \return None 
+ * \sa     RxQueue_UpdateReorderTimer
+ */ 
+static void RxQueue_ReorderTimeout (TI_HANDLE hTidDataBase, TI_BOOL bTwdInitOccured)
+{
+    TRxQueueTidDataBase *pTidDataBase = (TRxQueueTidDataBase *)hTidDataBase;
+    TRxQueue            *pRxQueue     = (TRxQueue *)pTidDataBase->hRxQueue;
+    TI_UINT32            i;
+
+    pTidDataBase->bReorderTimerRunning = TI_FALSE;
+
+    if ((pTidDataBase->aTidBaEstablished != TI_TRUE) || (pTidDataBase->uSavedPackets == 0))
+    {
+        return;
+    }
+
+    /* skip the missing packets up to the first saved one */
+    for (i = 0; 
+         (i < RX_QUEUE_ARRAY_SIZE) && (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket == NULL); 
+         i++)
+    {
+        pTidDataBase->aWinStartArrayInex++;
+        pTidDataBase->aWinStartArrayInex &= RX_QUEUE_ARRAY_SIZE_BIT_MASK;
+        pTidDataBase->aTidExpectedSn++;
+        pTidDataBase->aTidExpectedSn &= 0xFFF;
+    }
+
+    /* pass all sequential saved packets */
+    while (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL)
+    {
+        RxQueue_PassSavedPacket (pRxQueue, pTidDataBase, TI_TRUE);
+
+        pTidDataBase->aWinStartArrayInex++;
+        pTidDataBase->aWinStartArrayInex &= RX_QUEUE_ARRAY_SIZE_BIT_MASK;
+        pTidDataBase->aTidExpectedSn++;
+        pTidDataBase->aTidExpectedSn &= 0xFFF;
+    }
+
+#ifdef TI_DBG
+    pRxQueue->tDbgCount.uTimeoutEvents++;
+#endif /* TI_DBG */
+
+    RxQueue_UpdateReorderTimer (pRxQueue, pTidDataBase);
+}
+
+
 /** 
  * \fn     RxQueue_ReceivePacket()
  * \brief  Main function of the RxQueue module. 
@@ -428,6 +661,9 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
 
             /* pass the packet */
             RxQueue_PassPacket (pRxQueue, tStatus, pBuffer);
+#ifdef TI_DBG
+            pRxQueue->tDbgCount.uInOrderPackets++;
+#endif /* TI_DBG */
 
             pTidDataBase->aTidExpectedSn++;
             pTidDataBase->aTidExpectedSn &= 0xfff;
@@ -441,11 +677,7 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
             /* pass all saved queue packets with SN higher then the expected one */
             while (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL)
             {
-                RxQueue_PassPacket (pRxQueue, 
-                                    pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].tStatus,
-                                    pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket);
-
-                pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket = NULL;
+                RxQueue_PassSavedPacket (pRxQueue, pTidDataBase, TI_FALSE);
 
                 pTidDataBase->aWinStartArrayInex++;
 
@@ -456,6 +688,8 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
 				 pTidDataBase->aTidExpectedSn &= 0xfff;
             }
 
+            RxQueue_UpdateReorderTimer (pRxQueue, pTidDataBase);
+
             return;
         }
 
@@ -463,6 +697,9 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
         if (! BA_SESSION_IS_A_BIGGER_THAN_B (uFrameSn, pTidDataBase->aTidExpectedSn))
         {
 			RxQueue_PassPacket (pRxQueue, TI_NOK, pBuffer);
+#ifdef TI_DBG
+            pRxQueue->tDbgCount.uDuplicatePackets++;
+#endif /* TI_DBG */
 
             return;
         }
@@ -483,11 +720,17 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
                 pTidDataBase->aPaketsQueue[uSaveInex].tStatus = tStatus;
                 pTidDataBase->aPaketsQueue[uSaveInex].pPacket = (void *)pBuffer;
                 pTidDataBase->aPaketsQueue[uSaveInex].uFrameSn = uFrameSn;
+                pTidDataBase->uSavedPackets++;
+
+                RxQueue_UpdateReorderTimer (pRxQueue, pTidDataBase);
 			}
 			else
 			{
 
 				 RxQueue_PassPacket (pRxQueue, TI_NOK, pBuffer);
+#ifdef TI_DBG
+                 pRxQueue->tDbgCount.uDuplicatePackets++;
+#endif /* TI_DBG */
 				 return;
 			}
             return;
@@ -521,14 +764,7 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
                   (i < pTidDataBase->aTidWinSize);
                  i++)
             {
-                if (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL)
-                {
-                    RxQueue_PassPacket (pRxQueue, 
-                                        pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].tStatus,
-                                        pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket);
-
-                    pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket = NULL;
-                }
+                RxQueue_PassSavedPacket (pRxQueue, pTidDataBase, TI_FALSE);
 
                 pTidDataBase->aWinStartArrayInex++;
 
@@ -549,11 +785,7 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
             {
                 /* Incase the uWinStartDelta lower than aTidWinSize check if ther are packets stored in Array */
                 while (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL) {
-                    RxQueue_PassPacket (pRxQueue, 
-                                            pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].tStatus,
-                                            pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket);
-    
-                    pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket = NULL;
+                    RxQueue_PassSavedPacket (pRxQueue, pTidDataBase, TI_FALSE);
     
                     pTidDataBase->aWinStartArrayInex++;
     
@@ -569,8 +801,15 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
             {
                 /* pass the packet */
                 RxQueue_PassPacket (pRxQueue, tStatus, pBuffer);
+#ifdef TI_DBG
+                pRxQueue->tDbgCount.uInOrderPackets++;
+#endif /* TI_DBG */
                 pTidDataBase->aTidExpectedSn++;
 				pTidDataBase->aTidExpectedSn &= 0xfff; 
+
+                /* the array index that represents the passed packet SN is left behind */
+                pTidDataBase->aWinStartArrayInex++;
+                pTidDataBase->aWinStartArrayInex &= RX_QUEUE_ARRAY_SIZE_BIT_MASK;
             }
             else
             {
@@ -582,9 +821,12 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
 				/* save the packet in the last entry of the queue */
 				pTidDataBase->aPaketsQueue[uSaveInex].tStatus = tStatus;
 				pTidDataBase->aPaketsQueue[uSaveInex].pPacket = (void *)pBuffer;
-				pTidDataBase->aPaketsQueue[uSaveInex].pPacket = (void *)pBuffer;
+				pTidDataBase->aPaketsQueue[uSaveInex].uFrameSn = uFrameSn;
+                pTidDataBase->uSavedPackets++;
             }
 
+            RxQueue_UpdateReorderTimer (pRxQueue, pTidDataBase);
+
             return;
         }
     }
@@ -657,25 +899,27 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
                 /* pass all saved queue packets with SN lower then the new win start */
                 for (i = 0;
                      ((i < uWinStartDelta) || (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL)) &&
-                      (i < RX_QUEUE_ARRAY_SIZE) && 
-                      (i < RX_QUEUE_WIN_SIZE);
+                      (i < RX_QUEUE_ARRAY_SIZE);
                      i++)
                 {
-                    if (pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket != NULL)
-                    {
-                        RxQueue_PassPacket (pRxQueue, 
-                                            pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].tStatus,
-                                            pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket);
-
-                        pTidDataBase->aPaketsQueue[pTidDataBase->aWinStartArrayInex].pPacket = NULL;
-                    }
+                    RxQueue_PassSavedPacket (pRxQueue, pTidDataBase, TI_FALSE);
 
                     pTidDataBase->aWinStartArrayInex++;
 
                     /* aWinStartArrayInex % RX_QUEUE_ARRAY_SIZE */
                     pTidDataBase->aWinStartArrayInex &= RX_QUEUE_ARRAY_SIZE_BIT_MASK;
+
+                    pTidDataBase->aTidExpectedSn++;
+                    pTidDataBase->aTidExpectedSn &= 0xFFF;
                 }
-                pTidDataBase->aTidExpectedSn = uStartingSequenceNumber;
+
+                /* If the whole array was passed before reaching the new win start, just jump to it (the array is empty) */
+                if (i < uWinStartDelta)
+                {
+                    pTidDataBase->aTidExpectedSn = uStartingSequenceNumber;
+                }
+
+                RxQueue_UpdateReorderTimer (pRxQueue, pTidDataBase);
             }
             break;
 
@@ -722,10 +966,11 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
                 pTidDataBase->aTidWinSize = (uBAParameterField & DOT11_BA_PARAMETER_SET_FIELD_WINSIZE_BITS) >> 6; 
 
                 /* winSize illegal value ? */ 
-                if (pTidDataBase->aTidWinSize > RX_QUEUE_WIN_SIZE)
+                if ((pTidDataBase->aTidWinSize == 0) || (pTidDataBase->aTidWinSize > pTidDataBase->uMaxWinSize))
                 {
-                    /* In case the win Size is higher then 8 the driver and the FW set it to 8 and inform the AP in ADDBA respond */
-                    pTidDataBase->aTidWinSize = RX_QUEUE_WIN_SIZE;
+                    /* In case the win Size is higher then the configured BA receiver window (up to 64), 
+                       the FW sets it to the configured size and informs the AP in ADDBA respond */
+                    pTidDataBase->aTidWinSize = pTidDataBase->uMaxWinSize;
                 }
 
                 /* packet TID BA not yet established and winSize legal */
@@ -737,6 +982,7 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
                 COPY_WLAN_WORD (&uStartingSequenceNumber, (TI_UINT16 *)pDataFrameBody); /* copy with endianess handling. */
                 pTidDataBase->aTidExpectedSn = (uStartingSequenceNumber & DOT11_SC_SEQ_NUM_MASK) >> 4;
                 pTidDataBase->aWinStartArrayInex = 0;
+                pTidDataBase->uSavedPackets = 0;
                 os_memoryZero (pRxQueue->hOs, pTidDataBase->aPaketsQueue, sizeof (TRxQueuePacketEntry) * RX_QUEUE_ARRAY_SIZE);
 
                 break;
@@ -797,3 +1043,56 @@ void RxQueue_ReceivePacket (TI_HANDLE hRxQueue, const void * pBuffer)
     return;
 }
 
+
+#ifdef TI_DBG
+/** 
+ * \fn     RxQueue_ClearStats()
+ * \brief  Clear the reordering statistics.
+ *
+ * \note   
+ * \param  hRxQueue - RxQueue handle.
+ * \return None 
+ * \sa     RxQueue_PrintStats
+ */ 
+void RxQueue_ClearStats (TI_HANDLE hRxQueue)
+{
+    TRxQueue *pRxQueue = (TRxQueue *)hRxQueue;
+
+    os_memoryZero (pRxQueue->hOs, &pRxQueue->tDbgCount, sizeof(TRxQueueDbgCount));
+}
+
+
+/** 
+ * \fn     RxQueue_PrintStats()
+ * \brief  Print the reordering statistics and the BA sessions state.
+ *
+ * \note   
+ * \param  hRxQueue - RxQueue handle.
+ * \return None 
+ * \sa     RxQueue_ClearStats
+ */ 
+void RxQueue_PrintStats (TI_HANDLE hRxQueue)
+{
+    TRxQueue            *pRxQueue = (TRxQueue *)hRxQueue;
+    TRxQueueTidDataBase *pTidDataBase;
+    TI_UINT32            uTid;
+
+    WLAN_OS_REPORT(("RxQueue Statistics:\n"));
+    WLAN_OS_REPORT(("In-order:    %u\n", pRxQueue->tDbgCount.uInOrderPackets));
+    WLAN_OS_REPORT(("Reordered:   %u\n", pRxQueue->tDbgCount.uReorderedPackets));
+    WLAN_OS_REPORT(("Timed-out:   %u (in %u timeouts)\n", pRxQueue->tDbgCount.uTimeoutPackets, pRxQueue->tDbgCount.uTimeoutEvents));
+    WLAN_OS_REPORT(("Duplicates:  %u\n", pRxQueue->tDbgCount.uDuplicatePackets));
+    WLAN_OS_REPORT(("Reorder timeout: %u msec\n", pRxQueue->uReorderTimeout));
+
+    for (uTid = 0; uTid < MAX_NUM_OF_802_1d_TAGS; uTid++)
+    {
+        pTidDataBase = &(pRxQueue->tRxQueueArraysMng.tSa1ArrayMng[uTid]);
+        if (pTidDataBase->aTidBaEstablished)
+        {
+            WLAN_OS_REPORT(("TID %u: WinSize=%u (max %u), ESN=%u, Saved=%u\n", 
+                            uTid, pTidDataBase->aTidWinSize, pTidDataBase->uMaxWinSize, 
+                            pTidDataBase->aTidExpectedSn, pTidDataBase->uSavedPackets));
+        }
+    }
+}
+#endif /* TI_DBG */
@@ -144,6 +144,8 @@ TI_STATUS txCtrlBlk_Init (TI_HANDLE hTxCtrlBlk, TI_HANDLE hReport, TI_HANDLE hCo
         /* Prepare the Txn fields to the host-slave register (fixed address) */
         pTxn = &(pTxCtrlBlk->aTxCtrlBlkTbl[entry].tTxnStruct);
         TXN_PARAM_SET(pTxn, TXN_LOW_PRIORITY, TXN_FUNC_ID_WLAN, TXN_DIRECTION_WRITE, TXN_FIXED_ADDR)
+        /* The packet data buffers (OS packets or allocated mgmt buffers) may be written directly by the bus DMA */
+        TXN_PARAM_SET_DMA_ABLE(pTxn, TXN_DMA_ABLE);
 	}
 
 	/* Write null in the next-free index of the last entry. */
@@ -236,6 +238,60 @@ void txCtrlBlk_Free (TI_HANDLE hTxCtrlBlk, TTxCtrlBlk *pCurrentEntry)
 }
 
 
+/****************************************************************************
+ *					txCtrlBlk_FreeBatch()
+ ****************************************************************************
+ * DESCRIPTION:	
+	Free a batch of entries (e.g. all the packets of one Tx-complete).
+	The entries are linked to each other first, and then the whole chain is 
+	  linked after entry 0 in one critical section.
+ ****************************************************************************/
+void txCtrlBlk_FreeBatch (TI_HANDLE hTxCtrlBlk, TTxCtrlBlk **apEntries, TI_UINT32 uNumEntries)
+{
+	TTxCtrlBlkObj   *pTxCtrlBlk = (TTxCtrlBlkObj *)hTxCtrlBlk;
+	TTxCtrlBlk *pFirstFreeEntry = &(pTxCtrlBlk->aTxCtrlBlkTbl[0]);
+	TTxCtrlBlk *pChainHead = NULL;
+	TTxCtrlBlk *pChainTail = NULL;
+	TI_UINT32   i;
+
+	/* Link the freed entries to a chain (outside the critical section). */
+	for (i = 0; i < uNumEntries; i++)
+	{
+#ifdef TI_DBG
+		/* If the pointed entry is already free, skip it (not expected to happen). */
+		if (apEntries[i]->pNextFreeEntry != 0)
+		{
+			continue;
+		}
+		pTxCtrlBlk->uNumUsedEntries--;
+#endif
+		if (pChainTail == NULL)
+		{
+			pChainHead = apEntries[i];
+		}
+		else
+		{
+			pChainTail->pNextFreeEntry = apEntries[i];
+		}
+		pChainTail = apEntries[i];
+	}
+
+	if (pChainHead == NULL)
+	{
+		return;
+	}
+
+    /* Protect block freeing from preemption (may be called from external context) */
+    context_EnterCriticalSection (pTxCtrlBlk->hContext);
+
+	/* Link the chain between entry 0 and the next free entry. */
+	pChainTail->pNextFreeEntry      = pFirstFreeEntry->pNextFreeEntry;
+	pFirstFreeEntry->pNextFreeEntry = pChainHead;
+
+    context_LeaveCriticalSection (pTxCtrlBlk->hContext);
+}
+
+
 /****************************************************************************
  *					txCtrlBlk_GetPointer()
  ****************************************************************************
@@ -67,6 +67,8 @@
  */
 static void cmdMbox_TimeOut (TI_HANDLE hCmdMbox, TI_BOOL bTwdInitOccured);
 static void cmdMbox_ConfigHwCb (TI_HANDLE hCmdMbox, TTxnStruct *pTxn);
+static TI_UINT32 cmdMbox_BuildCommand (TCmdMbox *pCmdMbox, Command_t *pCmd, Command_e cmdType, TI_UINT8* pParamsBuf, TI_UINT32 uWriteLen);
+static void cmdMbox_Transmit (TCmdMbox *pCmdMbox);
 
 /*
  * \brief	Create the mailbox object
@@ -160,6 +162,10 @@ TI_STATUS cmdMbox_Init (TI_HANDLE hCmdMbox,
     pCmdMbox->bCmdInProgress = TI_FALSE;
     pCmdMbox->fErrorCb = fErrorCb;
 
+    pCmdMbox->pWriteCmdTxn = &pCmdMbox->aCmdTxn[0];
+    pCmdMbox->pStagedCmdTxn = &pCmdMbox->tSpareCmdTxn;
+    pCmdMbox->bCmdStaged = TI_FALSE;
+
 	/* allocate OS timer memory */
     pCmdMbox->hCmdMboxTimer = tmr_CreateTimer (hTimer);
 	if (pCmdMbox->hCmdMboxTimer == NULL)
@@ -197,9 +203,7 @@ TI_STATUS cmdMbox_Init (TI_HANDLE hCmdMbox,
 TI_STATUS cmdMbox_SendCommand       (TI_HANDLE hCmdMbox, Command_e cmdType, TI_UINT8* pParamsBuf, TI_UINT32 uWriteLen, TI_UINT32 uReadLen)
 {
     TCmdMbox   *pCmdMbox = (TCmdMbox *)hCmdMbox;
-    TTxnStruct *pCmdTxn = (TTxnStruct*)&pCmdMbox->aCmdTxn[0].tTxnStruct;
-    TTxnStruct *pRegTxn = (TTxnStruct*)&pCmdMbox->aRegTxn[0].tTxnStruct;
-    Command_t  *pCmd = (Command_t*)&pCmdMbox->aCmdTxn[0].tCmdMbox;
+    Command_t  *pCmd = (Command_t*)&pCmdMbox->pWriteCmdTxn->tCmdMbox;
     
 
     if (pCmdMbox->bCmdInProgress)
@@ -210,19 +214,145 @@ TI_STATUS cmdMbox_SendCommand       (TI_HANDLE hCmdMbox, Command_e cmdType, TI_U
     /* Add the CMDMBOX_HEADER_LEN to the read length, used when reading the result later on */
     pCmdMbox->uReadLen = uReadLen + CMDMBOX_HEADER_LEN;
     /* Prepare the Cmd Hw template */
+    pCmdMbox->uWriteLen = cmdMbox_BuildCommand (pCmdMbox, pCmd, cmdType, pParamsBuf, uWriteLen);
+
+    cmdMbox_Transmit (pCmdMbox);
+
+    return TXN_STATUS_PENDING;
+}
+
+
+/*
+ * \brief	Stage the next Command in host memory
+ * 
+ * \param  hCmdMbox  - Handle to CmdMbox
+ * \param  cmdType  - 
+ * \param  pParamsBuf  - The buffer that will be written to the mailbox
+ * \param  uWriteLen  - Length of data to write to the mailbox
+ * \param  uReadLen  - Length of data to read from the mailbox (when the result is received)
+ * \return TI_OK
+ * 
+ * \par Description
+ * Build the mailbox image of the next command in the spare write buffer.
+ * May be called while a command is in progress, since the spare buffer
+ * is not used by the bus until cmdMbox_SendStagedCommand is called.
+ * A previously staged command is overwritten.
+ * 
+ * \sa cmdMbox_SendStagedCommand
+ */
+TI_STATUS cmdMbox_StageCommand      (TI_HANDLE hCmdMbox, Command_e cmdType, TI_UINT8* pParamsBuf, TI_UINT32 uWriteLen, TI_UINT32 uReadLen)
+{
+    TCmdMbox   *pCmdMbox = (TCmdMbox *)hCmdMbox;
+    Command_t  *pCmd = (Command_t*)&pCmdMbox->pStagedCmdTxn->tCmdMbox;
+
+    pCmdMbox->uStagedReadLen  = uReadLen + CMDMBOX_HEADER_LEN;
+    pCmdMbox->uStagedWriteLen = cmdMbox_BuildCommand (pCmdMbox, pCmd, cmdType, pParamsBuf, uWriteLen);
+    pCmdMbox->bCmdStaged = TI_TRUE;
+
+    return TI_OK;
+}
+
+
+/*
+ * \brief	Send the staged Command to the Mailbox
+ * 
+ * \param  hCmdMbox  - Handle to CmdMbox
+ * \return TI_PENDING, or TI_NOK if no command is staged or a command is in progress
+ * 
+ * \par Description
+ * Swap the staged buffer with the write buffer of the previous command
+ * and send it to the FW's mailbox. The command parameters are not copied again.
+ * 
+ * \sa cmdMbox_StageCommand, cmdMbox_SendCommand
+ */
+TI_STATUS cmdMbox_SendStagedCommand (TI_HANDLE hCmdMbox)
+{
+    TCmdMbox   *pCmdMbox = (TCmdMbox *)hCmdMbox;
+    TCmdTxn    *pCmdTxn;
+
+    if (pCmdMbox->bCmdInProgress || !pCmdMbox->bCmdStaged)
+    {
+        return TI_NOK;
+    }
+
+    /* The previous write buffer becomes the spare one */
+    pCmdTxn = pCmdMbox->pWriteCmdTxn;
+    pCmdMbox->pWriteCmdTxn = pCmdMbox->pStagedCmdTxn;
+    pCmdMbox->pStagedCmdTxn = pCmdTxn;
+    pCmdMbox->bCmdStaged = TI_FALSE;
+
+    pCmdMbox->uReadLen  = pCmdMbox->uStagedReadLen;
+    pCmdMbox->uWriteLen = pCmdMbox->uStagedWriteLen;
+
+#ifdef TI_DBG
+    pCmdMbox->uStagedSendCounter++;
+#endif
+
+    cmdMbox_Transmit (pCmdMbox);
+
+    return TXN_STATUS_PENDING;
+}
+
+
+/*
+ * \brief	Build a command mailbox image
+ * 
+ * \param  pCmdMbox  - Pointer to CmdMbox
+ * \param  pCmd  - The mailbox image to build
+ * \param  cmdType  - 
+ * \param  pParamsBuf  - The command parameters
+ * \param  uWriteLen  - Length of the command parameters
+ * \return The length to write to the mailbox, including header and 32 bit alignment
+ * 
+ * \par Description
+ *             
+ *       ------------------------------------------------------
+ *      | CmdMbox Header | Cmd Header    | Command parameters |
+ *      ------------------------------------------------------
+ *      | ID   | Status  | Type | Length | Command parameters |
+ *      ------------------------------------------------------
+ *       16bit   16bit    16bit   16bit     
+ *
+ * \sa cmdMbox_SendCommand, cmdMbox_StageCommand
+ */
+static TI_UINT32 cmdMbox_BuildCommand (TCmdMbox *pCmdMbox, Command_t *pCmd, Command_e cmdType, TI_UINT8* pParamsBuf, TI_UINT32 uWriteLen)
+{
+    TI_UINT32   uLen;
+
     pCmd->cmdID = cmdType;
     pCmd->cmdStatus = TI_OK;
     os_memoryCopy (pCmdMbox->hOs, (void *)pCmd->parameters, (void *)pParamsBuf, uWriteLen);
 
     /* Add the CMDMBOX_HEADER_LEN to the write length */
-    pCmdMbox->uWriteLen = uWriteLen + CMDMBOX_HEADER_LEN;
+    uLen = uWriteLen + CMDMBOX_HEADER_LEN;
 
     /* Must make sure that the length is multiple of 32 bit */
-    if (pCmdMbox->uWriteLen & 0x3)
+    if (uLen & 0x3)
     {
-        pCmdMbox->uWriteLen = (pCmdMbox->uWriteLen + 4) & 0xFFFFFFFC;
+        uLen = (uLen + 4) & 0xFFFFFFFC;
     }
 
+    return uLen;
+}
+
+
+/*
+ * \brief	Write the current command to the mailbox and trigger the FW
+ * 
+ * \param  pCmdMbox  - Pointer to CmdMbox
+ * \return void
+ * 
+ * \par Description
+ * Sends the already built pWriteCmdTxn buffer of uWriteLen bytes.
+ * 
+ * \sa cmdMbox_SendCommand, cmdMbox_SendStagedCommand
+ */
+static void cmdMbox_Transmit (TCmdMbox *pCmdMbox)
+{
+    TTxnStruct *pCmdTxn = (TTxnStruct*)&pCmdMbox->pWriteCmdTxn->tTxnStruct;
+    TTxnStruct *pRegTxn = (TTxnStruct*)&pCmdMbox->aRegTxn[0].tTxnStruct;
+    Command_t  *pCmd = (Command_t*)&pCmdMbox->pWriteCmdTxn->tCmdMbox;
+
     /* no other command can start the send process  till bCmdInProgress will return to TI_FALSE*/
     pCmdMbox->bCmdInProgress = TI_TRUE;
 
@@ -238,13 +368,10 @@ TI_STATUS cmdMbox_SendCommand       (TI_HANDLE hCmdMbox, Command_e cmdType, TI_U
     BUILD_TTxnStruct(pRegTxn, ACX_REG_INTERRUPT_TRIG, &(pCmdMbox->aRegTxn[0].uRegister), REGISTER_SIZE, NULL, NULL)
 
     /* start the CmdMbox timer */
-    tmr_StartTimer (pCmdMbox->hCmdMboxTimer, cmdMbox_TimeOut, hCmdMbox, CMDMBOX_WAIT_TIMEOUT, TI_FALSE);
+    tmr_StartTimer (pCmdMbox->hCmdMboxTimer, cmdMbox_TimeOut, (TI_HANDLE)pCmdMbox, CMDMBOX_WAIT_TIMEOUT, TI_FALSE);
 
     /* Send the FW trigger */
     twIf_Transact(pCmdMbox->hTwIf, pRegTxn);
-
-
-    return TXN_STATUS_PENDING;
 }
 
 
@@ -327,7 +454,7 @@ TI_STATUS cmdMbox_TransferComplete(TI_HANDLE hCmdMbox)
 static void cmdMbox_TimeOut (TI_HANDLE hCmdMbox, TI_BOOL bTwdInitOccured)
 {
     TCmdMbox   *pCmdMbox = (TCmdMbox *)hCmdMbox;
-    Command_t  *pCmd = (Command_t*)&pCmdMbox->aCmdTxn[0].tCmdMbox;
+    Command_t  *pCmd = (Command_t*)&pCmdMbox->pWriteCmdTxn->tCmdMbox;
 
 
     /* Call error CB */
@@ -416,6 +543,7 @@ TI_STATUS cmdMbox_Restart (TI_HANDLE hCmdMbox)
     pCmdMbox->bCmdInProgress = TI_FALSE;
     pCmdMbox->uReadLen       = 0;
     pCmdMbox->uWriteLen      = 0;
+    pCmdMbox->bCmdStaged     = TI_FALSE;
 
     return TI_OK;
 }
@@ -494,6 +622,16 @@ void cmdMbox_GetCmdParams (TI_HANDLE hCmdMbox, TI_UINT8* pParamBuf)
 
 void cmdMbox_PrintInfo(TI_HANDLE hCmdMbox)
 {
+    TCmdMbox *pCmdMbox = (TCmdMbox *)hCmdMbox;
+
+    WLAN_OS_REPORT(("Print cmdMbox module info\n"));
+    WLAN_OS_REPORT(("=========================\n"));
+    WLAN_OS_REPORT(("bCmdInProgress = %d\n", pCmdMbox->bCmdInProgress));
+    WLAN_OS_REPORT(("uFwAddr        = 0x%x\n", pCmdMbox->uFwAddr));
+    WLAN_OS_REPORT(("uWriteLen      = %d\n", pCmdMbox->uWriteLen));
+    WLAN_OS_REPORT(("uReadLen       = %d\n", pCmdMbox->uReadLen));
+    WLAN_OS_REPORT(("bCmdStaged     = %d\n", pCmdMbox->bCmdStaged));
+    WLAN_OS_REPORT(("Staged sends   = %d\n", pCmdMbox->uStagedSendCounter));
 }
 
 #endif  /* TI_DBG */
@@ -95,6 +95,11 @@ typedef struct
 
     TCmdTxn             aCmdTxn[2];
     TRegTxn             aRegTxn[2];
+    /* Spare write buffer, used to stage the next command while the current one is executed */
+    TCmdTxn             tSpareCmdTxn;
+    /* The write buffer of the current command and the one holding the staged command */
+    TCmdTxn            *pWriteCmdTxn;
+    TCmdTxn            *pStagedCmdTxn;
 
     /* Holds the module state */
     TI_BOOL             bCmdInProgress;
@@ -102,6 +107,14 @@ typedef struct
     TI_UINT32           uWriteLen;
     TI_UINT32           uReadLen;
 
+    /* Staged command state */
+    TI_BOOL             bCmdStaged;
+    TI_UINT32           uStagedWriteLen;
+    TI_UINT32           uStagedReadLen;
+#ifdef TI_DBG
+    TI_UINT32           uStagedSendCounter;
+#endif
+
 } TCmdMbox;
 
 #endif
@@ -147,6 +147,40 @@ TI_STATUS cmdMbox_ConfigHw          (TI_HANDLE hCmdMbox, fnotify_t fCb, TI_HANDL
 TI_STATUS cmdMbox_SendCommand       (TI_HANDLE hCmdMbox, Command_e cmdType, TI_UINT8* pParamsBuf, TI_UINT32 uWriteLen, TI_UINT32 uReadLen);
 
 
+/*
+ * \brief	Stage the next Command in host memory
+ * 
+ * \param  hCmdMbox  - Handle to CmdMbox
+ * \param  cmdType  - 
+ * \param  pParamsBuf  - The buffer that will be written to the mailbox
+ * \param  uWriteLen  - Length of data to write to the mailbox
+ * \param  uReadLen  - Length of data to read from the mailbox (when the result is received)
+ * \return TI_OK
+ * 
+ * \par Description
+ * Build the mailbox image of the next command in the spare write buffer,
+ * while the current command is still executed by the FW.
+ * The staged command is later sent by cmdMbox_SendStagedCommand without copying it again.
+ *
+ * \sa cmdMbox_SendStagedCommand
+ */
+TI_STATUS cmdMbox_StageCommand      (TI_HANDLE hCmdMbox, Command_e cmdType, TI_UINT8* pParamsBuf, TI_UINT32 uWriteLen, TI_UINT32 uReadLen);
+
+
+/*
+ * \brief	Send the staged Command to the Mailbox
+ * 
+ * \param  hCmdMbox  - Handle to CmdMbox
+ * \return TI_PENDING, or TI_NOK if no command is staged or a command is in progress
+ * 
+ * \par Description
+ * Swap the staged buffer with the current write buffer and send it to the FW's mailbox.
+ *
+ * \sa cmdMbox_StageCommand, cmdMbox_SendCommand
+ */
+TI_STATUS cmdMbox_SendStagedCommand (TI_HANDLE hCmdMbox);
+
+
 /*
  * \brief	Read the command's result
  * 
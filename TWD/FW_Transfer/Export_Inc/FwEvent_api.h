@@ -42,6 +42,8 @@
 #ifndef _FW_EVENT_API_H
 #define _FW_EVENT_API_H
 
+#include "TWDriver.h"
+
 /* Public Function Definitions */
 
 /*
@@ -106,6 +108,21 @@ void            fwEvent_InterruptRequest    (TI_HANDLE hFwEvent);
 TI_STATUS       fwEvent_Init                (TI_HANDLE hFwEvent, TI_HANDLE hTWD);
 
 
+/*
+ * \brief	Set the FwEvent adaptive polling configuration
+ * 
+ * \param  hFwEvent    - FwEvent Driver handle
+ * \param  pInitParams - The TWD init parameters (registry)
+ * \return void
+ * 
+ * \par Description
+ * Save the thresholds for switching between FW interrupts and FW-Status polling.
+ * 
+ * \sa
+ */
+void            fwEvent_SetDefaults         (TI_HANDLE hFwEvent, TTwdInitParams *pInitParams);
+
+
 /*
  * \brief	Called by any handler that completed after pending
  * 
@@ -47,6 +47,7 @@
 #include "report.h"
 #include "context.h"
 #include "osApi.h"
+#include "timer.h"
 #include "TWDriver.h"
 #include "TWDriverInternal.h"
 #include "txResult_api.h"
@@ -84,7 +85,10 @@ extern int trigger_another_read;
                                  ACX_INTR_EVENT_B | ACX_INTR_CMD_COMPLETE |ACX_INTR_HW_AVAILABLE |\
                                  ACX_INTR_DATA
 
+#define ALL_EVENTS_MASKED        0xFFFFFFFF
+
 #define TXN_FW_EVENT_SET_MASK_ADDR(pFwEvent)      pFwEvent->tMaskTxn.tTxnStruct.uHwAddr = HINT_MASK;
+#define TXN_FW_EVENT_SET_POLL_MASK_ADDR(pFwEvent) pFwEvent->tPollMaskTxn.tTxnStruct.uHwAddr = HINT_MASK;
 #define TXN_FW_EVENT_SET_FW_STAT_ADDR(pFwEvent)   pFwEvent->tFwStatusTxn.tTxnStruct.uHwAddr = FW_STATUS_ADDR;
 
 #define UPDATE_PENDING_HANDLERS_NUMBER(eStatus)   if (eStatus == TXN_STATUS_PENDING) {pFwEvent->uNumPendHndlrs++;}
@@ -125,6 +129,26 @@ typedef struct
     TI_BOOL             bIntrPending;   /* If TRUE a new interrupt is pending while handling the previous one */
     TI_UINT32           uNumPendHndlrs; /* Number of event handlers that didn't complete their event processing */
 
+    /* Adaptive polling - poll the FW-Status on a timer while the interrupts rate is high */
+    TRegisterTxn        tPollMaskTxn;   /* The host mask register transaction used for polling mode switch */
+    TI_HANDLE           hPollTimer;     /* Polling timer (periodic while in polling mode) */
+    TI_BOOL             bPolling;       /* If TRUE, FW interrupts are masked and the FW-Status is polled */
+    TI_UINT32           uPollHighThreshold; /* Interrupts per window for switching to polling (0 = disabled) */
+    TI_UINT32           uPollLowThreshold;  /* FW-Status reads with events per window for staying in polling */
+    TI_UINT32           uPollInterval;  /* Idle polling interval in msec (while events arrive the FW-Status is re-read at once) */
+    TI_UINT32           uPollWindow;    /* Rate evaluation window in msec */
+    TI_UINT32           uWindowStartMs; /* Current evaluation window start time */
+    TI_UINT32           uWindowEvents;  /* Interrupts (or polls with events) in current window */
+
+    /* Statistics */
+    TI_UINT32           uIntrCount;     /* FW interrupts received */
+    TI_UINT32           uPollCount;     /* FW-Status polls issued by the polling timer */
+    TI_UINT32           uPollHitCount;  /* FW-Status reads in polling mode that found active events */
+    TI_UINT32           uPollRereads;   /* FW-Status re-reads scheduled at once since the last read found events */
+    TI_UINT32           uFwStatusReads; /* FW-Status reads (by interrupts and polls) */
+    TI_UINT32           uEnterPollCount;/* Switches from interrupts to polling */
+    TI_UINT32           uExitPollCount; /* Switches from polling back to interrupts */
+
     /* Other modules handles */
     TI_HANDLE           hOs;                    	
     TI_HANDLE           hTWD;
@@ -138,6 +162,7 @@ typedef struct
     TI_HANDLE           hTxXfer;
     TI_HANDLE           hTxHwQueue;
     TI_HANDLE           hTxResult;
+    TI_HANDLE           hTimer;
 
 } TfwEvent; 
 
@@ -147,6 +172,9 @@ static void       fwEvent_StateMachine   (TfwEvent *pFwEvent);
 static ETxnStatus fwEvent_SmReadIntrInfo (TfwEvent *pFwEvent);
 static ETxnStatus fwEvent_SmHandleEvents (TfwEvent *pFwEvent);
 static ETxnStatus fwEvent_CallHandlers   (TfwEvent *pFwEvent);
+static void       fwEvent_EnterPolling   (TfwEvent *pFwEvent);
+static void       fwEvent_ExitPolling    (TfwEvent *pFwEvent);
+static void       fwEvent_PollTimeout    (TI_HANDLE hFwEvent, TI_BOOL bTwdInitOccured);
 
 
 /*
@@ -195,6 +223,10 @@ TI_STATUS fwEvent_Destroy (TI_HANDLE hFwEvent)
 
     if (pFwEvent)
     {
+        if (pFwEvent->hPollTimer)
+        {
+            tmr_DestroyTimer (pFwEvent->hPollTimer);
+        }
         os_memoryFree (pFwEvent->hOs, pFwEvent, sizeof(TfwEvent));
     }
 
@@ -235,12 +267,21 @@ TI_STATUS fwEvent_Init (TI_HANDLE hFwEvent, TI_HANDLE hTWD)
     pFwEvent->hTxHwQueue        = pTWD->hTxHwQueue;
     pFwEvent->hTxXfer           = pTWD->hTxXfer;
     pFwEvent->hTxResult         = pTWD->hTxResult;
+    pFwEvent->hTimer            = pTWD->hTimer;
 
     pFwEvent->eSmState          = FWEVENT_STATE_IDLE;
     pFwEvent->bIntrPending      = TI_FALSE;
     pFwEvent->uNumPendHndlrs    = 0;
     pFwEvent->uEventMask        = 0;
     pFwEvent->uEventVector      = 0;
+    pFwEvent->bPolling          = TI_FALSE;
+
+    /* Create the polling timer (used only when the interrupts rate is high) */
+    pFwEvent->hPollTimer = tmr_CreateTimer (pFwEvent->hTimer);
+    if (pFwEvent->hPollTimer == NULL)
+    {
+        return TI_NOK;
+    }
 
     /* Prepare Interrupts Mask regiter Txn structure */
     /* 
@@ -252,6 +293,11 @@ TI_STATUS fwEvent_Init (TI_HANDLE hFwEvent, TI_HANDLE hTWD)
     TXN_PARAM_SET(pTxn, TXN_LOW_PRIORITY, TXN_FUNC_ID_WLAN, TXN_DIRECTION_WRITE, TXN_INC_ADDR)
     BUILD_TTxnStruct(pTxn, HINT_MASK, &pFwEvent->tMaskTxn.uData, REGISTER_SIZE, NULL, NULL)
 
+    /* Prepare the polling mode Interrupts Mask Txn (separate so it never collides with the init mask) */
+    pTxn = (TTxnStruct*)&pFwEvent->tPollMaskTxn.tTxnStruct;
+    TXN_PARAM_SET(pTxn, TXN_LOW_PRIORITY, TXN_FUNC_ID_WLAN, TXN_DIRECTION_WRITE, TXN_INC_ADDR)
+    BUILD_TTxnStruct(pTxn, HINT_MASK, &pFwEvent->tPollMaskTxn.uData, REGISTER_SIZE, NULL, NULL)
+
     /* Prepare FW status Txn structure (includes 4 bytes interrupt status reg and 64 bytes FW-status from memory area) */
     /* Note: This is the only transaction that is sent in high priority.
      *       The original reason was to lower the interrupt latency, but we may consider using the 
@@ -270,6 +316,8 @@ TI_STATUS fwEvent_Init (TI_HANDLE hFwEvent, TI_HANDLE hTWD)
                                                    fwEvent_NewEvent,
                                                    hFwEvent,
                                                    TI_FALSE,
+                                                   CONTEXT_PRIORITY_HIGH,
+                                                   CONTEXT_BUDGET_UNLIMITED,
                                                    "FW_EVENT",
                                                    sizeof("FW_EVENT"));
 	
@@ -277,6 +325,41 @@ TI_STATUS fwEvent_Init (TI_HANDLE hFwEvent, TI_HANDLE hTWD)
 }
 
 
+/*
+ * \brief	Set the FwEvent adaptive polling configuration
+ * 
+ * \param  hFwEvent    - FwEvent Driver handle
+ * \param  pInitParams - The TWD init parameters (registry)
+ * \return void
+ * 
+ * \par Description
+ * Save the thresholds for switching between FW interrupts and FW-Status polling.
+ * In PRIODIC_INTERRUPT debug mode the interrupts are already polled by the OS, so disable it.
+ * 
+ * \sa
+ */
+void fwEvent_SetDefaults (TI_HANDLE hFwEvent, TTwdInitParams *pInitParams)
+{
+    TfwEvent *pFwEvent = (TfwEvent *)hFwEvent;
+
+#ifdef PRIODIC_INTERRUPT
+    pFwEvent->uPollHighThreshold = 0;
+#else
+    pFwEvent->uPollHighThreshold = pInitParams->tGeneral.uFwEventPollHighThreshold;
+#endif
+    pFwEvent->uPollLowThreshold  = pInitParams->tGeneral.uFwEventPollLowThreshold;
+    pFwEvent->uPollInterval      = pInitParams->tGeneral.uFwEventPollInterval;
+
+    /* The timers expire on the timer module tick, so don't poll faster than the tick 
+         (it's only the idle polling, as the FW-Status is re-read at once while events arrive) */
+    if (pFwEvent->uPollInterval < tmr_GetTickMsec (pFwEvent->hTimer)) 
+    {
+        pFwEvent->uPollInterval = tmr_GetTickMsec (pFwEvent->hTimer);
+    }
+    pFwEvent->uPollWindow        = pInitParams->tGeneral.uFwEventPollWindow;
+}
+
+
 /*
  * \brief	FW interrupt handler, just switch to WLAN context for handling
  * 
@@ -293,6 +376,7 @@ void fwEvent_InterruptRequest (TI_HANDLE hFwEvent)
 {
     TfwEvent *pFwEvent = (TfwEvent *)hFwEvent;
 
+    pFwEvent->uIntrCount++;
 
     /* Request switch to driver context for handling the FW-Interrupt event */
     context_RequestSchedule (pFwEvent->hContext, pFwEvent->uContextId);
@@ -309,6 +393,8 @@ void fwEvent_InterruptRequest (TI_HANDLE hFwEvent)
  * \par Description
  * Called by the context module after scheduled by fwEvent_InterruptRequest().
  * If IDLE, start the SM, and if not just indicate pending event for later.
+ * Count the interrupts in the current window, and if above the high threshold
+ *     switch to polling mode before handling the events (the chip is awake now).
  * 
  * \sa
  */
@@ -316,6 +402,27 @@ static void fwEvent_NewEvent (TI_HANDLE hFwEvent)
 {
     TfwEvent *pFwEvent = (TfwEvent *)hFwEvent;
 
+    /* Evaluate the interrupts rate (if adaptive polling is enabled) */
+    if (pFwEvent->uPollHighThreshold && !pFwEvent->bPolling) 
+    {
+        TI_UINT32 uNowMs = os_timeStampMonoMs (pFwEvent->hOs);
+        TI_UINT32 uElapsedMs = uNowMs - pFwEvent->uWindowStartMs;
+
+        pFwEvent->uWindowEvents++;
+        if (uElapsedMs >= pFwEvent->uPollWindow) 
+        {
+            /* Switch to polling only if the window wasn't stretched by an idle period */
+            if ((pFwEvent->uWindowEvents >= pFwEvent->uPollHighThreshold) && 
+                (uElapsedMs < 2 * pFwEvent->uPollWindow) &&
+                (pFwEvent->eSmState == FWEVENT_STATE_IDLE)) 
+            {
+                fwEvent_EnterPolling (pFwEvent);
+            }
+            pFwEvent->uWindowStartMs = uNowMs;
+            pFwEvent->uWindowEvents  = 0;
+        }
+    }
+
     /* If the SM is idle, call it to start handling new events */
     if (pFwEvent->eSmState == FWEVENT_STATE_IDLE) 
     {
@@ -392,6 +499,17 @@ static void fwEvent_StateMachine (TfwEvent *pFwEvent)
                     twIf_Sleep(pFwEvent->hTwIf);
                     pFwEvent->eSmState = FWEVENT_STATE_IDLE;
 
+                    /* 
+                     * If polling and events were found, more are probably arriving, so read the 
+                     *   FW-Status again at once without waiting for the polling timer.
+                     * It's done through the context engine so the other clients are served meanwhile.
+                     */
+                    if (pFwEvent->bPolling && pFwEvent->uEventVector) 
+                    {
+                        pFwEvent->uPollRereads++;
+                        context_RequestSchedule (pFwEvent->hContext, pFwEvent->uContextId);
+                    }
+
 
                     /**** Finished all current events handling so exit ****/
                     return;
@@ -443,9 +561,11 @@ static ETxnStatus fwEvent_SmReadIntrInfo (TfwEvent *pFwEvent)
     os_InterruptServiced (pFwEvent->hOs);
 #endif
 
-    /* Indicate that the chip is awake (since it interrupted us) */
+    /* Indicate that the chip is awake (since it interrupted us, or kept awake while polling) */
     twIf_HwAvailable(pFwEvent->hTwIf);
 
+    pFwEvent->uFwStatusReads++;
+
     /*
      * Read FW-Status structure from HW ==> Special mapping, see note!!
      *
@@ -495,6 +615,13 @@ static ETxnStatus fwEvent_SmHandleEvents (TfwEvent *pFwEvent)
     /* Mask unwanted interrupts */
     pFwEvent->uEventVector &= pFwEvent->uEventMask;
 
+    /* In polling mode count the reads that found events, for measuring the events rate */
+    if (pFwEvent->bPolling && pFwEvent->uEventVector) 
+    {
+        pFwEvent->uPollHitCount++;
+        pFwEvent->uWindowEvents++;
+    }
+
     /* Call the interrupts handlers */
     eStatus = fwEvent_CallHandlers (pFwEvent);
 
@@ -601,6 +728,129 @@ void fwEvent_HandlerCompleted (TI_HANDLE hFwEvent)
 }
 
 
+/*
+ * \brief	Switch from FW interrupts to FW-Status polling
+ * 
+ * \param  pFwEvent  - FwEvent Driver handle
+ * \return void
+ * 
+ * \par Description
+ * Called upon interrupt while the SM is idle, so the chip is awake.
+ * Keep the chip awake while polling (no ELP wakeup interrupt), mask all FW interrupts
+ *     and start the periodic polling timer. The FW interrupt status is still latched
+ *     while masked, so each poll reads it with the FW-Status as on interrupt.
+ * 
+ * \sa     fwEvent_ExitPolling
+ */
+static void fwEvent_EnterPolling (TfwEvent *pFwEvent)
+{
+    twIf_Awake (pFwEvent->hTwIf);
+
+    pFwEvent->tPollMaskTxn.uData = ALL_EVENTS_MASKED;
+    TXN_FW_EVENT_SET_POLL_MASK_ADDR(pFwEvent)
+    twIf_Transact (pFwEvent->hTwIf, &(pFwEvent->tPollMaskTxn.tTxnStruct));
+
+    pFwEvent->bPolling = TI_TRUE;
+    pFwEvent->uEnterPollCount++;
+
+    tmr_StartTimer (pFwEvent->hPollTimer, fwEvent_PollTimeout, (TI_HANDLE)pFwEvent, pFwEvent->uPollInterval, TI_TRUE);
+}
+
+
+/*
+ * \brief	Switch from FW-Status polling back to FW interrupts
+ * 
+ * \param  pFwEvent  - FwEvent Driver handle
+ * \return void
+ * 
+ * \par Description
+ * Restore the interrupts mask and stop the polling timer.
+ * If the SM is idle, run it once more to handle any event latched before the unmask,
+ *     then release the awake request taken when entering the polling mode.
+ * 
+ * \sa     fwEvent_EnterPolling
+ */
+static void fwEvent_ExitPolling (TfwEvent *pFwEvent)
+{
+    tmr_StopTimer (pFwEvent->hPollTimer);
+    pFwEvent->bPolling = TI_FALSE;
+    pFwEvent->uExitPollCount++;
+
+    pFwEvent->tPollMaskTxn.uData = ~pFwEvent->uEventMask;
+    TXN_FW_EVENT_SET_POLL_MASK_ADDR(pFwEvent)
+    twIf_Transact (pFwEvent->hTwIf, &(pFwEvent->tPollMaskTxn.tTxnStruct));
+
+    if (pFwEvent->eSmState == FWEVENT_STATE_IDLE) 
+    {
+        fwEvent_StateMachine (pFwEvent);
+    }
+    else 
+    {
+        pFwEvent->bIntrPending = TI_TRUE;
+    }
+
+    twIf_Sleep (pFwEvent->hTwIf);
+}
+
+
+/*
+ * \brief	Polling timer expiry - read the FW-Status as done on interrupt
+ * 
+ * \param  hFwEvent        - FwEvent Driver handle
+ * \param  bTwdInitOccured - Indicates if TWDriver recovery occured since timer started 
+ * \return void
+ * 
+ * \par Description
+ * Called periodically in the driver context while in polling mode. While events keep arriving
+ *     the FW-Status is re-read at once (see fwEvent_StateMachine), so the timer only polls 
+ *     when idle and measures the events rate.
+ * At the end of each window, switch back to interrupts if the rate of FW-Status reads that 
+ *     found events is below the low threshold. Else, read the FW-Status as upon interrupt.
+ * 
+ * \sa
+ */
+static void fwEvent_PollTimeout (TI_HANDLE hFwEvent, TI_BOOL bTwdInitOccured)
+{
+    TfwEvent  *pFwEvent = (TfwEvent *)hFwEvent;
+    TI_UINT32  uNowMs;
+    TI_UINT32  uElapsedMs;
+
+    if (!pFwEvent->bPolling) 
+    {
+        return;
+    }
+
+    pFwEvent->uPollCount++;
+
+    uNowMs = os_timeStampMonoMs (pFwEvent->hOs);
+    uElapsedMs = uNowMs - pFwEvent->uWindowStartMs;
+    if (uElapsedMs >= pFwEvent->uPollWindow) 
+    {
+        /* Exit if the events rate (scaled to the window, as it may be exceeded by up to a tick) is below the low threshold */
+        TI_BOOL bExit = (pFwEvent->uWindowEvents * pFwEvent->uPollWindow < pFwEvent->uPollLowThreshold * uElapsedMs);
+
+        pFwEvent->uWindowStartMs = uNowMs;
+        pFwEvent->uWindowEvents  = 0;
+
+        if (bExit) 
+        {
+            fwEvent_ExitPolling (pFwEvent);
+            return;
+        }
+    }
+
+    /* If the SM is idle, call it to read the FW-Status, and if not just indicate pending event */
+    if (pFwEvent->eSmState == FWEVENT_STATE_IDLE) 
+    {
+        fwEvent_StateMachine (pFwEvent);
+    }
+    else 
+    {
+        pFwEvent->bIntrPending = TI_TRUE;
+    }
+}
+
+
 /*
  * \brief	Translate host to FW time (Usec)
  * 
@@ -663,6 +913,14 @@ TI_STATUS fwEvent_Stop (TI_HANDLE hFwEvent)
     pFwEvent->uNumPendHndlrs = 0;
     pFwEvent->uEventMask     = 0;
     pFwEvent->uEventVector   = 0;    
+
+    /* Stop polling (no need to release the TwIf awake request, TwIf is restarted by the stop process) */
+    if (pFwEvent->bPolling) 
+    {
+        tmr_StopTimer (pFwEvent->hPollTimer);
+        pFwEvent->bPolling = TI_FALSE;
+    }
+    pFwEvent->uWindowEvents  = 0;
     
     return TI_OK;
 }
@@ -733,6 +991,27 @@ void fwEvent_EnableInterrupts(TI_HANDLE hFwEvent)
 
 void fwEvent_PrintStat (TI_HANDLE hFwEvent)
 {
+    TfwEvent *pFwEvent = (TfwEvent *)hFwEvent;
+
+    WLAN_OS_REPORT(("Print FW event module info\n"));
+    WLAN_OS_REPORT(("==========================\n"));
+    WLAN_OS_REPORT(("SM state           = %d\n", pFwEvent->eSmState));
+    WLAN_OS_REPORT(("Event mask         = 0x%x\n", pFwEvent->uEventMask));
+    WLAN_OS_REPORT(("Event vector       = 0x%x\n", pFwEvent->uEventVector));
+    WLAN_OS_REPORT(("Interrupt pending  = %d\n", pFwEvent->bIntrPending));
+    WLAN_OS_REPORT(("Pending handlers   = %d\n", pFwEvent->uNumPendHndlrs));
+    WLAN_OS_REPORT(("FW time offset     = %d\n", pFwEvent->uFwTimeOffset));
+    WLAN_OS_REPORT(("Mode               = %s\n", pFwEvent->bPolling ? "Polling" : "Interrupts"));
+    WLAN_OS_REPORT(("Poll thresholds    = high %d, low %d (per %d msec window)\n", 
+                    pFwEvent->uPollHighThreshold, pFwEvent->uPollLowThreshold, pFwEvent->uPollWindow));
+    WLAN_OS_REPORT(("Idle poll interval = %d msec\n", pFwEvent->uPollInterval));
+    WLAN_OS_REPORT(("Interrupts         = %d\n", pFwEvent->uIntrCount));
+    WLAN_OS_REPORT(("Polls              = %d\n", pFwEvent->uPollCount));
+    WLAN_OS_REPORT(("Reads with events  = %d\n", pFwEvent->uPollHitCount));
+    WLAN_OS_REPORT(("Immediate re-reads = %d\n", pFwEvent->uPollRereads));
+    WLAN_OS_REPORT(("FW-Status reads    = %d\n", pFwEvent->uFwStatusReads));
+    WLAN_OS_REPORT(("Switches to poll   = %d\n", pFwEvent->uEnterPollCount));
+    WLAN_OS_REPORT(("Switches to intr   = %d\n", pFwEvent->uExitPollCount));
 }
 
 #endif  /* TI_DBG */
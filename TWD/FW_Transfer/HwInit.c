@@ -92,12 +92,18 @@ extern void cmdBld_FinalizeDownload (TI_HANDLE hCmdBld, TBootAttr *pBootAttr, Fw
 /* Total range of bus addresses range */
 #define PARTITION_TOTAL_ADDR_RANGE    0x1FFC0
 
-/* Maximal block size in a single SDIO transfer --> Firmware image load chunk size */
+/* 
+ * Firmware image download burst size - a multiple of the 512 bytes SDIO block, so each burst
+ *   is a single multi-block transfer. Limited by the bus driver DMA (bounce) buffer and by
+ *   keeping the burst buffers in kmalloc memory, so they are used directly for DMA.
+ */
 #ifdef _VLCT_
-#define MAX_SDIO_BLOCK					(4000)
+#define HW_INIT_FW_BURST_SIZE			(4000)
 #else
-#define MAX_SDIO_BLOCK					(500)
+#define HW_INIT_FW_BURST_SIZE			(4096)
 #endif
+/* Number of download bursts kept in flight (double buffering) */
+#define HW_INIT_FW_BURSTS				2
 
 #define ACX_EEPROMLESS_IND_REG        (SCR_PAD4)
 #define USE_EEPROM                    (0)
@@ -260,6 +266,14 @@ typedef struct
 
 } TFwStaticTxn;
 
+/* FW download burst - Txn and its DMA-able buffer (with WSPI_PAD_LEN_WRITE leading bytes) */
+typedef struct
+{
+    TTxnStruct              tTxnStruct;
+    TI_UINT8               *pBuf;
+
+} TFwBurst;
+
 
 /* The HW Init module object */
 typedef struct
@@ -323,8 +337,6 @@ typedef struct
     TI_UINT32               uInitSeqStage;
     TI_STATUS               uInitSeqStatus;
     TI_UINT32               uLoadStage;
-    TI_UINT32               uBlockReadNum;
-    TI_UINT32               uBlockWriteNum;
     TI_UINT32               uPartitionLimit;
     TI_UINT32               uFinStage;
     TI_UINT32               uFinData;
@@ -343,7 +355,16 @@ typedef struct
     TI_STATUS               uTopStatus;
 
 
-    TI_UINT8                auFwTmpBuf [WSPI_PAD_LEN_WRITE + MAX_SDIO_BLOCK];
+    /* FW image download bursts */
+    TFwBurst                aFwBurst[HW_INIT_FW_BURSTS];
+    TI_UINT32               uFwBurstIndex;      /* The next burst buffer to use */
+    TI_UINT32               uFwBurstsPending;   /* Number of bursts in flight */
+    TI_UINT32               uFwPortionOffset;   /* The next byte to send from the current image portion */
+    /* FW image download statistics (all portions) */
+    TI_UINT32               uFwDlStartMs;
+    TI_UINT32               uFwDlTimeMs;
+    TI_UINT32               uFwDlBytes;
+    TI_UINT32               uFwDlBursts;
 
     TFinalizeCb             fFinalizeDownload;
     TI_HANDLE               hFinalizeDownload;
@@ -369,6 +390,7 @@ static TI_STATUS hwInit_BootSm                      (TI_HANDLE hHwInit);
 static TI_STATUS hwInit_ResetSm                     (TI_HANDLE hHwInit);
 static TI_STATUS hwInit_EepromlessStartBurstSm      (TI_HANDLE hHwInit);
 static TI_STATUS hwInit_LoadFwImageSm               (TI_HANDLE hHwInit);
+static void      hwInit_FwBurstDone                 (TI_HANDLE hHwInit, void *pTxn);
 static TI_STATUS hwInit_FinalizeDownloadSm          (TI_HANDLE hHwInit);
 static TI_STATUS hwInit_TopRegisterRead(TI_HANDLE hHwInit);
 static TI_STATUS hwInit_InitTopRegisterRead(TI_HANDLE hHwInit, TI_UINT32 uAddress);
@@ -395,6 +417,7 @@ static TI_STATUS hwInit_InitTopRegisterWrite(TI_HANDLE hHwInit, TI_UINT32 uAddre
 TI_HANDLE hwInit_Create (TI_HANDLE hOs)
 {
     THwInit *pHwInit;
+    TI_UINT32 i;
 
     /* Allocate HwInit module */
     pHwInit = os_memoryAlloc (hOs, sizeof(THwInit));
@@ -409,6 +432,17 @@ TI_HANDLE hwInit_Create (TI_HANDLE hOs)
 
     pHwInit->hOs = hOs;
 
+    /* Allocate the FW download burst buffers separately, so they are small enough to be DMA-able */
+    for (i = 0; i < HW_INIT_FW_BURSTS; i++)
+    {
+        pHwInit->aFwBurst[i].pBuf = os_memoryAlloc (hOs, WSPI_PAD_LEN_WRITE + HW_INIT_FW_BURST_SIZE);
+        if (pHwInit->aFwBurst[i].pBuf == NULL)
+        {
+            hwInit_Destroy ((TI_HANDLE)pHwInit);
+            return NULL;
+        }
+    }
+
     return (TI_HANDLE)pHwInit;
 }
 
@@ -428,6 +462,15 @@ TI_HANDLE hwInit_Create (TI_HANDLE hOs)
 TI_STATUS hwInit_Destroy (TI_HANDLE hHwInit)
 {
     THwInit *pHwInit = (THwInit *)hHwInit;
+    TI_UINT32 i;
+
+    for (i = 0; i < HW_INIT_FW_BURSTS; i++)
+    {
+        if (pHwInit->aFwBurst[i].pBuf)
+        {
+            os_memoryFree (pHwInit->hOs, pHwInit->aFwBurst[i].pBuf, WSPI_PAD_LEN_WRITE + HW_INIT_FW_BURST_SIZE);
+        }
+    }
 
     /* Free HwInit Module */
     os_memoryFree (pHwInit->hOs, pHwInit, sizeof(THwInit));
@@ -563,6 +606,12 @@ TI_STATUS hwInit_Boot (TI_HANDLE hHwInit)
      */
     pHwInit->DownloadStatus = TXN_STATUS_PENDING;
 
+    /* Reset the FW download statistics (the download starts after the boot sequence) */
+    pHwInit->uFwDlStartMs = 0;
+    pHwInit->uFwDlTimeMs  = 0;
+    pHwInit->uFwDlBytes   = 0;
+    pHwInit->uFwDlBursts  = 0;
+
     /* Call the boot sequence state machine */
     pHwInit->uInitStage = 99;
 
@@ -1391,6 +1440,12 @@ static TI_STATUS hwInit_EepromlessStartBurstSm (TI_HANDLE hHwInit)
  ****************************************************************************
  * DESCRIPTION: Load image from the host and download into the hardware
  *
+ *              The image portion is sent in HW_INIT_FW_BURST_SIZE bursts, each a single
+ *              multi-block bus transaction, keeping up to HW_INIT_FW_BURSTS of them in flight.
+ *              While one burst is transferred, the next one is copied to the other buffer.
+ *              A partition change is queued behind the bursts in flight, since the TxnQ
+ *              keeps the order and the address translation is done when a Txn is issued.
+ *
  * INPUTS:  None
  *
  * OUTPUT:  None
@@ -1408,6 +1463,9 @@ static TI_STATUS hwInit_LoadFwImageSm (TI_HANDLE hHwInit)
 	ETxnStatus	TxnStatus;
 	TI_UINT32 uMaxPartitionSize	= PARTITION_DOWN_MEM_SIZE;
     TTxnStruct* pTxn;
+    TFwBurst   *pBurst;
+    TI_UINT32   uLen;
+    TI_UINT32   uAddr;
 
     pHwInit->uTxnIndex = 0;
 
@@ -1424,6 +1482,11 @@ static TI_STATUS hwInit_LoadFwImageSm (TI_HANDLE hHwInit)
 				EXCEPT_L (pHwInit, TXN_STATUS_ERROR);
 			}
 
+            /* First portion of the image */
+            if (pHwInit->uFwDlBytes == 0)
+            {
+                pHwInit->uFwDlStartMs = os_timeStampMs (pHwInit->hOs);
+            }
 
 	/* Set bus memory partition to current download area */
            SET_FW_LOAD_PARTITION(pHwInit->aPartition,pHwInit->uFwAddress)
@@ -1434,103 +1497,88 @@ static TI_STATUS hwInit_LoadFwImageSm (TI_HANDLE hHwInit)
         case 1:
 
 			pHwInit->uLoadStage = 2;
-			/* if initial size is smaller than MAX_SDIO_BLOCK - go strait to stage 4 to write partial block */
-			if (pHwInit->uFwLength < MAX_SDIO_BLOCK)
-			{
-				pHwInit->uLoadStage = 4;
-			}
 
-			pHwInit->uBlockReadNum 		= 0;
-			pHwInit->uBlockWriteNum 	= 0;
+			pHwInit->uFwPortionOffset 	= 0;
+			pHwInit->uFwBurstsPending 	= 0;
 			pHwInit->uPartitionLimit 	= pHwInit->uFwAddress + uMaxPartitionSize;
 
             continue;
 
         case 2:
 
-            /* Load firmware by blocks */
- 			if (pHwInit->uBlockReadNum < (pHwInit->uFwLength / MAX_SDIO_BLOCK))
+            /* All portion bursts were sent */
+            if (pHwInit->uFwPortionOffset >= pHwInit->uFwLength)
             {
-                pHwInit->uLoadStage = 3;
-
-                /* Change partition */
-				/* The +2 is for the last block and the block remainder */
-				if ( ((pHwInit->uBlockWriteNum + 2) * MAX_SDIO_BLOCK + pHwInit->uFwAddress) > pHwInit->uPartitionLimit)
+                /* Wait for the last bursts to complete (continued from hwInit_FwBurstDone) */
+                if (pHwInit->uFwBurstsPending > 0)
                 {
-					pHwInit->uFwAddress += pHwInit->uBlockWriteNum * MAX_SDIO_BLOCK;
-					/* update uPartitionLimit */
-					pHwInit->uPartitionLimit = pHwInit->uFwAddress + uMaxPartitionSize;
-                    /* Set bus memory partition to current download area */
-                    SET_FW_LOAD_PARTITION(pHwInit->aPartition,pHwInit->uFwAddress)
-                    hwInit_SetPartition (pHwInit,pHwInit->aPartition);
-                    TxnStatus = TXN_STATUS_OK;
-					pHwInit->uBlockWriteNum = 0;
+                    return TXN_STATUS_PENDING;
                 }
+
+                pHwInit->uLoadStage = 3;
+                continue;
             }
-            else
+
+            /* All burst buffers are in flight, continue when the oldest completes */
+            if (pHwInit->uFwBurstsPending == HW_INIT_FW_BURSTS)
             {
-                pHwInit->uLoadStage = 4;
+                return TXN_STATUS_PENDING;
             }
-            continue;
 
-        case 3:
-            pHwInit->uLoadStage = 2;
+            uLen  = pHwInit->uFwLength - pHwInit->uFwPortionOffset;
+            if (uLen > HW_INIT_FW_BURST_SIZE)
+            {
+                uLen = HW_INIT_FW_BURST_SIZE;
+            }
+            uAddr = pHwInit->uFwAddress + pHwInit->uFwPortionOffset;
 
-            pHwInit->uTxnIndex = 0;
+            /* Change partition if the burst exceeds the current one */
+            if (uAddr + uLen > pHwInit->uPartitionLimit)
+            {
+                pHwInit->uPartitionLimit = uAddr + uMaxPartitionSize;
+                /* Set bus memory partition to current download area */
+                SET_FW_LOAD_PARTITION(pHwInit->aPartition,uAddr)
+                hwInit_SetPartition (pHwInit,pHwInit->aPartition);
+            }
 
-            /* Copy image block to temporary buffer */
+            /* Copy the image burst to a free DMA-able buffer. Save WSPI_PAD_LEN_WRITE space for WSPI bus command */
+            pBurst = &pHwInit->aFwBurst[pHwInit->uFwBurstIndex];
             os_memoryCopy (pHwInit->hOs,
-                           (void *)&pHwInit->auFwTmpBuf[WSPI_PAD_LEN_WRITE],
-						   (void *)(pHwInit->pFwBuf + pHwInit->uBlockReadNum * MAX_SDIO_BLOCK),
-						   MAX_SDIO_BLOCK);
-
-            /* Load the block. Save WSPI_PAD_LEN_WRITE space for WSPI bus command */
-             BUILD_HW_INIT_FW_DL_TXN(pHwInit, pTxn, (pHwInit->uFwAddress + pHwInit->uBlockWriteNum * MAX_SDIO_BLOCK),
-                                     (pHwInit->auFwTmpBuf + WSPI_PAD_LEN_WRITE), MAX_SDIO_BLOCK, TXN_DIRECTION_WRITE,
-                                     (TTxnDoneCb)hwInit_LoadFwImageSm, hHwInit)
-            TxnStatus = twIf_Transact(pHwInit->hTwIf, pTxn);
-
-            /* Log ERROR if the transaction returned ERROR */
-
-			pHwInit->uBlockWriteNum ++;
-			pHwInit->uBlockReadNum ++;
-            EXCEPT_L (pHwInit, TxnStatus);
-            continue;
-
-        case 4:
-			pHwInit->uLoadStage 	= 5;
-
-            pHwInit->uTxnIndex = 0;
-
-			/* If No Last block to write */
-			if ( pHwInit->uFwLength % MAX_SDIO_BLOCK == 0 )
-			{
-				continue;
-			}
+                           (void *)(pBurst->pBuf + WSPI_PAD_LEN_WRITE),
+                           (void *)(pHwInit->pFwBuf + pHwInit->uFwPortionOffset),
+                           uLen);
 
+            pTxn = &pBurst->tTxnStruct;
+            TXN_PARAM_SET(pTxn, TXN_LOW_PRIORITY, TXN_FUNC_ID_WLAN, TXN_DIRECTION_WRITE, TXN_INC_ADDR)
+            TXN_PARAM_SET_DMA_ABLE(pTxn, TXN_DMA_ABLE);
+            BUILD_TTxnStruct(pTxn, uAddr, (pBurst->pBuf + WSPI_PAD_LEN_WRITE), uLen, hwInit_FwBurstDone, hHwInit)
 
-            /* Copy the last image block */
-             os_memoryCopy (pHwInit->hOs,
-                           (void *)&pHwInit->auFwTmpBuf[WSPI_PAD_LEN_WRITE],
-						   (void *)(pHwInit->pFwBuf + pHwInit->uBlockReadNum * MAX_SDIO_BLOCK),
-						   pHwInit->uFwLength % MAX_SDIO_BLOCK);
+            pHwInit->uFwPortionOffset += uLen;
+            pHwInit->uFwBurstIndex = (pHwInit->uFwBurstIndex + 1) % HW_INIT_FW_BURSTS;
+            pHwInit->uFwDlBytes += uLen;
+            pHwInit->uFwDlBursts++;
 
-            /* Load the last block */
-             BUILD_HW_INIT_FW_DL_TXN(pHwInit, pTxn, (pHwInit->uFwAddress + pHwInit->uBlockWriteNum * MAX_SDIO_BLOCK),
-                                     (pHwInit->auFwTmpBuf + WSPI_PAD_LEN_WRITE), (pHwInit->uFwLength % MAX_SDIO_BLOCK), TXN_DIRECTION_WRITE,
-                                     (TTxnDoneCb)hwInit_LoadFwImageSm, hHwInit)
             TxnStatus = twIf_Transact(pHwInit->hTwIf, pTxn);
 
+            /* Pending burst - go on preparing the next one in the other buffer */
+            if (TxnStatus == TXN_STATUS_PENDING)
+            {
+                pHwInit->uFwBurstsPending++;
+                continue;
+            }
 
+            /* Log ERROR if the transaction returned ERROR */
             EXCEPT_L (pHwInit, TxnStatus);
             continue;
 
-        case 5:
+        case 3:
             pHwInit->uLoadStage = 0;
 
 			/*If end of overall FW Download Process: Finalize download (run firmware)*/
 			if ( pHwInit->bFwBufLast == TI_TRUE )
 			{
+                pHwInit->uFwDlTimeMs = os_timeStampMs (pHwInit->hOs) - pHwInit->uFwDlStartMs;
+
 				/* The download has completed */
 				status = hwInit_FinalizeDownloadSm (hHwInit);
 			}
@@ -1553,6 +1601,55 @@ static TI_STATUS hwInit_LoadFwImageSm (TI_HANDLE hHwInit)
 
 } /* hwInit_LoadFwImageSm() */
 
+
+/****************************************************************************
+ *                      hwInit_FwBurstDone()
+ ****************************************************************************
+ * DESCRIPTION: Completion of an Async FW download burst
+ *
+ *              Frees the burst buffer and continues the download state machine.
+ *
+ * INPUTS:  hHwInit - The module's object
+ *          pTxn    - The completed burst Txn
+ *
+ * OUTPUT:  None
+ *
+ * RETURNS: None
+ ****************************************************************************/
+static void hwInit_FwBurstDone (TI_HANDLE hHwInit, void *pTxn)
+{
+    THwInit *pHwInit = (THwInit *)hHwInit;
+
+    pHwInit->uFwBurstsPending--;
+
+    hwInit_LoadFwImageSm (hHwInit);
+}
+
+
+/****************************************************************************
+ *                      hwInit_GetFwDownloadStat()
+ ****************************************************************************
+ * DESCRIPTION: Get the last FW image download statistics
+ *
+ * INPUTS:  hHwInit - The module's object
+ *
+ * OUTPUT:  pTimeMs - The download time (all image portions), in msec
+ *          pBytes  - The number of bytes downloaded
+ *          pBursts - The number of bus transactions used
+ *
+ * RETURNS: TI_OK
+ ****************************************************************************/
+TI_STATUS hwInit_GetFwDownloadStat (TI_HANDLE hHwInit, TI_UINT32 *pTimeMs, TI_UINT32 *pBytes, TI_UINT32 *pBursts)
+{
+    THwInit *pHwInit = (THwInit *)hHwInit;
+
+    *pTimeMs = pHwInit->uFwDlTimeMs;
+    *pBytes  = pHwInit->uFwDlBytes;
+    *pBursts = pHwInit->uFwDlBursts;
+
+    return TI_OK;
+}
+
 #define READ_TOP_REG_LOOP  32
 
 /****************************************************************************
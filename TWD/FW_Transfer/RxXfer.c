@@ -489,6 +489,8 @@ static TI_STATUS rxXfer_Handle(TI_HANDLE hRxXfer)
                     {
                         pTxn = (TTxnStruct*)&(pRxXfer->aTxnStruct[pRxXfer->uCurrTxnIndex]);
                         pTxn->uHwAddr = SLV_MEM_DATA;
+                        /* The OS Rx buffers may be read into directly by the bus driver DMA */
+                        TXN_PARAM_SET_DMA_ABLE(pTxn, TXN_DMA_ABLE);
     
                         /* Save first mem-block of first aggregated packet! */
                         uFirstMemBlkAddr = SLV_MEM_CP_VALUE(uRxDesc, pRxXfer->uPacketMemoryPoolStart);
@@ -592,6 +594,7 @@ static TI_STATUS rxXfer_Handle(TI_HANDLE hRxXfer)
             uFirstMemBlkAddr = SLV_MEM_CP_VALUE(uRxDesc, pRxXfer->uPacketMemoryPoolStart);
             pTxn = (TTxnStruct*)&pRxXfer->aTxnStruct[pRxXfer->uCurrTxnIndex];
             BUILD_TTxnStruct(pTxn, SLV_MEM_DATA, pRxXfer->aTempBuffer, uBuffSize, (TTxnDoneCb)rxXfer_PktDropTxnDoneCb, hRxXfer)
+            TXN_PARAM_SET_DMA_ABLE(pTxn, TXN_NON_DMA_ABLE);
             eTxnStatus = rxXfer_IssueTxn (pRxXfer, uFirstMemBlkAddr);
             if (eTxnStatus == TXN_STATUS_PENDING) 
             {
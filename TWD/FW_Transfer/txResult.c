@@ -42,7 +42,8 @@
  *   ============
  *      This module is called upon Tx-complete from FW. 
  *      It retrieves the transmitted packets results from the FW TxResult table and
- *        calls the upper layer callback function for each packet with its results.
+ *        calls the upper layer callback function for each packet with its results,
+ *        or the upper layer batch callback once with all the new results.
  *
  ****************************************************************************/
 
@@ -68,6 +69,12 @@
 /* Callback function definition for Tx sendPacketComplete */
 typedef void (* TSendPacketCompleteCb)(TI_HANDLE hCbObj, TxResultDescriptor_t *pTxResultInfo);
 
+/* Callback function definition for Tx sendPacketComplete of all new results (cyclic table range) */
+typedef void (* TSendPacketCompleteBatchCb)(TI_HANDLE hCbObj, 
+                                            TxResultDescriptor_t *pTxResultQueue, 
+                                            TI_UINT32 uFirstIndex, 
+                                            TI_UINT32 uNumResults);
+
 /* Tx-Result SM states */
 typedef enum
 {
@@ -102,10 +109,15 @@ typedef struct
     ETxResultState          eState;                  /* Current eState of SM */
     TSendPacketCompleteCb   fSendPacketCompleteCb;   /* Tx-Complete callback function */
     TI_HANDLE               hSendPacketCompleteHndl; /* Tx-Complete callback function handle */
+    TSendPacketCompleteBatchCb fSendPacketCompleteBatchCb;   /* Tx-Complete batch callback function (used if registered) */
+    TI_HANDLE               hSendPacketCompleteBatchHndl;    /* Tx-Complete batch callback function handle */
     THostCounterWriteTxn    tHostCounterWriteTxn;    /* The structure used for writing host results counter to FW */
     TResultsInfoReadTxn     tResultsInfoReadTxn;     /* The structure used for reading Tx-results counters and table from  FW */
 #ifdef TI_DBG
     TI_UINT32               uInterruptsCounter;         /* Count number of Tx-results */
+    TI_UINT32               uBatchesCounter;            /* Count number of handled Tx-results batches */
+    TI_UINT32               uResultsCounter;            /* Count number of handled Tx-results */
+    TI_UINT32               uMaxBatchSize;              /* The max number of Tx-results handled at once */
 #endif
 
 } TTxResultObj;
@@ -340,7 +352,8 @@ static void txResult_StateMachine (TI_HANDLE hTxResult)
  * ============
  *	We now have the Tx Result table info from the FW so do as follows:
  *	1.	Find the number of new results (FW counter minus host counter), and if 0 exit.
- *  2.	Call the upper layers callback per Tx result. 
+ *  2.	Call the upper layers batch callback once with all the new results if registered, 
+ *      or else the upper layers callback per Tx result. 
  *	3.	Update Host-Counter to be equal to the FW-Counter, and write it to the FW.
  ***************************************************************************/
 static void txResult_HandleNewResults (TTxResultObj *pTxResult)
@@ -375,8 +388,31 @@ static void txResult_HandleNewResults (TTxResultObj *pTxResult)
     twIf_Transact(pTxResult->hTwIf, pTxn);
 
 
-	/* Loop over all new Tx-results and call Tx-complete callback with current entry pointer. */
+#ifdef TI_DBG
+    pTxResult->uBatchesCounter++;
+    pTxResult->uResultsCounter += uNumNewResults;
+    if (uNumNewResults > pTxResult->uMaxBatchSize)
+    {
+        pTxResult->uMaxBatchSize = uNumNewResults;
+    }
+#endif
+
     /* NOTE: THIS SHOULD COME LAST because it may lead to driver-stop process!! */
+
+    /* If registered, call the batch Tx-complete callback once with the new results range. */
+    if (pTxResult->fSendPacketCompleteBatchCb != NULL)
+    {
+        uTableIndex = pTxResult->uHostResultsCounter & TX_RESULT_QUEUE_DEPTH_MASK;
+        pTxResult->uHostResultsCounter += uNumNewResults;
+
+        pTxResult->fSendPacketCompleteBatchCb (pTxResult->hSendPacketCompleteBatchHndl, 
+                                               pTxResult->tResultsInfoReadTxn.tTxResultInfo.TxResultQueue, 
+                                               uTableIndex, 
+                                               uNumNewResults);
+        return;
+    }
+
+	/* Loop over all new Tx-results and call Tx-complete callback with current entry pointer. */
 	for (i = 0; i < uNumNewResults; i++)
 	{
 		uTableIndex = pTxResult->uHostResultsCounter & TX_RESULT_QUEUE_DEPTH_MASK;
@@ -406,6 +442,12 @@ void txResult_RegisterCb (TI_HANDLE hTxResult, TI_UINT32 uCallBackId, void *CBFu
             pTxResult->hSendPacketCompleteHndl = hCbObj;
             break;
 
+        /* Set Tx-Complete batch callback */
+        case TWD_INT_SEND_PACKET_COMPLETE_BATCH:
+            pTxResult->fSendPacketCompleteBatchCb   = (TSendPacketCompleteBatchCb)CBFunc;
+            pTxResult->hSendPacketCompleteBatchHndl = hCbObj;
+            break;
+
         default:
             return;
     }
@@ -421,6 +463,19 @@ void txResult_RegisterCb (TI_HANDLE hTxResult, TI_UINT32 uCallBackId, void *CBFu
  ****************************************************************************/
 void txResult_PrintInfo (TI_HANDLE hTxResult)
 {
+    TTxResultObj* pTxResult = (TTxResultObj*)hTxResult;
+
+    WLAN_OS_REPORT(("Tx-Result Module Information:\n"));
+    WLAN_OS_REPORT(("=============================\n"));
+    WLAN_OS_REPORT(("uInterruptsCounter:     %d\n", pTxResult->uInterruptsCounter));
+    WLAN_OS_REPORT(("uHostResultsCounter:    %d\n", pTxResult->uHostResultsCounter));
+    WLAN_OS_REPORT(("uBatchesCounter:        %d\n", pTxResult->uBatchesCounter));
+    WLAN_OS_REPORT(("uResultsCounter:        %d\n", pTxResult->uResultsCounter));
+    WLAN_OS_REPORT(("Average batch size:     %d\n", 
+                    pTxResult->uBatchesCounter ? (pTxResult->uResultsCounter / pTxResult->uBatchesCounter) : 0));
+    WLAN_OS_REPORT(("uMaxBatchSize:          %d\n", pTxResult->uMaxBatchSize));
+    WLAN_OS_REPORT(("Batch callback:         %s\n", pTxResult->fSendPacketCompleteBatchCb ? "Yes" : "No"));
+    WLAN_OS_REPORT(("=============================\n"));
 }
 
 
@@ -434,6 +489,9 @@ void txResult_ClearInfo (TI_HANDLE hTxResult)
     TTxResultObj* pTxResult = (TTxResultObj*)hTxResult;
 
     pTxResult->uInterruptsCounter = 0;
+    pTxResult->uBatchesCounter = 0;
+    pTxResult->uResultsCounter = 0;
+    pTxResult->uMaxBatchSize = 0;
 }
 
 #endif  /* TI_DBG */
@@ -409,7 +409,7 @@ void TWD_Init (TI_HANDLE    hTWD,
 
     rxXfer_Init (pTWD->hRxXfer, pTWD->hFwEvent, pTWD->hReport, pTWD->hTwIf, pTWD->hRxQueue);
 
-    RxQueue_Init (pTWD->hRxQueue, pTWD->hReport);
+    RxQueue_Init (pTWD->hRxQueue, pTWD->hReport, pTWD->hTimer);
 
 #ifdef TI_DBG
     fwDbg_Init (pTWD->hFwDbg, pTWD->hReport, pTWD->hTwIf);
@@ -521,6 +521,18 @@ TI_STATUS TWD_InitFw (TI_HANDLE hTWD, TFileInfo *pFileInfo)
     return TI_OK;
 }
 
+TI_STATUS TWD_GetFwDownloadStat (TI_HANDLE hTWD, TI_UINT32 *pTimeMs, TI_UINT32 *pBytes, TI_UINT32 *pBursts)
+{
+    TTwd *pTWD = (TTwd *)hTWD;
+
+    if ((pTimeMs == NULL) || (pBytes == NULL) || (pBursts == NULL))
+    {
+        return TI_NOK;
+    }
+
+    return hwInit_GetFwDownloadStat (pTWD->hHwInit, pTimeMs, pBytes, pBursts);
+}
+
 /**
  * \brief  Propagate interrogate results
  * 
@@ -703,8 +715,10 @@ TI_STATUS TWD_SetDefaults (TI_HANDLE hTWD, TTwdInitParams *pInitParams)
 
     /* Configure the TWD modules */
     rxXfer_SetDefaults (pTWD->hRxXfer, pInitParams);
+    RxQueue_SetDefaults (pTWD->hRxQueue, pInitParams);
     txXfer_SetDefaults (pTWD->hTxXfer, pInitParams);
     txHwQueue_Config (pTWD->hTxHwQueue, pInitParams);
+    fwEvent_SetDefaults (pTWD->hFwEvent, pInitParams);
     MacServices_config (pTWD->hMacServices, pInitParams);   
 
     /* 
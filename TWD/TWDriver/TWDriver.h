@@ -286,6 +286,28 @@
 #define TWD_RX_INTR_TIMEOUT_MIN         1 
 #define TWD_RX_INTR_TIMEOUT_MAX         50000
 
+/*
+ * FwEvent adaptive polling: switch from FW interrupts to FW-Status polling when the interrupts
+ *   rate is high, and back to interrupts when the events rate drops (both in events per window).
+ *   While polling, the FW-Status is re-read at once as long as events are found, and polled on
+ *   a timer (rounded up to the timer module tick) when idle. Disabled by default (0 high threshold).
+ */
+#define TWD_FW_EVENT_POLL_HIGH_THRESHOLD_DEF    0   /* Interrupts per window for switching to polling */
+#define TWD_FW_EVENT_POLL_HIGH_THRESHOLD_MIN    0
+#define TWD_FW_EVENT_POLL_HIGH_THRESHOLD_MAX    10000
+
+#define TWD_FW_EVENT_POLL_LOW_THRESHOLD_DEF     100 /* FW-Status reads with events per window for staying in polling */
+#define TWD_FW_EVENT_POLL_LOW_THRESHOLD_MIN     1
+#define TWD_FW_EVENT_POLL_LOW_THRESHOLD_MAX     10000
+
+#define TWD_FW_EVENT_POLL_INTERVAL_DEF          10  /* Idle polling interval in milliseconds */
+#define TWD_FW_EVENT_POLL_INTERVAL_MIN          1
+#define TWD_FW_EVENT_POLL_INTERVAL_MAX          100
+
+#define TWD_FW_EVENT_POLL_WINDOW_DEF            100 /* Rate evaluation window in milliseconds */
+#define TWD_FW_EVENT_POLL_WINDOW_MIN            10
+#define TWD_FW_EVENT_POLL_WINDOW_MAX            10000
+
 /* Rx aggregation packets number limit (max packets in one aggregation) */
 #define TWD_RX_AGGREG_PKTS_LIMIT_DEF    4
 #define TWD_RX_AGGREG_PKTS_LIMIT_MIN    0 
@@ -363,6 +385,8 @@
 #define TX_CTRL_FLAG_PKT_IN_RAW_BUF        0x0010  /* The input packet is in a raw buffer (as opposed to OS packet) */
 #define TX_CTRL_FLAG_MULTICAST             0x0020  /* A multicast ethernet packet */
 #define TX_CTRL_FLAG_BROADCAST             0x0040  /* A broadcast ethernet packet */
+#define TX_CTRL_FLAG_CLASSIFIED            0x0080  /* The TID was already set by the OAL Tx queue selection */
+#define TX_CTRL_FLAG_OS_QUEUE              0x0100  /* uOsQueId holds the OS Tx subqueue (AC) the packet was sent from */
 
 #define TX_PKT_TYPE_MGMT                   1   /* Management Packet						  */
 #define TX_PKT_TYPE_EAPOL                  2   /* EAPOL packet (Ethernet)				  */
@@ -668,6 +692,7 @@ typedef enum
     TWD_INT_SEND_PACKET_TRANSFER        =  0x00 ,	/**< 	Tx Data Path Send Callback  	*/    
     TWD_INT_SEND_PACKET_COMPLETE                , 	/**< 	Tx Data Path Complete Callback 	*/   
     TWD_INT_UPDATE_BUSY_MAP                     , 	/**< 	Tx Data Path Update-Busy-Map Callback 	*/   
+    TWD_INT_SEND_PACKET_COMPLETE_BATCH          , 	/**< 	Tx Data Path Batch Complete Callback (all new results at once) 	*/   
 
     /* Rx Data Path Callbacks */
     TWD_INT_RECEIVE_PACKET              =  0x10 ,	/**< 	Rx Data Path Receive Packet Callback 	   	*/    
@@ -750,6 +775,7 @@ typedef enum
     TWD_EVENT_TX_XFER_SEND_PKT_TRANSFER 	=  TWD_OWNER_DRIVER_TX_XFER | TWD_INT_SEND_PACKET_TRANSFER,	/**< 	TX Data Path Send Packet Event ID 			*/
     TWD_EVENT_TX_RESULT_SEND_PKT_COMPLETE	=  TWD_OWNER_TX_RESULT | TWD_INT_SEND_PACKET_COMPLETE,      /**< 	TX Data Path Send Packet Complete Event ID 	*/
     TWD_EVENT_TX_HW_QUEUE_UPDATE_BUSY_MAP   =  TWD_OWNER_TX_HW_QUEUE | TWD_INT_UPDATE_BUSY_MAP,         /**< 	TX Data Path Update-Busy-Map Event ID 	*/
+    TWD_EVENT_TX_RESULT_SEND_PKT_COMPLETE_BATCH =  TWD_OWNER_TX_RESULT | TWD_INT_SEND_PACKET_COMPLETE_BATCH, /**< 	TX Data Path Send Packets Batch Complete Event ID 	*/
 
     /* Rx Data Path Callbacks */
     TWD_EVENT_RX_REQUEST_FOR_BUFFER     	=  TWD_OWNER_RX_XFER | TWD_INT_REQUEST_FOR_BUFFER,         	/**< 	RX Data Path Request for Buffer Internal Event ID 	*/
@@ -1599,6 +1625,7 @@ typedef struct
     TI_UINT8       uPktType;        /**< See TX_PKT_TYPE_xxxx above                                               */          
     TI_UINT8       uHeadroomSize;   /**< Only for WHA - headroom in bytes before the payload in the packet buffer */          
     TI_UINT16      uFlags;          /**< See TX_CTRL_FLAG__xxxx above 										      */          
+    TI_UINT8       uOsQueId;        /**< The OS Tx subqueue (AC) of the packet - valid if TX_CTRL_FLAG_OS_QUEUE is set */
 
 } TTxPktParams;
 
@@ -2569,8 +2596,13 @@ typedef struct
     TI_UINT16                           TxCompletePacingTimeout;			/**< */
     TI_UINT16                           RxIntrPacingThreshold;			    /**< */
     TI_UINT16                           RxIntrPacingTimeout;			    /**< */
+    TI_UINT16                           uFwEventPollHighThreshold;          /**< Interrupts per window for switching to polling (0 = disabled) */
+    TI_UINT16                           uFwEventPollLowThreshold;           /**< FW-Status reads with events per window for staying in polling */
+    TI_UINT16                           uFwEventPollInterval;               /**< FW-Status polling interval [msec] */
+    TI_UINT16                           uFwEventPollWindow;                 /**< Interrupts rate evaluation window [msec] */
 
     TI_UINT32                           uRxAggregPktsLimit;					/**< */
+    TI_UINT32                           uRxBaReorderTimeout;				/**< Time [msec] to wait for a missing packet in BA session (0 = no timeout) */
     TI_UINT32                           uTxAggregPktsLimit;					/**< */
     TI_UINT8                            hwAccessMethod;						/**< */
     TI_UINT8                            maxSitesFragCollect;				/**< */
@@ -3068,6 +3100,21 @@ TI_STATUS TWD_SetDefaults (TI_HANDLE hTWD, TTwdInitParams *pInitParams);
  * \sa
  */ 
 TI_STATUS TWD_InitFw (TI_HANDLE hTWD, TFileInfo *pFileInfo);
+/** @ingroup Control
+ * \brief  Get FW Download Statistics
+ * 
+ * \param  hTWD         - TWD module object handle
+ * \param  pTimeMs      - Pointer to output download time of the whole FW image, in msec
+ * \param  pBytes       - Pointer to output number of bytes downloaded
+ * \param  pBursts      - Pointer to output number of bus transactions used for the download
+ * \return TI_OK on success or TI_NOK on failure
+ * 
+ * \par Description
+ * Returns the statistics of the last FW image download (excluding the FW run and init)
+ * 
+ * \sa TWD_InitFw
+ */ 
+TI_STATUS TWD_GetFwDownloadStat (TI_HANDLE hTWD, TI_UINT32 *pTimeMs, TI_UINT32 *pBytes, TI_UINT32 *pBursts);
 /** @ingroup Control
  * \brief  Open UART Bus Txn
  * 
@@ -4569,6 +4616,21 @@ TTxCtrlBlk *TWD_txCtrlBlk_Alloc (TI_HANDLE hTWD);
  * \sa
  */ 
 void TWD_txCtrlBlk_Free (TI_HANDLE hTWD, TTxCtrlBlk *pCurrentEntry);
+/** @ingroup Data_Path
+ * \brief  TWD TX Control Block Free Batch
+ * 
+ * \param  hTWD   			- TWD module object handle
+ * \param  apEntries   		- Array of pointers to the TX Control Block Entries to Free
+ * \param  uNumEntries   	- Number of entries in apEntries
+ * \return void
+ * 
+ * \par Description
+ * Use this function for Free the Control-Blocks of several packets (e.g. on Tx-complete) 
+ * in one critical section
+ * 
+ * \sa	TWD_txCtrlBlk_Free
+ */ 
+void TWD_txCtrlBlk_FreeBatch (TI_HANDLE hTWD, TTxCtrlBlk **apEntries, TI_UINT32 uNumEntries);
 /** @ingroup Data_Path
  * \brief  TWD TX Control Get Pointer
  * 
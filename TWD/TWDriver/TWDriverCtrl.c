@@ -794,6 +794,11 @@ TI_STATUS TWD_CfgSetBaReceiver (TI_HANDLE hTWD,
 {
     TTwd *pTWD = (TTwd *)hTWD;
 
+    /* The Rx reorder window follows the window the FW accepts in ADDBA response */
+    if (uState)
+    {
+        RxQueue_SetBaWinSize (pTWD->hRxQueue, uTid, uWinSize);
+    }
 
     return cmdBld_CfgSetBaSession (pTWD->hCmdBld,
                                    ACX_BA_SESSION_RESPONDER_POLICY,
@@ -74,6 +74,13 @@ void TWD_txCtrlBlk_Free (TI_HANDLE hTWD, TTxCtrlBlk *pCurrentEntry)
     txCtrlBlk_Free (pTWD->hTxCtrlBlk, pCurrentEntry);
 }
 
+void TWD_txCtrlBlk_FreeBatch (TI_HANDLE hTWD, TTxCtrlBlk **apEntries, TI_UINT32 uNumEntries)
+{
+    TTwd *pTWD = (TTwd *)hTWD;
+
+    txCtrlBlk_FreeBatch (pTWD->hTxCtrlBlk, apEntries, uNumEntries);
+}
+
 TTxCtrlBlk *TWD_txCtrlBlk_GetPointer (TI_HANDLE hTWD, TI_UINT8 descId)
 {
     TTwd *pTWD = (TTwd *)hTWD;
@@ -325,6 +325,8 @@ void twIf_Init (TI_HANDLE hTwIf,
                                                 twIf_HandleTxnDone,
                                                 hTwIf,
                                                 TI_TRUE,
+                                                CONTEXT_PRIORITY_HIGH,
+                                                CONTEXT_BUDGET_UNLIMITED,
                                                 "TWIF",
                                                 sizeof("TWIF"));
 
@@ -1089,6 +1091,9 @@ TI_BOOL	twIf_isValidRegAddr(TI_HANDLE hTwIf, TI_UINT32 Address, TI_UINT32 Length
  */ 
 void twIf_PrintModuleInfo (TI_HANDLE hTwIf) 
 {
+    TTwIfObj *pTwIf = (TTwIfObj*)hTwIf;
+
+    txnQ_PrintBusDrvStats (pTwIf->hTxnQ);
 } 
 
 
@@ -38,3 +38,146 @@
 /*    PURPOSE:										*/
 /*																									*/
 /***************************************************************************/
+
+/** \file  RxDbg.c
+ *  \brief Rx debug functions.
+ *
+ *  \see   dataCtrlDbg.h
+ */
+
+#include "tidef.h"
+#include "osApi.h"
+#include "report.h"
+#include "RxBuf.h"
+#include "rx.h"
+#include "dataCtrlDbg.h"
+
+
+/** 
+ * \fn     rxDbg_PrintRxBufPool 
+ * \brief  Print Rx buffers recycle pool statistics
+ * 
+ * Print the Rx buffers pool occupancy, watermarks and hit/miss/recycle/refill counters per size class.
+ *
+ * \note   
+ * \param  hRxData - The RxData object handle
+ * \return void
+ * \sa     rxDbg_ResetRxBufPool
+ */ 
+void rxDbg_PrintRxBufPool (TI_HANDLE hRxData)
+{
+    rxData_t        *pRxData = (rxData_t *)hRxData;
+    TRxBufPoolStats  tStats;
+    TI_UINT32        uClass, uAllocs;
+
+    if (RxBufPoolGetStats (pRxData->hOs, &tStats) != TI_OK)
+    {
+        WLAN_OS_REPORT(("Rx buffers pool not available\n"));
+        return;
+    }
+
+    WLAN_OS_REPORT(("-------------- Rx Buffers Pool ---------------\n"));
+    WLAN_OS_REPORT(("Class  BufLen  Free  Low  High      Hits    Misses  Hit%%  Recycled  Overflow  Refilled\n"));
+    for (uClass = 0; uClass < RX_BUF_POOL_NUM_CLASSES; uClass++)
+    {
+        uAllocs = tStats.aHits[uClass] + tStats.aMisses[uClass];
+        WLAN_OS_REPORT(("%5d  %6d  %4d  %3d  %4d  %8d  %8d  %4d  %8d  %8d  %8d\n",
+                        uClass,
+                        tStats.aBufLen[uClass],
+                        tStats.aFreeBufs[uClass],
+                        tStats.aLowWatermark[uClass],
+                        tStats.aHighWatermark[uClass],
+                        tStats.aHits[uClass],
+                        tStats.aMisses[uClass],
+                        uAllocs ? (tStats.aHits[uClass] * 100) / uAllocs : 0,
+                        tStats.aRecycled[uClass],
+                        tStats.aRecycleOverflow[uClass],
+                        tStats.aRefilled[uClass]));
+    }
+    WLAN_OS_REPORT(("Oversize allocations = %d\n", tStats.uOversize));
+    WLAN_OS_REPORT(("Not recyclable       = %d\n", tStats.uNotRecyclable));
+    WLAN_OS_REPORT(("Refill runs          = %d\n", tStats.uRefillRuns));
+    WLAN_OS_REPORT(("Refill failures      = %d\n", tStats.uRefillFailures));
+    WLAN_OS_REPORT(("Alloc failures       = %d\n", tStats.uAllocFailures));
+}
+
+
+/** 
+ * \fn     rxDbg_ResetRxBufPool 
+ * \brief  Reset Rx buffers recycle pool statistics
+ * 
+ * \note   
+ * \param  hRxData - The RxData object handle
+ * \return void
+ * \sa     rxDbg_PrintRxBufPool
+ */ 
+void rxDbg_ResetRxBufPool (TI_HANDLE hRxData)
+{
+    rxData_t *pRxData = (rxData_t *)hRxData;
+
+    RxBufPoolResetStats (pRxData->hOs);
+}
+
+
+/** 
+ * \fn     rxDbg_PrintRxBatchStats 
+ * \brief  Print Rx batched delivery statistics
+ * 
+ * Print the Rx batches and polls counters, and the packets per batch and per poll histograms.
+ *
+ * \note   
+ * \param  hRxData - The RxData object handle
+ * \return void
+ * \sa     rxDbg_ResetRxBatchStats
+ */ 
+void rxDbg_PrintRxBatchStats (TI_HANDLE hRxData)
+{
+    rxData_t        *pRxData = (rxData_t *)hRxData;
+    TOsRxBatchStats  tStats;
+    TI_UINT32        uBin;
+
+    if (os_GetRxBatchStats (pRxData->hOs, &tStats) != TI_OK)
+    {
+        WLAN_OS_REPORT(("Rx batched delivery not available\n"));
+        return;
+    }
+
+    WLAN_OS_REPORT(("-------------- Rx Batched Delivery ---------------\n"));
+    WLAN_OS_REPORT(("Budget = %d, Batches = %d, Polls = %d, BudgetExhausted = %d, Packets = %d, Dropped = %d\n",
+                    tStats.uRxBatchBudget, tStats.uBatches, tStats.uPolls, 
+                    tStats.uBudgetExhausted, tStats.uPackets, tStats.uDropped));
+    WLAN_OS_REPORT(("Packets      Batches     Polls\n"));
+    for (uBin = 0; uBin < OS_RX_BATCH_HIST_BINS; uBin++)
+    {
+        if (uBin == 0)
+        {
+            WLAN_OS_REPORT(("%4d       ", 0));
+        }
+        else if (uBin == OS_RX_BATCH_HIST_BINS - 1)
+        {
+            WLAN_OS_REPORT(("%4d+      ", 1 << (uBin - 1)));
+        }
+        else 
+        {
+            WLAN_OS_REPORT(("%4d-%-4d  ", 1 << (uBin - 1), (1 << uBin) - 1));
+        }
+        WLAN_OS_REPORT(("%8d  %8d\n", tStats.aPktsPerBatch[uBin], tStats.aPktsPerPoll[uBin]));
+    }
+}
+
+
+/** 
+ * \fn     rxDbg_ResetRxBatchStats 
+ * \brief  Reset Rx batched delivery statistics
+ * 
+ * \note   
+ * \param  hRxData - The RxData object handle
+ * \return void
+ * \sa     rxDbg_PrintRxBatchStats
+ */ 
+void rxDbg_ResetRxBatchStats (TI_HANDLE hRxData)
+{
+    rxData_t *pRxData = (rxData_t *)hRxData;
+
+    os_ResetRxBatchStats (pRxData->hOs);
+}
@@ -34,6 +34,7 @@
 #include "tidef.h"
 #include "TWDriver.h"
 #include "rxXfer_api.h"
+#include "RxQueue_api.h"
 #include "report.h"
 #include "osApi.h"
 #include "eventMbox_api.h"
@@ -112,6 +113,7 @@ TWD_PRINT_FW_EVENT_INFO,
 TWD_PRINT_TW_IF_INFO,
 TWD_PRINT_MBOX_INFO,
 TWD_FORCE_TEMPLATES_RATES,
+TWD_SET_MBOX_PIPELINE,
 
 				TWD_DEBUG_TEST_MAX = 0xFF	/* mast be last!!! */
 
@@ -604,10 +606,12 @@ TI_STATUS TWD_Debug (TI_HANDLE hTWD, TI_UINT32 funcType, void *pParam)
 #ifdef TI_DBG
     case TWD_PRINT_RX_INFO:
 		rxXfer_PrintStats (pTWD->hRxXfer);  
+		RxQueue_PrintStats (pTWD->hRxQueue);  
         break;
 
 	case TWD_CLEAR_RX_INFO:
 		rxXfer_ClearStats (pTWD->hRxXfer);  
+		RxQueue_ClearStats (pTWD->hRxQueue);  
         break;
 
 #endif /* TI_DBG */
@@ -671,6 +675,14 @@ TI_STATUS TWD_Debug (TI_HANDLE hTWD, TI_UINT32 funcType, void *pParam)
 		cmdBld_DbgForceTemplatesRates (pTWD->hCmdBld, *(TI_UINT32 *)pParam);
         break;
 
+	case TWD_SET_MBOX_PIPELINE:
+		if (pParam == NULL)
+		{
+			return TI_NOK;
+		}
+		cmdQueue_SetPipeline (pTWD->hCmdQueue, (*(TI_UINT32 *)pParam) ? TI_TRUE : TI_FALSE);
+        break;
+
 
 	default:
         break;
@@ -115,6 +115,18 @@ void rxTxDebugFunction(TI_HANDLE hRxTxHandle, TI_UINT32 funcType, void *pParam)
         txDataClsfr_PrintClsfrTable (pTxCtrl->hTxDataQ);
         break;
 
+	case PRINT_TX_DATA_CLSFR_BENCHMARK:
+        txDataClsfr_Benchmark (pTxCtrl->hTxDataQ);
+        break;
+
+	case PRINT_TX_COMPLETE_BENCHMARK:
+        txCtrl_TxCompleteBenchmark (hRxTxHandle);
+        break;
+
+	case PRINT_TX_HDR_CACHE_BENCHMARK:
+        txCtrl_HdrCacheBenchmark (hRxTxHandle);
+        break;
+
 
 	case RESET_TX_CTRL_COUNTERS:
 		txCtrlParams_resetDbgCounters (hRxTxHandle);
@@ -172,6 +184,22 @@ void rxTxDebugFunction(TI_HANDLE hRxTxHandle, TI_UINT32 funcType, void *pParam)
 		rxData_stopRxThroughputTimer (hRxTxHandle);
 		break;
 
+    case PRINT_RX_BUF_POOL:
+		rxDbg_PrintRxBufPool (hRxTxHandle);
+		break;
+
+    case RESET_RX_BUF_POOL_COUNTERS:
+		rxDbg_ResetRxBufPool (hRxTxHandle);
+		break;
+
+    case PRINT_RX_BATCH_STATS:
+		rxDbg_PrintRxBatchStats (hRxTxHandle);
+		break;
+
+    case RESET_RX_BATCH_STATS:
+		rxDbg_ResetRxBatchStats (hRxTxHandle);
+		break;
+
 	default:
 		break;
 	}
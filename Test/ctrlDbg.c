@@ -46,6 +46,7 @@
 #include "report.h"
 #include "TWDriver.h"
 #include "paramOut.h"
+#include "TrafficMonitorAPI.h"
 
 void printCtrlDbgFunctions(void);
 
@@ -87,6 +88,14 @@ void ctrlDebugFunction(TI_HANDLE hCtrlData, TI_UINT32 funcType, void *pParam)
 		ctrlData_setParam(pCtrlData,&paramInfo);
 		break;
 
+	case CTRL_PRINT_TRAFFIC_MONITOR_STATS:
+		TrafficMonitor_PrintStats(pCtrlData->hTrafficMonitor);
+		break;
+
+	case CTRL_TRAFFIC_MONITOR_BENCHMARK:
+		TrafficMonitor_Benchmark(pCtrlData->hTrafficMonitor);
+		break;
+
 	default:
 		break;
 	}
@@ -51,6 +51,9 @@ typedef enum
 /*	9	*/	PRINT_TX_XFER_INFO,
 /*	10	*/	PRINT_TX_RESULT_INFO,
 /*	11	*/	PRINT_TX_DATA_CLSFR_TABLE,
+/*	12	*/	PRINT_TX_DATA_CLSFR_BENCHMARK,
+/*	13	*/	PRINT_TX_COMPLETE_BENCHMARK,
+/*	14	*/	PRINT_TX_HDR_CACHE_BENCHMARK,
 /*	20	*/	RESET_TX_CTRL_COUNTERS          = 20,
 /*	21	*/	RESET_TX_DATA_QUEUE_COUNTERS,
 /*	22	*/	RESET_TX_DATA_CLSFR_TABLE,
@@ -64,7 +67,11 @@ typedef enum
 /*	51	*/	PRINT_RX_COUNTERS,
 /*	52	*/	RESET_RX_COUNTERS,
 /*	53	*/	PRINT_RX_THROUGHPUT_START,
-/*	54	*/	PRINT_RX_THROUGHPUT_STOP
+/*	54	*/	PRINT_RX_THROUGHPUT_STOP,
+/*	55	*/	PRINT_RX_BUF_POOL,
+/*	56	*/	RESET_RX_BUF_POOL_COUNTERS,
+/*	57	*/	PRINT_RX_BATCH_STATS,
+/*	58	*/	RESET_RX_BATCH_STATS
 
 } ERxTxDbgFunc;
 
@@ -75,13 +82,19 @@ typedef enum
 /*	0	*/	CTRL_PRINT_DBG_FUNCTIONS,
 /*	1	*/	CTRL_PRINT_CTRL_BLOCK,
 /*	2	*/	CTRL_PRINT_TX_PARAMETERS,
-/*	3	*/	CTRL_SET_CTS_TO_SELF
+/*	3	*/	CTRL_SET_CTS_TO_SELF,
+/*	4	*/	CTRL_PRINT_TRAFFIC_MONITOR_STATS,
+/*	5	*/	CTRL_TRAFFIC_MONITOR_BENCHMARK
 
 } ECtrlDbgFunc;
 
 
 void rxTxDebugFunction (TI_HANDLE hRxTxHandle, TI_UINT32 funcType, void *pParam);
 void ctrlDebugFunction (TI_HANDLE hCtrlData, TI_UINT32 funcType, void *pParam);
+void rxDbg_PrintRxBufPool (TI_HANDLE hRxData);
+void rxDbg_ResetRxBufPool (TI_HANDLE hRxData);
+void rxDbg_PrintRxBatchStats (TI_HANDLE hRxData);
+void rxDbg_ResetRxBatchStats (TI_HANDLE hRxData);
 
 
 #endif /* __DATA_CTRL_DBG_H__*/
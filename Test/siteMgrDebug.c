@@ -57,6 +57,7 @@
 #include "healthMonitor.h"
 #include "conn.h"
 #include "connApi.h"
+#include "mlmeApi.h"
 
 #ifdef XCC_MODULE_INCLUDED
 #include "XCCMngr.h"
@@ -239,6 +240,14 @@ void siteMgrDebugFunction (TI_HANDLE         hSiteMgr,
 		printSiteTable(pSiteMgr, (char*)pParam);
 		break;
 
+	case MLME_PARSER_BENCHMARK:
+		mlmeParser_Benchmark(pStadHandles->hMlmeSm);
+		break;
+
+	case PRINT_BEACON_CACHE_STATS:
+		mlmeParser_PrintBeaconCacheStats(pStadHandles->hMlmeSm);
+		break;
+
 	case SET_DESIRED_CHANNEL:
 		param.paramType = SITE_MGR_DESIRED_CHANNEL_PARAM;
 		param.content.siteMgrDesiredChannel = *(TI_UINT8*)pParam;
@@ -99,6 +99,8 @@
 #define TEST_TOGGLE_LNA_OFF   								61 
 
 #define PRINT_SITE_TABLE_PER_SSID							70
+#define MLME_PARSER_BENCHMARK								71
+#define PRINT_BEACON_CACHE_STATS							72
 
 #define ROAM_TEST1											81
 #define ROAM_TEST2											82
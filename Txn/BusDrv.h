@@ -74,6 +74,9 @@
 #define TXN_NON_SLEEP_ELP           1
 #define TXN_SLEEP_ELP               0
 
+#define TXN_NON_DMA_ABLE            0   /* Txn buffers must be copied to the bus driver DMA buffer */
+#define TXN_DMA_ABLE                1   /* Txn buffers (e.g. OS packets) may be used directly for DMA */
+
 #define NUM_OF_PARTITION            4
 
 /************************************************************************
@@ -89,6 +92,7 @@
 #define TXN_PARAM_GET_STATUS(pTxn)              ( (pTxn->uTxnParams & 0x00000F00) >> 8 )
 #define TXN_PARAM_GET_AGGREGATE(pTxn)           ( (pTxn->uTxnParams & 0x00001000) >> 12 )
 #define TXN_PARAM_GET_END_OF_BURST(pTxn)        ( (pTxn->uTxnParams & 0x00002000) >> 13 )
+#define TXN_PARAM_GET_DMA_ABLE(pTxn)            ( (pTxn->uTxnParams & 0x00004000) >> 14 )
 
 
 
@@ -102,6 +106,7 @@
 #define TXN_PARAM_SET_STATUS(pTxn, uValue)      ( pTxn->uTxnParams = (pTxn->uTxnParams & ~0x00000F00) | (uValue << 8 ) )
 #define TXN_PARAM_SET_AGGREGATE(pTxn, uValue)   ( pTxn->uTxnParams = (pTxn->uTxnParams & ~0x00001000) | (uValue << 12 ) )
 #define TXN_PARAM_SET_END_OF_BURST(pTxn, uValue)( pTxn->uTxnParams = (pTxn->uTxnParams & ~0x00002000) | (uValue << 13 ) )
+#define TXN_PARAM_SET_DMA_ABLE(pTxn, uValue)    ( pTxn->uTxnParams = (pTxn->uTxnParams & ~0x00004000) | (uValue << 14 ) )
 
 
 #define TXN_PARAM_SET(pTxn, uPriority, uId, uDirection, uAddrMode) \
@@ -151,6 +156,7 @@ typedef struct
 {
     TI_UINT32    uBlkSizeShift;
     TI_UINT32    uBusDrvThreadPriority;
+    TI_BOOL      bZeroCopy;                /* If TRUE, DMA-able Txn buffers are transacted without copy */
 } TSdioCfg; 
 
 typedef struct
@@ -194,6 +200,9 @@ TI_STATUS   busDrv_ConnectBus (TI_HANDLE        hBusDrv,
                                TI_UINT32        *pTxDmaBufLen);
 TI_STATUS   busDrv_DisconnectBus (TI_HANDLE hBusDrv);
 ETxnStatus  busDrv_Transact   (TI_HANDLE hBusDrv, TTxnStruct *pTxn);
+#ifdef TI_DBG
+void        busDrv_PrintStats (TI_HANDLE hBusDrv);
+#endif
 
 
 
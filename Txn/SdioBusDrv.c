@@ -53,7 +53,14 @@
 /************************************************************************
  * Defines
  ************************************************************************/
+#define MAX_TXN_SEGS      16                  /* Max host memory segments per transaction (incl. Tx aggregation) */
+#ifdef  DISABLE_SDIO_MULTI_BLK_MODE
 #define MAX_TXN_PARTS     MAX_XFER_BUFS * 5   /* for aggregation we may need a few parts for each buffer */
+#else
+#define MAX_TXN_PARTS     MAX_TXN_SEGS * 2    /* each segment may have a remainder part and a block-mode part */
+#endif
+#define TXN_DMA_ALIGN_MASK  0x3               /* Host buffers used directly for DMA must be word aligned */
+#define TXN_DMA_READ_ALIGN_MASK  (TI_CACHE_LINE_SIZE - 1) /* and read buffers also cache line aligned */
 
 
 /************************************************************************
@@ -71,6 +78,29 @@ typedef struct
 } TTxnPart; 
 
 
+/* A contiguous host memory segment of the current transaction.
+ * Either a host buffer used directly by the SDIO DMA (zero-copy), or an area of the bounce DMA buffer
+ *     holding one or more consecutive host buffers that can't be used directly.
+ */
+typedef struct
+{
+    TI_UINT8 *       pHostAddr;          /* The segment start address */
+    TI_UINT32        uLength;            /* The segment length in bytes */
+    TI_BOOL          bBounce;            /* If TRUE the segment resides in the bounce DMA buffer */
+} TTxnSeg;
+
+
+/* Zero-copy (scatter-gather) statistics */
+typedef struct
+{
+    TI_UINT32        uZeroCopyTxns;      /* Transactions sent with no copy at all */
+    TI_UINT32        uPartialTxns;       /* Transactions with both direct and bounced buffers */
+    TI_UINT32        uBounceTxns;        /* Transactions fully copied through the bounce buffer */
+    TI_UINT32        uZeroCopyBytes;     /* Bytes transfered directly from/to the host buffers */
+    TI_UINT32        uBounceBytes;       /* Bytes copied through the bounce buffer */
+} TBusDrvStat;
+
+
 /* The busDrv module Object */
 typedef struct _TBusDrvObj
 {
@@ -93,6 +123,12 @@ typedef struct _TBusDrvObj
     TI_UINT8 *       pTxDmaBuf;          /* The Tx DMA-able buffer for buffering all write transactions */
     TI_UINT32        uTxDmaBufLen;       /* The Tx DMA-able buffer length in bytes */
     TI_UINT32        uTxnLength;         /* The current transaction accumulated length (including Tx aggregation case) */
+    TI_UINT32        uBounceLen;         /* The current transaction length copied to the bounce DMA buffer */
+    TTxnSeg          aTxnSegs[MAX_TXN_SEGS]; /* The host memory segments of the current transaction */
+    TI_UINT32        uTxnSegsNum;        /* Number of host memory segments of the current transaction */
+    TI_UINT32        uDirectBufsMask;    /* Bit per Txn buffer that is read directly (no copy from bounce buffer) */
+    TI_BOOL          bZeroCopy;          /* If TRUE, DMA-able host buffers are transacted directly (no bounce) */
+    TBusDrvStat      tStat;              /* Zero-copy statistics */
 
 } TBusDrvObj;
 
@@ -101,6 +137,9 @@ typedef struct _TBusDrvObj
  * Internal functions prototypes
  ************************************************************************/
 static TI_BOOL  busDrv_PrepareTxnParts  (TBusDrvObj *pBusDrv, TTxnStruct *pTxn);
+static TI_BOOL  busDrv_IsDirectBuf      (TBusDrvObj *pBusDrv, TTxnStruct *pTxn, TI_UINT32 uBufNum);
+static TI_UINT32 busDrv_PrepareSegParts (TBusDrvObj *pBusDrv, TTxnSeg *pSeg, TI_UINT32 uPartNum, 
+                                         TI_UINT32 *pHwAddr, TI_BOOL bFixedHwAddr);
 static void     busDrv_SendTxnParts     (TBusDrvObj *pBusDrv);
 static void     busDrv_TxnDoneCb        (TI_HANDLE hBusDrv, TI_INT32 status);
  
@@ -229,6 +268,10 @@ TI_STATUS busDrv_ConnectBus (TI_HANDLE        hBusDrv,
     pBusDrv->uCurrTxnPartsNum = 0;
     pBusDrv->uCurrTxnPartsCountSync = 0;
     pBusDrv->uTxnLength = 0;
+    pBusDrv->uBounceLen = 0;
+    pBusDrv->uTxnSegsNum = 0;
+    pBusDrv->bZeroCopy  = pBusDrvCfg->tSdioCfg.bZeroCopy;
+    os_memoryZero (pBusDrv->hOs, &pBusDrv->tStat, sizeof(TBusDrvStat));
 	
     /* 
      * Configure the SDIO driver parameters and handle SDIO enumeration.
@@ -330,9 +373,11 @@ ETxnStatus busDrv_Transact (TI_HANDLE hBusDrv, TTxnStruct *pTxn)
  * 
  * Called by busDrv_Transact().
  * Prepares the actual sequence of SDIO bus transactions in a table.
- * Use a DMA-able buffer for the bus transaction, so all data is copied 
+ * DMA-able host buffers (see busDrv_IsDirectBuf) are used directly by the bus transactions (zero-copy).
+ * Other buffers use a DMA-able bounce buffer, so their data is copied 
  *     to it from the host buffer(s) before write transactions, 
  *     or copied from it to the host buffers after read transactions.
+ * Each resulting memory segment is split to a remainder part and a block-mode part.
  * 
  * \note   
  * \param  pBusDrv - The module's object
@@ -346,10 +391,13 @@ static TI_BOOL busDrv_PrepareTxnParts (TBusDrvObj *pBusDrv, TTxnStruct *pTxn)
     TI_UINT32 uCurrHwAddr  = pTxn->uHwAddr;
     TI_BOOL   bFixedHwAddr = TXN_PARAM_GET_FIXED_ADDR(pTxn);
     TI_BOOL   bWrite       = (TXN_PARAM_GET_DIRECTION(pTxn) == TXN_DIRECTION_WRITE) ? TI_TRUE : TI_FALSE;
-    TI_UINT8 *pHostBuf     = bWrite ? pBusDrv->pTxDmaBuf : pBusDrv->pRxDmaBuf; /* Use DMA buffer (Rx or Tx) for actual transaction */
+    TI_UINT8 *pBounceBuf   = bWrite ? pBusDrv->pTxDmaBuf : pBusDrv->pRxDmaBuf; /* Use DMA buffer (Rx or Tx) for bounced buffers */
+    TTxnSeg  *pSeg;
     TI_UINT32 uBufNum;
     TI_UINT32 uBufLen;
-    TI_UINT32 uRemainderLen;
+    TI_UINT32 uSegNum;
+
+    pBusDrv->uDirectBufsMask = 0;
 
     /* Go over the transaction buffers */
     for (uBufNum = 0; uBufNum < MAX_XFER_BUFS; uBufNum++) 
@@ -362,10 +410,41 @@ static TI_BOOL busDrv_PrepareTxnParts (TBusDrvObj *pBusDrv, TTxnStruct *pTxn)
             break;
         }
 
-        /* For write transaction, copy the data to the DMA buffer */
-        if (bWrite) 
+        /* If the buffer can be used directly by the DMA, add it as a separate segment */
+        if (busDrv_IsDirectBuf (pBusDrv, pTxn, uBufNum))
+        {
+            pSeg = &(pBusDrv->aTxnSegs[pBusDrv->uTxnSegsNum++]);
+            pSeg->pHostAddr = pTxn->aBuf[uBufNum];
+            pSeg->uLength   = uBufLen;
+            pSeg->bBounce   = TI_FALSE;
+            pBusDrv->uDirectBufsMask |= (1 << uBufNum);
+            pBusDrv->tStat.uZeroCopyBytes += uBufLen;
+        }
+
+        /* Else, use the bounce buffer */
+        else 
         {
-            os_memoryCopy (pBusDrv->hOs, pHostBuf + pBusDrv->uTxnLength, pTxn->aBuf[uBufNum], uBufLen);
+            /* For write transaction, copy the data to the DMA buffer */
+            if (bWrite) 
+            {
+                os_memoryCopy (pBusDrv->hOs, pBounceBuf + pBusDrv->uBounceLen, pTxn->aBuf[uBufNum], uBufLen);
+            }
+
+            /* If last segment is a bounce one it is contiguous to this buffer, so extend it */
+            if (pBusDrv->uTxnSegsNum > 0  &&  pBusDrv->aTxnSegs[pBusDrv->uTxnSegsNum - 1].bBounce)
+            {
+                pBusDrv->aTxnSegs[pBusDrv->uTxnSegsNum - 1].uLength += uBufLen;
+            }
+            else 
+            {
+                pSeg = &(pBusDrv->aTxnSegs[pBusDrv->uTxnSegsNum++]);
+                pSeg->pHostAddr = pBounceBuf + pBusDrv->uBounceLen;
+                pSeg->uLength   = uBufLen;
+                pSeg->bBounce   = TI_TRUE;
+            }
+
+            pBusDrv->uBounceLen += uBufLen;
+            pBusDrv->tStat.uBounceBytes += uBufLen;
         }
 
         /* Add buffer length to total transaction length */
@@ -377,21 +456,131 @@ static TI_BOOL busDrv_PrepareTxnParts (TBusDrvObj *pBusDrv, TTxnStruct *pTxn)
     {
         return TI_TRUE;
     }
-    
-    /* If current buffer has a remainder, prepare its transaction part */
-    uRemainderLen = pBusDrv->uTxnLength & pBusDrv->uBlkSizeMask;
+
+    /* Update the zero-copy statistics */
+    if (pBusDrv->uBounceLen == 0)
+    {
+        pBusDrv->tStat.uZeroCopyTxns++;
+    }
+    else if (pBusDrv->uBounceLen < pBusDrv->uTxnLength)
+    {
+        pBusDrv->tStat.uPartialTxns++;
+    }
+    else 
+    {
+        pBusDrv->tStat.uBounceTxns++;
+    }
+
+    /* Prepare the transaction parts of all segments */
+    for (uSegNum = 0; uSegNum < pBusDrv->uTxnSegsNum; uSegNum++)
+    {
+        uPartNum = busDrv_PrepareSegParts (pBusDrv, 
+                                           &(pBusDrv->aTxnSegs[uSegNum]), 
+                                           uPartNum, 
+                                           &uCurrHwAddr, 
+                                           bFixedHwAddr);
+    }
+
+    /* Set last More flag as specified for the whole Txn */
+    pBusDrv->aTxnParts[uPartNum - 1].bMore = TXN_PARAM_GET_MORE(pTxn);
+    pBusDrv->uCurrTxnPartsNum = uPartNum;
+
+    pBusDrv->uTxnLength  = 0;
+    pBusDrv->uBounceLen  = 0;
+    pBusDrv->uTxnSegsNum = 0;
+
+    /* Return FALSE to indicate that we are not in the middle of a Tx aggregation so the Txn is ready to send */
+    return TI_FALSE;
+}
+
+
+/** 
+ * \fn     busDrv_IsDirectBuf
+ * \brief  Check if a transaction buffer can be used directly by the DMA
+ * 
+ * Called by busDrv_PrepareTxnParts().
+ * A buffer is transacted directly (without copy to the bounce buffer) if:
+ *   - Zero-copy is enabled and the Txn originator marked its buffers as DMA-able.
+ *   - The buffer address and length are word aligned, and for reads also cache line aligned,
+ *       since reading into a shared cache line corrupts the neighbouring data on non-coherent hosts.
+ *   - It's at least one SDIO block long (so saving the copy is worth another bus transaction).
+ *   - There is still room in the segments table (leave one for a trailing bounce segment).
+ * 
+ * \note   
+ * \param  pBusDrv - The module's object
+ * \param  pTxn    - The transaction object 
+ * \param  uBufNum - The buffer index in the transaction
+ * \return TRUE if the buffer can be used directly
+ * \sa     busDrv_PrepareTxnParts
+ */ 
+static TI_BOOL busDrv_IsDirectBuf (TBusDrvObj *pBusDrv, TTxnStruct *pTxn, TI_UINT32 uBufNum)
+{
+#ifdef  DISABLE_SDIO_MULTI_BLK_MODE
+    /* Each transaction is split to single blocks in the bounce buffer */
+    return TI_FALSE;
+#else
+    TI_UINT32  uBufLen = pTxn->aLen[uBufNum];
+    TI_UINTPTR uAlignMask;
+
+    if (!pBusDrv->bZeroCopy  ||  !TXN_PARAM_GET_DMA_ABLE(pTxn))
+    {
+        return TI_FALSE;
+    }
+
+    uAlignMask = (TXN_PARAM_GET_DIRECTION(pTxn) == TXN_DIRECTION_READ) ? 
+                     (TXN_DMA_ALIGN_MASK | TXN_DMA_READ_ALIGN_MASK) : TXN_DMA_ALIGN_MASK;
+
+    if ((((TI_UINTPTR)pTxn->aBuf[uBufNum] | uBufLen) & uAlignMask)          ||
+        (uBufLen < pBusDrv->uBlkSize)                                       ||
+        (pBusDrv->uTxnSegsNum >= MAX_TXN_SEGS - 1))
+    {
+        return TI_FALSE;
+    }
+
+    return TI_TRUE;
+#endif
+}
+
+
+/** 
+ * \fn     busDrv_PrepareSegParts
+ * \brief  Prepare the transaction parts of one host memory segment
+ * 
+ * Called by busDrv_PrepareTxnParts().
+ * Adds to the parts table a byte-mode part for the segment's remainder (if any), 
+ *     and a block-mode part for its full SDIO blocks (if any).
+ * 
+ * \note   
+ * \param  pBusDrv      - The module's object
+ * \param  pSeg         - The memory segment
+ * \param  uPartNum     - The first free entry in the parts table
+ * \param  pHwAddr      - The current HW address (updated if not fixed)
+ * \param  bFixedHwAddr - If TRUE, the HW address is fixed
+ * \return The next free entry in the parts table
+ * \sa     busDrv_PrepareTxnParts
+ */ 
+static TI_UINT32 busDrv_PrepareSegParts (TBusDrvObj *pBusDrv, 
+                                         TTxnSeg    *pSeg, 
+                                         TI_UINT32   uPartNum, 
+                                         TI_UINT32  *pHwAddr, 
+                                         TI_BOOL     bFixedHwAddr)
+{
+    TI_UINT32 uRemainderLen;
+
+    /* If current segment has a remainder, prepare its transaction part */
+    uRemainderLen = pSeg->uLength & pBusDrv->uBlkSizeMask;
     if (uRemainderLen > 0)
     {
         pBusDrv->aTxnParts[uPartNum].bBlkMode  = TI_FALSE;
         pBusDrv->aTxnParts[uPartNum].uLength   = uRemainderLen;
-        pBusDrv->aTxnParts[uPartNum].uHwAddr   = uCurrHwAddr;
-        pBusDrv->aTxnParts[uPartNum].pHostAddr = (void *)pHostBuf;
+        pBusDrv->aTxnParts[uPartNum].uHwAddr   = *pHwAddr;
+        pBusDrv->aTxnParts[uPartNum].pHostAddr = (void *)pSeg->pHostAddr;
         pBusDrv->aTxnParts[uPartNum].bMore     = TI_TRUE;
 
         /* If not fixed HW address, increment it by this part's size */
         if (!bFixedHwAddr)
         {
-            uCurrHwAddr += uRemainderLen;
+            *pHwAddr += uRemainderLen;
         }
 
         uPartNum++;
@@ -403,18 +592,18 @@ static TI_BOOL busDrv_PrepareTxnParts (TBusDrvObj *pBusDrv, TTxnStruct *pTxn)
     {
         TI_UINT32 uLen;
 
-        for (uLen = uRemainderLen; uLen < pBusDrv->uTxnLength; uLen += pBusDrv->uBlkSize)
+        for (uLen = uRemainderLen; uLen < pSeg->uLength; uLen += pBusDrv->uBlkSize)
         {
             pBusDrv->aTxnParts[uPartNum].bBlkMode  = TI_FALSE;
             pBusDrv->aTxnParts[uPartNum].uLength   = pBusDrv->uBlkSize;
-            pBusDrv->aTxnParts[uPartNum].uHwAddr   = uCurrHwAddr;
-            pBusDrv->aTxnParts[uPartNum].pHostAddr = (void *)(pHostBuf + uLen);
+            pBusDrv->aTxnParts[uPartNum].uHwAddr   = *pHwAddr;
+            pBusDrv->aTxnParts[uPartNum].pHostAddr = (void *)(pSeg->pHostAddr + uLen);
             pBusDrv->aTxnParts[uPartNum].bMore     = TI_TRUE;
 
             /* If not fixed HW address, increment it by this part's size */
             if (!bFixedHwAddr)
             {
-                uCurrHwAddr += pBusDrv->uBlkSize;
+                *pHwAddr += pBusDrv->uBlkSize;
             }
 
             uPartNum++;
@@ -423,28 +612,27 @@ static TI_BOOL busDrv_PrepareTxnParts (TBusDrvObj *pBusDrv, TTxnStruct *pTxn)
 
 #else  /* Use SDIO block mode (this is the default behavior) */
 
-    /* If current buffer has full SDIO blocks, prepare a block-mode transaction part */
-    if (pBusDrv->uTxnLength >= pBusDrv->uBlkSize)
+    /* If current segment has full SDIO blocks, prepare a block-mode transaction part */
+    if (pSeg->uLength >= pBusDrv->uBlkSize)
     {
         pBusDrv->aTxnParts[uPartNum].bBlkMode  = TI_TRUE;
-        pBusDrv->aTxnParts[uPartNum].uLength   = pBusDrv->uTxnLength - uRemainderLen;
-        pBusDrv->aTxnParts[uPartNum].uHwAddr   = uCurrHwAddr;
-        pBusDrv->aTxnParts[uPartNum].pHostAddr = (void *)(pHostBuf + uRemainderLen);
+        pBusDrv->aTxnParts[uPartNum].uLength   = pSeg->uLength - uRemainderLen;
+        pBusDrv->aTxnParts[uPartNum].uHwAddr   = *pHwAddr;
+        pBusDrv->aTxnParts[uPartNum].pHostAddr = (void *)(pSeg->pHostAddr + uRemainderLen);
         pBusDrv->aTxnParts[uPartNum].bMore     = TI_TRUE;
 
+        /* If not fixed HW address, increment it by this part's size */
+        if (!bFixedHwAddr)
+        {
+            *pHwAddr += pSeg->uLength - uRemainderLen;
+        }
+
         uPartNum++;
     }
 
 #endif /* DISABLE_SDIO_MULTI_BLK_MODE */
 
-    /* Set last More flag as specified for the whole Txn */
-    pBusDrv->aTxnParts[uPartNum - 1].bMore = TXN_PARAM_GET_MORE(pTxn);
-    pBusDrv->uCurrTxnPartsNum = uPartNum;
-
-    pBusDrv->uTxnLength = 0;
-
-    /* Return FALSE to indicate that we are not in the middle of a Tx aggregation so the Txn is ready to send */
-    return TI_FALSE;
+    return uPartNum;
 }
 
 
@@ -537,7 +725,7 @@ static void busDrv_SendTxnParts (TBusDrvObj *pBusDrv)
 
     /* If we got here we sent all buffers and we don't pend transaction end */
 
-    /* For read transaction, copy the data from the DMA-able buffer to the host buffer(s) */
+    /* For read transaction, copy the data from the DMA-able buffer to the bounced host buffer(s) */
     if (TXN_PARAM_GET_DIRECTION(pTxn) == TXN_DIRECTION_READ) 
     {
         TI_UINT32 uBufNum;
@@ -553,6 +741,12 @@ static void busDrv_SendTxnParts (TBusDrvObj *pBusDrv)
             {
                 break;
             }
+
+            /* If the buffer was read directly, no copy is needed */
+            if (pBusDrv->uDirectBufsMask & (1 << uBufNum))
+            {
+                continue;
+            }
     
             os_memoryCopy (pBusDrv->hOs, pTxn->aBuf[uBufNum], pDmaBuf, uBufLen);
             pDmaBuf += uBufLen;
@@ -600,4 +794,24 @@ static void busDrv_TxnDoneCb (TI_HANDLE hBusDrv, int iStatus)
 }
 
 
+#ifdef TI_DBG
+/** 
+ * \fn     busDrv_PrintStats
+ * \brief  Print the zero-copy statistics
+ * 
+ * \note   
+ * \param  hBusDrv - The module's object
+ * \return void
+ * \sa     
+ */ 
+void busDrv_PrintStats (TI_HANDLE hBusDrv)
+{
+    TBusDrvObj *pBusDrv = (TBusDrvObj*)hBusDrv;
 
+    WLAN_OS_REPORT(("BusDrv zero-copy %s:\n", pBusDrv->bZeroCopy ? "enabled" : "disabled"));
+    WLAN_OS_REPORT(("Zero-copy Txns = %d,  Partial Txns = %d,  Bounced Txns = %d\n", 
+                    pBusDrv->tStat.uZeroCopyTxns, pBusDrv->tStat.uPartialTxns, pBusDrv->tStat.uBounceTxns));
+    WLAN_OS_REPORT(("Zero-copy bytes = %d,  Bounced bytes = %d\n", 
+                    pBusDrv->tStat.uZeroCopyBytes, pBusDrv->tStat.uBounceBytes));
+}
+#endif /* TI_DBG */
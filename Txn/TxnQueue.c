@@ -788,6 +788,13 @@ void txnQ_PrintQueues (TI_HANDLE hTxnQ)
     que_Print(pTxnQ->aTxnQueues[TXN_FUNC_ID_WLAN][TXN_LOW_PRIORITY]);
     que_Print(pTxnQ->aTxnQueues[TXN_FUNC_ID_WLAN][TXN_HIGH_PRIORITY]);
 }
+
+void txnQ_PrintBusDrvStats (TI_HANDLE hTxnQ)
+{
+    TTxnQObj    *pTxnQ   = (TTxnQObj*)hTxnQ;
+
+    busDrv_PrintStats (pTxnQ->hBusDrv);
+}
 #endif /* TI_DBG */
 
 
@@ -266,6 +266,17 @@ void        txnQ_ClearQueues (TI_HANDLE hTxnQ, TI_UINT32 uFuncId);
  * \sa
  */ 
 void txnQ_PrintQueues (TI_HANDLE hTxnQ);
+/** \brief	Print Bus-Driver statistics
+ * 
+ * \param  hTxnQ - The module's object
+ * \return void
+ * 
+ * \par Description
+ * Print the bus driver statistics (e.g. SDIO zero-copy vs bounced transactions).
+ * 
+ * \sa
+ */ 
+void txnQ_PrintBusDrvStats (TI_HANDLE hTxnQ);
 #endif
 
 
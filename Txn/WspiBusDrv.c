@@ -352,6 +352,31 @@ static void asyncEnded_CB(TI_HANDLE hBusDrv, int status)
 }
 
 
+#ifdef TI_DBG
+/** 
+ * \fn     busDrv_PrintStats
+ * \brief  Print the bus driver statistics
+ * 
+ * The WSPI bus driver has no zero-copy, so print the current transaction state.
+ * 
+ * \note   
+ * \param  hBusDrv - The module's object
+ * \return void
+ * \sa     
+ */ 
+void busDrv_PrintStats (TI_HANDLE hBusDrv)
+{
+    TBusDrvObj *pBusDrv = (TBusDrvObj*)hBusDrv;
+
+    WLAN_OS_REPORT(("WSPI bus driver (no zero-copy):\n"));
+    WLAN_OS_REPORT(("Current Txn     = 0x%x\n", pBusDrv->pCurrTxn));
+    WLAN_OS_REPORT(("Txn status      = %d\n", pBusDrv->eCurrTxnStatus));
+    WLAN_OS_REPORT(("Txn bufs count  = %d\n", pBusDrv->uCurrTxnBufsCount));
+    WLAN_OS_REPORT(("Pending byte    = %d\n", pBusDrv->bPendingByte));
+}
+#endif /* TI_DBG */
+
+
 /****************************************************************************
  *                      ConnectDone_CB()
  ****************************************************************************
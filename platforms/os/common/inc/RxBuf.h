@@ -127,5 +127,60 @@ void  RxBufFree          (TI_HANDLE hOs, void* pBuf);
  */ 
 void  RxBufReserve       (TI_HANDLE hOs, void* pBuf, TI_UINT32 len); 
 
+
+/* Rx buffers recycle pool size classes */
+#define RX_BUF_POOL_CLASS_SMALL     0   /* Short frames (management, TCP ACKs) */
+#define RX_BUF_POOL_CLASS_MEDIUM    1   /* Frames up to the Ethernet MTU */
+#define RX_BUF_POOL_CLASS_LARGE     2   /* Up to the max Rx frame length (A-MSDU) */
+#define RX_BUF_POOL_NUM_CLASSES     3
+
+/**
+ * \brief Rx buffers recycle pool statistics (per size class)
+ */ 
+typedef struct
+{
+    TI_UINT32   aHits[RX_BUF_POOL_NUM_CLASSES];          /* Allocations served from the pool */
+    TI_UINT32   aMisses[RX_BUF_POOL_NUM_CLASSES];        /* Allocations served by the OS allocator since the pool was empty */
+    TI_UINT32   aRecycled[RX_BUF_POOL_NUM_CLASSES];      /* Freed buffers returned to the pool */
+    TI_UINT32   aRecycleOverflow[RX_BUF_POOL_NUM_CLASSES]; /* Freed buffers released since the pool was at its high watermark */
+    TI_UINT32   aRefilled[RX_BUF_POOL_NUM_CLASSES];      /* Buffers added by the deferred refill */
+    TI_UINT32   aFreeBufs[RX_BUF_POOL_NUM_CLASSES];      /* Current number of buffers in the pool */
+    TI_UINT32   aLowWatermark[RX_BUF_POOL_NUM_CLASSES];  /* Refill is scheduled below this number of buffers */
+    TI_UINT32   aHighWatermark[RX_BUF_POOL_NUM_CLASSES]; /* Refill and recycle stop at this number of buffers */
+    TI_UINT32   aBufLen[RX_BUF_POOL_NUM_CLASSES];        /* Max Rx frame length served by the class */
+    TI_UINT32   uOversize;          /* Allocations larger than the large class (never pooled) */
+    TI_UINT32   uNotRecyclable;     /* Freed buffers released since they were shared or too small */
+    TI_UINT32   uRefillRuns;        /* Number of deferred refill runs */
+    TI_UINT32   uRefillFailures;    /* Refill allocations failures */
+    TI_UINT32   uAllocFailures;     /* Rx allocation failures (pool empty and the OS allocator failed) */
+} TRxBufPoolStats;
+
+
+/** \brief Get Rx Buffers Pool Statistics
+ * 
+ * \param  hOs		- OS module object handle
+ * \param  pStats	- Pointer to the statistics structure to fill
+ * \return TI_OK on success, TI_NOK if the pool doesn't exist
+ * 
+ * \par Description
+ * This function copies the Rx buffers recycle pool counters and current occupancy.
+ * 
+ * \sa	RxBufPoolResetStats
+ */ 
+TI_STATUS RxBufPoolGetStats  (TI_HANDLE hOs, TRxBufPoolStats *pStats);
+
+
+/** \brief Reset Rx Buffers Pool Statistics
+ * 
+ * \param  hOs		- OS module object handle
+ * \return void
+ * 
+ * \par Description
+ * This function clears the Rx buffers recycle pool counters.
+ * 
+ * \sa	RxBufPoolGetStats
+ */ 
+void  RxBufPoolResetStats    (TI_HANDLE hOs);
+
 #endif
 
@@ -70,6 +70,29 @@ typedef struct
     TI_UINT8*      Data;
 } TI_CONNECTION_STATUS, *PTI_CONNECTION_STATUS;
 
+/* Rx batched delivery histograms bins: bin 0 counts 0, bin N counts [2^(N-1), 2^N), the last bin counts the rest */
+#define OS_RX_BATCH_HIST_BINS   8
+
+/** \struct TOsRxBatchStats
+ * \brief Rx batched delivery statistics
+ * 
+ * \par Description
+ * Rx packets of a bus burst are collected to a batch, which is delivered to the OS stack in polls.
+ * 
+ * \sa	os_GetRxBatchStats
+ */ 
+typedef struct
+{
+    TI_UINT32   uRxBatchBudget;                         /* Max packets per poll (0 = batching disabled) */
+    TI_UINT32   uBatches;                               /* Batches handed to the poll                   */
+    TI_UINT32   uPolls;                                 /* Poll invocations                             */
+    TI_UINT32   uBudgetExhausted;                       /* Polls that used their whole budget           */
+    TI_UINT32   uPackets;                               /* Packets delivered by the polls               */
+    TI_UINT32   uDropped;                               /* Batch packets dropped (interface down)       */
+    TI_UINT32   aPktsPerBatch[OS_RX_BATCH_HIST_BINS];   /* Histogram of packets per batch               */
+    TI_UINT32   aPktsPerPoll [OS_RX_BATCH_HIST_BINS];   /* Histogram of delivered packets per poll      */
+} TOsRxBatchStats;
+
 typedef struct 
 {
     TI_UINT8 	uFormat;
@@ -270,6 +293,33 @@ void os_memoryCopy (TI_HANDLE OsContext, void *pDestination, void *pSource, TI_U
  */
 void os_memoryFree (TI_HANDLE OsContext, void *pMemPtr, TI_UINT32 Size);
 
+/** \brief  OS Memory Barrier Acquire
+ * 
+ * \param  OsContext 	- Handle to the OS object
+ * \return void
+ * 
+ * \par Description
+ * This function orders a preceding read of a shared index before any following memory access,
+ * so data published by another CPU (see os_memoryBarrierRelease) is seen once the index is seen.
+ * Used by lock-free single-producer/single-consumer structures.
+ * 
+ * \sa	os_memoryBarrierRelease
+ */
+void os_memoryBarrierAcquire (TI_HANDLE OsContext);
+
+/** \brief  OS Memory Barrier Release
+ * 
+ * \param  OsContext 	- Handle to the OS object
+ * \return void
+ * 
+ * \par Description
+ * This function orders all preceding memory accesses before a following write of a shared index,
+ * so another CPU that reads the index (see os_memoryBarrierAcquire) also sees the data it covers.
+ * 
+ * \sa	os_memoryBarrierAcquire
+ */
+void os_memoryBarrierRelease (TI_HANDLE OsContext);
+
 /** \brief  OS Memory Compare
  * 
  * \param  OsContext 	- Handle to the OS object
@@ -445,6 +495,17 @@ void os_periodicIntrTimerStart (TI_HANDLE OsContext);
  */
 TI_UINT32 os_timeStampMs (TI_HANDLE OsContext);
 
+/** \brief  OS Monotonic Time Stamp Ms
+ * 
+ * \param  OsContext 	- Handle to the OS object
+ * \return A monotonic milliseconds counter
+ * 
+ * \par Description
+ * This function returns a milliseconds counter which is not affected by system time changes.	\n
+ * It should be used for measuring intervals (the counter wraps around at 2^32 msec).
+ */
+TI_UINT32 os_timeStampMonoMs (TI_HANDLE OsContext);
+
 /** \brief  OS Time Stamp Us
  * 
  * \param  OsContext 	- Handle to the OS object
@@ -482,7 +543,8 @@ void os_StalluSec (TI_HANDLE OsContext, TI_UINT32 uSec);
  * \par Description
  * This function allocates a mutex/spin lock object.
  * The mutex/spinlock object which is created by this function is used for mutual-exclusion and protection of resources which are shared between
- * multi-Tasks/Threads
+ * multi-Tasks/Threads	\n
+ * Each created object is a separate lock, so different objects may be nested (always in the same order).
  * 
  * \sa
  */
@@ -654,6 +716,25 @@ void os_hwWriteMemRegisterUINT32 (TI_HANDLE OsContext, TI_UINT32* Register, TI_U
  */
 TI_BOOL os_receivePacket(TI_HANDLE OsContext, void *pRxDesc ,void *pPacket, TI_UINT16 Length);
 
+/** \brief  OS Receive Sub-Packet
+ * 
+ * \param  OsContext 	- Handle to the OS object
+ * \param  pParentPacket - Pointer to the received Rx buffer containing the packet (e.g. an A-MSDU)
+ * \param  pEthData 	- Pointer to the packet data (in ethernet format) within the parent buffer
+ * \param  Length 		- Length of the packet
+ * \return TI_TRUE on Success	;	TI_FALSE on Failure (the packet was not passed to the OS)
+ * 
+ * \par Description
+ * This function transfers a packet from WLAN driver to OS without copy, sharing the 
+ * parent buffer data. The parent buffer is still freed by the driver, and its data is 
+ * released when the OS has consumed all the packets sharing it.	\n
+ * It fails if the buffer can't be shared, e.g. if the OS requires an aligned IP header 
+ * and the packet's IP header isn't aligned in place. The caller should copy the packet then.
+ * 
+ * \sa     os_receivePacket
+ */
+TI_BOOL os_receiveSubPacket (TI_HANDLE OsContext, void *pParentPacket, void *pEthData, TI_UINT16 Length);
+
 /** \brief  OS Indicate Event
  * 
  * \param  OsContext 	- Handle to the OS object
@@ -695,6 +776,51 @@ void os_Trace (TI_HANDLE OsContext, TI_UINT32 uLevel, TI_UINT32 uFileId, TI_UINT
  */
 void os_SetDrvThreadPriority (TI_HANDLE OsContext, TI_UINT32 uWlanDrvThreadPriority);
 
+/** 
+ * \fn     os_SetRxBatchBudget
+ * \brief  Called upon init to set the max Rx packets delivered to the OS stack per batch poll.
+ * 
+ * \param  OsContext      - The OS handle
+ * \param  uRxBatchBudget - Max Rx packets per poll (0 = deliver each packet separately)
+ * \return 
+ */
+void os_SetRxBatchBudget (TI_HANDLE OsContext, TI_UINT32 uRxBatchBudget);
+
+/** 
+ * \fn     os_GetRxBatchStats / os_ResetRxBatchStats
+ * \brief  Get / Reset the Rx batched delivery statistics (for debug).
+ * 
+ * \param  OsContext - The OS handle
+ * \param  pStats    - The returned statistics
+ * \return TI_OK, or TI_NOK if batched delivery is not supported by the OS
+ */
+TI_STATUS os_GetRxBatchStats   (TI_HANDLE OsContext, TOsRxBatchStats *pStats);
+void      os_ResetRxBatchStats (TI_HANDLE OsContext);
+
+/** 
+ * \fn     os_StatsPageCreate
+ * \brief  Allocate the statistics page shared with user space.
+ * 
+ * The page is zeroed, and exported to user space for read-only mapping or reading.
+ * 
+ * \param  OsContext - The OS handle
+ * \param  uSize     - The page size (sizeof(TStatsPage))
+ * \return Pointer to the page, or NULL if failed or not supported by the OS
+ * \sa     os_StatsPageDestroy
+ */
+void *os_StatsPageCreate (TI_HANDLE OsContext, TI_UINT32 uSize);
+
+/** 
+ * \fn     os_StatsPageDestroy
+ * \brief  Stop exporting and free the statistics page.
+ * 
+ * \param  OsContext - The OS handle
+ * \param  pPage     - The page returned by os_StatsPageCreate
+ * \return 
+ * \sa     os_StatsPageCreate
+ */
+void os_StatsPageDestroy (TI_HANDLE OsContext, void *pPage);
+
 
 #ifdef __cplusplus
 }
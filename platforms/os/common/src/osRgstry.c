@@ -133,6 +133,11 @@ NDIS_STRING STRTxCompleteTimeout            = NDIS_STRING_CONST( "TxCompleteTime
 NDIS_STRING STRRxInterruptThreshold         = NDIS_STRING_CONST( "RxInterruptThreshold" );
 NDIS_STRING STRRxInterruptTimeout           = NDIS_STRING_CONST( "RxInterruptTimeout" );
 
+NDIS_STRING STRFwEventPollHighThreshold     = NDIS_STRING_CONST( "FwEventPollHighThreshold" );
+NDIS_STRING STRFwEventPollLowThreshold      = NDIS_STRING_CONST( "FwEventPollLowThreshold" );
+NDIS_STRING STRFwEventPollInterval          = NDIS_STRING_CONST( "FwEventPollInterval" );
+NDIS_STRING STRFwEventPollWindow            = NDIS_STRING_CONST( "FwEventPollWindow" );
+
 NDIS_STRING STRRxAggregationPktsLimit       = NDIS_STRING_CONST( "RxAggregationPktsLimit" );
 NDIS_STRING STRTxAggregationPktsLimit       = NDIS_STRING_CONST( "TxAggregationPktsLimit" );
 
@@ -150,6 +155,15 @@ NDIS_STRING STRWiFiWmmPS                    = NDIS_STRING_CONST( "WiFiWmmPS" );
 NDIS_STRING STRWiFiMode                     = NDIS_STRING_CONST( "WiFiMode" );
 NDIS_STRING STRStopNetStackTx               = NDIS_STRING_CONST( "StopNetStackTx" );
 NDIS_STRING STRTxSendPaceThresh             = NDIS_STRING_CONST( "TxSendPaceThresh" );
+NDIS_STRING STRTxBurstScheduler             = NDIS_STRING_CONST( "TxBurstScheduler" );
+NDIS_STRING STRTxBurstMaxPkts               = NDIS_STRING_CONST( "TxBurstMaxPkts" );
+NDIS_STRING STRTxBurstQuantumBE             = NDIS_STRING_CONST( "TxBurstQuantumBE" );
+NDIS_STRING STRTxBurstQuantumBK             = NDIS_STRING_CONST( "TxBurstQuantumBK" );
+NDIS_STRING STRTxBurstQuantumVI             = NDIS_STRING_CONST( "TxBurstQuantumVI" );
+NDIS_STRING STRTxBurstQuantumVO             = NDIS_STRING_CONST( "TxBurstQuantumVO" );
+NDIS_STRING STRTxDataLockFree               = NDIS_STRING_CONST( "TxDataLockFree" );
+NDIS_STRING STRTxRingWakePercent            = NDIS_STRING_CONST( "TxRingWakePercent" );
+NDIS_STRING STRTxHdrCacheEnable             = NDIS_STRING_CONST( "TxHdrCacheEnable" );
 NDIS_STRING STRdot11DesiredChannel          = NDIS_STRING_CONST( "dot11DesiredChannel");
 NDIS_STRING STRdot11DesiredSSID             = NDIS_STRING_CONST( "dot11DesiredSSID" );
 NDIS_STRING STRdot11DesiredBSSType          = NDIS_STRING_CONST( "dot11DesiredBSSType" );
@@ -456,6 +470,8 @@ NDIS_STRING STRBaInactivityTimeoutTid_4         = NDIS_STRING_CONST("BaInactivit
 NDIS_STRING STRBaInactivityTimeoutTid_5         = NDIS_STRING_CONST("BaInactivityTimeoutTid_5");
 NDIS_STRING STRBaInactivityTimeoutTid_6         = NDIS_STRING_CONST("BaInactivityTimeoutTid_6");
 NDIS_STRING STRBaInactivityTimeoutTid_7         = NDIS_STRING_CONST("BaInactivityTimeoutTid_7");
+NDIS_STRING STRBaRxWinSize                      = NDIS_STRING_CONST("BaRxWinSize");
+NDIS_STRING STRBaRxReorderTimeout               = NDIS_STRING_CONST("BaRxReorderTimeout");
 
 
 /* HW Tx queues mem-blocks allocation thresholds */
@@ -473,6 +489,8 @@ NDIS_STRING STRTrafficIntensityThresLow         = NDIS_STRING_CONST("TrafficInte
 NDIS_STRING STRTrafficIntensityTestInterval     = NDIS_STRING_CONST("TrafficIntensityTestInterval");
 NDIS_STRING STRTrafficIntensityThresholdEnabled = NDIS_STRING_CONST("TrafficIntensityThresholdEnabled");
 NDIS_STRING STRTrafficMonitorMinIntervalPercentage = NDIS_STRING_CONST("TrafficMonitorMinIntervalPercent");
+NDIS_STRING STRTrafficMonitorEvalTickMs = NDIS_STRING_CONST("TrafficMonitorEvalTickMs");
+NDIS_STRING STRTrafficMonitorEvalBurst = NDIS_STRING_CONST("TrafficMonitorEvalBurst");
 
 
 /* Packet Burst parameters */
@@ -677,6 +695,7 @@ NDIS_STRING STRDfsPassiveDwellTimeMs             = NDIS_STRING_CONST( "DfsPassiv
 NDIS_STRING STRScanPushMode                      = NDIS_STRING_CONST( "ScanPushMode" );
 
 NDIS_STRING STRParseWSCInBeacons      = NDIS_STRING_CONST( "ParseWSCInBeacons" );
+NDIS_STRING STRBeaconCacheMaxHits     = NDIS_STRING_CONST( "BeaconCacheMaxHits" );
 
 /*-----------------------------------*/
 /*      Current BSS parameters       */
@@ -687,6 +706,8 @@ NDIS_STRING STRNullDataKeepAliveDefaultPeriod  = NDIS_STRING_CONST("NullDataKeep
 /*      Context-Engine parameters    */
 /*-----------------------------------*/
 NDIS_STRING STRContextSwitchRequired  = NDIS_STRING_CONST("ContextSwitchRequired");
+NDIS_STRING STRContextTaskBudget      = NDIS_STRING_CONST("ContextTaskBudget");
+NDIS_STRING STRTimerTickMsec          = NDIS_STRING_CONST("TimerTickMsec");
 
 /*-----------------------------------*/
 /*      Radio parameters             */
@@ -743,6 +764,9 @@ NDIS_STRING STRSettings = 							NDIS_STRING_CONST("Settings");
 NDIS_STRING STRWlanDrvThreadPriority = NDIS_STRING_CONST("WlanDrvThreadPriority");
 NDIS_STRING STRBusDrvThreadPriority  = NDIS_STRING_CONST("BusDrvThreadPriority");
 NDIS_STRING STRSdioBlkSizeShift      = NDIS_STRING_CONST("SdioBlkSizeShift");
+NDIS_STRING STRSdioZeroCopy          = NDIS_STRING_CONST("SdioZeroCopy");
+NDIS_STRING STRRxBatchBudget         = NDIS_STRING_CONST("RxBatchBudget");
+NDIS_STRING STRStatsPagePublishPeriod = NDIS_STRING_CONST("StatsPagePublishPeriod");
 
 
 /*-----------------------------------*/
@@ -1571,6 +1595,30 @@ regFillInitTable(
                             sizeof p->twdInitParams.tGeneral.RxIntrPacingTimeout, 
                             (TI_UINT8*)&(p->twdInitParams.tGeneral.RxIntrPacingTimeout));
 
+    regReadIntegerParameter(pAdapter, &STRFwEventPollHighThreshold,
+                            TWD_FW_EVENT_POLL_HIGH_THRESHOLD_DEF, TWD_FW_EVENT_POLL_HIGH_THRESHOLD_MIN,
+                            TWD_FW_EVENT_POLL_HIGH_THRESHOLD_MAX,
+                            sizeof p->twdInitParams.tGeneral.uFwEventPollHighThreshold, 
+                            (TI_UINT8*)&(p->twdInitParams.tGeneral.uFwEventPollHighThreshold));
+
+    regReadIntegerParameter(pAdapter, &STRFwEventPollLowThreshold,
+                            TWD_FW_EVENT_POLL_LOW_THRESHOLD_DEF, TWD_FW_EVENT_POLL_LOW_THRESHOLD_MIN,
+                            TWD_FW_EVENT_POLL_LOW_THRESHOLD_MAX,
+                            sizeof p->twdInitParams.tGeneral.uFwEventPollLowThreshold, 
+                            (TI_UINT8*)&(p->twdInitParams.tGeneral.uFwEventPollLowThreshold));
+
+    regReadIntegerParameter(pAdapter, &STRFwEventPollInterval,
+                            TWD_FW_EVENT_POLL_INTERVAL_DEF, TWD_FW_EVENT_POLL_INTERVAL_MIN,
+                            TWD_FW_EVENT_POLL_INTERVAL_MAX,
+                            sizeof p->twdInitParams.tGeneral.uFwEventPollInterval, 
+                            (TI_UINT8*)&(p->twdInitParams.tGeneral.uFwEventPollInterval));
+
+    regReadIntegerParameter(pAdapter, &STRFwEventPollWindow,
+                            TWD_FW_EVENT_POLL_WINDOW_DEF, TWD_FW_EVENT_POLL_WINDOW_MIN,
+                            TWD_FW_EVENT_POLL_WINDOW_MAX,
+                            sizeof p->twdInitParams.tGeneral.uFwEventPollWindow, 
+                            (TI_UINT8*)&(p->twdInitParams.tGeneral.uFwEventPollWindow));
+
 
     regReadIntegerParameter(pAdapter, &STRRxAggregationPktsLimit,
                             TWD_RX_AGGREG_PKTS_LIMIT_DEF, TWD_RX_AGGREG_PKTS_LIMIT_MIN,
@@ -3398,6 +3446,20 @@ regReadIntegerParameter(pAdapter, &STRSettings,
                             sizeof p->trafficMonitorMinIntervalPercentage,
                             (TI_UINT8*)&p->trafficMonitorMinIntervalPercentage);
 
+    regReadIntegerParameter(pAdapter, &STRTrafficMonitorEvalTickMs, 
+                            TRAFFIC_MONITOR_EVAL_TICK_MS_DEF, 
+                            TRAFFIC_MONITOR_EVAL_TICK_MS_MIN, 
+                            TRAFFIC_MONITOR_EVAL_TICK_MS_MAX, 
+                            sizeof p->tTrafficMonitorInitParams.uEvalTickMs,
+                            (TI_UINT8*)&p->tTrafficMonitorInitParams.uEvalTickMs);
+
+    regReadIntegerParameter(pAdapter, &STRTrafficMonitorEvalBurst, 
+                            TRAFFIC_MONITOR_EVAL_BURST_DEF, 
+                            TRAFFIC_MONITOR_EVAL_BURST_MIN, 
+                            TRAFFIC_MONITOR_EVAL_BURST_MAX, 
+                            sizeof p->tTrafficMonitorInitParams.uEvalBurst,
+                            (TI_UINT8*)&p->tTrafficMonitorInitParams.uEvalBurst);
+
     regReadIntegerParameter(pAdapter, &STRWMEEnable,
                             WME_ENABLED_DEF, WME_ENABLED_MIN,
                             WME_ENABLED_MAX,
@@ -3535,6 +3597,60 @@ regReadIntegerParameter(pAdapter, &STRSettings,
 							sizeof p->txDataInitParams.uTxSendPaceThresh,
                             (TI_UINT8*)&p->txDataInitParams.uTxSendPaceThresh);
 
+	regReadIntegerParameter(pAdapter, &STRTxBurstScheduler,
+                            TX_BURST_SCHED_DEF, TX_BURST_SCHED_MIN,
+                            TX_BURST_SCHED_MAX,
+							sizeof p->txDataInitParams.bTxBurstSched,
+                            (TI_UINT8*)&p->txDataInitParams.bTxBurstSched);
+
+	regReadIntegerParameter(pAdapter, &STRTxBurstMaxPkts,
+                            TX_BURST_MAX_PKTS_DEF, TX_BURST_MAX_PKTS_MIN,
+                            TX_BURST_MAX_PKTS_MAX,
+							sizeof p->txDataInitParams.uTxBurstMaxPkts,
+                            (TI_UINT8*)&p->txDataInitParams.uTxBurstMaxPkts);
+
+	regReadIntegerParameter(pAdapter, &STRTxBurstQuantumBE,
+                            TX_BURST_QUANTUM_BE_DEF, TX_BURST_QUANTUM_MIN,
+                            TX_BURST_QUANTUM_MAX,
+							sizeof p->txDataInitParams.aTxBurstQuantum[QOS_AC_BE],
+                            (TI_UINT8*)&p->txDataInitParams.aTxBurstQuantum[QOS_AC_BE]);
+
+	regReadIntegerParameter(pAdapter, &STRTxBurstQuantumBK,
+                            TX_BURST_QUANTUM_BK_DEF, TX_BURST_QUANTUM_MIN,
+                            TX_BURST_QUANTUM_MAX,
+							sizeof p->txDataInitParams.aTxBurstQuantum[QOS_AC_BK],
+                            (TI_UINT8*)&p->txDataInitParams.aTxBurstQuantum[QOS_AC_BK]);
+
+	regReadIntegerParameter(pAdapter, &STRTxBurstQuantumVI,
+                            TX_BURST_QUANTUM_VI_DEF, TX_BURST_QUANTUM_MIN,
+                            TX_BURST_QUANTUM_MAX,
+							sizeof p->txDataInitParams.aTxBurstQuantum[QOS_AC_VI],
+                            (TI_UINT8*)&p->txDataInitParams.aTxBurstQuantum[QOS_AC_VI]);
+
+	regReadIntegerParameter(pAdapter, &STRTxBurstQuantumVO,
+                            TX_BURST_QUANTUM_VO_DEF, TX_BURST_QUANTUM_MIN,
+                            TX_BURST_QUANTUM_MAX,
+							sizeof p->txDataInitParams.aTxBurstQuantum[QOS_AC_VO],
+                            (TI_UINT8*)&p->txDataInitParams.aTxBurstQuantum[QOS_AC_VO]);
+
+	regReadIntegerParameter(pAdapter, &STRTxDataLockFree,
+                            TX_DATA_LOCK_FREE_DEF, TX_DATA_LOCK_FREE_MIN,
+                            TX_DATA_LOCK_FREE_MAX,
+							sizeof p->txDataInitParams.bTxLockFree,
+                            (TI_UINT8*)&p->txDataInitParams.bTxLockFree);
+
+	regReadIntegerParameter(pAdapter, &STRTxRingWakePercent,
+                            TX_RING_WAKE_PERCENT_DEF, TX_RING_WAKE_PERCENT_MIN,
+                            TX_RING_WAKE_PERCENT_MAX,
+							sizeof p->txDataInitParams.uTxRingWakePercent,
+                            (TI_UINT8*)&p->txDataInitParams.uTxRingWakePercent);
+
+	regReadIntegerParameter(pAdapter, &STRTxHdrCacheEnable,
+                            TX_HDR_CACHE_ENABLE_DEF, TX_HDR_CACHE_ENABLE_MIN,
+                            TX_HDR_CACHE_ENABLE_MAX,
+							sizeof p->txDataInitParams.bHdrCacheEnabled,
+                            (TI_UINT8*)&p->txDataInitParams.bHdrCacheEnabled);
+
 
     /* special numbers for WiFi mode! */
     if (uWiFiMode)
@@ -3860,6 +3976,11 @@ regReadIntegerParameter(pAdapter, &STRSettings,
                              sizeof p->tMlmeInitParams.parseWSCInBeacons,
                              (TI_UINT8*)&p->tMlmeInitParams.parseWSCInBeacons );
 
+    regReadIntegerParameter( pAdapter, &STRBeaconCacheMaxHits,
+                             MLME_BEACON_CACHE_MAX_HITS_DEF, MLME_BEACON_CACHE_MAX_HITS_MIN, MLME_BEACON_CACHE_MAX_HITS_MAX,
+                             sizeof p->tMlmeInitParams.uBeaconCacheMaxHits,
+                             (TI_UINT8*)&p->tMlmeInitParams.uBeaconCacheMaxHits );
+
 /*----------------------------------
  Current BSS
 ------------------------------------*/
@@ -3876,6 +3997,19 @@ regReadIntegerParameter(pAdapter, &STRSettings,
                              sizeof p->tContextInitParams.bContextSwitchRequired,
                              (TI_UINT8*)&p->tContextInitParams.bContextSwitchRequired );
 
+    regReadIntegerParameter( pAdapter, &STRContextTaskBudget,
+                             CONTEXT_TASK_BUDGET_DEF, CONTEXT_TASK_BUDGET_MIN, CONTEXT_TASK_BUDGET_MAX,
+                             sizeof p->tContextInitParams.uTaskBudget,
+                             (TI_UINT8*)&p->tContextInitParams.uTaskBudget );
+
+/*----------------------------------
+ Timer module
+------------------------------------*/
+    regReadIntegerParameter( pAdapter, &STRTimerTickMsec,
+                             TIMER_TICK_MSEC_DEF, TIMER_TICK_MSEC_MIN, TIMER_TICK_MSEC_MAX,
+                             sizeof p->tTimerInitParams.uTickMsec,
+                             (TI_UINT8*)&p->tTimerInitParams.uTickMsec );
+
     /*
      *  set 802.11n init parameters
     */
@@ -3981,6 +4115,18 @@ regReadIntegerParameter(pAdapter, &STRSettings,
                             sizeof p->qosMngrInitParams.aBaInactivityTimeout[7],
                             (TI_UINT8*)&p->qosMngrInitParams.aBaInactivityTimeout[7]);
 
+    regReadIntegerParameter(pAdapter, &STRBaRxWinSize,
+                            HT_BA_RX_WIN_SIZE_DEF, HT_BA_RX_WIN_SIZE_MIN,
+                            HT_BA_RX_WIN_SIZE_MAX,
+                            sizeof p->qosMngrInitParams.uBaRxWinSize,
+                            (TI_UINT8*)&p->qosMngrInitParams.uBaRxWinSize);
+
+    regReadIntegerParameter(pAdapter, &STRBaRxReorderTimeout,
+                            HT_BA_RX_REORDER_TIMEOUT_DEF, HT_BA_RX_REORDER_TIMEOUT_MIN,
+                            HT_BA_RX_REORDER_TIMEOUT_MAX,
+                            sizeof p->twdInitParams.tGeneral.uRxBaReorderTimeout,
+                            (TI_UINT8*)&p->twdInitParams.tGeneral.uRxBaReorderTimeout);
+
 /*----------------------------------
  Radio module parameters
 ------------------------------------*/
@@ -4158,6 +4304,21 @@ regReadIntegerParameter(pAdapter, &STRSingle_Dual_Band_Solution,
                              sizeof p->tDrvMainParams.uSdioBlkSizeShift,
                              (TI_UINT8*)&p->tDrvMainParams.uSdioBlkSizeShift);
 
+    regReadIntegerParameter( pAdapter, &STRSdioZeroCopy,
+                             SDIO_ZERO_COPY_DEF, SDIO_ZERO_COPY_MIN, SDIO_ZERO_COPY_MAX,
+                             sizeof p->tDrvMainParams.bSdioZeroCopy,
+                             (TI_UINT8*)&p->tDrvMainParams.bSdioZeroCopy);
+
+    regReadIntegerParameter( pAdapter, &STRRxBatchBudget,
+                             RX_BATCH_BUDGET_DEF, RX_BATCH_BUDGET_MIN, RX_BATCH_BUDGET_MAX,
+                             sizeof p->tDrvMainParams.uRxBatchBudget,
+                             (TI_UINT8*)&p->tDrvMainParams.uRxBatchBudget);
+
+    regReadIntegerParameter( pAdapter, &STRStatsPagePublishPeriod,
+                             STATS_PAGE_PUBLISH_PERIOD_DEF, STATS_PAGE_PUBLISH_PERIOD_MIN, STATS_PAGE_PUBLISH_PERIOD_MAX,
+                             sizeof p->tStatsPageInitParams.uPublishPeriodMs,
+                             (TI_UINT8*)&p->tStatsPageInitParams.uPublishPeriodMs);
+
 
 
 /*-----------------------------------*/
@@ -59,10 +59,16 @@ typedef struct
     TConfigCommand         *pAsyncCmd;       /* Pointer to the command currently being processed */
     void                   *pAllocatedBuffer;
     TI_UINT32              AllocatedBufferSize;
+    OS_802_11_BSSID_LIST_EX *pBssidList;         /* Cached scan results, refreshed with the changed entries only */
+    TI_UINT32              uBssidListSize;      /* Allocated size of the cached scan results */
+    TI_UINT32              uBssidListGeneration;/* Scan result table generation of the cached scan results */
 } cmdInterpret_t;
 
 #define WLAN_PROTOCOL_NAME    "IEEE 802.11ABG"
 
+/* Internal command code of a batch of TI private commands (param3 is a kernel ti_private_cmd_batch_t) */
+#define TI_PRIVATE_CMD_BATCH  (SIOCIWFIRSTPRIV + 0x10)
+
 typedef enum _TIWLAN_KEY_FLAGS
 {
 	TIWLAN_KEY_FLAGS_TRANSMIT		= 0x80000000,           /* Used whenever key should be immidiately used for TX */
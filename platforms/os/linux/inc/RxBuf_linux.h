@@ -41,6 +41,8 @@
 #ifndef _BUF_LINUX_H_
 #define _BUF_LINUX_H_
 
+#include <linux/skbuff.h>
+#include <linux/workqueue.h>
 #include "RxBuf.h"
 typedef struct _rx_head_
 {
@@ -49,5 +51,42 @@ typedef struct _rx_head_
 
 #define RX_HEAD_LEN_ALIGNED ((sizeof(rx_head_t) + 0x3) & ~0x3)
 
+/* Bytes added to the requested length in each Rx skb */
+#define RX_BUF_OVERHEAD     (WSPI_PAD_BYTES + PAYLOAD_ALIGN_PAD_BYTES + RX_HEAD_LEN_ALIGNED)
+
+/* Rx recycle pool size classes (frame length including the Rx descriptor) */
+#define RX_BUF_POOL_SMALL_LEN       512
+#define RX_BUF_POOL_MEDIUM_LEN      1664    /* MTU MPDU + Rx descriptor, so with the skb overhead it fits a 2KB slab */
+#define RX_BUF_POOL_LARGE_LEN       4096    /* Max A-MSDU (3839) + Rx descriptor and MAC/security headers */
+
+/* Rx recycle pool watermarks (number of buffers per class) */
+#define RX_BUF_POOL_SMALL_LOW       16
+#define RX_BUF_POOL_SMALL_HIGH      64
+#define RX_BUF_POOL_MEDIUM_LOW      16
+#define RX_BUF_POOL_MEDIUM_HIGH     48
+#define RX_BUF_POOL_LARGE_LOW       2
+#define RX_BUF_POOL_LARGE_HIGH      8
+
+/* Rx recycle pool size class */
+typedef struct
+{
+    struct sk_buff_head  tFreeList;       /* The free buffers (has its own spinlock) */
+    TI_UINT32            uBufLen;         /* Max frame length served by this class */
+    TI_UINT32            uAllocLen;       /* The skb allocation length */
+    TI_UINT32            uLowWatermark;   /* Refill is scheduled below this number of buffers */
+    TI_UINT32            uHighWatermark;  /* Refill and recycle stop at this number of buffers */
+} TRxBufPoolClass;
+
+/* Rx recycle pool object */
+typedef struct
+{
+    TRxBufPoolClass      aClass[RX_BUF_POOL_NUM_CLASSES];
+    struct work_struct   tRefillWork;     /* Deferred refill (may sleep) */
+    TRxBufPoolStats      tStats;
+} TRxBufPool;
+
+TI_HANDLE RxBufPoolCreate  (TI_HANDLE hOs);
+void      RxBufPoolDestroy (TI_HANDLE hRxBufPool);
+
 #endif
 
@@ -58,6 +58,7 @@
 #endif
 #endif
 #include "tidef.h"
+#include "osApi.h"
 #include "WlanDrvCommon.h"
 #include "paramOut.h"
 #include "DrvMain.h"
@@ -89,6 +90,16 @@
 
 #define ti_nodprintf(log, fmt, args...)
 
+/* Rx packets are delivered to the network stack in batches through NAPI and GRO */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,29)
+#define TI_RX_NAPI
+#endif
+
+/* The interface has a Tx subqueue per AC, selected by the driver classifier and stopped/resumed separately */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,29)
+#define TI_TX_MULTI_QUEUE
+#endif
+
 typedef enum 
 {
    TIWLAN_LOG_ERROR,
@@ -119,6 +130,14 @@ typedef struct
     spinlock_t               lock;      /* The OS spinlock handle. */
     unsigned long            flags;     /* For saving the cpu flags during spinlock */
     TI_HANDLE                hPollTimer;/* Polling timer for working without interrupts (debug) */
+    TI_HANDLE                hRxBufPool;/* Rx buffers recycle pool (NULL if not available) */
+#ifdef TI_RX_NAPI
+    struct napi_struct       tRxNapi;       /* NAPI context delivering the Rx batches */
+    struct sk_buff_head      tRxNapiQueue;  /* Rx packets handed to the NAPI poll */
+    struct sk_buff_head      tRxBatch;      /* Rx packets of the current burst (driver task only) */
+    TI_UINT32                uRxBatchBudget;/* Max Rx packets per NAPI poll (0 = no batching) */
+    TOsRxBatchStats          tRxBatchStats; /* Rx batched delivery statistics */
+#endif
     struct net_device_stats  stats;     /* The driver's statistics for OS reports. */
     struct sock             *wl_sock;   /* The OS socket used for sending it the driver events */
     struct net_device       *netdev;    /* The OS handle for the driver interface. */
@@ -135,4 +154,9 @@ typedef struct
 
 #define NETDEV(drv) (((TWlanDrvIfObj*)(drv))->netdev)
 
+#ifdef TI_RX_NAPI
+int  os_RxBatchPoll  (struct napi_struct *napi, int budget);
+void os_RxBatchFlush (TWlanDrvIfObj *drv);
+#endif
+
 #endif /* WLAN_DRV_IF_H*/
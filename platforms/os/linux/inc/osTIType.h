@@ -44,6 +44,7 @@
 
 #ifdef __KERNEL__
 #include <linux/compiler.h>	/* likely()/unlikely() */
+#include <linux/cache.h>	/* L1_CACHE_BYTES */
 #endif
 
 typedef char                TI_CHAR;
@@ -55,6 +56,7 @@ typedef signed int          TI_INT32;
 typedef unsigned int        TI_UINT32;
 typedef signed long long    TI_INT64;
 typedef unsigned long long  TI_UINT64;
+typedef unsigned long       TI_UINTPTR;     /* Integer type of the pointers width */
 
 #define TI_CONST64(x)       (x##LL)
 
@@ -63,6 +65,13 @@ typedef unsigned long long  TI_UINT64;
 
 #define INLINE              inline
 
+/* The host cache line size (DMA buffers not aligned to it share lines with other data) */
+#ifdef __KERNEL__
+#define TI_CACHE_LINE_SIZE  L1_CACHE_BYTES
+#else
+#define TI_CACHE_LINE_SIZE  64
+#endif
+
 #endif /* __OSTITYPE_H__*/
 
 
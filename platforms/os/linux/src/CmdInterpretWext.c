@@ -63,6 +63,8 @@ static TI_INT32 cmdInterpret_Event(IPC_EV_DATA* pData);
 static int cmdInterpret_setSecurityParams (TI_HANDLE hCmdInterpret);
 static int cmdInterpret_initEvents(TI_HANDLE hCmdInterpret);
 static int cmdInterpret_unregisterEvents(TI_HANDLE hCmdInterpret, TI_HANDLE hEvHandler);
+static TI_STATUS cmdInterpret_updateBssidList (cmdInterpret_t *pCmdInterpret, paramInfo_t *pParam);
+static TI_STATUS cmdInterpret_PrivateCmd (cmdInterpret_t *pCmdInterpret, TConfigCommand *cmdObj, ti_private_cmd_t *my_command, paramInfo_t *pParam);
 
 #define CHECK_PENDING_RESULT(x,y)                   if (x == COMMAND_PENDING) { os_printf ("Unexpected COMMAND PENDING result (cmd = 0x%x)\n",y.paramType);  break; }
 #define CHECK_PENDING_RESULT_RET(x,y)                   if (x == COMMAND_PENDING) { os_printf ("Unexpected COMMAND PENDING result (cmd = 0x%x)\n",y.paramType);  return NULL; }
@@ -84,6 +86,17 @@ typedef struct
 #define CCKM_START_EVENT_SIZE     23 /* cckm-start string + timestamp + bssid + null */
 #endif
 
+/* BSSID hash index of the changed scan entries, used when merging them into the cached list */
+#define BSSID_INDEX_HASH_SIZE     64
+#define BSSID_INDEX_HASH(mac)     (((mac)[3] ^ (mac)[4] ^ (mac)[5]) & (BSSID_INDEX_HASH_SIZE - 1))
+#define BSSID_INDEX_END           0xFFFF
+
+typedef struct
+{
+    OS_802_11_BSSID_EX  *pBssid;
+    TI_UINT16           uNext;      /* Next entry in the same hash bucket */
+} TBssidIndexEntry;
+
 /* Initialize the CmdInterpreter module */
 TI_HANDLE cmdInterpret_Create (TI_HANDLE hOs)
 {
@@ -118,6 +131,12 @@ TI_STATUS cmdInterpret_Destroy (TI_HANDLE hCmdInterpret, TI_HANDLE hEvHandler)
     /* Unregister events */
 	cmdInterpret_unregisterEvents ((TI_HANDLE)pCmdInterpret, hEvHandler);
 
+    /* Release the cached scan results */
+    if (pCmdInterpret->pBssidList)
+    {
+        os_memoryFree (pCmdInterpret->hOs, pCmdInterpret->pBssidList, pCmdInterpret->uBssidListSize);
+    }
+
     /* Release allocated memory */
     os_memoryFree (pCmdInterpret->hOs, pCmdInterpret, sizeof(cmdInterpret_t));
 
@@ -592,7 +611,6 @@ int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdO
             unsigned char buf[200];
             struct iw_event iwe;
             char *end_buf,*current_val;
-            int allocated_size;
             OS_802_11_BSSID_LIST_EX *my_list;
             OS_802_11_BSSID_EX *my_current;
             int offset;
@@ -604,23 +622,15 @@ int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdO
 #endif
             end_buf = (char *)(cmdObj->buffer2 + wrqu->data.length);
 
-            /* First get the amount of memory required to hold the entire BSSID list by setting the length to 0 */
-            Param.paramType = SCAN_CNCN_BSSID_LIST_SIZE_PARAM;
-            Param.paramLength = 0;
-            res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, &Param );
+            /* Bring the cached BSSID list up to date, retrieving only the entries changed since the last read */
+            res = cmdInterpret_updateBssidList (pCmdInterpret, &Param);
             CHECK_PENDING_RESULT(res,Param)
+            if ((res != TI_OK) || (pCmdInterpret->pBssidList == NULL))
+            {
+                break;
+            }
 
-            allocated_size = Param.content.uBssidListSize;
-
-            /* Allocate required memory */
-            my_list = os_memoryAlloc (pCmdInterpret->hOs, allocated_size);
-
-            /* And retrieve the list */
-            Param.paramType = SCAN_CNCN_BSSID_LIST_PARAM;
-            Param.content.pBssidList = my_list;
-            Param.paramLength = allocated_size;
-            res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, &Param );
-            CHECK_PENDING_RESULT(res,Param)
+            my_list = pCmdInterpret->pBssidList;
 
             my_current = &my_list->Bssid[0];
             i=0;
@@ -794,7 +804,6 @@ int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdO
                 wrqu->data.flags = i;
             }
 
-            os_memoryFree (pCmdInterpret->hOs, my_list, allocated_size);
             cmdObj->return_code = WEXT_OK;
         }
 
@@ -1297,108 +1306,30 @@ int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdO
         break;
 
     case SIOCIWFIRSTPRIV:
+        res = cmdInterpret_PrivateCmd (pCmdInterpret, cmdObj, (ti_private_cmd_t *)cmdObj->param3, &Param);
+        if (res == EXTERNAL_GET_PARAM_DENIED)
         {
-            ti_private_cmd_t *my_command = (ti_private_cmd_t *)cmdObj->param3;
-
-            /*
-            os_printf ("cmd =  0x%x     flags = 0x%x\n",(unsigned int)my_command->cmd,(unsigned int)my_command->flags);
-            os_printf ("in_buffer =  0x%x (len = %d)\n",my_command->in_buffer,(unsigned int)my_command->in_buffer_len);
-            os_printf ("out_buffer =  0x%x (len = %d)\n",my_command->out_buffer,(unsigned int)my_command->out_buffer_len);
-            */
-           
-            Param.paramType = my_command->cmd;
-
-            if (IS_PARAM_ASYNC(my_command->cmd))
-            {
-
-                /* os_printf ("Detected ASYNC command - setting CB \n"); */
-                Param.content.interogateCmdCBParams.hCb  =  (TI_HANDLE)pCmdInterpret;
-                Param.content.interogateCmdCBParams.fCb  =  (void*)cmdInterpret_ServiceCompleteCB;
-                Param.content.interogateCmdCBParams.pCb  =  my_command->out_buffer;
-                if (my_command->out_buffer) 
-                {
-                    /* the next copy is need for PLT commands */
-                    os_memoryCopy(pCmdInterpret->hOs,  my_command->out_buffer, my_command->in_buffer, min(my_command->in_buffer_len,my_command->out_buffer_len));
-                }
-            }
-            else if ((my_command->in_buffer) && (my_command->in_buffer_len))
-            {
-
-                /*
-                this cmd doesnt have the structure allocated as part of the paramInfo_t structure.
-                as a result we need to allocate the memory internally.
-                */
-                if(IS_ALLOC_NEEDED_PARAM(my_command->cmd))
-                {
-                   
-                    *(void**)&Param.content = os_memoryAlloc(pCmdInterpret->hOs, my_command->in_buffer_len);
-                    os_memoryCopy(pCmdInterpret->hOs, *(void**)&Param.content, my_command->in_buffer, my_command->in_buffer_len);
-                }
-                else
-                    os_memoryCopy(pCmdInterpret->hOs,&Param.content,my_command->in_buffer,my_command->in_buffer_len);
-            }
+            return res;
+        }
+        break;
 
-            if (my_command->flags & PRIVATE_CMD_SET_FLAG)
-            {
-                Param.paramLength = my_command->in_buffer_len;
-                res = cmdDispatch_SetParam (pCmdInterpret->hCmdDispatch,&Param);                
-            } 
-            else if (my_command->flags & PRIVATE_CMD_GET_FLAG)
-            {
-                
-                /* os_printf ("Calling getParam\n"); */
-                Param.paramLength = my_command->out_buffer_len;
-                res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch,&Param);
-                if(res == EXTERNAL_GET_PARAM_DENIED)
-                {
-                    cmdObj->return_code  = WEXT_INVALID_PARAMETER;
-                    return res;
-                }
+    case TI_PRIVATE_CMD_BATCH:
+        {
+            ti_private_cmd_batch_t *pBatch = (ti_private_cmd_batch_t *)cmdObj->param3;
 
-                /* 
-                this is for cmd that want to check the size of memory that they need to 
-                allocate for the actual data.
-                */
-                if(Param.paramLength && (my_command->out_buffer_len == 0))
-                {
-                   my_command->out_buffer_len = Param.paramLength;  
-                }
-            }
-            else
+            /* Execute all batch commands back to back in this driver context */
+            for (i = 0; i < (int)pBatch->uNumCmds; i++)
             {
-                 res = TI_NOK;
-            }
-
-            if (res == TI_OK)
-                {
-                 if(IS_PARAM_ASYNC(my_command->cmd))
+                /* Async commands are completed in a later context so they can't be batched */
+                if (IS_PARAM_ASYNC(pBatch->pCmds[i].cmd))
                 {
-                    pCmdInterpret->pAsyncCmd = cmdObj; /* Save command handle for completion CB */
-                    res = COMMAND_PENDING;
+                    pBatch->pResults[i] = TI_NOK;
+                    continue;
                 }
-                else
-                {
-                    if ((my_command->out_buffer) && (my_command->out_buffer_len))
-                    {
-                        if(IS_ALLOC_NEEDED_PARAM(my_command->cmd))
-                        {
-                            os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,*(void**)&Param.content,my_command->out_buffer_len);
-                        }
-                        else
-                        {
-                            os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,&Param.content,my_command->out_buffer_len);
-                        }                   
-                    }               
-                }
-            }
-
-            /* need to free the allocated memory */
-            if(IS_ALLOC_NEEDED_PARAM(my_command->cmd))
-            {
-               os_memoryFree(pCmdInterpret->hOs, *(void**)&Param.content, my_command->in_buffer_len);               
+                pBatch->pResults[i] = cmdInterpret_PrivateCmd (pCmdInterpret, cmdObj, &pBatch->pCmds[i], &Param);
             }
+            res = TI_OK;
         }
-
         break;
  
     default:
@@ -1419,6 +1350,113 @@ int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdO
 }
 
 
+/* Execute a TI private command (set or get param), used for single and batched private commands */
+static TI_STATUS cmdInterpret_PrivateCmd (cmdInterpret_t *pCmdInterpret, TConfigCommand *cmdObj, ti_private_cmd_t *my_command, paramInfo_t *pParam)
+{
+    TI_STATUS res;
+
+    /*
+    os_printf ("cmd =  0x%x     flags = 0x%x\n",(unsigned int)my_command->cmd,(unsigned int)my_command->flags);
+    os_printf ("in_buffer =  0x%x (len = %d)\n",my_command->in_buffer,(unsigned int)my_command->in_buffer_len);
+    os_printf ("out_buffer =  0x%x (len = %d)\n",my_command->out_buffer,(unsigned int)my_command->out_buffer_len);
+    */
+   
+    pParam->paramType = my_command->cmd;
+
+    if (IS_PARAM_ASYNC(my_command->cmd))
+    {
+
+        /* os_printf ("Detected ASYNC command - setting CB \n"); */
+        pParam->content.interogateCmdCBParams.hCb  =  (TI_HANDLE)pCmdInterpret;
+        pParam->content.interogateCmdCBParams.fCb  =  (void*)cmdInterpret_ServiceCompleteCB;
+        pParam->content.interogateCmdCBParams.pCb  =  my_command->out_buffer;
+        if (my_command->out_buffer) 
+        {
+            /* the next copy is need for PLT commands */
+            os_memoryCopy(pCmdInterpret->hOs,  my_command->out_buffer, my_command->in_buffer, min(my_command->in_buffer_len,my_command->out_buffer_len));
+        }
+    }
+    else if ((my_command->in_buffer) && (my_command->in_buffer_len))
+    {
+
+        /*
+        this cmd doesnt have the structure allocated as part of the paramInfo_t structure.
+        as a result we need to allocate the memory internally.
+        */
+        if(IS_ALLOC_NEEDED_PARAM(my_command->cmd))
+        {
+           
+            *(void**)&pParam->content = os_memoryAlloc(pCmdInterpret->hOs, my_command->in_buffer_len);
+            os_memoryCopy(pCmdInterpret->hOs, *(void**)&pParam->content, my_command->in_buffer, my_command->in_buffer_len);
+        }
+        else
+            os_memoryCopy(pCmdInterpret->hOs,&pParam->content,my_command->in_buffer,my_command->in_buffer_len);
+    }
+
+    if (my_command->flags & PRIVATE_CMD_SET_FLAG)
+    {
+        pParam->paramLength = my_command->in_buffer_len;
+        res = cmdDispatch_SetParam (pCmdInterpret->hCmdDispatch,pParam);                
+    } 
+    else if (my_command->flags & PRIVATE_CMD_GET_FLAG)
+    {
+        
+        /* os_printf ("Calling getParam\n"); */
+        pParam->paramLength = my_command->out_buffer_len;
+        res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch,pParam);
+        if(res == EXTERNAL_GET_PARAM_DENIED)
+        {
+            cmdObj->return_code  = WEXT_INVALID_PARAMETER;
+            return res;
+        }
+
+        /* 
+        this is for cmd that want to check the size of memory that they need to 
+        allocate for the actual data.
+        */
+        if(pParam->paramLength && (my_command->out_buffer_len == 0))
+        {
+           my_command->out_buffer_len = pParam->paramLength;  
+        }
+    }
+    else
+    {
+         res = TI_NOK;
+    }
+
+    if (res == TI_OK)
+        {
+         if(IS_PARAM_ASYNC(my_command->cmd))
+        {
+            pCmdInterpret->pAsyncCmd = cmdObj; /* Save command handle for completion CB */
+            res = COMMAND_PENDING;
+        }
+        else
+        {
+            if ((my_command->out_buffer) && (my_command->out_buffer_len))
+            {
+                if(IS_ALLOC_NEEDED_PARAM(my_command->cmd))
+                {
+                    os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,*(void**)&pParam->content,my_command->out_buffer_len);
+                }
+                else
+                {
+                    os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,&pParam->content,my_command->out_buffer_len);
+                }                   
+            }               
+        }
+    }
+
+    /* need to free the allocated memory */
+    if(IS_ALLOC_NEEDED_PARAM(my_command->cmd))
+    {
+       os_memoryFree(pCmdInterpret->hOs, *(void**)&pParam->content, my_command->in_buffer_len);               
+    }
+
+    return res;
+}
+
+
 
 /* This routine is called by the command mailbox module to signal an ASYNC command has complete */
 int cmdInterpret_ServiceCompleteCB (TI_HANDLE hCmdInterpret, int status, void *buffer)
@@ -1882,3 +1920,152 @@ void *cmdInterpret_GetStat (TI_HANDLE hCmdInterpret)
 }
 
 
+/* Check if the indexed BSSID list holds an entry with the same BSSID and SSID */
+static TI_BOOL cmdInterpret_isBssidInList (TI_HANDLE hOs, TI_UINT16 *aBucket, TBssidIndexEntry *aEntry, OS_802_11_BSSID_EX *pBssid)
+{
+    OS_802_11_BSSID_EX *pCurrent;
+    TI_UINT16 i;
+
+    for (i = aBucket[BSSID_INDEX_HASH(pBssid->MacAddress)]; i != BSSID_INDEX_END; i = aEntry[i].uNext)
+    {
+        pCurrent = aEntry[i].pBssid;
+        if (MAC_EQUAL (pCurrent->MacAddress, pBssid->MacAddress) &&
+            (pCurrent->Ssid.SsidLength == pBssid->Ssid.SsidLength) &&
+            (os_memoryCompare (hOs, pCurrent->Ssid.Ssid, pBssid->Ssid.Ssid, pBssid->Ssid.SsidLength) == 0))
+        {
+            return TI_TRUE;
+        }
+    }
+
+    return TI_FALSE;
+}
+
+/* 
+ * Update the cached BSSID list with the scan result table entries changed since it was read.
+ * If nothing changed the cached list is kept as is, and if the table was cleared it is replaced.
+ */
+static TI_STATUS cmdInterpret_updateBssidList (cmdInterpret_t *pCmdInterpret, paramInfo_t *pParam)
+{
+    TScanBssidListDelta     *pDelta = &pParam->content.tBssidListDelta;
+    OS_802_11_BSSID_LIST_EX *pDeltaList, *pNewList;
+    OS_802_11_BSSID_EX      *pOld, *pNew;
+    TI_UINT16               aBucket[BSSID_INDEX_HASH_SIZE];
+    TBssidIndexEntry        *aEntry;
+    TI_UINT32               uDeltaAllocSize, uDeltaSize, uNewAllocSize, uHeaderSize, uIndexSize, i, uHash;
+    TI_STATUS               res;
+
+    uHeaderSize = sizeof(OS_802_11_BSSID_LIST_EX) - sizeof(OS_802_11_BSSID_EX);
+
+    /* First get the generation and the memory required to hold the changed entries */
+    pParam->paramType = SCAN_CNCN_BSSID_LIST_DELTA_PARAM;
+    pParam->paramLength = sizeof(TScanBssidListDelta);
+    pDelta->uSinceGeneration = pCmdInterpret->uBssidListGeneration;
+    pDelta->bFullList = (pCmdInterpret->pBssidList == NULL);
+    pDelta->pBssidList = NULL;
+    res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam);
+    if (res != TI_OK)
+    {
+        return res;
+    }
+
+    /* Nothing changed since the last read */
+    if ((pCmdInterpret->pBssidList != NULL) && (pDelta->uGeneration == pCmdInterpret->uBssidListGeneration))
+    {
+        return TI_OK;
+    }
+
+    uDeltaAllocSize = pDelta->uListSize;
+    pDeltaList = os_memoryAlloc (pCmdInterpret->hOs, uDeltaAllocSize);
+    if (pDeltaList == NULL)
+    {
+        return TI_NOK;
+    }
+
+    /* And retrieve the changed entries */
+    pParam->paramType = SCAN_CNCN_BSSID_LIST_DELTA_PARAM;
+    pParam->paramLength = sizeof(TScanBssidListDelta);
+    pDelta->uSinceGeneration = pCmdInterpret->uBssidListGeneration;
+    pDelta->bFullList = (pCmdInterpret->pBssidList == NULL);
+    pDelta->pBssidList = pDeltaList;
+    pDelta->uListSize = uDeltaAllocSize;
+    res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam);
+    if (res != TI_OK)
+    {
+        os_memoryFree (pCmdInterpret->hOs, pDeltaList, uDeltaAllocSize);
+        return res;
+    }
+    uDeltaSize = pDelta->uListSize;
+
+    /* The table was cleared (or this is the first read) - the changed entries are the whole list */
+    if ((pCmdInterpret->pBssidList == NULL) || pDelta->bFullList)
+    {
+        if (pCmdInterpret->pBssidList)
+        {
+            os_memoryFree (pCmdInterpret->hOs, pCmdInterpret->pBssidList, pCmdInterpret->uBssidListSize);
+        }
+        pCmdInterpret->pBssidList = pDeltaList;
+        pCmdInterpret->uBssidListSize = uDeltaAllocSize;
+        pCmdInterpret->uBssidListGeneration = pDelta->uGeneration;
+        return TI_OK;
+    }
+
+    /* Merge: keep the cached entries which didn't change, followed by the changed entries */
+    uNewAllocSize = pCmdInterpret->uBssidListSize + uDeltaSize;
+    pNewList = os_memoryAlloc (pCmdInterpret->hOs, uNewAllocSize);
+    uIndexSize = (pDeltaList->NumberOfItems ? pDeltaList->NumberOfItems : 1) * sizeof(TBssidIndexEntry);
+    aEntry = os_memoryAlloc (pCmdInterpret->hOs, uIndexSize);
+    if ((pNewList == NULL) || (aEntry == NULL))
+    {
+        if (pNewList)
+        {
+            os_memoryFree (pCmdInterpret->hOs, pNewList, uNewAllocSize);
+        }
+        if (aEntry)
+        {
+            os_memoryFree (pCmdInterpret->hOs, aEntry, uIndexSize);
+        }
+        os_memoryFree (pCmdInterpret->hOs, pDeltaList, uDeltaAllocSize);
+        return TI_NOK;
+    }
+
+    /* Index the changed entries by BSSID, so each cached entry is looked up in constant time */
+    for (i = 0; i < BSSID_INDEX_HASH_SIZE; i++)
+    {
+        aBucket[i] = BSSID_INDEX_END;
+    }
+    pNew = &pDeltaList->Bssid[0];
+    for (i = 0; i < pDeltaList->NumberOfItems; i++)
+    {
+        uHash = BSSID_INDEX_HASH(pNew->MacAddress);
+        aEntry[i].pBssid = pNew;
+        aEntry[i].uNext  = aBucket[uHash];
+        aBucket[uHash]   = (TI_UINT16)i;
+        pNew = (OS_802_11_BSSID_EX *) (((char *) pNew) + pNew->Length);
+    }
+
+    pNewList->NumberOfItems = 0;
+    pNew = &pNewList->Bssid[0];
+    pOld = &pCmdInterpret->pBssidList->Bssid[0];
+    for (i = 0; i < pCmdInterpret->pBssidList->NumberOfItems; i++)
+    {
+        if (!cmdInterpret_isBssidInList (pCmdInterpret->hOs, aBucket, aEntry, pOld))
+        {
+            os_memoryCopy (pCmdInterpret->hOs, pNew, pOld, pOld->Length);
+            pNew = (OS_802_11_BSSID_EX *) (((char *) pNew) + pNew->Length);
+            pNewList->NumberOfItems++;
+        }
+        pOld = (OS_802_11_BSSID_EX *) (((char *) pOld) + pOld->Length);
+    }
+    os_memoryCopy (pCmdInterpret->hOs, pNew, &pDeltaList->Bssid[0], uDeltaSize - uHeaderSize);
+    pNewList->NumberOfItems += pDeltaList->NumberOfItems;
+
+    os_memoryFree (pCmdInterpret->hOs, pCmdInterpret->pBssidList, pCmdInterpret->uBssidListSize);
+    os_memoryFree (pCmdInterpret->hOs, pDeltaList, uDeltaAllocSize);
+    os_memoryFree (pCmdInterpret->hOs, aEntry, uIndexSize);
+
+    pCmdInterpret->pBssidList = pNewList;
+    pCmdInterpret->uBssidListSize = uNewAllocSize;
+    pCmdInterpret->uBssidListGeneration = pDelta->uGeneration;
+
+    return TI_OK;
+}
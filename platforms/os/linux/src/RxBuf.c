@@ -40,41 +40,264 @@
 
 #include "tidef.h"
 #include "RxBuf_linux.h"
+#include "WlanDrvIf.h"
 #include <linux/netdevice.h>
+
+
+/*--------------------------------------------------------------------------------------*/
+/* 
+ * Rx buffers recycle pool:
+ * Rx skbs are allocated in a few size classes and kept in per class free lists.
+ * Buffers dropped by the driver (RxBufFree) return to their class list instead of the 
+ *   allocator, and a deferred work refills a class that drops below its low watermark.
+ * Allocation falls back to alloc_skb(GFP_ATOMIC) when the class list is empty.
+ */
+
+/* Prepare an skb taken from the pool or the allocator for Rx, and return its data pointer */
+static inline void *RxBufPrepare (struct sk_buff *skb)
+{
+    rx_head_t *rx_head = (rx_head_t *)skb->head;
+
+    skb->data     = skb->head;
+    skb_reset_tail_pointer(skb);
+    skb->len      = 0;
+    skb->data_len = 0;
+
+	rx_head->skb = skb;
+	skb_reserve(skb, RX_HEAD_LEN_ALIGNED+WSPI_PAD_BYTES);
+
+	return skb->data;
+}
+
+/* Refill all classes up to their high watermark (process context) */
+static void RxBufPoolRefill (TRxBufPool *pPool)
+{
+    TRxBufPoolClass *pClass;
+    struct sk_buff  *skb;
+    TI_UINT32        uClass;
+
+    pPool->tStats.uRefillRuns++;
+
+    for (uClass = 0; uClass < RX_BUF_POOL_NUM_CLASSES; uClass++)
+    {
+        pClass = &pPool->aClass[uClass];
+
+        while (skb_queue_len(&pClass->tFreeList) < pClass->uHighWatermark)
+        {
+            skb = alloc_skb (pClass->uAllocLen, GFP_KERNEL);
+            if (skb == NULL)
+            {
+                pPool->tStats.uRefillFailures++;
+                return;
+            }
+            skb_queue_tail (&pClass->tFreeList, skb);
+            pPool->tStats.aRefilled[uClass]++;
+        }
+    }
+}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,23)
+static void RxBufPoolRefillWork (struct work_struct *work)
+{
+    TRxBufPool *pPool = container_of(work, TRxBufPool, tRefillWork);
+#else
+static void RxBufPoolRefillWork (void *hPool)
+{
+    TRxBufPool *pPool = (TRxBufPool *)hPool;
+#endif
+
+    RxBufPoolRefill (pPool);
+}
+
+/*--------------------------------------------------------------------------------------*/
+/* 
+ * Create the Rx buffers recycle pool and fill it up to the high watermarks.
+ * Returns NULL on failure (Rx buffers are then allocated without the pool).
+ */
+TI_HANDLE RxBufPoolCreate (TI_HANDLE hOs)
+{
+    TRxBufPool *pPool;
+    TI_UINT32   uClass;
+
+    pPool = kmalloc (sizeof(TRxBufPool), GFP_KERNEL);
+    if (pPool == NULL)
+    {
+        printk("RxBufPoolCreate(): kmalloc failed\n");
+        return NULL;
+    }
+    memset (pPool, 0, sizeof(TRxBufPool));
+
+    pPool->aClass[RX_BUF_POOL_CLASS_SMALL].uBufLen         = RX_BUF_POOL_SMALL_LEN;
+    pPool->aClass[RX_BUF_POOL_CLASS_SMALL].uLowWatermark   = RX_BUF_POOL_SMALL_LOW;
+    pPool->aClass[RX_BUF_POOL_CLASS_SMALL].uHighWatermark  = RX_BUF_POOL_SMALL_HIGH;
+    pPool->aClass[RX_BUF_POOL_CLASS_MEDIUM].uBufLen        = RX_BUF_POOL_MEDIUM_LEN;
+    pPool->aClass[RX_BUF_POOL_CLASS_MEDIUM].uLowWatermark  = RX_BUF_POOL_MEDIUM_LOW;
+    pPool->aClass[RX_BUF_POOL_CLASS_MEDIUM].uHighWatermark = RX_BUF_POOL_MEDIUM_HIGH;
+    pPool->aClass[RX_BUF_POOL_CLASS_LARGE].uBufLen         = RX_BUF_POOL_LARGE_LEN;
+    pPool->aClass[RX_BUF_POOL_CLASS_LARGE].uLowWatermark   = RX_BUF_POOL_LARGE_LOW;
+    pPool->aClass[RX_BUF_POOL_CLASS_LARGE].uHighWatermark  = RX_BUF_POOL_LARGE_HIGH;
+
+    for (uClass = 0; uClass < RX_BUF_POOL_NUM_CLASSES; uClass++)
+    {
+        pPool->aClass[uClass].uAllocLen = pPool->aClass[uClass].uBufLen + RX_BUF_OVERHEAD;
+        skb_queue_head_init (&pPool->aClass[uClass].tFreeList);
+    }
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,23)
+    INIT_WORK(&pPool->tRefillWork, RxBufPoolRefillWork);
+#else
+    INIT_WORK(&pPool->tRefillWork, RxBufPoolRefillWork, (void *)pPool);
+#endif
+
+    RxBufPoolRefill (pPool);
+
+    return (TI_HANDLE)pPool;
+}
+
+/*--------------------------------------------------------------------------------------*/
+/* 
+ * Destroy the Rx buffers recycle pool (called after Rx is stopped).
+ */
+void RxBufPoolDestroy (TI_HANDLE hRxBufPool)
+{
+    TRxBufPool *pPool = (TRxBufPool *)hRxBufPool;
+    TI_UINT32   uClass;
+
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,21))
+    cancel_work_sync (&pPool->tRefillWork);
+#else
+    flush_scheduled_work ();
+#endif
+
+    for (uClass = 0; uClass < RX_BUF_POOL_NUM_CLASSES; uClass++)
+    {
+        skb_queue_purge (&pPool->aClass[uClass].tFreeList);
+    }
+
+    kfree (pPool);
+}
+
+/*--------------------------------------------------------------------------------------*/
+/* 
+ * Get / Reset the Rx buffers recycle pool statistics.
+ */
+TI_STATUS RxBufPoolGetStats (TI_HANDLE hOs, TRxBufPoolStats *pStats)
+{
+    TRxBufPool *pPool = (TRxBufPool *)((TWlanDrvIfObj *)hOs)->hRxBufPool;
+    TI_UINT32   uClass;
+
+    if (pPool == NULL)
+    {
+        return TI_NOK;
+    }
+
+    memcpy (pStats, &pPool->tStats, sizeof(TRxBufPoolStats));
+    for (uClass = 0; uClass < RX_BUF_POOL_NUM_CLASSES; uClass++)
+    {
+        pStats->aFreeBufs[uClass]      = skb_queue_len(&pPool->aClass[uClass].tFreeList);
+        pStats->aLowWatermark[uClass]  = pPool->aClass[uClass].uLowWatermark;
+        pStats->aHighWatermark[uClass] = pPool->aClass[uClass].uHighWatermark;
+        pStats->aBufLen[uClass]        = pPool->aClass[uClass].uBufLen;
+    }
+
+    return TI_OK;
+}
+
+void RxBufPoolResetStats (TI_HANDLE hOs)
+{
+    TRxBufPool *pPool = (TRxBufPool *)((TWlanDrvIfObj *)hOs)->hRxBufPool;
+
+    if (pPool != NULL)
+    {
+        memset (&pPool->tStats, 0, sizeof(TRxBufPoolStats));
+    }
+}
+
 /*--------------------------------------------------------------------------------------*/
 /* 
  * Allocate BUF Rx packets.
  * Add 16 bytes before the data buffer for WSPI overhead!
+ * The skb is taken from the smallest pool class that fits the length. If the class is empty
+ *   a class sized skb is allocated, so it can be recycled when freed by the driver.
  */
 void* RxBufAlloc(TI_HANDLE hOs, TI_UINT32 len,PacketClassTag_e ePacketClassTag)
 {
-    rx_head_t      *rx_head;
-    TI_UINT32      alloc_len = len + WSPI_PAD_BYTES + PAYLOAD_ALIGN_PAD_BYTES + RX_HEAD_LEN_ALIGNED;
-	struct sk_buff *skb      = alloc_skb (alloc_len, GFP_ATOMIC);
+    TRxBufPool      *pPool     = (TRxBufPool *)((TWlanDrvIfObj *)hOs)->hRxBufPool;
+    TRxBufPoolClass *pClass;
+    TI_UINT32        uClass;
+    TI_UINT32        alloc_len = len + RX_BUF_OVERHEAD;
+	struct sk_buff  *skb       = NULL;
+
+    if (pPool == NULL)
+    {
+        skb = alloc_skb (alloc_len, GFP_ATOMIC);
+    }
+    else 
+    {
+        for (uClass = 0; uClass < RX_BUF_POOL_NUM_CLASSES; uClass++)
+        {
+            pClass = &pPool->aClass[uClass];
+            if (len <= pClass->uBufLen)
+            {
+                skb = skb_dequeue (&pClass->tFreeList);
+                if (skb != NULL)
+                {
+                    pPool->tStats.aHits[uClass]++;
+                }
+                else 
+                {
+                    pPool->tStats.aMisses[uClass]++;
+                    skb = alloc_skb (pClass->uAllocLen, GFP_ATOMIC);
+                }
+
+                /* Refill from process context when going below the low watermark */
+                if (skb_queue_len(&pClass->tFreeList) < pClass->uLowWatermark)
+                {
+                    schedule_work (&pPool->tRefillWork);
+                }
+                break;
+            }
+        }
+
+        /* Longer than all classes, so not pooled */
+        if (uClass == RX_BUF_POOL_NUM_CLASSES)
+        {
+            pPool->tStats.uOversize++;
+            skb = alloc_skb (alloc_len, GFP_ATOMIC);
+        }
+
+        if (skb == NULL)
+        {
+            pPool->tStats.uAllocFailures++;
+        }
+    }
 
     if(skb == NULL){
         printk("RxBufAlloc(): alloc_skb failed\n");
         return NULL;
     }
-	rx_head  = (rx_head_t *)skb->head;
-
-	rx_head->skb = skb;
-	skb_reserve(skb, RX_HEAD_LEN_ALIGNED+WSPI_PAD_BYTES);
 /*
 	printk("-->> RxBufAlloc(len=%d)  skb=0x%x skb->data=0x%x skb->head=0x%x skb->len=%d\n",
 		   (int)len, (int)skb, (int)skb->data, (int)skb->head, (int)skb->len);
 */
-	return skb->data;
+	return RxBufPrepare (skb);
     
 }
 
 /*--------------------------------------------------------------------------------------*/
-
+/* 
+ * Free BUF Rx packets dropped by the driver.
+ * The skb is returned to the largest pool class it can serve, unless it is shared 
+ *   or the class is at its high watermark.
+ */
 inline void  RxBufFree(TI_HANDLE hOs, void* pBuf)		
 {
+    TRxBufPool     *pPool   = (TRxBufPool *)((TWlanDrvIfObj *)hOs)->hRxBufPool;
     unsigned char  *pdata   = (unsigned char *)((TI_UINT32)pBuf & ~(TI_UINT32)0x3);
 	rx_head_t      *rx_head = (rx_head_t *)(pdata -  WSPI_PAD_BYTES - RX_HEAD_LEN_ALIGNED);
 	struct sk_buff *skb     = rx_head->skb;
+    TI_UINT32       uBufSize;
+    TI_INT32        iClass;
 
 
 #ifdef TI_DBG
@@ -97,6 +320,37 @@ inline void  RxBufFree(TI_HANDLE hOs, void* pBuf)
 	printk("-->> RxBufFree()  skb=0x%x skb->data=0x%x skb->head=0x%x skb->len=%d\n",
 		   (int)skb, (int)skb->data, (int)skb->head, (int)skb->len);
 */
+    if (pPool != NULL)
+    {
+        iClass = -1;
+        if (!skb_cloned(skb) && !skb_shared(skb) && (skb_shinfo(skb)->nr_frags == 0))
+        {
+            uBufSize = skb_end_pointer(skb) - skb->head;
+            for (iClass = RX_BUF_POOL_NUM_CLASSES - 1; iClass >= 0; iClass--)
+            {
+                if (uBufSize >= pPool->aClass[iClass].uAllocLen)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (iClass < 0)
+        {
+            pPool->tStats.uNotRecyclable++;
+        }
+        else if (skb_queue_len(&pPool->aClass[iClass].tFreeList) < pPool->aClass[iClass].uHighWatermark)
+        {
+            skb_queue_tail (&pPool->aClass[iClass].tFreeList, skb);
+            pPool->tStats.aRecycled[iClass]++;
+            return;
+        }
+        else 
+        {
+            pPool->tStats.aRecycleOverflow[iClass]++;
+        }
+    }
+
 	dev_kfree_skb(skb);
 }
 
@@ -67,6 +67,7 @@
 #include "txMgmtQueue_Api.h"
 #include "TWDriver.h"
 #include "Ethernet.h"
+#include "RxBuf_linux.h"
 /* PM hooks */
 #if defined HOST_PLATFORM_OMAP3430 || defined HOST_PLATFORM_ZOOM2  || defined HOST_PLATFORM_ZOOM1 || defined HOST_PLATFORM_MSM
 #include "SdioDrv.h"
@@ -127,6 +128,19 @@ static int wlanDrvIf_Xmit (struct sk_buff *skb, struct net_device *dev)
     pPktCtrlBlk->tTxDescriptor.length       = skb->len;
     pPktCtrlBlk->tTxPktParams.pInputPkt     = skb;
 
+#ifdef TI_TX_MULTI_QUEUE
+    /* The subqueue the stack serialized this packet on (the lock-free Tx rings must follow it) */
+    pPktCtrlBlk->tTxPktParams.uOsQueId = (TI_UINT8)skb_get_queue_mapping (skb);
+    pPktCtrlBlk->tTxPktParams.uFlags  |= TX_CTRL_FLAG_OS_QUEUE;
+
+    /* If the packet went through wlanDrvIf_SelectQueue its priority holds the classified TID, so skip reclassification */
+    if ((skb->priority < MAX_NUM_OF_802_1d_TAGS) &&
+        (skb_get_queue_mapping (skb) == txDataQ_TidToQueue ((TI_UINT8)skb->priority)))
+    {
+        pPktCtrlBlk->tTxPktParams.uFlags |= TX_CTRL_FLAG_CLASSIFIED;
+    }
+#endif
+
 	/* Point the first BDL buffer to the Ethernet header, and the second buffer to the rest of the packet */
 	pPktCtrlBlk->tTxnStruct.aBuf[0] = skb->data;
 	pPktCtrlBlk->tTxnStruct.aLen[0] = ETHERNET_HDR_LEN;
@@ -147,6 +161,39 @@ static int wlanDrvIf_Xmit (struct sk_buff *skb, struct net_device *dev)
     return 0;
 }
 /*--------------------------------------------------------------------------------------*/
+#ifdef TI_TX_MULTI_QUEUE
+/**
+ * \fn     wlanDrvIf_SelectQueue
+ * \brief  Select the packet Tx subqueue
+ *
+ * The network stack calls this function to select the interface Tx subqueue of a packet.
+ * The packet is classified by the driver classifier, and its AC is used as the subqueue.
+ * The classified TID is saved in the packet priority for wlanDrvIf_Xmit.
+ *
+ * \note
+ * \param  dev - The driver network-interface handle
+ * \param  skb - The Linux packet buffer structure
+ * \return The Tx subqueue index (AC)
+ * \sa     wlanDrvIf_Xmit
+ */
+static u16 wlanDrvIf_SelectQueue (struct net_device *dev, struct sk_buff *skb)
+{
+    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)NETDEV_GET_PRIVATE(dev);
+    TI_UINT8       uTid = (TI_UINT8)skb->priority;
+    TI_UINT32      uQueId;
+
+    if (drv->tCommon.hTxDataQ == NULL)
+    {
+        return 0;
+    }
+
+    uQueId = txDataQ_SelectQueue (drv->tCommon.hTxDataQ, skb->data, skb->len, &uTid);
+    skb->priority = uTid;
+
+    return (u16)uQueId;
+}
+#endif
+
 /**
  * \fn     wlanDrvIf_FreeTxPacket
  * \brief  Free the OS Tx packet
@@ -300,6 +347,11 @@ static void wlanDrvIf_DriverTask (void *hDrv)
     /* Call the driver main task */
     context_DriverTask (drv->tCommon.hContext);
 
+#ifdef TI_RX_NAPI
+    /* Hand the Rx packets left in the current batch (e.g. released without a burst end) to the NAPI poll */
+    os_RxBatchFlush (drv);
+#endif
+
 	os_profile (drv, 1, 0);
 	os_wake_lock_timeout(drv);
 	os_wake_unlock(drv);
@@ -599,7 +651,10 @@ int wlanDrvIf_Open (struct net_device *dev)
      *  Finalize network interface setup
      */
     drv->netdev->addr_len = MAC_ADDR_LEN;
-    netif_start_queue (dev);
+#ifdef TI_RX_NAPI
+    napi_enable (&drv->tRxNapi);
+#endif
+    netif_tx_start_all_queues (dev);
 
     /* register 3430 PM hooks in our SDIO driver */
 #if defined HOST_PLATFORM_OMAP3430 || defined HOST_PLATFORM_ZOOM2 || defined HOST_PLATFORM_ZOOM1 || defined HOST_PLATFORM_MSM
@@ -638,12 +693,20 @@ int wlanDrvIf_Stop (struct net_device *dev)
 
 int wlanDrvIf_Release (struct net_device *dev)
 {
-    /* TWlanDrvIfObj *drv = (TWlanDrvIfObj *)NETDEV_GET_PRIVATE(dev); */
+#ifdef TI_RX_NAPI
+    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)NETDEV_GET_PRIVATE(dev);
+#endif
 
     ti_dprintf (TIWLAN_LOG_OTHER, "wlanDrvIf_Release()\n");
 
-    /* Disable network interface queue */
-    netif_stop_queue (dev);
+    /* Disable network interface queues */
+    netif_tx_stop_all_queues (dev);
+
+#ifdef TI_RX_NAPI
+    /* Stop the Rx NAPI poll and drop the Rx packets waiting for it */
+    napi_disable (&drv->tRxNapi);
+    skb_queue_purge (&drv->tRxNapiQueue);
+#endif
     return 0;
 }
 
@@ -667,6 +730,9 @@ static const struct net_device_ops wlan_netdev_ops = {
   .ndo_start_xmit       = wlanDrvIf_Xmit,
   .ndo_get_stats        = wlanDrvIf_NetGetStat,
   .ndo_validate_addr    = NULL,
+#ifdef TI_TX_MULTI_QUEUE
+  .ndo_select_queue     = wlanDrvIf_SelectQueue,
+#endif
 };
 
 /**
@@ -686,8 +752,12 @@ static int wlanDrvIf_SetupNetif (TWlanDrvIfObj *drv)
    struct net_device *dev;
    int res;
 
-   /* Allocate network interface structure for the driver */
+   /* Allocate network interface structure for the driver (with a Tx subqueue per AC) */
+#ifdef TI_TX_MULTI_QUEUE
+   dev = alloc_etherdev_mq (0, MAX_NUM_OF_AC);
+#else
    dev = alloc_etherdev (0);
+#endif
    if (dev == NULL)
    {
       ti_dprintf (TIWLAN_LOG_ERROR, "alloc_etherdev() failed\n");
@@ -704,6 +774,13 @@ static int wlanDrvIf_SetupNetif (TWlanDrvIfObj *drv)
 
    NETDEV_SET_PRIVATE(dev, drv);
    drv->netdev = dev;
+
+#ifdef TI_RX_NAPI
+   /* Setup the Rx batched delivery (the weight is updated to the configured Rx batch budget) */
+   skb_queue_head_init (&drv->tRxBatch);
+   skb_queue_head_init (&drv->tRxNapiQueue);
+   netif_napi_add (dev, &drv->tRxNapi, os_RxBatchPoll, 64);
+#endif
    strcpy (dev->name, TIWLAN_DRV_IF_NAME);
    netif_carrier_off (dev);
    dev->tx_queue_len = 100;
@@ -818,6 +895,12 @@ static int wlanDrvIf_Create (void)
 		goto drv_create_end_3;
     }
 
+    /* Create the Rx buffers recycle pool (if it fails, Rx buffers are allocated without it) */
+    drv->hRxBufPool = RxBufPoolCreate (drv);
+	if (drv->hRxBufPool == NULL) {
+        ti_dprintf (TIWLAN_LOG_ERROR, "wlanDrvIf_Create(): Failed to create Rx buffers pool!\n");
+    }
+
     /* Create all driver modules and link their handles */
 	rc = drvMain_Create (drv,
                     &drv->tCommon.hDrvMain,
@@ -860,6 +943,9 @@ drv_create_end_5:
 		drvMain_Destroy (drv->tCommon.hDrvMain);
 	}
 drv_create_end_4:
+	if (drv->hRxBufPool) {
+		RxBufPoolDestroy (drv->hRxBufPool);
+	}
 	if (drv->wl_sock) {
 		sock_release (drv->wl_sock->sk_socket);
 	}
@@ -905,7 +991,7 @@ static void wlanDrvIf_Destroy (TWlanDrvIfObj *drv)
 {
     /* Release the driver network interface */
 	if (drv->netdev) {
-        netif_stop_queue  (drv->netdev);
+        netif_tx_stop_all_queues (drv->netdev);
 		wlanDrvIf_Stop    (drv->netdev);
         unregister_netdev (drv->netdev);
 		free_netdev (drv->netdev);
@@ -942,6 +1028,17 @@ static void wlanDrvIf_Destroy (TWlanDrvIfObj *drv)
 	if (drv->tiwlan_wq)
 		destroy_workqueue(drv->tiwlan_wq);
 
+#ifdef TI_RX_NAPI
+    /* Drop the Rx packets left in the current batch or handed to the poll after it was disabled */
+    __skb_queue_purge (&drv->tRxBatch);
+    skb_queue_purge (&drv->tRxNapiQueue);
+#endif
+
+    /* Release the Rx buffers recycle pool (no Rx after the driver modules are destroyed) */
+	if (drv->hRxBufPool) {
+		RxBufPoolDestroy (drv->hRxBufPool);
+	}
+
 #ifdef CONFIG_HAS_WAKELOCK
 	wake_lock_destroy(&drv->wl_wifi);
 	wake_lock_destroy(&drv->wl_rxwake);
@@ -1011,17 +1108,23 @@ static void __exit wlanDrvIf_ModuleExit (void)
  * \brief  block Tx thread until wlanDrvIf_ResumeTx called .
  *
  * This routine is called whenever we need to stop the network stack to send us pakets since one of our Q's is full.
+ * Only the network stack subqueue of the full queue (AC) is stopped.
  *
  * \note
  * \param  hOs           - The driver object handle
+ * \param  uQueId        - The full queue (AC)
 * \return
  * \sa     wlanDrvIf_StopTx
  */
-void wlanDrvIf_StopTx (TI_HANDLE hOs)
+void wlanDrvIf_StopTx (TI_HANDLE hOs, TI_UINT32 uQueId)
 {
     TWlanDrvIfObj *drv = (TWlanDrvIfObj *)hOs;
 
+#ifdef TI_TX_MULTI_QUEUE
+    netif_stop_subqueue (drv->netdev, (u16)uQueId);
+#else
     netif_stop_queue (drv->netdev);
+#endif
 }
 
 /**
@@ -1029,17 +1132,23 @@ void wlanDrvIf_StopTx (TI_HANDLE hOs)
  * \brief  Resume Tx thread .
  *
  * This routine is called whenever we need to resume the network stack to send us pakets since our Q's are empty.
+ * Only the network stack subqueue of the drained queue (AC) is resumed.
  *
  * \note
  * \param  hOs           - The driver object handle
+ * \param  uQueId        - The drained queue (AC)
  * \return
  * \sa     wlanDrvIf_ResumeTx
  */
-void wlanDrvIf_ResumeTx (TI_HANDLE hOs)
+void wlanDrvIf_ResumeTx (TI_HANDLE hOs, TI_UINT32 uQueId)
 {
     TWlanDrvIfObj *drv = (TWlanDrvIfObj *)hOs;
 
+#ifdef TI_TX_MULTI_QUEUE
+    netif_wake_subqueue (drv->netdev, (u16)uQueId);
+#else
     netif_wake_queue (drv->netdev);
+#endif
 }
 
 module_init (wlanDrvIf_ModuleInit);
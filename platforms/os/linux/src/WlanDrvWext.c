@@ -48,6 +48,17 @@
 #include "CmdInterpretWext.h"
 #include "privateCmd.h"
 #include "DrvMain.h"
+#include "EvHandler.h"
+
+/* A batch of private commands copied to the kernel (one allocation) */
+typedef struct
+{
+    TWlanDrvIfObj          *drv;
+    ti_private_cmd_batch_t  tBatch;         /* The kernel batch: pCmds and pResults point to the arrays below */
+    ti_private_cmd_t       *pUserCmds;      /* The user commands (with the user buffers pointers) */
+    TI_INT32               *pUserResults;   /* The user results array */
+    TI_UINT32               uAllocSize;
+} TWextCmdBatch;
 
 /* Routine prototypes */
 
@@ -57,6 +68,7 @@ int wlanDrvWext_Handler (struct net_device *dev,
                          void  *extra);
 
 static struct iw_statistics *wlanDrvWext_GetWirelessStats (struct net_device *dev);
+static int  wlanDrvWext_BatchHandler (TWlanDrvIfObj *drv, ti_private_cmd_t *pCmd);
 
 extern int wlanDrvIf_LoadFiles (TWlanDrvIfObj *drv, TLoaderFilesData *pInitInfo);
 extern int wlanDrvIf_Start (struct net_device *dev);
@@ -165,6 +177,207 @@ void disable_wext_ioctl(void)
 	wext_ioctl_off = 1;
 }
 
+/* Free a commands batch and its commands kernel buffers */
+static void wlanDrvWext_BatchFree (TWextCmdBatch *pBatch)
+{
+    TWlanDrvIfObj *drv = pBatch->drv;
+    TI_UINT32      i;
+
+    for (i = 0; i < pBatch->tBatch.uNumCmds; i++)
+    {
+        if (pBatch->tBatch.pCmds[i].in_buffer)
+        {
+            os_memoryFree (drv, pBatch->tBatch.pCmds[i].in_buffer, pBatch->tBatch.pCmds[i].in_buffer_len);
+        }
+        if (pBatch->tBatch.pCmds[i].out_buffer)
+        {
+            os_memoryFree (drv, pBatch->tBatch.pCmds[i].out_buffer, pBatch->tBatch.pCmds[i].out_buffer_len);
+        }
+    }
+    os_memoryFree (drv, pBatch, pBatch->uAllocSize);
+}
+
+/* Copy a commands batch and its commands input buffers from the user */
+static TWextCmdBatch *wlanDrvWext_BatchAlloc (TWlanDrvIfObj *drv, ti_private_cmd_t *pCmd)
+{
+    ti_private_cmd_batch_t  tUserBatch;
+    TWextCmdBatch          *pBatch;
+    ti_private_cmd_t       *pKrnCmd;
+    TI_UINT32               uAllocSize, i;
+
+    if ((pCmd->in_buffer == NULL) || (pCmd->in_buffer_len != sizeof(ti_private_cmd_batch_t)) ||
+        os_memoryCopyFromUser (drv, &tUserBatch, pCmd->in_buffer, sizeof(ti_private_cmd_batch_t)))
+    {
+        return NULL;
+    }
+    if ((tUserBatch.uNumCmds == 0) || (tUserBatch.uNumCmds > PRIVATE_CMD_BATCH_MAX_CMDS) || (tUserBatch.pCmds == NULL))
+    {
+        return NULL;
+    }
+
+    uAllocSize = sizeof(TWextCmdBatch) + tUserBatch.uNumCmds * (2 * sizeof(ti_private_cmd_t) + sizeof(TI_INT32));
+    pBatch = os_memoryAlloc (drv, uAllocSize);
+    if (pBatch == NULL)
+    {
+        return NULL;
+    }
+    os_memoryZero (drv, pBatch, uAllocSize);
+    pBatch->drv                = drv;
+    pBatch->uAllocSize         = uAllocSize;
+    pBatch->pUserResults       = tUserBatch.pResults;
+    pBatch->tBatch.uBatchId    = tUserBatch.uBatchId;
+    pBatch->tBatch.pCmds       = (ti_private_cmd_t *)(pBatch + 1);
+    pBatch->pUserCmds          = pBatch->tBatch.pCmds + tUserBatch.uNumCmds;
+    pBatch->tBatch.pResults    = (TI_INT32 *)(pBatch->pUserCmds + tUserBatch.uNumCmds);
+
+    if (os_memoryCopyFromUser (drv, pBatch->pUserCmds, tUserBatch.pCmds, tUserBatch.uNumCmds * sizeof(ti_private_cmd_t)))
+    {
+        os_memoryFree (drv, pBatch, uAllocSize);
+        return NULL;
+    }
+
+    /* Allocate the kernel buffers of each command (uNumCmds counts the commands to free on failure) */
+    for (i = 0; i < tUserBatch.uNumCmds; i++)
+    {
+        pKrnCmd = &pBatch->tBatch.pCmds[i];
+        pKrnCmd->cmd   = pBatch->pUserCmds[i].cmd;
+        pKrnCmd->flags = pBatch->pUserCmds[i].flags;
+        pBatch->tBatch.pResults[i] = TI_NOK;    /* Set upon the command execution */
+        pBatch->tBatch.uNumCmds++;
+
+        /* A batch which isn't waited for may include only SET commands */
+        if ((pCmd->flags & PRIVATE_CMD_NOWAIT_FLAG) && !(pKrnCmd->flags & PRIVATE_CMD_SET_FLAG))
+        {
+            wlanDrvWext_BatchFree (pBatch);
+            return NULL;
+        }
+
+        if (pBatch->pUserCmds[i].in_buffer && pBatch->pUserCmds[i].in_buffer_len)
+        {
+            pKrnCmd->in_buffer = os_memoryAlloc (drv, pBatch->pUserCmds[i].in_buffer_len);
+            if (pKrnCmd->in_buffer == NULL)
+            {
+                wlanDrvWext_BatchFree (pBatch);
+                return NULL;
+            }
+            pKrnCmd->in_buffer_len = pBatch->pUserCmds[i].in_buffer_len;
+            if (os_memoryCopyFromUser (drv, pKrnCmd->in_buffer, pBatch->pUserCmds[i].in_buffer, pKrnCmd->in_buffer_len))
+            {
+                wlanDrvWext_BatchFree (pBatch);
+                return NULL;
+            }
+        }
+
+        if (pBatch->pUserCmds[i].out_buffer && pBatch->pUserCmds[i].out_buffer_len)
+        {
+            pKrnCmd->out_buffer = os_memoryAlloc (drv, pBatch->pUserCmds[i].out_buffer_len);
+            if (pKrnCmd->out_buffer == NULL)
+            {
+                wlanDrvWext_BatchFree (pBatch);
+                return NULL;
+            }
+            pKrnCmd->out_buffer_len = pBatch->pUserCmds[i].out_buffer_len;
+        }
+    }
+
+    return pBatch;
+}
+
+/* Completion of a batch which isn't waited for - report its results by event (called in driver context) */
+static void wlanDrvWext_BatchDone (TI_HANDLE hBatch, TI_UINT32 uReturnCode)
+{
+    TWextCmdBatch              *pBatch = (TWextCmdBatch *)hBatch;
+    ti_private_cmd_batch_done_t tDone;
+    TI_UINT32                   i;
+
+    tDone.uBatchId     = pBatch->tBatch.uBatchId;
+    tDone.uNumCmds     = pBatch->tBatch.uNumCmds;
+    tDone.uNumFailed   = 0;
+    tDone.uFirstFailed = 0;
+
+    for (i = 0; i < pBatch->tBatch.uNumCmds; i++)
+    {
+        /* If the batch wasn't executed (cleared from queue) all commands failed */
+        if ((uReturnCode != WEXT_OK) || (pBatch->tBatch.pResults[i] != TI_OK))
+        {
+            if (tDone.uNumFailed++ == 0)
+            {
+                tDone.uFirstFailed = i;
+            }
+        }
+    }
+
+    EvHandlerSendEvent (pBatch->drv->tCommon.hEvHandler, IPC_EVENT_CMD_BATCH_DONE, (TI_UINT8 *)&tDone, sizeof(tDone));
+
+    wlanDrvWext_BatchFree (pBatch);
+}
+
+/* 
+ * Handle a batch of private commands: execute all commands in one driver context pass.
+ * If waited for, copy the commands outputs and results to the user upon completion.
+ * Else, return once queued (completion is reported by IPC_EVENT_CMD_BATCH_DONE).
+ */
+static int wlanDrvWext_BatchHandler (TWlanDrvIfObj *drv, ti_private_cmd_t *pCmd)
+{
+    TWextCmdBatch *pBatch;
+    TI_UINT32      i;
+    int            rc;
+
+    /* If the driver is not running, return NOK */
+    if (drv->tCommon.eDriverState != DRV_STATE_RUNNING)
+    {
+        return TI_NOK;
+    }
+
+    pBatch = wlanDrvWext_BatchAlloc (drv, pCmd);
+    if (pBatch == NULL)
+    {
+        os_printf ("wlanDrvWext_BatchHandler() invalid batch or allocation failure\n");
+        return TI_NOK;
+    }
+
+    if (pCmd->flags & PRIVATE_CMD_NOWAIT_FLAG)
+    {
+        /* The batch is freed by wlanDrvWext_BatchDone */
+        rc = cmdHndlr_PostCommand (drv->tCommon.hCmdHndlr, TI_PRIVATE_CMD_BATCH, pCmd->flags, NULL, 0, NULL, 0, 
+                                   (TI_UINT32 *)&pBatch->tBatch, NULL, wlanDrvWext_BatchDone, (TI_HANDLE)pBatch);
+        if (rc != TI_OK)
+        {
+            wlanDrvWext_BatchFree (pBatch);
+        }
+        return rc;
+    }
+
+    rc = cmdHndlr_InsertCommand (drv->tCommon.hCmdHndlr, TI_PRIVATE_CMD_BATCH, pCmd->flags, NULL, 0, NULL, 0, 
+                                 (TI_UINT32 *)&pBatch->tBatch, NULL);
+
+    /* Here we are after the batch was completed - copy the outputs of the succeeded commands and all results */
+    if (rc == TI_OK)
+    {
+        for (i = 0; i < pBatch->tBatch.uNumCmds; i++)
+        {
+            if ((pBatch->tBatch.pResults[i] == TI_OK) && pBatch->tBatch.pCmds[i].out_buffer &&
+                os_memoryCopyToUser (drv, pBatch->pUserCmds[i].out_buffer, pBatch->tBatch.pCmds[i].out_buffer, pBatch->tBatch.pCmds[i].out_buffer_len))
+            {
+                rc = TI_NOK;
+            }
+        }
+        if (pBatch->pUserResults &&
+            os_memoryCopyToUser (drv, pBatch->pUserResults, pBatch->tBatch.pResults, pBatch->tBatch.uNumCmds * sizeof(TI_INT32)))
+        {
+            rc = TI_NOK;
+        }
+        if (rc != TI_OK)
+        {
+            os_printf ("wlanDrvWext_BatchHandler() os_memoryCopyToUser FAILED !!!\n");
+        }
+    }
+
+    wlanDrvWext_BatchFree (pBatch);
+
+    return rc;
+}
+
 /* Generic callback for WEXT commands */
 
 int wlanDrvWext_Handler (struct net_device *dev,
@@ -197,6 +410,11 @@ int wlanDrvWext_Handler (struct net_device *dev,
 		 os_printf ("wlanDrvWext_Handler() os_memoryCopyFromUser FAILED !!!\n");
 		 return TI_NOK;
 	   }
+	   if (my_command.flags & PRIVATE_CMD_BATCH_FLAG)
+	   {
+		 /* A batch of commands is handled separately */
+		 return wlanDrvWext_BatchHandler (drv, &my_command);
+	   }
 	   if (IS_PARAM_FOR_MODULE(my_command.cmd, DRIVER_MODULE_PARAM))
        {
 		   /* If it's a driver level command, handle it here and exit */
@@ -38,27 +38,81 @@
  */
 
 #include "osRgstry_parser.h"
+#include "report.h"
 
 extern void regReadLastDbgState(TWlanDrvIfObjPtr pAdapter);
 
+/* 
+ * The ini file is tokenized once per load into a hashed key->value index,
+ *     so every NdisReadConfiguration is a hash lookup instead of a scan of the whole file.
+ * If the index can't be allocated, the keys are searched in the file as before.
+ */
+#define REG_INDEX_MIN_BUCKETS   64
+#define REG_INDEX_NONE          (-1)
+
+typedef struct
+{
+    char       *pKey;           /* Key start in the ini buffer */
+    char       *pValue;         /* First non-blank character after the '=' */
+    TI_UINT32   uKeyLen;
+    TI_INT32    iNext;          /* Next entry in the same bucket */
+} TRegIndexEntry;
+
+typedef struct
+{
+    TRegIndexEntry *pEntries;
+    TI_INT32       *pBuckets;
+    TI_UINT32       uNumEntries;
+    TI_UINT32       uHashMask;
+    TI_UINT32       uAllocSize;
+    TI_UINT32       uLookups;
+    TI_UINT32       uMisses;
+} TRegIndex;
+
 static char *init_file     = NULL;
 static int init_file_length= 0;
 static PNDIS_CONFIGURATION_PARAMETER pNdisParm;
+static TRegIndex tRegIndex;
+
+static void reg_BuildIndex (TI_HANDLE hOs, char *buf, char *end_buf);
+static void reg_FreeIndex  (TI_HANDLE hOs);
 
 int osInitTable_IniFile (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length)
 {
     TWlanDrvIfObjPtr drv = (TWlanDrvIfObjPtr)hOs;
+#ifdef TI_DBG
+    TI_UINT32 uStartUs, uIndexUs;
+#endif
     
     static NDIS_CONFIGURATION_PARAMETER vNdisParm;
     
     init_file         = file_buf;
     init_file_length  = file_length;
     pNdisParm = &vNdisParm;
+
+#ifdef TI_DBG
+    /* Measure the registry load time, as it is a part of the driver start latency */
+    uStartUs = os_timeStampUs (hOs);
+#endif
+    if (init_file && init_file_length > 0)
+    {
+        reg_BuildIndex (hOs, init_file, init_file + init_file_length);
+    }
+#ifdef TI_DBG
+    uIndexUs = os_timeStampUs (hOs) - uStartUs;
+#endif
     
     regFillInitTable (drv, InitTable);
 #ifdef TI_DBG
     regReadLastDbgState(drv);
+
+    WLAN_OS_REPORT(("Registry loaded in %u us (index %u us): %u keys, %u lookups, %u not found\n",
+                    os_timeStampUs (hOs) - uStartUs, uIndexUs, 
+                    tRegIndex.uNumEntries, tRegIndex.uLookups, tRegIndex.uMisses));
 #endif
+
+    /* The index points into the ini buffer which is valid only during this call */
+    reg_FreeIndex (hOs);
    
     return 0;
 }
@@ -115,6 +169,185 @@ char * ltrim(char *s )
     return s;
 }
 
+    /* Case-insensitive hash of a key (FNV-1a) */
+static TI_UINT32 reg_HashKey (const char *key, TI_UINT32 len)
+{
+    TI_UINT32 hash = 2166136261U;
+    TI_UINT32 i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= (TI_UINT8)tolower(key[i]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+    /* Case-insensitive compare of a key of the given length */
+static TI_BOOL reg_KeyEqual (const char *key1, const char *key2, TI_UINT32 len)
+{
+    TI_UINT32 i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (tolower(key1[i]) != tolower(key2[i]))
+            return TI_FALSE;
+    }
+    return TI_TRUE;
+}
+
+    /* Tokenize the ini buffer into the key->value index: one "key = value" per line, '#' to EOL is a remark */
+static void reg_BuildIndex (TI_HANDLE hOs, char *buf, char *end_buf)
+{
+    TI_UINT32 uMaxEntries = 1;
+    TI_UINT32 uNumBuckets = REG_INDEX_MIN_BUCKETS;
+    TI_UINT32 uHash;
+    TI_INT32  i;
+    char *s, *key, *eol;
+    TRegIndexEntry *pEntry;
+
+    os_memoryZero (hOs, &tRegIndex, sizeof(tRegIndex));
+
+    /* Size the table by the number of lines, with at most half of the buckets used */
+    for (s = buf; s < end_buf; s++)
+    {
+        if (*s == '\n')
+            uMaxEntries++;
+    }
+    while (uNumBuckets < 2 * uMaxEntries)
+        uNumBuckets <<= 1;
+
+    tRegIndex.uAllocSize = uMaxEntries * sizeof(TRegIndexEntry) + uNumBuckets * sizeof(TI_INT32);
+    tRegIndex.pEntries = os_memoryAlloc (hOs, tRegIndex.uAllocSize);
+    if (!tRegIndex.pEntries)
+    {
+        print_err("reg_BuildIndex(): failed to allocate %u bytes, searching the ini file per key\n", tRegIndex.uAllocSize);
+        tRegIndex.uAllocSize = 0;
+        return;
+    }
+    tRegIndex.pBuckets  = (TI_INT32 *)(tRegIndex.pEntries + uMaxEntries);
+    tRegIndex.uHashMask = uNumBuckets - 1;
+    for (uHash = 0; uHash < uNumBuckets; uHash++)
+        tRegIndex.pBuckets[uHash] = REG_INDEX_NONE;
+
+    for ( ; buf < end_buf; buf = eol + 1)
+    {
+        eol = memchr(buf, '\n', end_buf - buf);
+        if (!eol)
+            eol = end_buf;
+
+        /* Key: up to a blank, '=' or remark */
+        key = buf = ltrim(buf);
+        while (buf < eol && *buf != ' ' && *buf != '\t' && *buf != '=' && *buf != '#' && *buf != '\r')
+            buf++;
+        if (buf == key)
+            continue;
+
+        s = ltrim(buf);
+        if (s >= eol || *s != '=')
+            continue;
+
+        /* The first definition of a key is the one used */
+        uHash = reg_HashKey(key, buf - key) & tRegIndex.uHashMask;
+        for (i = tRegIndex.pBuckets[uHash]; i != REG_INDEX_NONE; i = tRegIndex.pEntries[i].iNext)
+        {
+            pEntry = &tRegIndex.pEntries[i];
+            if (pEntry->uKeyLen == (TI_UINT32)(buf - key) && reg_KeyEqual(pEntry->pKey, key, pEntry->uKeyLen))
+                break;
+        }
+        if (i != REG_INDEX_NONE)
+            continue;
+
+        pEntry = &tRegIndex.pEntries[tRegIndex.uNumEntries];
+        pEntry->pKey    = key;
+        pEntry->uKeyLen = buf - key;
+        pEntry->pValue  = ltrim(s + 1);
+        pEntry->iNext   = tRegIndex.pBuckets[uHash];
+        tRegIndex.pBuckets[uHash] = tRegIndex.uNumEntries++;
+    }
+}
+
+static void reg_FreeIndex (TI_HANDLE hOs)
+{
+    if (tRegIndex.pEntries)
+    {
+        os_memoryFree (hOs, tRegIndex.pEntries, tRegIndex.uAllocSize);
+    }
+    os_memoryZero (hOs, &tRegIndex, sizeof(tRegIndex));
+}
+
+    /* Find the value of a key in the index (NULL if not found) */
+static char *reg_FindValue (char *name)
+{
+    TI_UINT32 uLen = strlen(name);
+    TI_INT32  i;
+
+    tRegIndex.uLookups++;
+    for (i = tRegIndex.pBuckets[reg_HashKey(name, uLen) & tRegIndex.uHashMask]; i != REG_INDEX_NONE; i = tRegIndex.pEntries[i].iNext)
+    {
+        if (tRegIndex.pEntries[i].uKeyLen == uLen && reg_KeyEqual(tRegIndex.pEntries[i].pKey, name, uLen))
+            return tRegIndex.pEntries[i].pValue;
+    }
+    tRegIndex.uMisses++;
+    return NULL;
+}
+
+    /* Parse the value found for a key according to the requested type */
+static void reg_ParseValue (PNDIS_STATUS status, char *name, char *buf, NDIS_PARAMETER_TYPE param_type)
+{
+    char *s;
+
+    if( param_type == NdisParameterString )
+    {
+        char *remark = NULL;
+
+        s = strchr(buf, '\n');
+        if( !s )
+            s = buf+strlen(buf);
+        
+        remark = memchr(buf, '#', s - buf);        /* skip remarks */
+        if( remark )
+        {
+            do {        /* remove whitespace  */
+                remark--;
+            } while( *remark == ' ' || *remark == '\t' );    
+            
+            pNdisParm->ParameterData.StringData.Length = remark - buf + 1;
+        }
+        else
+            pNdisParm->ParameterData.StringData.Length = s - buf;
+               
+        pNdisParm->ParameterData.StringData.Buffer = (TI_UINT8*)&pNdisParm->StringBuffer[0];
+        pNdisParm->ParameterData.StringData.MaximumLength = NDIS_MAX_STRING_LEN;
+        if( !pNdisParm->ParameterData.StringData.Length > NDIS_MAX_STRING_LEN )
+        {
+            *status = NDIS_STATUS_BUFFER_TOO_SHORT;
+            return;
+        }
+        memcpy(pNdisParm->ParameterData.StringData.Buffer, buf, pNdisParm->ParameterData.StringData.Length);
+        print_info("NdisReadConfiguration(): %s = (%d)'%s'\n", name, pNdisParm->ParameterData.StringData.Length, pNdisParm->ParameterData.StringData.Buffer);
+    }
+    else if( param_type == NdisParameterInteger )
+    {
+        char *end_p;
+        pNdisParm->ParameterData.IntegerData = simple_strtol(buf, &end_p, 0);
+        if (end_p && *end_p && *end_p!=' ' && *end_p!='\n'
+            && *end_p!='\r' && *end_p!='\t')
+        {
+            print_err("\n...init_config: invalid int value for <%s> : %s\n", name, buf );
+            return;
+        }
+        /*print_deb(" NdisReadConfiguration(): buf = %p (%.20s)\n", buf, buf );*/
+        print_info("NdisReadConfiguration(): %s = %d\n", name, (TI_INT32) pNdisParm->ParameterData.IntegerData);
+    }
+    else
+    {
+        print_err("NdisReadConfiguration(): unknow parameter type %d for %s\n", param_type, name );
+        return;
+    }
+    *status = NDIS_STATUS_SUCCESS;
+}
+
 void NdisReadConfiguration( OUT PNDIS_STATUS  status, OUT PNDIS_CONFIGURATION_PARAMETER  *param_value,
     IN NDIS_HANDLE  config_handle, IN PNDIS_STRING  keyword, IN NDIS_PARAMETER_TYPE  param_type )
 {
@@ -136,6 +369,14 @@ void NdisReadConfiguration( OUT PNDIS_STATUS  status, OUT PNDIS_CONFIGURATION_PA
 
     memset(pNdisParm, 0, sizeof(NDIS_CONFIGURATION_PARAMETER));
 
+    /* Use the ini file index if available */
+    if( tRegIndex.pEntries )
+    {
+        if( (buf = reg_FindValue(name)) != NULL )
+            reg_ParseValue(status, name, buf, param_type);
+        return;
+    }
+
     while(buf < end_buf)
     {
         buf = ltrim(buf);
@@ -151,55 +392,7 @@ void NdisReadConfiguration( OUT PNDIS_STATUS  status, OUT PNDIS_CONFIGURATION_PA
             continue;
         }
         buf = ltrim(buf);
-        if( param_type == NdisParameterString )
-        {
-            char *remark = NULL;
-
-            s = strchr(buf, '\n');
-            if( !s )
-                s = buf+strlen(buf);
-            
-            remark = memchr(buf, '#', s - buf);        /* skip remarks */
-            if( remark )
-            {
-                do {        /* remove whitespace  */
-                    remark--;
-                } while( *remark == ' ' || *remark == '\t' );    
-                
-                pNdisParm->ParameterData.StringData.Length = remark - buf + 1;
-            }
-            else
-                pNdisParm->ParameterData.StringData.Length = s - buf;
-                   
-            pNdisParm->ParameterData.StringData.Buffer = (TI_UINT8*)&pNdisParm->StringBuffer[0];
-            pNdisParm->ParameterData.StringData.MaximumLength = NDIS_MAX_STRING_LEN;
-            if( !pNdisParm->ParameterData.StringData.Length > NDIS_MAX_STRING_LEN )
-            {
-                *status = NDIS_STATUS_BUFFER_TOO_SHORT;
-                return;
-            }
-            memcpy(pNdisParm->ParameterData.StringData.Buffer, buf, pNdisParm->ParameterData.StringData.Length);
-            print_info("NdisReadConfiguration(): %s = (%d)'%s'\n", name, pNdisParm->ParameterData.StringData.Length, pNdisParm->ParameterData.StringData.Buffer);
-        }
-        else if( param_type == NdisParameterInteger )
-        {
-	    char *end_p;
-            pNdisParm->ParameterData.IntegerData = simple_strtol(buf, &end_p, 0);
-            if (end_p && *end_p && *end_p!=' ' && *end_p!='\n'
-		&& *end_p!='\r' && *end_p!='\t')
-            {
-                print_err("\n...init_config: invalid int value for <%s> : %s\n", name, buf );
-                return;
-            }
-            /*print_deb(" NdisReadConfiguration(): buf = %p (%.20s)\n", buf, buf );*/
-            print_info("NdisReadConfiguration(): %s = %d\n", name, (TI_INT32) pNdisParm->ParameterData.IntegerData);
-        }
-        else
-        {
-            print_err("NdisReadConfiguration(): unknow parameter type %d for %s\n", param_type, name );
-            return;
-        }
-        *status = NDIS_STATUS_SUCCESS;
+        reg_ParseValue(status, name, buf, param_type);
         return;
 
     }
@@ -0,0 +1,248 @@
+/*
+ * osStatsPage.c
+ *
+ * All rights reserved.                                                  
+ *                                                                       
+ * Redistribution and use in source and binary forms, with or without    
+ * modification, are permitted provided that the following conditions    
+ * are met:                                                              
+ *                                                                       
+ *  * Redistributions of source code must retain the above copyright     
+ *    notice, this list of conditions and the following disclaimer.      
+ *  * Redistributions in binary form must reproduce the above copyright  
+ *    notice, this list of conditions and the following disclaimer in    
+ *    the documentation and/or other materials provided with the         
+ *    distribution.                                                      
+ *  * Neither the name Texas Instruments nor the names of its            
+ *    contributors may be used to endorse or promote products derived    
+ *    from this software without specific prior written permission.      
+ *                                                                       
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS   
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT     
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT      
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT   
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file  osStatsPage.c
+ *  \brief Linux export of the statistics page (see TI_StatsPage.h).
+ *
+ *  \see   StatsPage.c
+ */
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/fs.h>
+#include <linux/mm.h>
+#include <linux/slab.h>
+#include <linux/vmalloc.h>
+#include <linux/miscdevice.h>
+#include <linux/delay.h>
+#include <asm/uaccess.h>
+#include "tidef.h"
+#include "osApi.h"
+#include "TI_StatsPage.h"
+
+/* 
+ * The page is updated in the preemptible driver task, so a reader that finds it being 
+ *   updated sleeps to let the driver complete the update, and gives up after a while. 
+ */
+#define OS_STATS_PAGE_READ_RETRIES      10
+#define OS_STATS_PAGE_RETRY_SLEEP_MS    1
+
+
+/* The exported page object */
+typedef struct
+{
+    TStatsPage          *pPage;
+    TI_UINT32           uSize;
+    struct miscdevice   tDev;
+} TOsStatsPage;
+
+static TOsStatsPage *pOsStatsPage = NULL;
+
+
+/**
+ * \fn     osStatsPage_Read
+ * \brief  Read a consistent copy of the statistics page
+ *
+ * The page is copied again if it was updated during the copy (the driver never 
+ *   waits for the readers), up to OS_STATS_PAGE_READ_RETRIES times (then -EAGAIN 
+ *   is returned). The file position allows partial reads.
+ */
+static ssize_t osStatsPage_Read (struct file *pFile, char __user *pUserBuf, size_t uCount, loff_t *pPos)
+{
+    TOsStatsPage *pStats = (TOsStatsPage *)pFile->private_data;
+    TI_UINT8     *pCopy;
+    TI_UINT32    uSeq;
+    TI_UINT32    uRetry;
+    size_t       uLen;
+
+    if (*pPos >= pStats->uSize)
+    {
+        return 0;
+    }
+    uLen = min (uCount, (size_t)(pStats->uSize - *pPos));
+
+    pCopy = kmalloc (pStats->uSize, GFP_KERNEL);
+    if (pCopy == NULL)
+    {
+        return -ENOMEM;
+    }
+
+    for (uRetry = 0; ; uRetry++)
+    {
+        if (uRetry == OS_STATS_PAGE_READ_RETRIES)
+        {
+            kfree (pCopy);
+            return -EAGAIN;
+        }
+
+        /* If the page is being updated, sleep so the (possibly preempted) driver task can complete it */
+        uSeq = ACCESS_ONCE(pStats->pPage->uSeq);
+        if (uSeq & 1)
+        {
+            msleep (OS_STATS_PAGE_RETRY_SLEEP_MS);
+            continue;
+        }
+
+        smp_rmb ();
+        memcpy (pCopy, pStats->pPage, pStats->uSize);
+        smp_rmb ();
+
+        if (ACCESS_ONCE(pStats->pPage->uSeq) == uSeq)
+        {
+            break;
+        }
+    }
+
+    if (copy_to_user (pUserBuf, pCopy + *pPos, uLen))
+    {
+        kfree (pCopy);
+        return -EFAULT;
+    }
+    kfree (pCopy);
+
+    *pPos += uLen;
+    return (ssize_t)uLen;
+}
+
+
+/**
+ * \fn     osStatsPage_Mmap
+ * \brief  Map the statistics page to user space (read-only)
+ */
+static int osStatsPage_Mmap (struct file *pFile, struct vm_area_struct *vma)
+{
+    TOsStatsPage *pStats = (TOsStatsPage *)pFile->private_data;
+
+    if (vma->vm_flags & VM_WRITE)
+    {
+        return -EPERM;
+    }
+    vma->vm_flags &= ~VM_MAYWRITE;
+
+    return remap_vmalloc_range (vma, pStats->pPage, vma->vm_pgoff);
+}
+
+
+static int osStatsPage_Open (struct inode *pInode, struct file *pFile)
+{
+    if (pOsStatsPage == NULL)
+    {
+        return -ENODEV;
+    }
+    pFile->private_data = pOsStatsPage;
+
+    return 0;
+}
+
+
+static const struct file_operations tOsStatsPageFops = {
+    .owner      = THIS_MODULE,
+    .open       = osStatsPage_Open,
+    .read       = osStatsPage_Read,
+    .mmap       = osStatsPage_Mmap,
+    .llseek     = default_llseek,
+};
+
+
+/** 
+ * \fn     os_StatsPageCreate
+ * \brief  Allocate the statistics page and register the STATS_PAGE_DEV_NAME device.
+ * 
+ * \param  OsContext - The OS handle
+ * \param  uSize     - The page size (sizeof(TStatsPage))
+ * \return Pointer to the page, or NULL if failed
+ * \sa     os_StatsPageDestroy
+ */
+void *os_StatsPageCreate (TI_HANDLE OsContext, TI_UINT32 uSize)
+{
+    TOsStatsPage *pStats;
+
+    if (pOsStatsPage != NULL)
+    {
+        return NULL;
+    }
+
+    pStats = kzalloc (sizeof(TOsStatsPage), GFP_KERNEL);
+    if (pStats == NULL)
+    {
+        return NULL;
+    }
+
+    /* Zeroed and suitable for mapping to user space */
+    pStats->uSize = uSize;
+    pStats->pPage = (TStatsPage *)vmalloc_user (PAGE_ALIGN(uSize));
+    if (pStats->pPage == NULL)
+    {
+        kfree (pStats);
+        return NULL;
+    }
+
+    pStats->tDev.minor = MISC_DYNAMIC_MINOR;
+    pStats->tDev.name  = STATS_PAGE_DEV_NAME;
+    pStats->tDev.fops  = &tOsStatsPageFops;
+    if (misc_register (&pStats->tDev) != 0)
+    {
+        vfree (pStats->pPage);
+        kfree (pStats);
+        return NULL;
+    }
+
+    pOsStatsPage = pStats;
+
+    return pStats->pPage;
+}
+
+
+/** 
+ * \fn     os_StatsPageDestroy
+ * \brief  Unregister the statistics page device and free the page.
+ * 
+ * \param  OsContext - The OS handle
+ * \param  pPage     - The page returned by os_StatsPageCreate
+ * \return 
+ * \sa     os_StatsPageCreate
+ */
+void os_StatsPageDestroy (TI_HANDLE OsContext, void *pPage)
+{
+    TOsStatsPage *pStats = pOsStatsPage;
+
+    if ((pStats == NULL) || (pStats->pPage != pPage))
+    {
+        return;
+    }
+
+    pOsStatsPage = NULL;
+    misc_deregister (&pStats->tDev);
+    vfree (pStats->pPage);
+    kfree (pStats);
+}
@@ -301,6 +301,26 @@ TI_UINT32 os_timeStampMs (TI_HANDLE OsContext)
 }
 
 
+/****************************************************************************************
+ *                        os_timeStampMonoMs()                                 
+ ****************************************************************************************
+DESCRIPTION:	This function returns a monotonic milliseconds counter, which is not
+				affected by system time changes (settimeofday, NTP steps).
+
+ARGUMENTS:		OsContext - our adapter context.
+
+RETURN:			
+
+NOTES:         	Use it for measuring intervals. The counter wraps around at 2^32 msec.
+*****************************************************************************************/
+TI_UINT32 os_timeStampMonoMs (TI_HANDLE OsContext)
+{
+   struct timespec ts;
+   ktime_get_ts(&ts);
+   return ts.tv_sec*1000 + ts.tv_nsec/1000000;
+}
+
+
 /****************************************************************************************
  *                        os_timeStampUs()                                 
  ****************************************************************************************
@@ -346,8 +366,19 @@ void os_StalluSec (TI_HANDLE OsContext, TI_UINT32 uSec)
  *																						*
  ****************************************************************************************
  * OS protection is implemented as spin_lock_irqsave and spin_unlock_irqrestore  								*
+ * Each protection object has its own spinlock, so two objects can be nested (e.g. the timer wheel 	*
+ *   lock inside the context critical section). The driver object lock (drv->lock) is left to the 	*
+ *   wake lock functions below, which are never called within a protection object lock.				*
+ * A NULL protection handle uses the driver object lock.												*
  ****************************************************************************************/
 
+/* A dedicated protection object (see os_protectCreate) */
+typedef struct
+{
+    spinlock_t      lock;
+    unsigned long   flags;
+} TOsProtect;
+
 
 /****************************************************************************************
  *                        os_protectCreate()                                 
@@ -360,11 +391,20 @@ RETURN:			A handle of the created mutex/spinlock.
 				TI_HANDLE_INVALID if there is insufficient memory available or problems
 				initializing the mutex
 
-NOTES:         	
+NOTES:         	Returns NULL (i.e. use the driver object lock) if the allocation failed.
 *****************************************************************************************/
 TI_HANDLE os_protectCreate (TI_HANDLE OsContext)
 {
-    return NULL;
+    TOsProtect *pProtect = kmalloc (sizeof(TOsProtect), GFP_KERNEL);
+
+    if (pProtect == NULL)
+    {
+        return NULL;
+    }
+
+    spin_lock_init (&pProtect->lock);
+
+    return (TI_HANDLE)pProtect;
 }
 
 
@@ -381,6 +421,10 @@ NOTES:
 *****************************************************************************************/
 void os_protectDestroy (TI_HANDLE OsContext, TI_HANDLE ProtectCtx)
 {
+    if (ProtectCtx)
+    {
+        kfree (ProtectCtx);
+    }
 }
 
 
@@ -397,7 +441,16 @@ NOTES:
 *****************************************************************************************/
 void os_protectLock (TI_HANDLE OsContext, TI_HANDLE ProtectContext)
 {
-    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)OsContext;
+    TWlanDrvIfObj *drv      = (TWlanDrvIfObj *)OsContext;
+    TOsProtect    *pProtect = (TOsProtect *)ProtectContext;
+    unsigned long  flags;
+
+    if (pProtect)
+    {
+        spin_lock_irqsave (&pProtect->lock, flags);
+        pProtect->flags = flags;
+        return;
+    }
 
     spin_lock_irqsave (&drv->lock, drv->flags);
 }
@@ -416,7 +469,14 @@ NOTES:
 *****************************************************************************************/
 void os_protectUnlock (TI_HANDLE OsContext, TI_HANDLE ProtectContext)
 {
-    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)OsContext;
+    TWlanDrvIfObj *drv      = (TWlanDrvIfObj *)OsContext;
+    TOsProtect    *pProtect = (TOsProtect *)ProtectContext;
+
+    if (pProtect)
+    {
+        spin_unlock_irqrestore (&pProtect->lock, pProtect->flags);
+        return;
+    }
     
     spin_unlock_irqrestore (&drv->lock, drv->flags);
 }
@@ -481,6 +541,20 @@ TI_BOOL os_receivePacket(TI_HANDLE OsContext, void *pRxDesc ,void *pPacket, TI_U
    drv->stats.rx_packets++;
    drv->stats.rx_bytes += skb->len;
 
+#ifdef TI_RX_NAPI
+   /* Add the skb to the current Rx batch, and hand the batch to the NAPI poll at the burst end */
+   if (drv->uRxBatchBudget)
+   {
+       __skb_queue_tail (&drv->tRxBatch, skb);
+       if ((((RxIfDescriptor_t *)pRxDesc)->driverFlags & DRV_RX_FLAG_END_OF_BURST) ||
+           (skb_queue_len (&drv->tRxBatch) >= drv->uRxBatchBudget))
+       {
+           os_RxBatchFlush (drv);
+       }
+       return TI_TRUE;
+   }
+#endif
+
    /* Send the skb to the TCP stack. 
     * it responsibly of the Linux kernel to free the skb
     */
@@ -495,6 +569,193 @@ TI_BOOL os_receivePacket(TI_HANDLE OsContext, void *pRxDesc ,void *pPacket, TI_U
    return TI_TRUE;
 }
 
+/****************************************************************************************
+ *                        os_receiveSubPacket()                                 
+ ****************************************************************************************
+DESCRIPTION:    Pass a packet located within a received Rx buffer (e.g. an A-MSDU subframe)
+                to the network stack without copy.
+
+ARGUMENTS:      pParentPacket - The Rx buffer containing the packet
+                pEthData      - The packet start (ethernet header) within the Rx buffer
+                Length        - The packet length
+
+RETURN:         TI_TRUE if passed to the stack, TI_FALSE if the packet can't be shared
+                (the skb clone failed, or its IP header would be misaligned) - the caller
+                should copy it then.
+
+NOTES:          The packet is an skb clone sharing the parent skb data. The parent is still 
+                freed by the driver (and is then not recycled to the Rx pool), and the data
+                is released when the stack frees the last clone.
+                The clone keeps the parent's truesize, since it pins the whole Rx buffer
+                until freed (so the socket memory accounting still bounds the real usage).
+*****************************************************************************************/
+TI_BOOL os_receiveSubPacket (TI_HANDLE OsContext, void *pParentPacket, void *pEthData, TI_UINT16 Length)
+{
+   TWlanDrvIfObj  *drv     = (TWlanDrvIfObj *)OsContext;
+   unsigned char  *pdata   = (unsigned char *)((TI_UINT32)pParentPacket & ~(TI_UINT32)0x3);
+   rx_head_t      *rx_head = (rx_head_t *)(pdata -  WSPI_PAD_BYTES - RX_HEAD_LEN_ALIGNED);
+   struct sk_buff *skb;
+
+#ifndef CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS
+   /* The packet is shared in place, so if its IP header isn't 4 bytes aligned it must be copied
+        (the copy path reserves PADDING_ETH_PACKET_SIZE for that) */
+   if (((TI_UINT32)pEthData + ETH_HLEN) & 0x3)
+   {
+       return TI_FALSE;
+   }
+#endif
+
+   skb = skb_clone (rx_head->skb, GFP_ATOMIC);
+   if (skb == NULL)
+   {
+       return TI_FALSE;
+   }
+
+   /* Point the clone to the packet within the shared data */
+   skb->data     = pEthData;
+   skb_reset_tail_pointer(skb);
+   skb->len      = 0;
+   skb->data_len = 0;
+   skb_put(skb, Length);
+
+   skb->dev       = drv->netdev;
+   skb->protocol  = eth_type_trans(skb, drv->netdev);
+   skb->ip_summed = CHECKSUM_NONE;
+
+   drv->stats.rx_packets++;
+   drv->stats.rx_bytes += skb->len;
+
+#ifdef TI_RX_NAPI
+   /* Add the skb to the current Rx batch (handed to the NAPI poll with the following packets) */
+   if (drv->uRxBatchBudget)
+   {
+       __skb_queue_tail (&drv->tRxBatch, skb);
+       if (skb_queue_len (&drv->tRxBatch) >= drv->uRxBatchBudget)
+       {
+           os_RxBatchFlush (drv);
+       }
+       return TI_TRUE;
+   }
+#endif
+
+   os_wake_lock_timeout_enable(drv);
+
+   netif_rx_ni(skb);
+
+   return TI_TRUE;
+}
+
+#ifdef TI_RX_NAPI
+
+/* Get the histogram bin of a packets count (see OS_RX_BATCH_HIST_BINS) */
+static inline TI_UINT32 os_RxBatchHistBin (TI_UINT32 uCount)
+{
+    TI_UINT32 uBin = 0;
+
+    while (uCount && uBin < OS_RX_BATCH_HIST_BINS - 1)
+    {
+        uCount >>= 1;
+        uBin++;
+    }
+
+    return uBin;
+}
+
+/****************************************************************************************
+ *                        os_RxBatchFlush()                                 
+ ****************************************************************************************
+DESCRIPTION:    Hand the current Rx batch to the NAPI poll and schedule it.
+                Called from the driver task at a burst end, when the batch reaches the poll 
+                budget, and when the driver task completes.
+
+ARGUMENTS:      drv - The driver object
+
+RETURN:         
+
+NOTES:          The wake-lock timeout is enabled once per batch.
+*****************************************************************************************/
+void os_RxBatchFlush (TWlanDrvIfObj *drv)
+{
+    TI_UINT32     uLen = skb_queue_len (&drv->tRxBatch);
+    unsigned long flags;
+
+    if (uLen == 0)
+    {
+        return;
+    }
+
+    /* If the interface is down the poll is disabled, so drop the batch */
+    if (!netif_running (drv->netdev))
+    {
+        drv->tRxBatchStats.uDropped += uLen;
+        __skb_queue_purge (&drv->tRxBatch);
+        return;
+    }
+
+    drv->tRxBatchStats.uBatches++;
+    drv->tRxBatchStats.aPktsPerBatch[os_RxBatchHistBin (uLen)]++;
+
+    spin_lock_irqsave (&drv->tRxNapiQueue.lock, flags);
+    skb_queue_splice_tail_init (&drv->tRxBatch, &drv->tRxNapiQueue);
+    spin_unlock_irqrestore (&drv->tRxNapiQueue.lock, flags);
+
+    os_wake_lock_timeout_enable (drv);
+
+    /* Raise the Rx softirq from the driver task (process context) when enabling bottom halves */
+    local_bh_disable ();
+    napi_schedule (&drv->tRxNapi);
+    local_bh_enable ();
+}
+
+/****************************************************************************************
+ *                        os_RxBatchPoll()                                 
+ ****************************************************************************************
+DESCRIPTION:    The NAPI poll - deliver up to the budget Rx packets to the stack through GRO.
+
+ARGUMENTS:      napi   - The driver NAPI context
+                budget - Max packets to deliver (the NAPI weight, set to the Rx batch budget)
+
+RETURN:         The number of delivered packets
+
+NOTES:          The HW doesn't provide the packets checksum, so they are passed as CHECKSUM_NONE
+                and the stack verifies the checksum once (summing it here would add a pass).
+*****************************************************************************************/
+int os_RxBatchPoll (struct napi_struct *napi, int budget)
+{
+    TWlanDrvIfObj  *drv   = container_of (napi, TWlanDrvIfObj, tRxNapi);
+    struct sk_buff *skb;
+    int             iDone = 0;
+
+    while (iDone < budget  &&  (skb = skb_dequeue (&drv->tRxNapiQueue)) != NULL)
+    {
+        napi_gro_receive (napi, skb);
+        iDone++;
+    }
+
+    drv->tRxBatchStats.uPolls++;
+    drv->tRxBatchStats.uPackets += iDone;
+    drv->tRxBatchStats.aPktsPerPoll[os_RxBatchHistBin (iDone)]++;
+
+    if (iDone < budget)
+    {
+        napi_complete (napi);
+
+        /* A batch handed over before the completion didn't schedule the poll, so check again */
+        if (!skb_queue_empty (&drv->tRxNapiQueue))
+        {
+            napi_schedule (napi);
+        }
+    }
+    else 
+    {
+        drv->tRxBatchStats.uBudgetExhausted++;
+    }
+
+    return iDone;
+}
+
+#endif /* TI_RX_NAPI */
+
 /*-----------------------------------------------------------------------------
   
 Routine Name:  os_timerHandlr
@@ -928,3 +1189,60 @@ void os_Trace (TI_HANDLE OsContext, TI_UINT32 uLevel, TI_UINT32 uFileId, TI_UINT
 void os_SetDrvThreadPriority (TI_HANDLE OsContext, TI_UINT32 uWlanDrvThreadPriority)
 {
 }
+
+/** 
+ * \fn     os_SetRxBatchBudget
+ * \brief  Called upon init to set the max Rx packets delivered to the stack per NAPI poll.
+ *         The budget is used as the NAPI weight. Zero disables the batching (packets are 
+ *         passed separately with netif_rx_ni).
+ * 
+ * \param  OsContext      - The OS handle
+ * \param  uRxBatchBudget - Max Rx packets per poll
+ * \return 
+ */
+void os_SetRxBatchBudget (TI_HANDLE OsContext, TI_UINT32 uRxBatchBudget)
+{
+#ifdef TI_RX_NAPI
+    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)OsContext;
+
+    /* Deliver the packets batched with the previous budget */
+    os_RxBatchFlush (drv);
+
+    drv->uRxBatchBudget = uRxBatchBudget;
+    drv->tRxBatchStats.uRxBatchBudget = uRxBatchBudget;
+    if (uRxBatchBudget)
+    {
+        drv->tRxNapi.weight = uRxBatchBudget;
+    }
+#endif
+}
+
+/** 
+ * \fn     os_GetRxBatchStats / os_ResetRxBatchStats
+ * \brief  Get / Reset the Rx batched delivery statistics.
+ * 
+ * \param  OsContext - The OS handle
+ * \param  pStats    - The returned statistics
+ * \return TI_OK, or TI_NOK if batched delivery is not supported by the kernel
+ */
+TI_STATUS os_GetRxBatchStats (TI_HANDLE OsContext, TOsRxBatchStats *pStats)
+{
+#ifdef TI_RX_NAPI
+    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)OsContext;
+
+    memcpy (pStats, &drv->tRxBatchStats, sizeof(TOsRxBatchStats));
+    return TI_OK;
+#else
+    return TI_NOK;
+#endif
+}
+
+void os_ResetRxBatchStats (TI_HANDLE OsContext)
+{
+#ifdef TI_RX_NAPI
+    TWlanDrvIfObj *drv = (TWlanDrvIfObj *)OsContext;
+
+    memset (&drv->tRxBatchStats, 0, sizeof(TOsRxBatchStats));
+    drv->tRxBatchStats.uRxBatchBudget = drv->uRxBatchBudget;
+#endif
+}
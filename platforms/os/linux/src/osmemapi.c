@@ -453,6 +453,46 @@ os_memoryCompare(
 
 
 
+/****************************************************************************************
+ *                        os_memoryBarrierAcquire()                                 
+ ****************************************************************************************
+DESCRIPTION:    Order a preceding read of a shared index before the following memory accesses.
+
+ARGUMENTS:		OsContext	- our adapter context.
+
+RETURN:			None
+
+NOTES:          The following writes depend on the index value, so a read barrier is enough.
+*****************************************************************************************/
+void
+os_memoryBarrierAcquire(
+        TI_HANDLE OsContext
+        )
+{
+   smp_rmb();
+}
+
+
+/****************************************************************************************
+ *                        os_memoryBarrierRelease()                                 
+ ****************************************************************************************
+DESCRIPTION:    Order all preceding memory accesses before a following write of a shared index.
+
+ARGUMENTS:		OsContext	- our adapter context.
+
+RETURN:			None
+
+NOTES:          Both reads and writes must complete before the index write, so a full barrier is used.
+*****************************************************************************************/
+void
+os_memoryBarrierRelease(
+        TI_HANDLE OsContext
+        )
+{
+   smp_mb();
+}
+
+
 /****************************************************************************************
  *                        os_memoryCopyFromUser()                                 
  ****************************************************************************************
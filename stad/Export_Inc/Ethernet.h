@@ -69,6 +69,7 @@ typedef struct
 #define ETHERTYPE_EAPOL                         0x888e
 #define ETHERTYPE_PREAUTH_EAPOL                 0x88c7
 #define ETHERTYPE_IP                            0x0800
+#define ETHERTYPE_IPV6                          0x86dd
 #define ETHERTYPE_APPLE_AARP                    0x80f3
 #define ETHERTYPE_DIX_II_IPX                    0x8137
 
@@ -107,6 +107,7 @@ enum
     IPC_EVENT_RE_AUTH_TERMINATED,
     IPC_EVENT_TIMEOUT,
     IPC_EVENT_GWSI,
+    IPC_EVENT_CMD_BATCH_DONE,
     IPC_EVENT_MAX
 };
 
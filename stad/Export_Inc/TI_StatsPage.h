@@ -0,0 +1,136 @@
+/*
+ * TI_StatsPage.h
+ *
+ * All rights reserved.                                                  
+ *                                                                       
+ * Redistribution and use in source and binary forms, with or without    
+ * modification, are permitted provided that the following conditions    
+ * are met:                                                              
+ *                                                                       
+ *  * Redistributions of source code must retain the above copyright     
+ *    notice, this list of conditions and the following disclaimer.      
+ *  * Redistributions in binary form must reproduce the above copyright  
+ *    notice, this list of conditions and the following disclaimer in    
+ *    the documentation and/or other materials provided with the         
+ *    distribution.                                                      
+ *  * Neither the name Texas Instruments nor the names of its            
+ *    contributors may be used to endorse or promote products derived    
+ *    from this software without specific prior written permission.      
+ *                                                                       
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS   
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT     
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT      
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT   
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*--------------------------------------------------------------------------*/
+/* Module:		TI_StatsPage.h                                              */
+/*                                                                          */
+/* Purpose:		The statistics page shared with user space                  */
+/*                                                                          */
+/*--------------------------------------------------------------------------*/
+#ifndef _TI_STATS_PAGE_H
+#define _TI_STATS_PAGE_H
+
+#include "tidef.h"
+
+/*
+ * The statistics page is updated periodically by the driver (see StatsPage.c), and can be 
+ *   mapped read-only or read by user space through the STATS_PAGE_DEV_NAME device, with no 
+ *   command to the driver.
+ *
+ * The page is protected by a sequence lock: uSeq is odd while the page is updated.
+ * A reader of the mapped page should copy it only when uSeq is even, and retry if uSeq 
+ *   changed during the copy. The update runs in the preemptible driver task, so a reader 
+ *   that finds uSeq odd should sleep (not spin) before retrying.
+ * A read() of the device returns a consistent copy, or fails with EAGAIN if the page was 
+ *   being updated on all its retries.
+ * Fields are only added at the end of the page (uSize tells the driver's page size), and 
+ *   uVersion is incremented if the existing fields are changed.
+ */
+
+#define STATS_PAGE_DEV_NAME         "tiwlan_stats"
+#define STATS_PAGE_MAGIC            0x53544154      /* "STAT" */
+#define STATS_PAGE_VERSION          1
+#define STATS_PAGE_NUM_OF_AC        4               /* Per AC entries (BE, BK, VI, VO) */
+
+/* The link state (published by currBss) */
+typedef struct
+{
+    TI_UINT32       bConnected;
+    TI_UINT32       uBand;                          /* ERadioBand */
+    TI_UINT32       uChannel;
+    TI_INT32        iRssi;                          /* Average RSSI (dBm) from the last quality indication */
+    TI_UINT8        aBssid[6];
+    TI_UINT8        aReserved[2];
+} TStatsPageLink;
+
+/* The Rx counters (published by rxData) */
+typedef struct
+{
+    TI_UINT32       uRecvOk;
+    TI_UINT32       uDirectedFramesRecv;
+    TI_UINT32       uDirectedBytesRecv;
+    TI_UINT32       uMulticastFramesRecv;
+    TI_UINT32       uMulticastBytesRecv;
+    TI_UINT32       uBroadcastFramesRecv;
+    TI_UINT32       uBroadcastBytesRecv;
+    TI_UINT32       uExcludedFrames;                /* Dropped by the encryption exclusion rules */
+    TI_UINT32       uLastDataPktRate;               /* ERate of the last Rx data packet */
+} TStatsPageRx;
+
+/* The Tx counters and queue state of an AC (published by txCtrl) */
+typedef struct
+{
+    TI_UINT32       uXmitOk;
+    TI_UINT32       uDirectedFramesXmit;
+    TI_UINT32       uDirectedBytesXmit;
+    TI_UINT32       uMulticastFramesXmit;
+    TI_UINT32       uMulticastBytesXmit;
+    TI_UINT32       uBroadcastFramesXmit;
+    TI_UINT32       uBroadcastBytesXmit;
+    TI_UINT32       uRetryFailCounter;
+    TI_UINT32       uTxTimeoutCounter;
+    TI_UINT32       uNoLinkCounter;
+    TI_UINT32       uOtherFailCounter;
+    TI_UINT32       uNumPackets;                    /* Packets counted in the delay sum */
+    TI_UINT32       uSumTotalDelayMs;               /* Sum of the packets total Tx delay */
+    TI_UINT32       bBusy;                          /* The AC HW queue is busy (backpressure) */
+    TI_UINT32       bAdmitted;                      /* The AC is allowed to transmit */
+} TStatsPageTxAc;
+
+/* The traffic rates (published by TrafficMonitor) */
+typedef struct
+{
+    TI_UINT32       uDirectRxFrames;                /* Directed Rx frames in the last bandwidth window */
+    TI_UINT32       uDirectTxFrames;                /* Directed Tx frames in the last bandwidth window */
+    TI_UINT32       uWindowMs;                      /* The bandwidth window */
+} TStatsPageTraffic;
+
+/* The statistics page */
+typedef struct
+{
+    TI_UINT32           uMagic;
+    TI_UINT32           uVersion;
+    TI_UINT32           uSize;                      /* sizeof(TStatsPage) in the driver */
+    TI_UINT32           uSeq;                       /* Odd while the page is updated */
+    TI_UINT32           uPublishTimeMs;             /* The driver time of the last update */
+    TI_UINT32           uPublishCount;
+    TI_UINT32           uPublishPeriodMs;
+    TI_UINT32           aReserved[1];
+
+    TStatsPageLink      tLink;
+    TStatsPageRx        tRx;
+    TStatsPageTxAc      aTx[STATS_PAGE_NUM_OF_AC];
+    TStatsPageTraffic   tTraffic;
+} TStatsPage;
+
+#endif /* _TI_STATS_PAGE_H */
@@ -345,6 +345,39 @@ IP&Port classification table  */
 #define  TX_SEND_PACE_THRESH_MAX                16
 #define  TX_SEND_PACE_THRESH_DEF_WIFI_MODE      1
 
+/* Tx burst scheduler: dequeue a batch per AC by deficit round robin (0 = per-packet round robin) */
+#define  TX_BURST_SCHED_DEF                     0
+#define  TX_BURST_SCHED_MIN                     0
+#define  TX_BURST_SCHED_MAX                     1
+
+/* Tx burst scheduler: max packets dequeued from one AC in one batch */
+#define  TX_BURST_MAX_PKTS_DEF                  8
+#define  TX_BURST_MAX_PKTS_MIN                  1
+#define  TX_BURST_MAX_PKTS_MAX                  16
+
+/* Tx burst scheduler: bytes added to each AC deficit per round (VO/VI are also served first in each round) */
+#define  TX_BURST_QUANTUM_MIN                   256
+#define  TX_BURST_QUANTUM_MAX                   65535
+#define  TX_BURST_QUANTUM_BE_DEF                3000
+#define  TX_BURST_QUANTUM_BK_DEF                1500
+#define  TX_BURST_QUANTUM_VI_DEF                6000
+#define  TX_BURST_QUANTUM_VO_DEF                3000
+
+/* Tx data queues backend: lock-free SPSC ring per AC instead of the locked queues (0 = locked queues) */
+#define  TX_DATA_LOCK_FREE_DEF                  0
+#define  TX_DATA_LOCK_FREE_MIN                  0
+#define  TX_DATA_LOCK_FREE_MAX                  1
+
+/* Tx data rings low watermark for resuming the network stack, in percents of the ring size */
+#define  TX_RING_WAKE_PERCENT_DEF               50
+#define  TX_RING_WAKE_PERCENT_MIN               0
+#define  TX_RING_WAKE_PERCENT_MAX               100
+
+/* Tx data WLAN header templates cache (per destination, TID and Ethertype) enable */
+#define  TX_HDR_CACHE_ENABLE_DEF                1
+#define  TX_HDR_CACHE_ENABLE_MIN                0
+#define  TX_HDR_CACHE_ENABLE_MAX                1
+
 #define  QOS_TX_BLKS_THRESHOLD_MIN              0
 #define  QOS_TX_BLKS_THRESHOLD_MAX              200
 
@@ -488,6 +521,16 @@ IP&Port classification table  */
 #define  HT_BA_INACTIVITY_TIMEOUT_MAX               0xffff
 #define  HT_BA_INACTIVITY_TIMEOUT_DEF               10000
 
+/* BA receiver window size (in packets) configured to the FW and used for Rx reordering */
+#define  HT_BA_RX_WIN_SIZE_MIN                      1
+#define  HT_BA_RX_WIN_SIZE_MAX                      64
+#define  HT_BA_RX_WIN_SIZE_DEF                      8
+
+/* Time [msec] to hold reordered Rx packets waiting for a missing one (0 - wait for BAR or next window) */
+#define  HT_BA_RX_REORDER_TIMEOUT_MIN               0
+#define  HT_BA_RX_REORDER_TIMEOUT_MAX               1000
+#define  HT_BA_RX_REORDER_TIMEOUT_DEF               100
+
 /*---------------------------
       ROAMING parameters
 -----------------------------*/
@@ -651,6 +694,16 @@ IP&Port classification table  */
 #define TRAFFIC_MONITOR_MIN_INTERVAL_PERCENT_MAX   90
 #define TRAFFIC_MONITOR_MIN_INTERVAL_PERCENT_DEF   50
 
+/* Traffic alerts evaluation period (msec) while there is traffic */
+#define TRAFFIC_MONITOR_EVAL_TICK_MS_MIN           10
+#define TRAFFIC_MONITOR_EVAL_TICK_MS_MAX           1000
+#define TRAFFIC_MONITOR_EVAL_TICK_MS_DEF           50
+
+/* Tx/Rx events that trigger a traffic alerts evaluation before the tick (0 = tick only) */
+#define TRAFFIC_MONITOR_EVAL_BURST_MIN             0
+#define TRAFFIC_MONITOR_EVAL_BURST_MAX             10000
+#define TRAFFIC_MONITOR_EVAL_BURST_DEF             64
+
 #define CTRL_DATA_CONT_TX_THRESHOLD_MIN  2
 #define CTRL_DATA_CONT_TX_THRESHOLD_MAX  256
 #define CTRL_DATA_CONT_TX_THRESHOLD_DEF  30
@@ -889,6 +942,14 @@ IP&Port classification table  */
 #define CONTEXT_SWITCH_REQUIRED_DEF     TI_TRUE
 #define CONTEXT_SWITCH_REQUIRED_MIN     TI_FALSE
 #define CONTEXT_SWITCH_REQUIRED_MAX     TI_TRUE
+#define CONTEXT_TASK_BUDGET_DEF         32      /* Max client invocations per driver task run */
+#define CONTEXT_TASK_BUDGET_MIN         1
+#define CONTEXT_TASK_BUDGET_MAX         1000
+
+/* Timer module init paramaters - the timer wheel tick (Msec) */
+#define TIMER_TICK_MSEC_DEF             10
+#define TIMER_TICK_MSEC_MIN             1
+#define TIMER_TICK_MSEC_MAX             100
 
 /* WSC */
 #define WSC_PARSE_IN_BEACON_DEF 1
@@ -899,6 +960,11 @@ IP&Port classification table  */
 #define WSC_INCLUDE_IN_BEACON_MIN 0
 #define WSC_INCLUDE_IN_BEACON_MAX 1
 
+/* Beacon fingerprint cache - unchanged beacons handled before a full parse is forced (0 disables the cache) */
+#define MLME_BEACON_CACHE_MAX_HITS_DEF  20
+#define MLME_BEACON_CACHE_MAX_HITS_MIN  0
+#define MLME_BEACON_CACHE_MAX_HITS_MAX  1000
+
 
 /* Packet Filtering Define */
 #define MIN_NUM_OF_BEACONS_IN_BUFFER 1
@@ -1404,6 +1470,21 @@ IP&Port classification table  */
 #define SDIO_BLK_SIZE_SHIFT_MAX                             16
 #define SDIO_BLK_SIZE_SHIFT_DEF                             9
 
+/* SDIO zero-copy: transact DMA-able host buffers directly, and use the bounce DMA buffer only as fallback */
+#define SDIO_ZERO_COPY_MIN                                  TI_FALSE
+#define SDIO_ZERO_COPY_MAX                                  TI_TRUE
+#define SDIO_ZERO_COPY_DEF                                  TI_TRUE
+
+/* Max Rx packets delivered to the OS stack per batch poll (0 = no batching) - Note that this is an OS dependent parameter! */
+#define RX_BATCH_BUDGET_MIN                                 0
+#define RX_BATCH_BUDGET_MAX                                 64
+#define RX_BATCH_BUDGET_DEF                                 64
+
+/* Statistics page update period in msec (0 = the page is not updated) */
+#define STATS_PAGE_PUBLISH_PERIOD_MIN                       0
+#define STATS_PAGE_PUBLISH_PERIOD_MAX                       60000
+#define STATS_PAGE_PUBLISH_PERIOD_DEF                       1000
+
 
 /*****************************************************************************
  **         POWER MANAGER MODULE REGISTRY DEFINITIONS                       **
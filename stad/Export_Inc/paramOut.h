@@ -45,6 +45,7 @@
 #include "tidef.h"
 #include "report.h"
 #include "context.h"
+#include "timer.h"
 #include "rate.h"
 #include "bssTypes.h"
 #include "roamingMngrTypes.h"
@@ -322,6 +323,16 @@ typedef struct
     TI_BOOL     priority;
 } siteMgr_prioritySite_t;
 
+/* Incremental BSSID list read - the sites changed since the previous read */
+typedef struct
+{
+    TI_UINT32                   uSinceGeneration;   /* in:  generation returned by the previous read */
+    TI_UINT32                   uGeneration;        /* out: generation to pass on the next read */
+    TI_BOOL                     bFullList;          /* in:  reader holds no list, out: the list replaces the previous one */
+    TI_UINT32                   uListSize;          /* in:  list buffer size, out: required / actual list size */
+    OS_802_11_BSSID_LIST_EX     *pBssidList;        /* in:  list buffer, NULL to get only the size and generation */
+} TScanBssidListDelta;
+
 typedef struct{
 	TI_UINT32 thresholdCross;                /* high or low */
 	TI_UINT32 thresholdCrossDirection;       /* direction of crossing */
@@ -397,6 +408,7 @@ typedef struct{
     /* 802.11n BA session */
     TI_UINT8               aBaPolicy[MAX_NUM_OF_802_1d_TAGS];
     TI_UINT16              aBaInactivityTimeout[MAX_NUM_OF_802_1d_TAGS];
+    TI_UINT16              uBaRxWinSize;
 	
 }QosMngrInitParams_t;
 
@@ -752,6 +764,8 @@ typedef struct{
         TI_UINT32                   		uBssidListSize;
         OS_802_11_BSSID_LIST_EX     		*pBssidList;
         TSsid                   			tScanDesiredSSID;
+        TI_UINT32                   		uBssidListGeneration;
+        TScanBssidListDelta         		tBssidListDelta;
 
         /* tx data qos related parameters */
         TTxDataQosParams           			txDataQosParams;
@@ -931,6 +945,7 @@ typedef struct
 typedef struct
 {
     TI_UINT8                    parseWSCInBeacons;
+    TI_UINT32                   uBeaconCacheMaxHits;
 } TMlmeInitParams;
 
 typedef struct
@@ -997,9 +1012,15 @@ typedef struct
     /* TxCtrl Parameters */
 	TI_UINT32					creditCalculationTimeout;
 	TI_BOOL					    bCreditCalcTimerEnabled;
+	TI_BOOL					    bHdrCacheEnabled;
     /* TxDataQueue Parameters */
 	TI_BOOL					    bStopNetStackTx;
 	TI_UINT32					uTxSendPaceThresh;
+	TI_BOOL					    bTxBurstSched;
+	TI_UINT32					uTxBurstMaxPkts;
+	TI_UINT32					aTxBurstQuantum[MAX_NUM_OF_AC];
+	TI_BOOL					    bTxLockFree;
+	TI_UINT32					uTxRingWakePercent;
 	TClsfrParams				ClsfrInitParam;
 } txDataInitParams_t;
 
@@ -1143,8 +1164,21 @@ typedef struct
     TI_UINT32       uWlanDrvThreadPriority; /* Default setting of the WLAN driver task priority  */
     TI_UINT32       uBusDrvThreadPriority;  /* Default setting of the bus driver thread priority */
     TI_UINT32       uSdioBlkSizeShift;      /* In block-mode:  uBlkSize = (1 << uBlkSizeShift)   */
+    TI_BOOL         bSdioZeroCopy;          /* If TRUE, DMA-able buffers are transacted without bounce copy */
+    TI_UINT32       uRxBatchBudget;         /* Max Rx packets delivered to the OS per poll (0 = no batching) */
 }TDrvMainParams;
 
+typedef struct
+{
+    TI_UINT32       uPublishPeriodMs;       /* Statistics page update period (0 = disabled) */
+} TStatsPageInitParams;
+
+typedef struct
+{
+    TI_UINT32       uEvalTickMs;            /* Traffic alerts evaluation period while there is traffic */
+    TI_UINT32       uEvalBurst;             /* Tx/Rx events that trigger an alerts evaluation (0 = tick only) */
+} TTrafficMonitorInitParams;
+
 /* This table is forwarded to the driver upon creation by the OS abstraction layer. */
 typedef struct
 {
@@ -1178,9 +1212,12 @@ typedef struct
     TReportInitParams               tReport;
     TCurrBssInitParams              tCurrBssInitParams;
     TContextInitParams              tContextInitParams;
+    TTimerInitParams                tTimerInitParams;
     TMlmeInitParams                 tMlmeInitParams;
     TDrvMainParams                  tDrvMainParams;
     TRoamScanMngrInitParams         tRoamScanMngrInitParams;
+    TStatsPageInitParams            tStatsPageInitParams;
+    TTrafficMonitorInitParams       tTrafficMonitorInitParams;
 } TInitTable;
 
 
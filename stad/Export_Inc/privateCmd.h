@@ -64,6 +64,19 @@
  * \brief Bitmaks of bit which indicates that the Command is GET Command
  */
 #define PRIVATE_CMD_GET_FLAG	0x00000002
+/** \def PRIVATE_CMD_BATCH_FLAG
+ * \brief Bitmaks of bit which indicates that the Command is a batch of commands (see ti_private_cmd_batch_t)
+ */
+#define PRIVATE_CMD_BATCH_FLAG	0x00000004
+/** \def PRIVATE_CMD_NOWAIT_FLAG
+ * \brief Bitmaks of bit which indicates that a batch of SET Commands returns once queued, 
+ * and its completion is reported by IPC_EVENT_CMD_BATCH_DONE event
+ */
+#define PRIVATE_CMD_NOWAIT_FLAG	0x00000008
+/** \def PRIVATE_CMD_BATCH_MAX_CMDS
+ * \brief Maximum number of Commands in a batch
+ */
+#define PRIVATE_CMD_BATCH_MAX_CMDS	64
 
 
 /*********/
@@ -88,6 +101,42 @@ typedef struct
 	TI_UINT32	out_buffer_len;	/**< Output buffer length 												*/
 } ti_private_cmd_t; 
 
+/** \struct ti_private_cmd_batch_t
+ * \brief TI Private Commands Batch
+ * 
+ * \par Description
+ * Passed as the in_buffer of a ti_private_cmd_t with PRIVATE_CMD_BATCH_FLAG set.
+ * The Commands are executed in order in a single driver context, and each command's 
+ * result (TI_OK or an error status) is returned in its pResults entry.
+ * Asynchronous Commands can't be batched and fail with TI_NOK.
+ * With PRIVATE_CMD_NOWAIT_FLAG only SET Commands are allowed, and pResults is not used.
+ * 
+ * \sa
+ */
+typedef struct
+{
+	TI_UINT32			uBatchId;		/**< User identifier of the batch, reported in the completion event 	*/
+	TI_UINT32			uNumCmds;		/**< Number of Commands (up to PRIVATE_CMD_BATCH_MAX_CMDS) 			*/
+	ti_private_cmd_t*	pCmds;			/**< Pointer to the Commands array									*/
+	TI_INT32*			pResults;		/**< Pointer to the Commands results array 							*/
+} ti_private_cmd_batch_t; 
+
+/** \struct ti_private_cmd_batch_done_t
+ * \brief TI Private Commands Batch Completion
+ * 
+ * \par Description
+ * The data of IPC_EVENT_CMD_BATCH_DONE event, sent upon completion of a PRIVATE_CMD_NOWAIT_FLAG batch
+ * 
+ * \sa
+ */
+typedef struct
+{
+	TI_UINT32			uBatchId;		/**< User identifier of the batch 									*/
+	TI_UINT32			uNumCmds;		/**< Number of Commands in the batch 								*/
+	TI_UINT32			uNumFailed;		/**< Number of failed Commands (0 if all succeeded) 				*/
+	TI_UINT32			uFirstFailed;	/**< Index of the first failed Command (valid if uNumFailed > 0) 	*/
+} ti_private_cmd_batch_done_t; 
+
 
 /*************/
 /* functions */
@@ -70,6 +70,10 @@ typedef struct
 /* External functions prototypes */
 extern void wlanDrvIf_CommandDone (TI_HANDLE hOs, void *pSignalObject, TI_UINT8 *CmdResp_p);
 
+/* Internal functions prototypes */
+static TI_STATUS cmdHndlr_EnqueueCommand (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pNewCmd);
+static void      cmdHndlr_CommandDone    (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd);
+
 
 void cmdHndlr_ClearPendingCommands (TI_HANDLE hCmdHndlr)
 {
@@ -173,6 +177,13 @@ void cmdHndlr_ClearQueue (TI_HANDLE hCmdHndlr)
         {
             break;
         }
+        /* A posted command is completed with failure and freed here */
+        if (pCurrCmd->fDoneCb) 
+        {
+            pCurrCmd->fDoneCb (pCurrCmd->hDoneCb, (TI_UINT32)TI_NOK);
+            os_memoryFree (pCmdHndlr->hOs, pCurrCmd, sizeof (TConfigCommand));
+            continue;
+        }
         /* Just release the semaphore. The command is freed subsequently. */
         os_SignalObjectSet (pCmdHndlr->hOs, pCurrCmd->pSignalObject);
     }
@@ -212,6 +223,8 @@ void cmdHndlr_Init (TStadHandlesList *pStadHandles)
                                                     cmdHndlr_HandleCommands,
                                                     (TI_HANDLE)pCmdHndlr,
                                                     TI_FALSE,
+                                                    CONTEXT_PRIORITY_LOW,
+                                                    CONTEXT_BUDGET_UNLIMITED,
                                                     "COMMAND",
                                                     sizeof("COMMAND"));
 
@@ -283,20 +296,131 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
     /* Indicate the start of command process, from adding it to the queue until get return status form it */  
     pNewCmd->bWaitFlag = TI_TRUE;
 
+	/* Enqueue the command (if failed, release memory and return NOK) */
+    if (cmdHndlr_EnqueueCommand (pCmdHndlr, pNewCmd) != TI_OK) 
+	{
+		os_SignalObjectFree (pCmdHndlr->hOs, pNewCmd->pSignalObject);
+		os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
+        return TI_NOK;
+    }
+
+	/* Wait until the command is executed */
+	os_SignalObjectWait (pCmdHndlr->hOs, pNewCmd->pSignalObject);
+
+	/* After "wait" - the command has already been processed by the drivers' context */
+    /* Indicate the end of command process, from adding it to the queue until get return status form it */  
+    pNewCmd->bWaitFlag = TI_FALSE;
+
+	/* Copy the return code */
+	eStatus = pNewCmd->return_code;
+
+	/* Free signalling object and command structure */
+	os_SignalObjectFree (pCmdHndlr->hOs, pNewCmd->pSignalObject);
+
+    /* If command not completed in this context (Async) don't free the command memory */
+    if(COMMAND_PENDING != pNewCmd->eCmdStatus)
+    {
+        os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
+    }
+
+	/* Return to calling process with command return code */
+	return eStatus;
+}
+
+
+/** 
+ * \fn     cmdHndlr_PostCommand 
+ * \brief  Post a new command to the driver without waiting for its completion
+ * 
+ * Insert a new command to the commands queue from user context and return once it is queued.
+ * The command is executed in the driver context like the commands inserted by cmdHndlr_InsertCommand, 
+ *     and upon its completion the given callback is called (in the driver context) with the 
+ *     command return code, and the command is freed.
+ * The callback is also called (with TI_NOK) if the command is cleared from the queue before execution.
+ * The command buffers must remain valid until the callback is called.
+ * 
+ * \note   
+ * \param  hCmdHndlr    - The module object
+ * \param  cmd          - User request
+ * \param  others       - The command flags, data and params
+ * \param  fDoneCb      - The completion callback
+ * \param  hDoneCb      - The completion callback handle
+ * \return TI_OK if the command was queued, TI_NOK if failed in memory allocation (the callback is not called).  
+ * \sa     cmdHndlr_InsertCommand, cmdHndlr_HandleCommands
+ */ 
+TI_STATUS cmdHndlr_PostCommand (TI_HANDLE       hCmdHndlr,
+                                TI_UINT32       cmd,
+                                TI_UINT32       flags,
+                                void           *buffer1,
+                                TI_UINT32       buffer1_len,
+                                void           *buffer2,
+                                TI_UINT32       buffer2_len,
+                                TI_UINT32      *param3,
+                                TI_UINT32      *param4,
+                                TCmdHndlrDoneCb fDoneCb,
+                                TI_HANDLE       hDoneCb)
+{
+    TCmdHndlrObj     *pCmdHndlr = (TCmdHndlrObj *)hCmdHndlr;
+	TConfigCommand   *pNewCmd;
+
+	/* Allocated command structure */
+	pNewCmd = os_memoryAlloc (pCmdHndlr->hOs, sizeof (TConfigCommand));
+	if (pNewCmd == NULL)
+	{
+		return TI_NOK;
+	}
+    os_memoryZero (pCmdHndlr->hOs, (void *)pNewCmd, sizeof(TConfigCommand));
+
+	/* Copy user request into local structure (no signal object as no one waits for completion) */
+	pNewCmd->cmd = cmd;
+	pNewCmd->flags = flags;
+	pNewCmd->buffer1 = buffer1;
+	pNewCmd->buffer1_len = buffer1_len;
+	pNewCmd->buffer2 = buffer2;
+	pNewCmd->buffer2_len = buffer2_len;
+	pNewCmd->param3 = param3;
+	pNewCmd->param4 = param4;
+	pNewCmd->fDoneCb = fDoneCb;
+	pNewCmd->hDoneCb = hDoneCb;
+    pNewCmd->bWaitFlag = TI_FALSE;
+
+	/* Enqueue the command (if failed, release memory and return NOK) */
+    if (cmdHndlr_EnqueueCommand (pCmdHndlr, pNewCmd) != TI_OK) 
+	{
+		os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
+        return TI_NOK;
+    }
+
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     cmdHndlr_EnqueueCommand 
+ * \brief  Enqueue a new command and schedule its handling
+ * 
+ * Enqueue the command in a critical section, and if commands are not beeing processed 
+ *     set a request to start processing in the driver context.
+ * 
+ * \note   
+ * \param  pCmdHndlr    - The module object
+ * \param  pNewCmd      - The command
+ * \return TI_OK if queued, TI_NOK if failed (the command is not freed)
+ * \sa     cmdHndlr_InsertCommand, cmdHndlr_PostCommand
+ */ 
+static TI_STATUS cmdHndlr_EnqueueCommand (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pNewCmd)
+{
     /* Enter critical section to protect queue access */
     context_EnterCriticalSection (pCmdHndlr->hContext);
 
-	/* Enqueue the command (if failed, release memory and return NOK) */
-    eStatus = que_Enqueue (pCmdHndlr->hCmdQueue, (TI_HANDLE)pNewCmd);
-    if (eStatus != TI_OK) 
+    if (que_Enqueue (pCmdHndlr->hCmdQueue, (TI_HANDLE)pNewCmd) != TI_OK) 
 	{
 		os_printf("cmdPerform: Failed to enqueue new command\n");
-		os_SignalObjectFree (pCmdHndlr->hOs, pNewCmd->pSignalObject);
-		os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
         context_LeaveCriticalSection (pCmdHndlr->hContext);  /* Leave critical section */
         return TI_NOK;
     }
 
+
     /* 
      * Note: The bProcessingCmds flag is used for indicating if we are already processing
      *           the queued commands, so the context-engine shouldn't invoke cmdHndlr_HandleCommands.
@@ -323,27 +447,34 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
         context_RequestSchedule (pCmdHndlr->hContext, pCmdHndlr->uContextId);
     }
 
-	/* Wait until the command is executed */
-	os_SignalObjectWait (pCmdHndlr->hOs, pNewCmd->pSignalObject);
-
-	/* After "wait" - the command has already been processed by the drivers' context */
-    /* Indicate the end of command process, from adding it to the queue until get return status form it */  
-    pNewCmd->bWaitFlag = TI_FALSE;
 
-	/* Copy the return code */
-	eStatus = pNewCmd->return_code;
+    return TI_OK;
+}
 
-	/* Free signalling object and command structure */
-	os_SignalObjectFree (pCmdHndlr->hOs, pNewCmd->pSignalObject);
 
-    /* If command not completed in this context (Async) don't free the command memory */
-    if(COMMAND_PENDING != pNewCmd->eCmdStatus)
+/** 
+ * \fn     cmdHndlr_CommandDone 
+ * \brief  Notify a completed command
+ * 
+ * For a posted command call its completion callback and free it.
+ * Else, release the waiting originator (which frees the command).
+ * 
+ * \note   
+ * \param  pCmdHndlr    - The module object
+ * \param  pCmd         - The completed command
+ * \return void
+ * \sa     cmdHndlr_HandleCommands, cmdHndlr_Complete
+ */ 
+static void cmdHndlr_CommandDone (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd)
+{
+    if (pCmd->fDoneCb)
     {
-        os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
+        pCmd->fDoneCb (pCmd->hDoneCb, pCmd->return_code);
+        os_memoryFree (pCmdHndlr->hOs, pCmd, sizeof (TConfigCommand));
+        return;
     }
 
-	/* Return to calling process with command return code */
-	return eStatus;
+    wlanDrvIf_CommandDone (pCmdHndlr->hOs, pCmd->pSignalObject, pCmd->CmdRespBuffer); 
 }
 
 
@@ -394,7 +525,7 @@ void cmdHndlr_HandleCommands (TI_HANDLE hCmdHndlr)
             }
 
             /* Command was completed so free the wait signal and continue to next command */
-            wlanDrvIf_CommandDone(pCmdHndlr->hOs, pCmdHndlr->pCurrCmd->pSignalObject, pCmdHndlr->pCurrCmd->CmdRespBuffer); 
+            cmdHndlr_CommandDone (pCmdHndlr, pCmdHndlr->pCurrCmd);
 
             pCmdHndlr->pCurrCmd = NULL;
 
@@ -438,6 +569,14 @@ void cmdHndlr_Complete (TI_HANDLE hCmdHndlr)
     {
         /* set Status to COMPLETE */
         pCmdHndlr->pCurrCmd->eCmdStatus = TI_OK;
+
+        /* A posted command is freed after its callback */
+        if (pCmdHndlr->pCurrCmd->fDoneCb)
+        {
+            cmdHndlr_CommandDone (pCmdHndlr, pCmdHndlr->pCurrCmd);
+            pCmdHndlr->pCurrCmd = NULL;
+            return;
+        }
     
         /* save the wait flag before free semaphore */
         bLocalWaitFlag = pCmdHndlr->pCurrCmd->bWaitFlag;
@@ -39,6 +39,9 @@
 #include "DrvMainModules.h"
 #include "WlanDrvIf.h"
 
+/* Completion callback of a posted command (called in the driver context with the command return code) */
+typedef void (*TCmdHndlrDoneCb) (TI_HANDLE hCb, TI_UINT32 uReturnCode);
+
 /* The configuration commands structure */
 typedef struct 
 {
@@ -57,6 +60,8 @@ typedef struct
     TI_UINT32   return_code;
     TI_STATUS	eCmdStatus;                             /* (PEND / COMPLETE) */
     TI_BOOL	    bWaitFlag; 	                            /* (TRUE / FALSE) */
+    TCmdHndlrDoneCb fDoneCb;                            /* If not NULL, a posted command (no originator waiting) */
+    TI_HANDLE   hDoneCb;
     /*
      * TCmdRespUnion is defined for each OS:
      * For Linx and WM that defined is empty.
@@ -79,6 +84,17 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
                                   TI_UINT32     buffer2_len,
                                   TI_UINT32    *param3,
                                   TI_UINT32    *param4);
+TI_STATUS cmdHndlr_PostCommand   (TI_HANDLE       hCmdHndlr,
+                                  TI_UINT32       cmd,
+                                  TI_UINT32       flags,
+                                  void           *buffer1,
+                                  TI_UINT32       buffer1_len,
+                                  void           *buffer2,
+                                  TI_UINT32       buffer2_len,
+                                  TI_UINT32      *param3,
+                                  TI_UINT32      *param4,
+                                  TCmdHndlrDoneCb fDoneCb,
+                                  TI_HANDLE       hDoneCb);
 void      cmdHndlr_HandleCommands (TI_HANDLE hCmdHndlr);
 void      cmdHndlr_Complete (TI_HANDLE hCmdHndlr);
 void     *cmdHndlr_GetStat (TI_HANDLE hCmdHndlr);
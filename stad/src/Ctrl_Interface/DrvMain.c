@@ -76,6 +76,7 @@
 #include "WlanDrvCommon.h"
 #include "DrvMainModules.h"
 #include "CmdDispatcher.h"
+#include "StatsPage.h"
 
 
 #define SM_WATCHDOG_TIME_MS     20000  /* SM processes timeout is 20 sec. */
@@ -141,6 +142,9 @@ typedef struct
     TBusDrvCfg        tBusDrvCfg;   /* A union (struc per each supported bus type) for the bus driver configuration */
     TI_UINT32         uRxDmaBufLen; /* The bus driver Rx DMA buffer length (needed as a limit for Rx aggregation length) */
     TI_UINT32         uTxDmaBufLen; /* The bus driver Tx DMA buffer length (needed as a limit for Tx aggregation length) */
+    TI_UINT32         uBootStartMs; /* Time-stamp of the bus connect and HW reset start (start or recovery) */
+    TI_UINT32         uHwInitDoneMs;/* Time-stamp of the HW-Init completion (FW download start) */
+    TI_UINT32         uFwInitDoneMs;/* Time-stamp of the FW-Init completion (FW configuration start) */
 
 } TDrvMain;
 
@@ -152,6 +156,7 @@ static void drvMain_ConfigFwCb (TI_HANDLE hDrvMain, TI_STATUS eStatus);
 static void drvMain_TwdStopCb (TI_HANDLE hDrvMain, TI_STATUS eStatus);
 static void drvMain_InitFailCb (TI_HANDLE hDrvMain, TI_STATUS eStatus);
 static void drvMain_InitLocals (TDrvMain *pDrvMain);
+static void drvMain_PrintBootTime (TDrvMain *pDrvMain);
 /* static void drvMain_SmWatchdogTimeout (TI_HANDLE hDrvMain); */
 static void drvMain_SmEvent (TI_HANDLE hDrvMain, ESmEvent eEvent);
 static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent);
@@ -463,6 +468,13 @@ TI_STATUS drvMain_Create (TI_HANDLE  hOs,
         return TI_NOK;
     }
 
+    pDrvMain->tStadHandles.hStatsPage = statsPage_Create (hOs);
+    if (pDrvMain->tStadHandles.hStatsPage == NULL)
+    {
+        drvMain_Destroy (pDrvMain);
+        return TI_NOK;
+    }
+
     pDrvMain->tStadHandles.hQosMngr = qosMngr_create (hOs);
     if (pDrvMain->tStadHandles.hQosMngr == NULL)
     {
@@ -710,6 +722,11 @@ TI_STATUS drvMain_Destroy (TI_HANDLE  hDrvMain)
         currBSS_unload (pDrvMain->tStadHandles.hCurrBss);
     }
 
+    if (pDrvMain->tStadHandles.hStatsPage != NULL)
+    {
+        statsPage_Destroy (pDrvMain->tStadHandles.hStatsPage);
+    }
+
     if (pDrvMain->tStadHandles.hSwitchChannel != NULL)
     {
         switchChannel_unload (pDrvMain->tStadHandles.hSwitchChannel);
@@ -825,6 +842,7 @@ static void drvMain_Init (TI_HANDLE hDrvMain)
 #endif
     scanMngr_init (pModules);
     currBSS_init (pModules);
+    statsPage_Init (pModules);
     apConn_init (pModules);
     roamingMngr_init (pModules);
     qosMngr_init (pModules);
@@ -884,6 +902,7 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
      */
     report_SetDefaults (pDrvMain->tStadHandles.hReport, &pInitTable->tReport);
     context_SetDefaults (pDrvMain->tStadHandles.hContext, &pInitTable->tContextInitParams);
+    tmr_SetDefaults (pDrvMain->tStadHandles.hTimer, &pInitTable->tTimerInitParams);
     TWD_SetDefaults (pDrvMain->tStadHandles.hTWD, &pInitTable->twdInitParams);
     conn_SetDefaults (pDrvMain->tStadHandles.hConn, &pInitTable->connInitParams);
     ctrlData_SetDefaults (pDrvMain->tStadHandles.hCtrlData, &pInitTable->ctrlDataInitParams);
@@ -907,6 +926,8 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
     txDataQ_SetDefaults (pDrvMain->tStadHandles.hTxDataQ, &pInitTable->txDataInitParams);
     txCtrl_SetDefaults (pDrvMain->tStadHandles.hTxCtrl, &pInitTable->txDataInitParams);
     currBSS_SetDefaults (pDrvMain->tStadHandles.hCurrBss, &pInitTable->tCurrBssInitParams);
+    statsPage_SetDefaults (pDrvMain->tStadHandles.hStatsPage, &pInitTable->tStatsPageInitParams);
+    TrafficMonitor_SetDefaults (pDrvMain->tStadHandles.hTrafficMon, &pInitTable->tTrafficMonitorInitParams);
     mlme_SetDefaults (pDrvMain->tStadHandles.hMlmeSm, &pInitTable->tMlmeInitParams);
 
     scanMngr_SetDefaults(pDrvMain->tStadHandles.hScanMngr, &pInitTable->tRoamScanMngrInitParams);
@@ -918,7 +939,9 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
     /* Set DrvMain local defaults */
     pDrvMain->tBusDrvCfg.tSdioCfg.uBlkSizeShift         = pInitTable->tDrvMainParams.uSdioBlkSizeShift;
     pDrvMain->tBusDrvCfg.tSdioCfg.uBusDrvThreadPriority = pInitTable->tDrvMainParams.uBusDrvThreadPriority;
+    pDrvMain->tBusDrvCfg.tSdioCfg.bZeroCopy             = pInitTable->tDrvMainParams.bSdioZeroCopy;
     os_SetDrvThreadPriority (pDrvMain->tStadHandles.hOs, pInitTable->tDrvMainParams.uWlanDrvThreadPriority);
+    os_SetRxBatchBudget (pDrvMain->tStadHandles.hOs, pInitTable->tDrvMainParams.uRxBatchBudget);
 
     /* Release the init table memory */
     os_memoryFree (pDrvMain->tStadHandles.hOs, pInitTable, sizeof(TInitTable));
@@ -1047,6 +1070,8 @@ static void drvMain_InitLocals (TDrvMain *pDrvMain)
                                                    drvMain_InvokeAction,
                                                    (TI_HANDLE)pDrvMain,
                                                    TI_TRUE,
+                                                   CONTEXT_PRIORITY_LOW,
+                                                   CONTEXT_BUDGET_UNLIMITED,
                                                    "ACTION",
                                                    sizeof("ACTION"));
 
@@ -1141,6 +1166,9 @@ static TI_STATUS drvMain_StopActivities (TDrvMain *pDrvMain)
 {
     txPort_suspendTx (pDrvMain->tStadHandles.hTxPort);
 
+    /* Stop the statistics page updates (the page keeps the last counters) */
+    statsPage_Stop (pDrvMain->tStadHandles.hStatsPage);
+
     /* Disable External Inputs (IRQs and commands) */
     TWD_DisableInterrupts(pDrvMain->tStadHandles.hTWD);
     cmdHndlr_Disable (pDrvMain->tStadHandles.hCmdHndlr);
@@ -1171,6 +1199,8 @@ static void drvMain_EnableActivities (TDrvMain *pDrvMain)
     /* Enable external events from FW */
     TWD_EnableExternalEvents (pDrvMain->tStadHandles.hTWD);
 
+    /* Start the periodic statistics page updates */
+    statsPage_Start (pDrvMain->tStadHandles.hStatsPage);
 
 }
 
@@ -1307,6 +1337,44 @@ static void drvMain_RecoveryNotify (TDrvMain *pDrvMain)
 }
 
 
+/*
+ * \fn     drvMain_PrintBootTime
+ * \brief  Print the boot time breakdown
+ *
+ * Called when the FW configuration is completed (on driver start or recovery).
+ * Prints the time of each boot phase:
+ *     - Reset:       Bus connect, device reset and HW-Init (up to FW download).
+ *     - FW download: The FW image download (as measured by the TWD).
+ *     - FW init:     Running the FW until its init-complete indication.
+ *     - ACX config:  The FW configuration commands sequence.
+ *
+ * \note
+ * \param  pDrvMain - The DrvMain object
+ * \return void
+ * \sa     drvMain_Sm
+ */
+static void drvMain_PrintBootTime (TDrvMain *pDrvMain)
+{
+    TI_UINT32 uNowMs = os_timeStampMs (pDrvMain->tStadHandles.hOs);
+    TI_UINT32 uFwDlTimeMs, uFwDlBytes, uFwDlBursts;
+    TI_UINT32 uFwInitMs;
+
+    TWD_GetFwDownloadStat (pDrvMain->tStadHandles.hTWD, &uFwDlTimeMs, &uFwDlBytes, &uFwDlBursts);
+
+    /* The FW-Init phase includes the download, so deduct it */
+    uFwInitMs = pDrvMain->uFwInitDoneMs - pDrvMain->uHwInitDoneMs;
+    uFwInitMs = (uFwInitMs > uFwDlTimeMs) ? (uFwInitMs - uFwDlTimeMs) : 0;
+
+    WLAN_OS_REPORT(("%s time %d ms: reset %d ms, FW download %d ms (%d bytes in %d bursts), FW init %d ms, ACX config %d ms\n",
+                    pDrvMain->bRecovery ? "Recovery" : "Boot",
+                    uNowMs - pDrvMain->uBootStartMs,
+                    pDrvMain->uHwInitDoneMs - pDrvMain->uBootStartMs,
+                    uFwDlTimeMs, uFwDlBytes, uFwDlBursts,
+                    uFwInitMs,
+                    uNowMs - pDrvMain->uFwInitDoneMs));
+}
+
+
 /*
  * \fn     drvMain_SmWatchdogTimeout
  * \brief  SM watchdog timer expiry handler
@@ -1455,6 +1523,8 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 
     case SM_STATE_WAIT_NVS_FILE:
 
+        pDrvMain->uBootStartMs = os_timeStampMs (hOs);
+
         /* SDBus Connect connection validation  */
         for(uSdioConIndex=0; (uSdioConIndex < SDIO_CONNECT_THRESHOLD) && (eStatus != TI_OK); uSdioConIndex++)
         {
@@ -1499,6 +1569,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
          */
         if (eEvent == SM_EVENT_HW_INIT_COMPLETE)
         {
+            pDrvMain->uHwInitDoneMs = os_timeStampMs (hOs);
             pDrvMain->tFileInfo.eFileType = FILE_TYPE_FW;
             pDrvMain->eSmState = SM_STATE_DOWNLOAD_FW_FILE;
             eStatus = wlanDrvIf_GetFile (hOs, &pDrvMain->tFileInfo);
@@ -1542,6 +1613,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
          */
         if (eEvent == SM_EVENT_FW_INIT_COMPLETE)
         {
+            pDrvMain->uFwInitDoneMs = os_timeStampMs (hOs);
             pDrvMain->eSmState = SM_STATE_FW_CONFIG;
             if (!pDrvMain->bRecovery)
             {
@@ -1570,6 +1642,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
         if (eEvent == SM_EVENT_FW_CONFIG_COMPLETE)
         {
             pDrvMain->eSmState = SM_STATE_OPERATIONAL;
+            drvMain_PrintBootTime (pDrvMain);
             if (pDrvMain->bRecovery)
             {
                 pDrvMain->uNumOfRecoveryAttempts = 0;
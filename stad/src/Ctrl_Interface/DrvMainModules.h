@@ -79,6 +79,7 @@ typedef struct
     TI_HANDLE           hCmdDispatch; 
     TI_HANDLE           hStaCap;
     TI_HANDLE           hTxnQ;
+    TI_HANDLE           hStatsPage;
 
 } TStadHandlesList;
 
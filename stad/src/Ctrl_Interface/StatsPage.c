@@ -0,0 +1,303 @@
+/*
+ * StatsPage.c
+ *
+ * Copyright(c) 1998 - 2009 Texas Instruments. All rights reserved.      
+ * All rights reserved.                                                  
+ *                                                                       
+ * Redistribution and use in source and binary forms, with or without    
+ * modification, are permitted provided that the following conditions    
+ * are met:                                                              
+ *                                                                       
+ *  * Redistributions of source code must retain the above copyright     
+ *    notice, this list of conditions and the following disclaimer.      
+ *  * Redistributions in binary form must reproduce the above copyright  
+ *    notice, this list of conditions and the following disclaimer in    
+ *    the documentation and/or other materials provided with the         
+ *    distribution.                                                      
+ *  * Neither the name Texas Instruments nor the names of its            
+ *    contributors may be used to endorse or promote products derived    
+ *    from this software without specific prior written permission.      
+ *                                                                       
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS   
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT     
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT      
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT   
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file   StatsPage.c 
+ *  \brief  The StatsPage module. Publishes the driver statistics to a page shared with user space.
+ *  
+ *  The page (see TI_StatsPage.h) is allocated and exported by the OS abstraction layer.
+ *  It is updated periodically from a driver timer, so monitoring tools read the counters 
+ *      from the page with no command to the driver, and the data path is not loaded by the updates.
+ *  The update is protected by a sequence lock: uSeq is odd while the page is written.
+ *
+ *  \see    StatsPage.h, TI_StatsPage.h
+ */
+
+#define __FILE_ID__  FILE_ID_140
+#include "tidef.h"
+#include "osApi.h"
+#include "report.h"
+#include "timer.h"
+#include "DataCtrl_Api.h"
+#include "TrafficMonitorAPI.h"
+#include "currBss.h"
+#include "TI_StatsPage.h"
+#include "DrvMainModules.h"
+#include "StatsPage.h"
+
+
+/* The module's object */
+typedef struct
+{
+    /* Other modules handles */
+    TI_HANDLE    hOs;
+    TI_HANDLE    hReport;
+    TI_HANDLE    hTimer;
+    TI_HANDLE    hRxData;
+    TI_HANDLE    hTxCtrl;
+    TI_HANDLE    hTrafficMon;
+    TI_HANDLE    hCurrBss;
+
+    TI_HANDLE    hPublishTimer;     /* The periodic page update timer */
+    TStatsPage  *pPage;             /* The shared page (NULL if not supported by the OS) */
+    TI_UINT32    uPublishPeriodMs;  /* The page update period (0 = disabled) */
+    TI_BOOL      bStarted;
+
+} TStatsPageObj;
+
+
+/* Internal functions prototypes */
+static void statsPage_Publish (TI_HANDLE hStatsPage, TI_BOOL bTwdInitOccured);
+
+
+
+/** 
+ * \fn     statsPage_Create
+ * \brief  Create the module
+ * 
+ * Create the module object and the page shared with user space.
+ * 
+ * \note   The module is created also if the OS doesn't provide the page (it does nothing in this case).
+ * \param  hOs - Handle to the Os Abstraction Layer                           
+ * \return Handle to the allocated module (NULL if failed) 
+ * \sa     statsPage_Destroy
+ */ 
+TI_HANDLE statsPage_Create (TI_HANDLE hOs)
+{
+    TStatsPageObj *pStatsPage;
+
+    /* allocate StatsPage module */
+    pStatsPage = os_memoryAlloc (hOs, sizeof(TStatsPageObj));
+    
+    if (!pStatsPage)
+    {
+        return NULL;
+    }
+
+    /* Reset StatsPage module */
+    os_memoryZero (hOs, pStatsPage, sizeof(TStatsPageObj));
+
+    pStatsPage->hOs = hOs;
+
+    /* Allocate the shared page (zeroed by the OS layer) and fill its fixed header */
+    pStatsPage->pPage = (TStatsPage *)os_StatsPageCreate (hOs, sizeof(TStatsPage));
+    if (pStatsPage->pPage)
+    {
+        pStatsPage->pPage->uMagic   = STATS_PAGE_MAGIC;
+        pStatsPage->pPage->uVersion = STATS_PAGE_VERSION;
+        pStatsPage->pPage->uSize    = sizeof(TStatsPage);
+    }
+
+    return (TI_HANDLE)pStatsPage;
+}
+
+
+/** 
+ * \fn     statsPage_Destroy
+ * \brief  Destroy the module
+ * 
+ * Release the timer, the shared page and the module object.
+ * 
+ * \note   
+ * \param  hStatsPage - The module object
+ * \return TI_OK
+ * \sa     statsPage_Create
+ */ 
+TI_STATUS statsPage_Destroy (TI_HANDLE hStatsPage)
+{
+    TStatsPageObj *pStatsPage = (TStatsPageObj *)hStatsPage;
+
+    if (pStatsPage->hPublishTimer)
+    {
+        tmr_DestroyTimer (pStatsPage->hPublishTimer);
+    }
+
+    if (pStatsPage->pPage)
+    {
+        os_StatsPageDestroy (pStatsPage->hOs, pStatsPage->pPage);
+    }
+
+    os_memoryFree (pStatsPage->hOs, pStatsPage, sizeof(TStatsPageObj));
+
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     statsPage_Init
+ * \brief  Save modules handles
+ * 
+ * \note   
+ * \param  pStadHandles  - The driver modules handles
+ * \return void  
+ * \sa     
+ */ 
+void statsPage_Init (TStadHandlesList *pStadHandles)
+{
+    TStatsPageObj *pStatsPage = (TStatsPageObj *)(pStadHandles->hStatsPage);
+    
+    pStatsPage->hReport     = pStadHandles->hReport;
+    pStatsPage->hTimer      = pStadHandles->hTimer;
+    pStatsPage->hRxData     = pStadHandles->hRxData;
+    pStatsPage->hTxCtrl     = pStadHandles->hTxCtrl;
+    pStatsPage->hTrafficMon = pStadHandles->hTrafficMon;
+    pStatsPage->hCurrBss    = pStadHandles->hCurrBss;
+}
+
+
+/** 
+ * \fn     statsPage_SetDefaults
+ * \brief  Set the update period and create the update timer
+ * 
+ * \note   
+ * \param  hStatsPage  - The module object
+ * \param  pInitParams - The module init parameters
+ * \return TI_OK, or TI_NOK if failed to create the timer
+ * \sa     
+ */ 
+TI_STATUS statsPage_SetDefaults (TI_HANDLE hStatsPage, TStatsPageInitParams *pInitParams)
+{
+    TStatsPageObj *pStatsPage = (TStatsPageObj *)hStatsPage;
+
+    pStatsPage->uPublishPeriodMs = pInitParams->uPublishPeriodMs;
+
+    /* No timer is needed if the page is not supported or disabled */
+    if (pStatsPage->pPage == NULL || pStatsPage->uPublishPeriodMs == 0)
+    {
+        return TI_OK;
+    }
+
+    pStatsPage->pPage->uPublishPeriodMs = pStatsPage->uPublishPeriodMs;
+
+    pStatsPage->hPublishTimer = tmr_CreateTimer (pStatsPage->hTimer);
+    if (pStatsPage->hPublishTimer == NULL)
+    {
+        return TI_NOK;
+    }
+
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     statsPage_Start
+ * \brief  Start the periodic page update
+ * 
+ * Called when the driver activities are enabled (after init or recovery).
+ * 
+ * \note   
+ * \param  hStatsPage - The module object
+ * \return void  
+ * \sa     statsPage_Stop
+ */ 
+void statsPage_Start (TI_HANDLE hStatsPage)
+{
+    TStatsPageObj *pStatsPage = (TStatsPageObj *)hStatsPage;
+
+    if (pStatsPage->hPublishTimer == NULL || pStatsPage->bStarted)
+    {
+        return;
+    }
+
+    pStatsPage->bStarted = TI_TRUE;
+    statsPage_Publish (hStatsPage, TI_FALSE);
+    tmr_StartTimer (pStatsPage->hPublishTimer,
+                    statsPage_Publish,
+                    hStatsPage,
+                    pStatsPage->uPublishPeriodMs,
+                    TI_TRUE);
+}
+
+
+/** 
+ * \fn     statsPage_Stop
+ * \brief  Stop the periodic page update
+ * 
+ * Called when the driver activities are stopped. The page is updated a last time 
+ *     so it holds the counters at the stop time.
+ * 
+ * \note   
+ * \param  hStatsPage - The module object
+ * \return void  
+ * \sa     statsPage_Start
+ */ 
+void statsPage_Stop (TI_HANDLE hStatsPage)
+{
+    TStatsPageObj *pStatsPage = (TStatsPageObj *)hStatsPage;
+
+    if (!pStatsPage->bStarted)
+    {
+        return;
+    }
+
+    tmr_StopTimer (pStatsPage->hPublishTimer);
+    pStatsPage->bStarted = TI_FALSE;
+    statsPage_Publish (hStatsPage, TI_FALSE);
+}
+
+
+/** 
+ * \fn     statsPage_Publish
+ * \brief  Update the shared page
+ * 
+ * Called in the driver context by the periodic timer.
+ * Each module copies its counters to its page section, within the sequence lock update.
+ * 
+ * \note   
+ * \param  hStatsPage      - The module object
+ * \param  bTwdInitOccured - Indicates if TWDriver recovery occured since timer started (not used)
+ * \return void  
+ * \sa     
+ */ 
+static void statsPage_Publish (TI_HANDLE hStatsPage, TI_BOOL bTwdInitOccured)
+{
+    TStatsPageObj *pStatsPage = (TStatsPageObj *)hStatsPage;
+    TStatsPage    *pPage      = pStatsPage->pPage;
+
+    /* Mark the page as being updated (odd sequence) before changing its content */
+    pPage->uSeq++;
+    os_memoryBarrierRelease (pStatsPage->hOs);
+
+    currBSS_PublishStats (pStatsPage->hCurrBss, &pPage->tLink);
+    rxData_PublishStats (pStatsPage->hRxData, &pPage->tRx);
+    txCtrlParams_PublishStats (pStatsPage->hTxCtrl, pPage->aTx);
+    TrafficMonitor_PublishStats (pStatsPage->hTrafficMon, &pPage->tTraffic);
+
+    pPage->uPublishTimeMs = os_timeStampMs (pStatsPage->hOs);
+    pPage->uPublishCount++;
+
+    /* Mark the update completion (even sequence) after the content is visible */
+    os_memoryBarrierRelease (pStatsPage->hOs);
+    pPage->uSeq++;
+}
+
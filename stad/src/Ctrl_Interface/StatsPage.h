@@ -0,0 +1,60 @@
+/*
+ * StatsPage.h
+ *
+ * Copyright(c) 1998 - 2009 Texas Instruments. All rights reserved.      
+ * All rights reserved.                                                  
+ *                                                                       
+ * Redistribution and use in source and binary forms, with or without    
+ * modification, are permitted provided that the following conditions    
+ * are met:                                                              
+ *                                                                       
+ *  * Redistributions of source code must retain the above copyright     
+ *    notice, this list of conditions and the following disclaimer.      
+ *  * Redistributions in binary form must reproduce the above copyright  
+ *    notice, this list of conditions and the following disclaimer in    
+ *    the documentation and/or other materials provided with the         
+ *    distribution.                                                      
+ *  * Neither the name Texas Instruments nor the names of its            
+ *    contributors may be used to endorse or promote products derived    
+ *    from this software without specific prior written permission.      
+ *                                                                       
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS   
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT     
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT      
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT   
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file   StatsPage.h
+ *  \brief  StatsPage module header file.                                  
+ *
+ *  \see    StatsPage.c
+ */
+
+#ifndef _STATS_PAGE_H_
+#define _STATS_PAGE_H_
+
+#include "DrvMainModules.h"
+#include "paramOut.h"
+
+
+/* Public Functions Prototypes */
+/* =========================== */
+
+TI_HANDLE statsPage_Create      (TI_HANDLE hOs);
+TI_STATUS statsPage_Destroy     (TI_HANDLE hStatsPage);
+void      statsPage_Init        (TStadHandlesList *pStadHandles);
+TI_STATUS statsPage_SetDefaults (TI_HANDLE hStatsPage, TStatsPageInitParams *pInitParams);
+void      statsPage_Start       (TI_HANDLE hStatsPage);
+void      statsPage_Stop        (TI_HANDLE hStatsPage);
+
+
+#endif  /* _STATS_PAGE_H_ */
+
@@ -108,6 +108,8 @@ TI_STATUS rxData_setParam(TI_HANDLE hRxData, paramInfo_t *pParamInfo);
 
 TI_STATUS rxData_getTiwlnCounters(TI_HANDLE hRxData, TIWLN_COUNTERS *pTiwlnCounters);
 
+void      rxData_PublishStats (TI_HANDLE hRxData, TStatsPageRx *pRx);
+
 void      rxData_resetCounters(TI_HANDLE hRxData);
 
 TI_HANDLE rxData_RegNotif(TI_HANDLE hRxData,TI_UINT16 EventMask,GeneralEventCall_t CallBack,TI_HANDLE context,TI_UINT32 Cookie);
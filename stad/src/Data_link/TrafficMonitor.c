@@ -68,12 +68,14 @@ void TestEventFunc (TI_HANDLE hTrafficMonitor, TI_BOOL bTwdInitOccured);
 /*           Function prototype                                         */
 /************************************************************************/
 static void TimerMonitor_TimeOut (TI_HANDLE hTrafficMonitor, TI_BOOL bTwdInitOccured);
-static void TrafficMonitor_updateBW(BandWidth_t *pBandWidth, TI_UINT32 uCurrentTS);
+static void TrafficMonitor_EvalTimeout (TI_HANDLE hTrafficMonitor, TI_BOOL bTwdInitOccured);
+static void TrafficMonitor_Evaluate (TrafficMonitor_t *TrafficMonitor);
+static TI_UINT32 TrafficMonitor_alertCount (TrafficMonitor_t *TrafficMonitor, TrafficAlertElement_t *AlertElement);
+static void TrafficMonitor_updateBW(BandWidth_t *pBandWidth, TI_UINT32 uCurrentTS, TI_UINT32 uFrames);
+static void TrafficMonitor_flushBW(TrafficMonitor_t *TrafficMonitor, TI_UINT32 uCurrentTS);
 static TI_UINT32 TrafficMonitor_calcBW(BandWidth_t *pBandWidth, TI_UINT32 uCurrentTS);
-static TI_BOOL isThresholdDown(TrafficAlertElement_t *AlertElement,TI_UINT32 CurrentTime);
-static TI_BOOL isThresholdUp(TrafficAlertElement_t *AlertElement , TI_UINT32 CurrentTime);
-static void SimpleByteAggregation(TI_HANDLE TraffElem,int Count);
-static void SimpleFrameAggregation(TI_HANDLE TraffElem,int Count);
+static TI_BOOL isThresholdDown(TrafficMonitor_t *TrafficMonitor, TrafficAlertElement_t *AlertElement, TI_UINT32 CurrentTime);
+static TI_BOOL isThresholdUp(TrafficMonitor_t *TrafficMonitor, TrafficAlertElement_t *AlertElement, TI_UINT32 CurrentTime);
 static TI_HANDLE TrafficMonitor_ExitFunc(TrafficMonitor_t *TrafficMonitor,TI_HANDLE hOs);
 static TI_STATUS FindRstElemEntryIndex (TrafficMonitor_t *TrafficMonitor,TrafficAlertElement_t  *TrafficAlertElement,int *Index);
 static TI_STATUS TrafficMonitor_SetMask(TrafficMonitor_t *TrafficMonitor,TrafficAlertElement_t *TrafficAlertElement,TraffEvntOptNum_t MaskType);
@@ -121,6 +123,10 @@ static TI_HANDLE TrafficMonitor_ExitFunc(TrafficMonitor_t *TrafficMonitor,TI_HAN
         {
             tmr_DestroyTimer (TrafficMonitor->hTrafficMonTimer);
         }
+        if(TrafficMonitor->hEvalTimer)
+        {
+            tmr_DestroyTimer (TrafficMonitor->hEvalTimer);
+        }
         os_memoryFree(hOs, TrafficMonitor, sizeof(TrafficMonitor_t));            
     }
     return NULL;
@@ -139,6 +145,13 @@ void TrafficMonitor_Init (TStadHandlesList *pStadHandles, TI_UINT32 BWwindowMs)
     /* Create the base threshold timer that will serve all the down thresholds*/
     TrafficMonitor->hTrafficMonTimer = tmr_CreateTimer (pStadHandles->hTimer);
 
+    /* Create the alerts evaluation timer, running while there is traffic */
+    TrafficMonitor->hEvalTimer = tmr_CreateTimer (pStadHandles->hTimer);
+    TrafficMonitor->bEvalTimerRunning = TI_FALSE;
+    TrafficMonitor->uEvalTickMs = TRAFFIC_MONITOR_EVAL_TICK_MS_DEF;
+    TrafficMonitor->uEvalBurst = TRAFFIC_MONITOR_EVAL_BURST_DEF;
+    TrafficMonitor->uEventsSinceEval = 0;
+
     TrafficMonitor->Active = TI_FALSE;
 
     TrafficMonitor->hRxData = pStadHandles->hRxData;
@@ -175,6 +188,17 @@ void TrafficMonitor_Init (TStadHandlesList *pStadHandles, TI_UINT32 BWwindowMs)
 #endif
 }
 
+/************************************************************************/
+/*                TrafficMonitor_SetDefaults                            */
+/************************************************************************/
+void TrafficMonitor_SetDefaults (TI_HANDLE hTrafficMonitor, TTrafficMonitorInitParams *pInitParams)
+{
+    TrafficMonitor_t *TrafficMonitor = (TrafficMonitor_t *)hTrafficMonitor;
+
+    TrafficMonitor->uEvalTickMs = pInitParams->uEvalTickMs;
+    TrafficMonitor->uEvalBurst  = pInitParams->uEvalBurst;
+}
+
 /************************************************************************/
 /*                TrafficMonitor_Start                                  */
 /************************************************************************/
@@ -203,6 +227,8 @@ TI_STATUS TrafficMonitor_Start(TI_HANDLE hTrafficMonitor)
         if(AlertElement->CurrentState != ALERT_WAIT_FOR_RESET) 
         {
             AlertElement->EventCounter = 0;
+            AlertElement->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, AlertElement);
+            AlertElement->uLastEvalCount = AlertElement->uBaseCount;
             AlertElement->TimeOut = AlertElement->TimeIntervalMs + CurentTime;
         }
         AlertElement = (TrafficAlertElement_t*)List_GetNext(TrafficMonitor->NotificationRegList);
@@ -239,6 +265,12 @@ TI_STATUS TrafficMonitor_Stop(TI_HANDLE hTrafficMonitor)
         pTrafficMonitor->DownTimerEnabled = TI_FALSE;
         tmr_StopTimer (pTrafficMonitor->hTrafficMonTimer);
 
+        if (pTrafficMonitor->bEvalTimerRunning)
+        {
+            pTrafficMonitor->bEvalTimerRunning = TI_FALSE;
+            tmr_StopTimer (pTrafficMonitor->hEvalTimer);
+        }
+        pTrafficMonitor->uEventsSinceEval = 0;
     }  
 
     /* Set all events state to ALERT_OFF to enable them to "kick" again once after TrafficMonitor is started */
@@ -277,6 +309,11 @@ TI_STATUS TrafficMonitor_Destroy(TI_HANDLE hTrafficMonitor)
         {
             tmr_DestroyTimer (TrafficMonitor->hTrafficMonTimer);
         }
+
+        if(TrafficMonitor->hEvalTimer)
+        {
+            tmr_DestroyTimer (TrafficMonitor->hEvalTimer);
+        }
         
 #ifdef TRAFF_TEST
 		if (TestEventTimer)
@@ -346,6 +383,8 @@ TI_HANDLE TrafficMonitor_RegEvent(TI_HANDLE hTrafficMonitor,TrafficAlertRegParm_
     TrafficAlertElement->TimeOut = CurentTime + TrafficAlertRegParm->TimeIntervalMs;
     TrafficAlertElement->EventCounter = 0;
     TrafficMonitor_SetMask(TrafficMonitor,TrafficAlertElement,TrafficAlertRegParm->MonitorType);
+    TrafficAlertElement->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, TrafficAlertElement);
+    TrafficAlertElement->uLastEvalCount = TrafficAlertElement->uBaseCount;
     
     TrafficAlertElement->CurrentState = ALERT_OFF;
     TrafficAlertElement->AutoCreated = TI_FALSE;
@@ -423,7 +462,7 @@ static TI_STATUS FindRstElemEntryIndex (TrafficMonitor_t *TrafficMonitor,Traffic
  *      Convert the Mask from the types that declared in the 
  *  TrafficMonitorAPI to the types that are used in the Rx Tx modules.
  *  And update the TX and RX module of the new event req
- *  Sets the aggregation function that corresponds to the specific mask type
+ *  Bytes events are counted by the event count, frames events by 1 (see TrafficMonitor_Event)
  ************************************************************************/
 static TI_STATUS TrafficMonitor_SetMask(TrafficMonitor_t *TrafficMonitor,TrafficAlertElement_t *TrafficAlertElement,TraffEvntOptNum_t MaskType)
 {
@@ -434,40 +473,32 @@ static TI_STATUS TrafficMonitor_SetMask(TrafficMonitor_t *TrafficMonitor,Traffic
    case TX_RX_DIRECTED_FRAMES:
         TxMask = DIRECTED_FRAMES_XFER;
         RxMask = DIRECTED_FRAMES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleFrameAggregation;
         break;
    case TX_ALL_MSDU_FRAMES:
         TxMask = DIRECTED_FRAMES_XFER|MULTICAST_FRAMES_XFER|BROADCAST_FRAMES_XFER;
-        TrafficAlertElement->ActionFunc = SimpleFrameAggregation;
     break;
    case RX_ALL_MSDU_FRAMES:
         RxMask = DIRECTED_FRAMES_RECV|MULTICAST_FRAMES_RECV|BROADCAST_FRAMES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleFrameAggregation;
         break;
    case TX_RX_ALL_MSDU_FRAMES:
         TxMask = DIRECTED_FRAMES_XFER|MULTICAST_FRAMES_XFER|BROADCAST_FRAMES_XFER;
         RxMask = DIRECTED_FRAMES_RECV|MULTICAST_FRAMES_RECV|BROADCAST_FRAMES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleFrameAggregation;
         break;
     case TX_RX_ALL_MSDU_IN_BYTES:
         TxMask = DIRECTED_BYTES_XFER|MULTICAST_BYTES_XFER|BROADCAST_BYTES_XFER;
         RxMask = DIRECTED_BYTES_RECV|MULTICAST_BYTES_RECV|BROADCAST_BYTES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleByteAggregation;
         break;
    case TX_RX_DIRECTED_IN_BYTES:
         TxMask = DIRECTED_BYTES_XFER;
         RxMask = DIRECTED_BYTES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleByteAggregation;
     break;
    case TX_RX_ALL_802_11_DATA_IN_BYTES:
         TxMask = DIRECTED_BYTES_XFER | MULTICAST_BYTES_XFER;
         RxMask = DIRECTED_BYTES_RECV | MULTICAST_BYTES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleByteAggregation;
     break;
    case TX_RX_ALL_802_11_DATA_FRAMES:
         TxMask = DIRECTED_FRAMES_XFER | MULTICAST_FRAMES_XFER;
         RxMask = DIRECTED_FRAMES_RECV | MULTICAST_FRAMES_RECV;
-        TrafficAlertElement->ActionFunc = SimpleFrameAggregation;
     break;
    default:
        return TI_NOK;
@@ -557,6 +588,8 @@ TI_STATUS TrafficMonitor_SetRstCondition(TI_HANDLE hTrafficMonitor, TI_HANDLE Ev
         TrafficAlertElement->CurrentState = ALERT_OFF;
         TrafficAlertElement->TimeOut = CurentTime + TrafficAlertElement->TimeIntervalMs;
         TrafficAlertElement->EventCounter =0;
+        TrafficAlertElement->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, TrafficAlertElement);
+        TrafficAlertElement->uLastEvalCount = TrafficAlertElement->uBaseCount;
     }
     
 
@@ -579,6 +612,8 @@ TI_STATUS TrafficMonitor_SetRstCondition(TI_HANDLE hTrafficMonitor, TI_HANDLE Ev
         TrafficResetAlertElement->CurrentState = ALERT_OFF;
         TrafficResetAlertElement->TimeOut = CurentTime + TrafficAlertElement->TimeIntervalMs;
         TrafficResetAlertElement->EventCounter = 0;
+        TrafficResetAlertElement->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, TrafficResetAlertElement);
+        TrafficResetAlertElement->uLastEvalCount = TrafficResetAlertElement->uBaseCount;
       }
     }
     return TI_OK;
@@ -664,6 +699,10 @@ void TrafficMonitor_ResetEvent(TI_HANDLE hTrafficMonitor, TI_HANDLE EventHandle)
         return ;
 
     TrafficAlertElement->CurrentState = ALERT_OFF;
+    /* The events received while waiting for reset are not counted */
+    TrafficAlertElement->EventCounter = 0;
+    TrafficAlertElement->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, TrafficAlertElement);
+    TrafficAlertElement->uLastEvalCount = TrafficAlertElement->uBaseCount;
 
     TrafficMonitor_UpdateDownTrafficTimerState (TrafficMonitor);
 }
@@ -697,6 +736,45 @@ void TrafficMonitor_UnregEvent(TI_HANDLE hTrafficMonitor, TI_HANDLE EventHandle)
  
 
 
+/***********************************************************************
+ *                        TrafficMonitor_alertCount
+ ***********************************************************************
+DESCRIPTION: Returns the aggregated count of the events monitored by an alert element,
+             i.e. the sum of the aggregated counters of the alert mask bits.
+             Each Tx/Rx event has a single frame type (directed, multicast or broadcast),
+             and an alert mask includes either bytes or frames bits, so an event is
+             counted only once per alert.
+
+INPUT:      TrafficMonitor - Traffic Monitor the object.
+            AlertElement -   Alert event
+
+RETURN:     The alert events aggregated count (cyclic)
+
+************************************************************************/
+static TI_UINT32 TrafficMonitor_alertCount (TrafficMonitor_t *TrafficMonitor, TrafficAlertElement_t *AlertElement)
+{
+    TI_UINT32 uCount = 0;
+    TI_UINT32 uModule, uBit;
+
+    for (uModule = 0; uModule < MAX_NUM_MONITORED_MODULES; uModule++)
+    {
+        if (AlertElement->MonitorMask[uModule] == 0)
+        {
+            continue;
+        }
+        for (uBit = 0; uBit < TRAFF_NUM_EVENT_BITS; uBit++)
+        {
+            if (AlertElement->MonitorMask[uModule] & (1 << uBit))
+            {
+                uCount += TrafficMonitor->aEventCount[uModule][uBit];
+            }
+        }
+    }
+
+    return uCount;
+}
+
+
 /***********************************************************************
  *                        isThresholdUp                 
  ***********************************************************************
@@ -709,6 +787,9 @@ DESCRIPTION: Evaluate if alert element as crossed his threshold
              For Edge
                 The alert mode is changed to wait for reset and the reset element is set to off.
                 And his timeout is set
+             Called once per evaluation, so the events counted in the window may exceed the 
+             time interval by up to one evaluation tick. An expired window is restarted 
+             before the threshold check, from the count of the last evaluation.
 
 INPUT:                          
             EventHandle -         Alert event
@@ -719,19 +800,28 @@ OUTPUT:
 RETURN:     If  threshold crossed TI_TRUE else False
 
 ************************************************************************/
-static TI_BOOL isThresholdUp(TrafficAlertElement_t *AlertElement , TI_UINT32 CurrentTime)
+static TI_BOOL isThresholdUp(TrafficMonitor_t *TrafficMonitor, TrafficAlertElement_t *AlertElement, TI_UINT32 CurrentTime)
 {  
     int i;
-    
+    TI_UINT32 uTotalCount = TrafficMonitor_alertCount(TrafficMonitor, AlertElement);
+
+    /* 
+     * End of time window - start a new window with the events since the last evaluation, 
+     *   so events of an old expired window (e.g. before an idle period) aren't counted.
+     */
     if (AlertElement->TimeOut < CurrentTime)        
     {
-        AlertElement->EventCounter = AlertElement->LastCounte;
+        AlertElement->uBaseCount = AlertElement->uLastEvalCount;
         AlertElement->TimeOut = CurrentTime + AlertElement->TimeIntervalMs;
     }
+    AlertElement->uLastEvalCount = uTotalCount;
+
+    AlertElement->EventCounter = (int)(uTotalCount - AlertElement->uBaseCount);
     
     if (AlertElement->EventCounter > AlertElement->Threshold)
     {
         AlertElement->EventCounter = 0;
+        AlertElement->uBaseCount = uTotalCount;
         /*Sets the new due time (time out)*/
         AlertElement->TimeOut = CurrentTime + AlertElement->TimeIntervalMs;
         
@@ -749,6 +839,8 @@ static TI_BOOL isThresholdUp(TrafficAlertElement_t *AlertElement , TI_UINT32 Cur
                     {
                         rstElmt->CurrentState = ALERT_OFF;
                         rstElmt->EventCounter = 0;
+                        rstElmt->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, rstElmt);
+                        rstElmt->uLastEvalCount = rstElmt->uBaseCount;
                         rstElmt->TimeOut = CurrentTime + rstElmt->TimeIntervalMs;
                     }
             }
@@ -761,7 +853,7 @@ static TI_BOOL isThresholdUp(TrafficAlertElement_t *AlertElement , TI_UINT32 Cur
             AlertElement->CallBack(AlertElement->Context,AlertElement->Cookie);
         return TI_TRUE;
     }
-    
+
     return TI_FALSE;
 }
 
@@ -790,10 +882,13 @@ OUTPUT:
 RETURN:     If threshold crossed TI_TRUE else False
 
 ************************************************************************/
-static TI_BOOL isThresholdDown(TrafficAlertElement_t *AlertElement , TI_UINT32 CurrentTime)
+static TI_BOOL isThresholdDown(TrafficMonitor_t *TrafficMonitor, TrafficAlertElement_t *AlertElement, TI_UINT32 CurrentTime)
 {
     int i;
     TI_BOOL returnVal = TI_FALSE;
+    TI_UINT32 uTotalCount = TrafficMonitor_alertCount(TrafficMonitor, AlertElement);
+
+    AlertElement->EventCounter = (int)(uTotalCount - AlertElement->uBaseCount);
 
     /*
     if its end of window time.
@@ -819,6 +914,8 @@ static TI_BOOL isThresholdDown(TrafficAlertElement_t *AlertElement , TI_UINT32 C
                         {
                             rstElmt->CurrentState = ALERT_OFF;
                             rstElmt->EventCounter = 0;
+                            rstElmt->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, rstElmt);
+                            rstElmt->uLastEvalCount = rstElmt->uBaseCount;
                             rstElmt->TimeOut = CurrentTime + rstElmt->TimeIntervalMs;
                         }
                 }
@@ -835,6 +932,7 @@ static TI_BOOL isThresholdDown(TrafficAlertElement_t *AlertElement , TI_UINT32 C
 
         /* end of time window - clear the event counter for the new window.*/
         AlertElement->EventCounter = 0;
+        AlertElement->uBaseCount = uTotalCount;
         /*Sets the new due time (time out)*/
         AlertElement->TimeOut = CurrentTime + AlertElement->TimeIntervalMs;
     }
@@ -848,6 +946,7 @@ static TI_BOOL isThresholdDown(TrafficAlertElement_t *AlertElement , TI_UINT32 C
         if(AlertElement->EventCounter > AlertElement->Threshold)
         {
             AlertElement->EventCounter = 0;
+            AlertElement->uBaseCount = uTotalCount;
             AlertElement->TimeOut = CurrentTime + AlertElement->TimeIntervalMs;
         }
     }
@@ -862,50 +961,100 @@ static TI_BOOL isThresholdDown(TrafficAlertElement_t *AlertElement , TI_UINT32 C
 /*
  *      Timer function that is called for every x time interval 
  *   That will invoke a process if any down limit as occurred. 
+ *   Evaluates all the alerts, as the evaluation tick runs only while there is traffic.
  *
  ************************************************************************/
 static void TimerMonitor_TimeOut (TI_HANDLE hTrafficMonitor, TI_BOOL bTwdInitOccured)
 {
-    
     TrafficMonitor_t *TrafficMonitor =(TrafficMonitor_t*)hTrafficMonitor;
+  
+    if(TrafficMonitor == NULL)
+        return;
+
+#ifdef TI_DBG
+    TrafficMonitor->uTimerEvals++;
+#endif
+
+    TrafficMonitor_Evaluate (TrafficMonitor);
+}
+
+
+/************************************************************************/
+/*              TrafficMonitor_EvalTimeout                              */
+/************************************************************************/
+/*
+ *      Evaluation tick - started by the first Tx/Rx event after an evaluation, 
+ *   so it runs only while there is traffic.
+ *
+ ************************************************************************/
+static void TrafficMonitor_EvalTimeout (TI_HANDLE hTrafficMonitor, TI_BOOL bTwdInitOccured)
+{
+    TrafficMonitor_t *TrafficMonitor =(TrafficMonitor_t*)hTrafficMonitor;
+
+    TrafficMonitor->bEvalTimerRunning = TI_FALSE;
+
+    if (TrafficMonitor->Active && (TrafficMonitor->uEventsSinceEval > 0))
+    {
+#ifdef TI_DBG
+        TrafficMonitor->uTickEvals++;
+#endif
+        TrafficMonitor_Evaluate (TrafficMonitor);
+    }
+}
+
+
+/************************************************************************/
+/*              TrafficMonitor_Evaluate                                 */
+/************************************************************************/
+/*
+ *      Evaluate all the alerts against the aggregated counters, and update
+ *   the bandwidth windows and the "traffic down" timer state.
+ *   Called on the evaluation tick, on a burst of events and on the "traffic down" timer.
+ *
+ ************************************************************************/
+static void TrafficMonitor_Evaluate (TrafficMonitor_t *TrafficMonitor)
+{
     TrafficAlertElement_t *AlertElement;
     TI_UINT32 CurentTime;
     TI_UINT32 activeTrafDownEventsNum = 0;
     TI_UINT32 trafficDownMinTimeout = 0xFFFFFFFF;
-  
-    if(TrafficMonitor == NULL)
-        return;
 
-    AlertElement  = (TrafficAlertElement_t*)List_GetFirst(TrafficMonitor->NotificationRegList);
     CurentTime = os_timeStampMs(TrafficMonitor->hOs);
+
+    TrafficMonitor_flushBW(TrafficMonitor, CurentTime);
+    TrafficMonitor->uEventsSinceEval = 0;
+
+    AlertElement  = (TrafficAlertElement_t*)List_GetFirst(TrafficMonitor->NotificationRegList);
     
-    
-    /* go over all the Down elements and check for alert */    
+    /* go over all the elements and check for alert */    
     while(AlertElement)
     {
         if(AlertElement->CurrentState != ALERT_WAIT_FOR_RESET) 
         {
-            if (AlertElement->Direction == TRAFF_DOWN)
+            if (AlertElement->Direction == TRAFF_UP)
+            {
+                isThresholdUp(TrafficMonitor, AlertElement, CurentTime);
+            }
+            else
             {
-               isThresholdDown(AlertElement,CurentTime);
-            }   
+                isThresholdDown(TrafficMonitor, AlertElement, CurentTime);
+            }
         }
  
-         if ((AlertElement->Direction == TRAFF_DOWN) && (AlertElement->Trigger == TRAFF_EDGE) && (AlertElement->CurrentState == ALERT_OFF) && (AlertElement->Enabled == TI_TRUE))
-{
+        if ((AlertElement->Direction == TRAFF_DOWN) && (AlertElement->Trigger == TRAFF_EDGE) && (AlertElement->CurrentState == ALERT_OFF) && (AlertElement->Enabled == TI_TRUE))
+        {
             /* Increase counter of active traffic down events */
             activeTrafDownEventsNum++;
 
             /* Search for the alert with the most short Interval time - will be used to start timer */
             if ((AlertElement->TimeIntervalMs) < (trafficDownMinTimeout))
                trafficDownMinTimeout = AlertElement->TimeIntervalMs;
-         }
+        }
     
         AlertElement = (TrafficAlertElement_t*)List_GetNext(TrafficMonitor->NotificationRegList);
     }   
     
-   TrafficMonitor_ChangeDownTimerStatus (TrafficMonitor,activeTrafDownEventsNum,trafficDownMinTimeout);
-    
+    TrafficMonitor_ChangeDownTimerStatus (TrafficMonitor,activeTrafDownEventsNum,trafficDownMinTimeout);
 }
 
 /***********************************************************************
@@ -960,39 +1109,94 @@ int TrafficMonitor_GetFrameBandwidth(TI_HANDLE hTrafficMonitor)
 
 	uCurentTS = os_timeStampMs(pTrafficMonitor->hOs);  
 
+	/* Add the frames counted since the last evaluation */
+	TrafficMonitor_flushBW(pTrafficMonitor, uCurentTS);
+
 	/* Calculate BW for Rx & Tx */
 	return ( TrafficMonitor_calcBW(&pTrafficMonitor->DirectRxFrameBW, uCurentTS) +
 			 TrafficMonitor_calcBW(&pTrafficMonitor->DirectTxFrameBW, uCurentTS) );
 }
 
+/***********************************************************************
+ *                        TrafficMonitor_PublishStats                        
+ ***********************************************************************
+DESCRIPTION: Copy the direct Rx and Tx frames bandwidth to the statistics page section.
+             Called in the driver context within the page update.
+                                
+INPUT:          hTrafficMonitor -       Traffic Monitor the object.
+                        
+OUTPUT:         pTraffic - the statistics page traffic section
+
+RETURN:     
+************************************************************************/
+void TrafficMonitor_PublishStats(TI_HANDLE hTrafficMonitor, TStatsPageTraffic *pTraffic)
+{
+	TrafficMonitor_t 	*pTrafficMonitor =(TrafficMonitor_t*)hTrafficMonitor;
+	TI_UINT32 			uCurentTS = os_timeStampMs(pTrafficMonitor->hOs);
+
+	TrafficMonitor_flushBW(pTrafficMonitor, uCurentTS);
+
+	pTraffic->uDirectRxFrames = TrafficMonitor_calcBW(&pTrafficMonitor->DirectRxFrameBW, uCurentTS);
+	pTraffic->uDirectTxFrames = TrafficMonitor_calcBW(&pTrafficMonitor->DirectTxFrameBW, uCurentTS);
+	pTraffic->uWindowMs       = BW_WINDOW_MS;
+}
+
 /***********************************************************************
 *                        TrafficMonitor_updateBW                        
 ***********************************************************************
-DESCRIPTION: Upon receiving an event of Tx/Rx (a packet was sent or received), This function is 
-				called and performs BW calculation.
+DESCRIPTION: Adds the directed frames counted since the last update to the BW windows.
 
 INPUT:          
 				pBandWidth		- BW of Rx or Tx	
-				uCurrentTS		- current TS of the recent event
+				uCurrentTS		- current TS
+				uFrames			- frames to add
 
 OUTPUT:         pBandWidth		- updated counters and TS
 
 ************************************************************************/
-void TrafficMonitor_updateBW(BandWidth_t *pBandWidth, TI_UINT32 uCurrentTS)
+void TrafficMonitor_updateBW(BandWidth_t *pBandWidth, TI_UINT32 uCurrentTS, TI_UINT32 uFrames)
 {
+	if (uFrames == 0)
+	{
+		return;
+	}
+
 	/* Check if we should move to the next window */
 	if ( (uCurrentTS - pBandWidth->auFirstEventsTS[pBandWidth->uCurrentWindow]) < (SIZE_OF_WINDOW_MS) )
 	{	
-		pBandWidth->auWindowCounter[pBandWidth->uCurrentWindow]++;
+		pBandWidth->auWindowCounter[pBandWidth->uCurrentWindow] += uFrames;
 	}
 	else	/* next window */
 	{	
 		/* increment current window and mark the first event received */	
 		pBandWidth->uCurrentWindow = (pBandWidth->uCurrentWindow + 1) & CYCLIC_COUNTER_ELEMENT;
 		pBandWidth->auFirstEventsTS[pBandWidth->uCurrentWindow] = uCurrentTS;
-		pBandWidth->auWindowCounter[pBandWidth->uCurrentWindow] = 1;
+		pBandWidth->auWindowCounter[pBandWidth->uCurrentWindow] = uFrames;
 	}
 }
+
+/***********************************************************************
+*                        TrafficMonitor_flushBW                        
+***********************************************************************
+DESCRIPTION: Adds the Rx and Tx directed frames aggregated since the last flush to the 
+			 BW windows. Called on evaluation and before the BW is calculated.
+
+INPUT:       TrafficMonitor	- Traffic Monitor the object.
+			 uCurrentTS		- current TS
+
+************************************************************************/
+static void TrafficMonitor_flushBW(TrafficMonitor_t *TrafficMonitor, TI_UINT32 uCurrentTS)
+{
+	TI_UINT32 uRxFrames = TrafficMonitor->aEventCount[RX_TRAFF_MODULE][TRAFF_DIRECTED_FRAMES_BIT] - TrafficMonitor->aBwCountedFrames[RX_TRAFF_MODULE];
+	TI_UINT32 uTxFrames = TrafficMonitor->aEventCount[TX_TRAFF_MODULE][TRAFF_DIRECTED_FRAMES_BIT] - TrafficMonitor->aBwCountedFrames[TX_TRAFF_MODULE];
+
+	TrafficMonitor_updateBW(&TrafficMonitor->DirectRxFrameBW, uCurrentTS, uRxFrames);
+	TrafficMonitor_updateBW(&TrafficMonitor->DirectTxFrameBW, uCurrentTS, uTxFrames);
+
+	TrafficMonitor->aBwCountedFrames[RX_TRAFF_MODULE] += uRxFrames;
+	TrafficMonitor->aBwCountedFrames[TX_TRAFF_MODULE] += uTxFrames;
+}
+
 /***********************************************************************
 *                        TrafficMonitor_calcBW                        
 ***********************************************************************
@@ -1035,8 +1239,9 @@ TI_UINT32 TrafficMonitor_calcBW(BandWidth_t *pBandWidth, TI_UINT32 uCurrentTS)
  *                        TrafficMonitor_Event                  
  ***********************************************************************
 DESCRIPTION: this function is called for every event that was requested from the Tx or Rx
-             The function preformes update of the all the relevant Alert in the system 
-             that corresponds to the event. checks the Alert Status due to this event.
+             The function only updates the aggregated counters of the event bits.
+             The alerts are evaluated against the counters once per evaluation tick 
+             (started by the first event after an evaluation), or after a burst of events.
              
  
                                 
@@ -1055,10 +1260,9 @@ RETURN:
 void TrafficMonitor_Event(TI_HANDLE hTrafficMonitor,int Count,TI_UINT16 Mask,TI_UINT32 MonitorModuleType)
 {
     TrafficMonitor_t *TrafficMonitor =(TrafficMonitor_t*)hTrafficMonitor;
-    TrafficAlertElement_t *AlertElement;
-    TI_UINT32 activeTrafDownEventsNum = 0;
-    TI_UINT32 trafficDownMinTimeout = 0xFFFFFFFF;
-    TI_UINT32 uCurentTS;
+    TI_UINT32 *pEventCount;
+    TI_UINT32 uEvents;
+    TI_UINT32 uBit;
 
     if(TrafficMonitor == NULL)
         return;
@@ -1066,84 +1270,47 @@ void TrafficMonitor_Event(TI_HANDLE hTrafficMonitor,int Count,TI_UINT16 Mask,TI_
     if(!TrafficMonitor->Active)   
         return;
 
-	uCurentTS = os_timeStampMs(TrafficMonitor->hOs);
-
-    /* for BW calculation */
-    if(MonitorModuleType == RX_TRAFF_MODULE)
-    {
-        if(Mask & DIRECTED_FRAMES_RECV)
-		{
-            TrafficMonitor_updateBW(&TrafficMonitor->DirectRxFrameBW, uCurentTS); 
-		} 
-    }
-    else if (MonitorModuleType == TX_TRAFF_MODULE)
-    {
-        if(Mask & DIRECTED_FRAMES_XFER)
-		{
-            TrafficMonitor_updateBW(&TrafficMonitor->DirectTxFrameBW, uCurentTS);
-		}
-    }
-    else  
+    if (MonitorModuleType >= MAX_NUM_MONITORED_MODULES)
 	{
         return; /* module type does not exist, error return */
 	}
 
-    AlertElement  = (TrafficAlertElement_t*)List_GetFirst(TrafficMonitor->NotificationRegList);
-    
-    /* go over all the elements and check for alert */    
-    while(AlertElement)
+    /* Update the aggregated counters - bytes events by the count, frames events by 1 */
+    pEventCount = TrafficMonitor->aEventCount[MonitorModuleType];
+    uEvents = Mask & TRAFF_COUNTED_EVENTS;
+    for (uBit = 0; uEvents; uBit++, uEvents >>= 1)
     {
-        if(AlertElement->CurrentState != ALERT_WAIT_FOR_RESET) 
+        if (uEvents & 1)
         {
-            if(AlertElement->MonitorMask[MonitorModuleType] & Mask)
-            {
-                AlertElement->ActionFunc(AlertElement,Count);
-                if (AlertElement->Direction == TRAFF_UP)
-                {
-                    isThresholdUp(AlertElement, uCurentTS);
-                }
-            }
-
-            if ((AlertElement->Direction == TRAFF_DOWN) && (AlertElement->Trigger == TRAFF_EDGE) && (AlertElement->CurrentState == ALERT_OFF) && (AlertElement->Enabled == TI_TRUE))
-            {
-               /* Increase counter of active traffic down events */
-               activeTrafDownEventsNum++;
-
-               /* Search for the alert with the most short Interval time - will be used to start timer */
-               if ((AlertElement->TimeIntervalMs) < (trafficDownMinTimeout))
-                  trafficDownMinTimeout = AlertElement->TimeIntervalMs;
-            }
-
+            pEventCount[uBit] += ((1 << uBit) & TRAFF_BYTES_EVENTS) ? (TI_UINT32)Count : 1;
         }
-        AlertElement = (TrafficAlertElement_t*)List_GetNext(TrafficMonitor->NotificationRegList);
     }
 
-    TrafficMonitor_ChangeDownTimerStatus (TrafficMonitor,activeTrafDownEventsNum,trafficDownMinTimeout);
-
-}
-
+    TrafficMonitor->uEventsSinceEval++;
+#ifdef TI_DBG
+    TrafficMonitor->uEvents++;
+#endif
 
-/*
- *      Used as the aggregation function that is used by the alerts for counting the events. 
- */
-static void SimpleByteAggregation(TI_HANDLE TraffElem,int Count)
-{
-    TrafficAlertElement_t *AlertElement = TraffElem;
-    AlertElement->EventCounter += Count;
-    AlertElement->LastCounte = Count; 
+    /* Evaluate the alerts on a burst of events, otherwise on the next tick */
+    if (TrafficMonitor->uEvalBurst && (TrafficMonitor->uEventsSinceEval >= TrafficMonitor->uEvalBurst))
+    {
+#ifdef TI_DBG
+        TrafficMonitor->uBurstEvals++;
+#endif
+        TrafficMonitor_Evaluate (TrafficMonitor);
+    }
+    else if (!TrafficMonitor->bEvalTimerRunning)
+    {
+        TrafficMonitor->bEvalTimerRunning = TI_TRUE;
+        tmr_StartTimer (TrafficMonitor->hEvalTimer,
+                        TrafficMonitor_EvalTimeout,
+                        (TI_HANDLE)TrafficMonitor,
+                        TrafficMonitor->uEvalTickMs,
+                        TI_FALSE);
+    }
 }
 
 
-/*
- *      Used as the aggregation function for frame. (count is not used)
- */
-static void SimpleFrameAggregation(TI_HANDLE TraffElem,int Count)
-{
-    TrafficAlertElement_t *AlertElement = TraffElem;
-    AlertElement->EventCounter++;
-    AlertElement->LastCounte = 1; 
-}
-
 /*-----------------------------------------------------------------------------
 Routine Name: TrafficMonitor_UpdateDownTrafficTimerState
 Routine Description: called whenever a "down" alert is called, or any other change in the alert list.
@@ -1239,6 +1406,187 @@ void TrafficMonitor_UpdateActiveEventsCounters (TI_HANDLE hTrafficMonitor)
 }
 
 
+/*-----------------------------------------------------------------------------
+Routine Name: TrafficMonitor_PrintStats
+Routine Description: Print the events aggregation and alerts evaluation statistics.
+Arguments:
+Return Value:
+-----------------------------------------------------------------------------*/
+void TrafficMonitor_PrintStats (TI_HANDLE hTrafficMonitor)
+{
+	TrafficMonitor_t *TrafficMonitor =(TrafficMonitor_t*)hTrafficMonitor;
+    TrafficAlertElement_t *AlertElement;
+    TI_UINT32 uEvals = TrafficMonitor->uTickEvals + TrafficMonitor->uBurstEvals + TrafficMonitor->uTimerEvals;
+    TI_UINT32 uModule, uBit;
+    TI_UINT32 uIdx = 0;
+
+    WLAN_OS_REPORT(("------------- Traffic Monitor Stats -------------\n"));
+    WLAN_OS_REPORT(("Active = %d, EvalTickMs = %d, EvalBurst = %d\n", 
+                    TrafficMonitor->Active, TrafficMonitor->uEvalTickMs, TrafficMonitor->uEvalBurst));
+    WLAN_OS_REPORT(("Events = %d, Evaluations: tick = %d, burst = %d, down timer = %d\n", 
+                    TrafficMonitor->uEvents, TrafficMonitor->uTickEvals, TrafficMonitor->uBurstEvals, TrafficMonitor->uTimerEvals));
+    WLAN_OS_REPORT(("Events per evaluation = %d\n", uEvals ? (TrafficMonitor->uEvents / uEvals) : 0));
+
+    for (uModule = 0; uModule < MAX_NUM_MONITORED_MODULES; uModule++)
+    {
+        WLAN_OS_REPORT(("%s counters:", (uModule == TX_TRAFF_MODULE) ? "Tx" : "Rx"));
+        for (uBit = 0; uBit < TRAFF_NUM_EVENT_BITS; uBit++)
+        {
+            if ((1 << uBit) & TRAFF_COUNTED_EVENTS)
+            {
+                WLAN_OS_REPORT((" 0x%02x=%u", 1 << uBit, TrafficMonitor->aEventCount[uModule][uBit]));
+            }
+        }
+        WLAN_OS_REPORT(("\n"));
+    }
+
+    AlertElement  = (TrafficAlertElement_t*)List_GetFirst(TrafficMonitor->NotificationRegList);
+    while(AlertElement)
+    {
+        WLAN_OS_REPORT(("Alert %d: %s %s, state = %d, enabled = %d, count = %d, threshold = %d, interval = %d\n",
+                        uIdx++,
+                        (AlertElement->Direction == TRAFF_UP) ? "UP" : "DOWN",
+                        (AlertElement->Trigger == TRAFF_EDGE) ? "EDGE" : "LEVEL",
+                        AlertElement->CurrentState, AlertElement->Enabled,
+                        AlertElement->EventCounter, AlertElement->Threshold, AlertElement->TimeIntervalMs));
+        AlertElement = (TrafficAlertElement_t*)List_GetNext(TrafficMonitor->NotificationRegList);
+    }
+}
+
+
+/*
+ *      The per event processing before the events aggregation - the alerts list walk, 
+ *   used as the reference of TrafficMonitor_Benchmark.
+ */
+static void TrafficMonitor_legacyEvent (TrafficMonitor_t *TrafficMonitor, int Count, TI_UINT16 Mask, TI_UINT32 MonitorModuleType)
+{
+    TrafficAlertElement_t *AlertElement;
+    TI_UINT32 activeTrafDownEventsNum = 0;
+    TI_UINT32 uCurentTS = os_timeStampMs(TrafficMonitor->hOs);
+
+    AlertElement  = (TrafficAlertElement_t*)List_GetFirst(TrafficMonitor->NotificationRegList);
+    while(AlertElement)
+    {
+        if(AlertElement->CurrentState != ALERT_WAIT_FOR_RESET) 
+        {
+            if(AlertElement->MonitorMask[MonitorModuleType] & Mask)
+            {
+                AlertElement->EventCounter++;
+                if ((AlertElement->Direction == TRAFF_UP) && (AlertElement->TimeOut < uCurentTS))
+                {
+                    AlertElement->EventCounter = 1;
+                    AlertElement->TimeOut = uCurentTS + AlertElement->TimeIntervalMs;
+                }
+                if (AlertElement->EventCounter > AlertElement->Threshold)
+                {
+                    AlertElement->EventCounter = 0;
+                }
+            }
+
+            if ((AlertElement->Direction == TRAFF_DOWN) && (AlertElement->Trigger == TRAFF_EDGE) && (AlertElement->CurrentState == ALERT_OFF) && (AlertElement->Enabled == TI_TRUE))
+            {
+               activeTrafDownEventsNum++;
+            }
+        }
+        AlertElement = (TrafficAlertElement_t*)List_GetNext(TrafficMonitor->NotificationRegList);
+    }
+}
+
+
+#define TRAFF_BENCHMARK_EVENTS      10000
+#define TRAFF_BENCHMARK_EVALS       1000
+
+/*-----------------------------------------------------------------------------
+Routine Name: TrafficMonitor_Benchmark
+Routine Description: Measure the per packet cost of the events aggregation against the
+                     per packet alerts list walk, and the cost of an alerts evaluation, 
+                     for a growing number of registered alerts.
+                     Uses a private Traffic Monitor instance, so the registered alerts 
+                     and the Tx/Rx notifications are not affected.
+Arguments:
+Return Value:
+-----------------------------------------------------------------------------*/
+void TrafficMonitor_Benchmark (TI_HANDLE hTrafficMonitor)
+{
+	TrafficMonitor_t *pRealMonitor = (TrafficMonitor_t*)hTrafficMonitor;
+    TrafficMonitor_t *TrafficMonitor;
+    TrafficAlertElement_t *AlertElement;
+    static const TI_UINT32 aNumAlerts[] = {1, 4, 8, 16, 24};
+    TI_UINT32 uTest, uAlerts, i;
+    TI_UINT32 uStartUs, uEventUs, uLegacyUs, uEvalUs;
+
+    TrafficMonitor = (TrafficMonitor_t*)TrafficMonitor_create(pRealMonitor->hOs);
+    if (TrafficMonitor == NULL)
+    {
+        WLAN_OS_REPORT(("TrafficMonitor_Benchmark: allocation failed\n"));
+        return;
+    }
+
+    /* No evaluation on burst, and no evaluation timer (marked as running) */
+    TrafficMonitor->Active = TI_TRUE;
+    TrafficMonitor->uEvalBurst = 0;
+    TrafficMonitor->bEvalTimerRunning = TI_TRUE;
+    TrafficMonitor->trafficDownTestIntervalPercent = pRealMonitor->trafficDownTestIntervalPercent;
+
+    WLAN_OS_REPORT(("------------- Traffic Monitor Benchmark (%d Rx events) -------------\n", TRAFF_BENCHMARK_EVENTS));
+    WLAN_OS_REPORT(("Alerts | aggregated ns/pkt | list walk ns/pkt | evaluation ns\n"));
+
+    uAlerts = 0;
+    for (uTest = 0; uTest < sizeof(aNumAlerts) / sizeof(aNumAlerts[0]); uTest++)
+    {
+        /* Add "directed frames" UP LEVEL alerts that never cross their threshold */
+        for ( ; uAlerts < aNumAlerts[uTest]; uAlerts++)
+        {
+            AlertElement = (TrafficAlertElement_t*)List_AllocElement(TrafficMonitor->NotificationRegList);
+            if (AlertElement == NULL)
+            {
+                break;
+            }
+            AlertElement->Direction = TRAFF_UP;
+            AlertElement->Trigger = TRAFF_LEVEL;
+            AlertElement->CurrentState = ALERT_OFF;
+            AlertElement->Threshold = 0x7FFFFFFF;
+            AlertElement->TimeIntervalMs = 1000;
+            AlertElement->TimeOut = os_timeStampMs(TrafficMonitor->hOs) + AlertElement->TimeIntervalMs;
+            AlertElement->MonitorMask[TX_TRAFF_MODULE] = DIRECTED_FRAMES_XFER;
+            AlertElement->MonitorMask[RX_TRAFF_MODULE] = DIRECTED_FRAMES_RECV;
+            AlertElement->uBaseCount = TrafficMonitor_alertCount(TrafficMonitor, AlertElement);
+            AlertElement->uLastEvalCount = AlertElement->uBaseCount;
+        }
+
+        uStartUs = os_timeStampUs(TrafficMonitor->hOs);
+        for (i = 0; i < TRAFF_BENCHMARK_EVENTS; i++)
+        {
+            TrafficMonitor_Event(TrafficMonitor, 1500, DIRECTED_BYTES_RECV | DIRECTED_FRAMES_RECV, RX_TRAFF_MODULE);
+        }
+        uEventUs = os_timeStampUs(TrafficMonitor->hOs) - uStartUs;
+
+        uStartUs = os_timeStampUs(TrafficMonitor->hOs);
+        for (i = 0; i < TRAFF_BENCHMARK_EVENTS; i++)
+        {
+            TrafficMonitor_legacyEvent(TrafficMonitor, 1500, DIRECTED_BYTES_RECV | DIRECTED_FRAMES_RECV, RX_TRAFF_MODULE);
+        }
+        uLegacyUs = os_timeStampUs(TrafficMonitor->hOs) - uStartUs;
+
+        uStartUs = os_timeStampUs(TrafficMonitor->hOs);
+        for (i = 0; i < TRAFF_BENCHMARK_EVALS; i++)
+        {
+            TrafficMonitor_Evaluate(TrafficMonitor);
+        }
+        uEvalUs = os_timeStampUs(TrafficMonitor->hOs) - uStartUs;
+
+        WLAN_OS_REPORT(("%6d | %17d | %16d | %13d\n", 
+                        uAlerts,
+                        (uEventUs * 1000) / TRAFF_BENCHMARK_EVENTS,
+                        (uLegacyUs * 1000) / TRAFF_BENCHMARK_EVENTS,
+                        (uEvalUs * 1000) / TRAFF_BENCHMARK_EVALS));
+    }
+
+    List_Destroy(TrafficMonitor->NotificationRegList);
+    TrafficMonitor_ExitFunc(TrafficMonitor, TrafficMonitor->hOs);
+}
+
+
 #endif
 
 #ifdef TRAFF_TEST
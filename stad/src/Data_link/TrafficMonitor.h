@@ -65,6 +65,19 @@
 
 #define SIZE_OF_WINDOW_MS	   ( BW_WINDOW_MS / NUM_OF_SLIDING_WINDOWS) /* 125 Ms */
 
+/* Number of event mask bits counted by the aggregated counters (see DataCtrl_Api.h) */
+#define TRAFF_NUM_EVENT_BITS   8
+
+/* The counted Tx/Rx event bits - the bytes and frames of directed, multicast and broadcast frames */
+#define TRAFF_COUNTED_EVENTS   (DIRECTED_BYTES_RECV | DIRECTED_FRAMES_RECV | MULTICAST_BYTES_RECV | \
+                                MULTICAST_FRAMES_RECV | BROADCAST_BYTES_RECV | BROADCAST_FRAMES_RECV)
+
+/* The counted bytes event bits - counted by the event count, the frames bits are counted by 1 */
+#define TRAFF_BYTES_EVENTS     (DIRECTED_BYTES_RECV | MULTICAST_BYTES_RECV | BROADCAST_BYTES_RECV)
+
+/* Bit index of DIRECTED_FRAMES_RECV / DIRECTED_FRAMES_XFER, counted for the BW calculation */
+#define TRAFF_DIRECTED_FRAMES_BIT   2
+
 /* BandWidth_t 
 	This struct is used for the sliding windows algorithm used to calculate the band width */
 typedef struct
@@ -75,6 +88,16 @@ typedef struct
 }BandWidth_t;
 
 
+/* This enum holds the event providers that are optional in the system */
+typedef enum
+{
+        TX_TRAFF_MODULE                                 = 0,
+        RX_TRAFF_MODULE                         = 1,
+    MAX_NUM_MONITORED_MODULES  /* Don't move this enum this index defines the 
+                                  number of module that can be monitored.*/                   
+}MonModuleTypes_t;
+
+
 /* The traffic manger class structure */
 typedef struct
 {
@@ -98,20 +121,25 @@ typedef struct
 
     TI_HANDLE           hTrafficMonTimer;
 
-}TrafficMonitor_t;
-
+    /* Aggregated counters - cumulative count per module and event bit, updated per Tx/Rx event */
+    TI_UINT32           aEventCount[MAX_NUM_MONITORED_MODULES][TRAFF_NUM_EVENT_BITS];
+    TI_UINT32           aBwCountedFrames[MAX_NUM_MONITORED_MODULES];  /* Directed frames already added to the BW windows */
+
+    /* Alerts evaluation - once per tick while there is traffic, or after a burst of events */
+    TI_HANDLE           hEvalTimer;
+    TI_BOOL             bEvalTimerRunning;
+    TI_UINT32           uEvalTickMs;
+    TI_UINT32           uEvalBurst;         /* Events that trigger an evaluation (0 = tick only) */
+    TI_UINT32           uEventsSinceEval;
+
+#ifdef TI_DBG
+    TI_UINT32           uEvents;            /* Tx/Rx events received */
+    TI_UINT32           uTickEvals;         /* Evaluations on tick */
+    TI_UINT32           uBurstEvals;        /* Evaluations on burst */
+    TI_UINT32           uTimerEvals;        /* Evaluations on the down traffic timer */
+#endif
 
-/* Function definition that used for event Aggregation/filtering/etc.. */
-typedef void (*TraffActionFunc_t)(TI_HANDLE TraffElem,int Count); 
-                
-/* This enum holds the event providers that are optional in the system */
-typedef enum
-{
-        TX_TRAFF_MODULE                                 = 0,
-        RX_TRAFF_MODULE                         = 1,
-    MAX_NUM_MONITORED_MODULES  /* Don't move this enum this index defines the 
-                                  number of module that can be monitored.*/                   
-}MonModuleTypes_t;
+}TrafficMonitor_t;
 
 
 
@@ -133,20 +161,20 @@ typedef struct AlertElement_t
 {
     /*initial param*/
     TraffAlertState_t   CurrentState; 
-    int                             EventCounter;
+    int                             EventCounter;   /* Events in the current window, as of the last evaluation */
+    TI_UINT32                       uBaseCount;     /* The aggregated count at the current window start */
+    TI_UINT32                       uLastEvalCount; /* The aggregated count at the last evaluation */
     int                             Threshold;
     TI_UINT32                              TimeOut;  
     TraffDirection_t    Direction;
     TraffTrigger_t      Trigger;
     TI_BOOL                Enabled;
-    int                             LastCounte;
         TraffEevntCall_t        CallBack;
     TI_HANDLE           Context ;
     TI_UINT32              Cookie;    
     TI_UINT32              TimeIntervalMs;               
     TI_BOOL                AutoCreated;
     TI_BOOL                RstWasAssigned;
-    TraffActionFunc_t   ActionFunc;
     TI_UINT32              MonitorMask[MAX_NUM_MONITORED_MODULES];
     struct AlertElement_t  *ResetElment[MAX_RST_ELMENT_PER_ALERT];     
 }TrafficAlertElement_t;
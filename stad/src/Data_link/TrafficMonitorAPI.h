@@ -103,6 +103,7 @@ TI_STATUS TrafficMonitor_Destroy(TI_HANDLE hTrafficMonitor);
 TI_HANDLE TrafficMonitor_RegEvent(TI_HANDLE hTrafficMonitor, TrafficAlertRegParm_t *TrafficAlertRegParm, TI_BOOL AutoResetCreate);
 TI_STATUS TrafficMonitor_SetRstCondition(TI_HANDLE hTrafficMonitor,TI_HANDLE EventHandle,TI_HANDLE ResetEventHandle,TI_BOOL MutualRst);
 int TrafficMonitor_GetFrameBandwidth(TI_HANDLE hTrafficMonitor);
+void TrafficMonitor_PublishStats(TI_HANDLE hTrafficMonitor, TStatsPageTraffic *pTraffic);
 void TrafficMonitor_UnregEvent(TI_HANDLE hTrafficMonitor, TI_HANDLE EventHandle);
 void TrafficMonitor_Event(TI_HANDLE hTrafficMonitor,int Count,TI_UINT16 Mask,TI_UINT32 MonitorModuleType);
 void TrafficMonitor_StopEventNotif(TI_HANDLE hTrafficMonitor,TI_HANDLE EventHandle);
@@ -111,6 +112,11 @@ void TrafficMonitor_ResetEvent(TI_HANDLE hTrafficMonitor, TI_HANDLE EventHandle)
 TI_STATUS TrafficMonitor_Stop(TI_HANDLE hTrafficMonitor);       
 TI_STATUS TrafficMonitor_Start(TI_HANDLE hTrafficMonitor);      
 TI_BOOL TrafficMonitor_IsEventOn(TI_HANDLE EventHandle);
+void TrafficMonitor_SetDefaults (TI_HANDLE hTrafficMonitor, TTrafficMonitorInitParams *pInitParams);
+#ifdef TI_DBG
+void TrafficMonitor_PrintStats (TI_HANDLE hTrafficMonitor);
+void TrafficMonitor_Benchmark (TI_HANDLE hTrafficMonitor);
+#endif
 
 
 
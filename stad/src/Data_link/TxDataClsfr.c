@@ -48,6 +48,184 @@
 #include "txDataQueue.h"
 
 
+/* IPv6 header fields used for classification */
+#define IPV6_HEADER_LEN             40
+#define IPV6_NEXT_HEADER_OFFSET     6
+#define IPV6_EXT_HOP_BY_HOP         0
+#define IPV6_EXT_ROUTING            43
+#define IPV6_EXT_DEST_OPTIONS       60
+#define IP_PROTOCOL_TCP             6
+#define IP_PROTOCOL_UDP             17
+
+/* Golden ratio multiplier for the port / IP-port hash */
+#define CLSFR_HASH_MULTIPLIER       0x9E3779B1
+
+
+/** 
+ * \fn     txDataClsfr_Hash 
+ * \brief  Hash a destination IP address and port number
+ * 
+ * Multiplicative hash into CLSFR_HASH_SIZE slots.
+ * For PORT_CLSFR the IP address is passed as 0.
+ *
+ * \note   A local inline function!
+ * \param  uIpAddr - Destination IP address as read from the IP header (0 for port only)
+ * \param  uPort   - Destination port number (host order)
+ * \return The hash slot
+ * \sa     txDataClsfr_Compile, txDataClsfr_Lookup
+ */ 
+static inline TI_UINT32 txDataClsfr_Hash (TI_UINT32 uIpAddr, TI_UINT16 uPort)
+{
+    return ((uIpAddr ^ ((TI_UINT32)uPort << 16) ^ uPort) * CLSFR_HASH_MULTIPLIER) >> (32 - CLSFR_HASH_BITS);
+}
+
+
+/** 
+ * \fn     txDataClsfr_Lookup 
+ * \brief  Find a port or IP-port entry in the compiled hash
+ * 
+ * Probe the open addressing hash from the key's slot until the key or an empty slot is found.
+ *
+ * \note   A local inline function!
+ * \param  pCompiled - The compiled classifier copy
+ * \param  uIpAddr   - Destination IP address (0 for PORT_CLSFR)
+ * \param  uPort     - Destination port number (host order)
+ * \return Pointer to the matching entry, or NULL if not found
+ * \sa     txDataClsfr_Compile
+ */ 
+static inline TClsfrTableEntry *txDataClsfr_Lookup (TClsfrCompiled *pCompiled, TI_UINT32 uIpAddr, TI_UINT16 uPort)
+{
+    TClsfrTableEntry *pEntry;
+    TI_UINT32         uSlot = txDataClsfr_Hash (uIpAddr, uPort);
+    TI_UINT32         uProbes;
+
+    for (uProbes = 0; uProbes < CLSFR_HASH_SIZE; uProbes++)
+    {
+        if (pCompiled->aHash[uSlot] == 0)
+        {
+            return NULL;
+        }
+
+        pEntry = &pCompiled->aEntries[pCompiled->aHash[uSlot] - 1];
+
+        if (pCompiled->eClsfrType == IPPORT_CLSFR)
+        {
+            if ((pEntry->Dscp.DstIPPort.DstIPAddress == uIpAddr) && (pEntry->Dscp.DstIPPort.DstPortNum == uPort))
+            {
+                return pEntry;
+            }
+        }
+        else if (pEntry->Dscp.DstPortNum == uPort)
+        {
+            return pEntry;
+        }
+
+        uSlot = (uSlot + 1) & CLSFR_HASH_MASK;
+    }
+
+    return NULL;
+}
+
+
+/** 
+ * \fn     txDataClsfr_Compile 
+ * \brief  Rebuild the classifier lookup structures
+ * 
+ * Compile the classifier table into direct lookup structures, so a packet is classified
+ *   in constant time regardless of the number of entries:
+ *   - DSCP_CLSFR:   a 64 entries DSCP to D-tag array.
+ *   - PORT_CLSFR:   a hash on the destination port.
+ *   - IPPORT_CLSFR: a hash on the destination IP address and port.
+ * The structures are built in the inactive copy and then switched, so a classification running
+ *   without the Tx critical section (lock-free Tx queues) normally sees a complete copy.
+ * The inactive copy may still be used by a classification that started before the previous switch,
+ *   so uClsfrSeq is odd while it is rebuilt, and a classification that sees it change is retried.
+ *
+ * \note   Called whenever the classifier table or type is changed, within critical section 
+ *          (non preemptible) except on configuration. 
+ * \param  pTxDataQ - The object
+ * \return void
+ * \sa     txDataClsfr_ClassifyTxPacket
+ */ 
+static void txDataClsfr_Compile (TTxDataQ *pTxDataQ)
+{
+    TClsfrParams     *pClsfrParams = &pTxDataQ->tClsfrParams;
+    TClsfrCompiled   *pCompiled;
+    TClsfrTableEntry *pEntry;
+    TI_UINT32         uSlot;
+    TI_UINT32         i;
+
+    /* Start of rebuild - make uClsfrSeq odd before the copy is modified */
+    pTxDataQ->uClsfrSeq++;
+    os_memoryBarrierRelease (pTxDataQ->hOs);
+
+    /* Build in the copy that is not currently used for classification */
+    if (pTxDataQ->pClsfrActive == &pTxDataQ->aClsfrCompiled[0])
+    {
+        pCompiled = &pTxDataQ->aClsfrCompiled[1];
+    }
+    else 
+    {
+        pCompiled = &pTxDataQ->aClsfrCompiled[0];
+    }
+
+    pCompiled->eClsfrType = pClsfrParams->eClsfrType;
+    os_memorySet (pTxDataQ->hOs, pCompiled->aDscpToDtag, CLSFR_NO_MATCH, sizeof(pCompiled->aDscpToDtag));
+    os_memoryZero (pTxDataQ->hOs, pCompiled->aHash, sizeof(pCompiled->aHash));
+
+    switch (pClsfrParams->eClsfrType)
+    {
+        case DSCP_CLSFR:
+            /* The first entry wins, as in the table search order (entries are unique anyway) */
+            for (i = 0; i < pClsfrParams->uNumActiveEntries; i++)
+            {
+                pEntry = &pClsfrParams->ClsfrTable[i];
+                if ((pEntry->Dscp.CodePoint < CLSFR_DSCP_MAP_SIZE) && 
+                    (pCompiled->aDscpToDtag[pEntry->Dscp.CodePoint] == CLSFR_NO_MATCH))
+                {
+                    pCompiled->aDscpToDtag[pEntry->Dscp.CodePoint] = pEntry->DTag;
+                }
+            }
+        break;
+
+        case PORT_CLSFR:
+        case IPPORT_CLSFR:
+            for (i = 0; i < pClsfrParams->uNumActiveEntries; i++)
+            {
+                pEntry = &pCompiled->aEntries[i];
+                *pEntry = pClsfrParams->ClsfrTable[i];
+
+                if (pClsfrParams->eClsfrType == IPPORT_CLSFR)
+                {
+                    uSlot = txDataClsfr_Hash (pEntry->Dscp.DstIPPort.DstIPAddress, pEntry->Dscp.DstIPPort.DstPortNum);
+                }
+                else 
+                {
+                    uSlot = txDataClsfr_Hash (0, pEntry->Dscp.DstPortNum);
+                }
+
+                /* Linear probing - the hash is at least twice the table size so a free slot always exists */
+                while (pCompiled->aHash[uSlot] != 0)
+                {
+                    uSlot = (uSlot + 1) & CLSFR_HASH_MASK;
+                }
+                pCompiled->aHash[uSlot] = (TI_UINT8)(i + 1);
+            }
+        break;
+
+        default:
+        break;
+    }
+
+    /* Publish the new copy only after it is complete */
+    os_memoryBarrierRelease (pTxDataQ->hOs);
+    pTxDataQ->pClsfrActive = pCompiled;
+
+    /* End of rebuild - make uClsfrSeq even after the copy is published */
+    os_memoryBarrierRelease (pTxDataQ->hOs);
+    pTxDataQ->uClsfrSeq++;
+}
+
 
 /** 
  * \fn     txDataClsfr_Config 
@@ -165,6 +343,9 @@ TI_STATUS txDataClsfr_Config (TI_HANDLE hTxDataQ, TClsfrParams *pClsfrInitParams
 			pParams->uNumActiveEntries = 0;
         break;  
     }
+
+    /* Build the lookup structures used for classification */
+    txDataClsfr_Compile (pTxDataQ);
     
     return TI_OK;
 }
@@ -174,36 +355,81 @@ TI_STATUS txDataClsfr_Config (TI_HANDLE hTxDataQ, TClsfrParams *pClsfrInitParams
  * \fn     getIpAndUdpHeader 
  * \brief  Get IP & UDP headers addresses if exist
  * 
- * This function gets the addresses of the IP and UDP headers
+ * This function gets the addresses of the IP and UDP headers of an IPv4 or IPv6 packet.
+ * For IPv6, the hop-by-hop, routing and destination options extension headers are skipped
+ *   and the UDP header is NULL if the transport header is not TCP/UDP or not reachable.
  *
  * \note   A local inline function!
  * \param  pTxDataQ    - The object handle                                         
  * \param  pPktCtrlBlk - Pointer to the packet
  * \param  pIpHeader   - Pointer to pointer to IP header
  * \param  pUdpHeader  - Pointer to pointer to UDP header 
+ * \param  pIpv6       - Set to TI_TRUE if it's an IPv6 packet
  * \return TI_OK on success, TI_NOK if it's not an IP packet
  * \sa     
  */ 
 static inline TI_STATUS getIpAndUdpHeader(TTxDataQ   *pTxDataQ, 
                                           TTxCtrlBlk *pPktCtrlBlk,
                                           TI_UINT8  **pIpHeader, 
-                                          TI_UINT8  **pUdpHeader)
+                                          TI_UINT8  **pUdpHeader,
+                                          TI_BOOL    *pIpv6)
 {
     TI_UINT8 *pEthHead = pPktCtrlBlk->tTxnStruct.aBuf[0];
-	TI_UINT8  ipHeaderLen = 0;
+    TI_UINT16 uEtherType = HTOWLANS(((TEthernetHeader *)pEthHead)->type);
+    TI_UINT32 uIpBufLen = pPktCtrlBlk->tTxnStruct.aLen[1];
+	TI_UINT32 ipHeaderLen = 0;
+    TI_UINT8  uNextHeader;
   
-	/* check if frame is IP according to ether type */
-    if( ( HTOWLANS(((TEthernetHeader *)pEthHead)->type) ) != ETHERTYPE_IP)
+    /* set the pointer to the beginning of the IP header */
+    *pIpHeader  = pPktCtrlBlk->tTxnStruct.aBuf[1];
+
+	/* check if frame is IP according to ether type and calculate the IP header size */
+    if (uEtherType == ETHERTYPE_IP)
+    {
+        *pIpv6 = TI_FALSE;
+        ipHeaderLen = ((*(unsigned char*)(*pIpHeader) & 0x0f) * 4);
+    }
+    else if (uEtherType == ETHERTYPE_IPV6)
+    {
+        *pIpv6 = TI_TRUE;
+        *pUdpHeader = NULL;
+
+        if (uIpBufLen < IPV6_HEADER_LEN)
+        {
+            return TI_NOK;
+        }
+
+        /* Skip the extension headers that may precede the transport header */
+        ipHeaderLen = IPV6_HEADER_LEN;
+        uNextHeader = (*pIpHeader)[IPV6_NEXT_HEADER_OFFSET];
+        while ((uNextHeader == IPV6_EXT_HOP_BY_HOP) || 
+               (uNextHeader == IPV6_EXT_ROUTING)    || 
+               (uNextHeader == IPV6_EXT_DEST_OPTIONS))
+        {
+            if (ipHeaderLen + 2 > uIpBufLen)
+            {
+                return TI_OK;   /* Extension header not in this buffer, so classify by the IP header only */
+            }
+            uNextHeader  = (*pIpHeader)[ipHeaderLen];
+            ipHeaderLen += ((*pIpHeader)[ipHeaderLen + 1] + 1) * 8;
+        }
+
+        if ((uNextHeader != IP_PROTOCOL_UDP) && (uNextHeader != IP_PROTOCOL_TCP))
+        {
+            return TI_OK;
+        }
+        if ((ipHeaderLen != uIpBufLen) && (ipHeaderLen + 4 > uIpBufLen))
+        {
+            return TI_OK;
+        }
+    }
+    else 
     {
         return TI_NOK;
     }
 
-    /* set the pointer to the beginning of the IP header and calculate it's size */
-    *pIpHeader  = pPktCtrlBlk->tTxnStruct.aBuf[1];
-    ipHeaderLen = ((*(unsigned char*)(*pIpHeader) & 0x0f) * 4);
-
     /* Set the pointer to the beggining of the TCP/UDP header */
-    if (ipHeaderLen == pPktCtrlBlk->tTxnStruct.aLen[1])
+    if (ipHeaderLen == uIpBufLen)
     {
         *pUdpHeader = pPktCtrlBlk->tTxnStruct.aBuf[2];  
     }
@@ -217,38 +443,32 @@ static inline TI_STATUS getIpAndUdpHeader(TTxDataQ   *pTxDataQ,
 
 
 /** 
- * \fn     txDataClsfr_ClassifyTxPacket 
- * \brief  Configure the classifier paramters
+ * \fn     txDataClsfr_Classify 
+ * \brief  Classify a Tx packet using a compiled classifier copy
  * 
- * This function classifies the given Tx packet according to the classifier parameters. 
- * It sets the TID field with the classification result.
- * The classification is according to one of the following methods:
- * - D-Tag  - Transparent (TID = Dtag)
- * - DSCP   - According to the DSCP field in the IP header - the default method!
- * - Dest UDP-Port   
- * - Dest IP-Addr & UDP-Port
+ * See txDataClsfr_ClassifyTxPacket.
  *
  * \note   
- * \param  hTxDataQ    - The object handle                                         
+ * \param  pTxDataQ    - The object                                         
+ * \param  pCompiled   - The compiled classifier copy
  * \param  pPktCtrlBlk - Pointer to the classified packet
  * \param  uPacketDtag - The packet priority optionaly set by the OAL
  * \return TI_OK on success, PARAM_VALUE_NOT_VALID in case of input parameters problems.
- * \sa     
+ * \sa     txDataClsfr_ClassifyTxPacket
  */ 
-TI_STATUS txDataClsfr_ClassifyTxPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 uPacketDtag)
+static TI_STATUS txDataClsfr_Classify (TTxDataQ *pTxDataQ, TClsfrCompiled *pCompiled, TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 uPacketDtag)
 {
-    TTxDataQ     *pTxDataQ = (TTxDataQ *)hTxDataQ;
-    TClsfrParams *pClsfrParams = &pTxDataQ->tClsfrParams;
+    TClsfrTableEntry *pEntry;
     TI_UINT8     *pUdpHeader = NULL;
     TI_UINT8     *pIpHeader = NULL;
+    TI_BOOL    bIpv6 = TI_FALSE;
     TI_UINT8   uDscp;
     TI_UINT16  uDstUdpPort;
     TI_UINT32  uDstIpAdd;
-    TI_UINT32  i;
 
     pPktCtrlBlk->tTxDescriptor.tid = 0;
 
-    switch(pClsfrParams->eClsfrType)
+    switch(pCompiled->eClsfrType)
     {
             /* Trivial mapping D-tag to D-tag */
         case D_TAG_CLSFR:
@@ -260,29 +480,32 @@ TI_STATUS txDataClsfr_ClassifyTxPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrl
         break;
 
         case DSCP_CLSFR:
-            if( (getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader) != TI_OK) 
+            if( (getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader, &bIpv6) != TI_OK) 
                 || (pIpHeader == NULL) )
             {
 				return PARAM_VALUE_NOT_VALID; 
             }
 
-            /* DSCP to D-tag mapping */
-            uDscp =  *((TI_UINT8 *)(pIpHeader + 1)); /* Fetching the DSCP from the header */
+            /* Fetching the DSCP from the IPv4 TOS or the IPv6 traffic class */
+            if (bIpv6)
+            {
+                uDscp = (TI_UINT8)(((pIpHeader[0] & 0x0F) << 4) | (pIpHeader[1] >> 4));
+            }
+            else 
+            {
+                uDscp = pIpHeader[1];
+            }
             uDscp = (uDscp >> 2);
             
-            /* looking for the specific DSCP, if found, its corresponding D-tag is set to the TID */
-            for(i = 0; i < pClsfrParams->uNumActiveEntries; i++)
+            /* DSCP to D-tag mapping - if the DSCP has an entry, its D-tag is set to the TID */
+            if (pCompiled->aDscpToDtag[uDscp] != CLSFR_NO_MATCH)
             {
-                if (pClsfrParams->ClsfrTable[i].Dscp.CodePoint == uDscp)
-				{
-                    pPktCtrlBlk->tTxDescriptor.tid = pClsfrParams->ClsfrTable[i].DTag;
-					break;
-				}
+                pPktCtrlBlk->tTxDescriptor.tid = pCompiled->aDscpToDtag[uDscp];
             }
         break;
 
         case PORT_CLSFR:
-            if( (getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader) != TI_OK) ||
+            if( (getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader, &bIpv6) != TI_OK) ||
                 (pUdpHeader == NULL) )
             {
                 return PARAM_VALUE_NOT_VALID; 
@@ -292,23 +515,26 @@ TI_STATUS txDataClsfr_ClassifyTxPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrl
             uDstUdpPort = HTOWLANS(uDstUdpPort);
             
             /* Looking for the specific port number. If found, its corresponding D-tag is set to the TID. */
-            for(i = 0; i < pClsfrParams->uNumActiveEntries; i++)
+            pEntry = txDataClsfr_Lookup (pCompiled, 0, uDstUdpPort);
+            if (pEntry != NULL)
             {
-                if (pClsfrParams->ClsfrTable[i].Dscp.DstPortNum == uDstUdpPort)
-				{
-                    pPktCtrlBlk->tTxDescriptor.tid = pClsfrParams->ClsfrTable[i].DTag;
-					break;
-				}
+                pPktCtrlBlk->tTxDescriptor.tid = pEntry->DTag;
             }
         break;
 
         case IPPORT_CLSFR: 
-            if ( (getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader) != TI_OK) 
+            if ( (getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader, &bIpv6) != TI_OK) 
                  || (pIpHeader == NULL) || (pUdpHeader == NULL) )
             {
                 return PARAM_VALUE_NOT_VALID; 
             }
 
+            /* The table holds IPv4 addresses only, so an IPv6 packet never matches */
+            if (bIpv6)
+            {
+                break;
+            }
+
             uDstUdpPort = *((TI_UINT16 *)(pUdpHeader + 2));
             uDstUdpPort = HTOWLANS(uDstUdpPort);
             uDstIpAdd = *((TI_UINT32 *)(pIpHeader + 16));
@@ -317,14 +543,10 @@ TI_STATUS txDataClsfr_ClassifyTxPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrl
              * Looking for the specific pair of dst IP address and dst port number.
              * If found, its corresponding D-tag is set to the TID.                                                         
              */
-            for(i = 0; i < pClsfrParams->uNumActiveEntries; i++)
+            pEntry = txDataClsfr_Lookup (pCompiled, uDstIpAdd, uDstUdpPort);
+            if (pEntry != NULL)
             {
-                if ((pClsfrParams->ClsfrTable[i].Dscp.DstIPPort.DstIPAddress == uDstIpAdd) &&
-                    (pClsfrParams->ClsfrTable[i].Dscp.DstIPPort.DstPortNum == uDstUdpPort))
-				{
-                    pPktCtrlBlk->tTxDescriptor.tid = pClsfrParams->ClsfrTable[i].DTag;
-					break;
-				}
+                pPktCtrlBlk->tTxDescriptor.tid = pEntry->DTag;
             }
         break;
         
@@ -335,6 +557,50 @@ TI_STATUS txDataClsfr_ClassifyTxPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrl
 }
 
 
+/** 
+ * \fn     txDataClsfr_ClassifyTxPacket 
+ * \brief  Configure the classifier paramters
+ * 
+ * This function classifies the given Tx packet according to the classifier parameters. 
+ * It sets the TID field with the classification result.
+ * The classification is according to one of the following methods:
+ * - D-Tag  - Transparent (TID = Dtag)
+ * - DSCP   - According to the DSCP field in the IP header - the default method!
+ * - Dest UDP-Port   
+ * - Dest IP-Addr & UDP-Port
+ * The classification is retried if the compiled copies were rebuilt meanwhile (see txDataClsfr_Compile).
+ *
+ * \note   
+ * \param  hTxDataQ    - The object handle                                         
+ * \param  pPktCtrlBlk - Pointer to the classified packet
+ * \param  uPacketDtag - The packet priority optionaly set by the OAL
+ * \return TI_OK on success, PARAM_VALUE_NOT_VALID in case of input parameters problems.
+ * \sa     
+ */ 
+TI_STATUS txDataClsfr_ClassifyTxPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 uPacketDtag)
+{
+    TTxDataQ   *pTxDataQ = (TTxDataQ *)hTxDataQ;
+    TI_UINT32   uSeq;
+    TI_STATUS   eStatus;
+
+    do
+    {
+        uSeq = pTxDataQ->uClsfrSeq;
+
+        /* Read the compiled copy only after its publication (see txDataClsfr_Compile) */
+        os_memoryBarrierAcquire (pTxDataQ->hOs);
+
+        eStatus = txDataClsfr_Classify (pTxDataQ, pTxDataQ->pClsfrActive, pPktCtrlBlk, uPacketDtag);
+
+        /* Make sure the copy wasn't being rebuilt while it was read */
+        os_memoryBarrierAcquire (pTxDataQ->hOs);
+
+    } while ((uSeq & 1) || (uSeq != pTxDataQ->uClsfrSeq));
+
+    return eStatus;
+}
+
+
 /** 
  * \fn     txDataClsfr_InsertClsfrEntry 
  * \brief  Insert a new entry to classifier table
@@ -467,8 +733,11 @@ TI_STATUS txDataClsfr_InsertClsfrEntry(TI_HANDLE hTxDataQ, TClsfrTableEntry *pNe
             
     } 
     
-    /* Increment the number of classifier active entries */
+    /* Increment the number of classifier active entries and rebuild the lookup structures */
+    context_EnterCriticalSection (pTxDataQ->hContext);
     pClsfrParams->uNumActiveEntries++;
+    txDataClsfr_Compile (pTxDataQ);
+    context_LeaveCriticalSection (pTxDataQ->hContext);
 
     return TI_OK;
 }
@@ -605,8 +874,11 @@ TI_STATUS txDataClsfr_RemoveClsfrEntry(TI_HANDLE hTxDataQ, TClsfrTableEntry *pRe
         default:{}
     } 
     
-    /* Decrement the number of classifier active entries */
+    /* Decrement the number of classifier active entries and rebuild the lookup structures */
+    context_EnterCriticalSection (pTxDataQ->hContext);
     pClsfrParams->uNumActiveEntries--;
+    txDataClsfr_Compile (pTxDataQ);
+    context_LeaveCriticalSection (pTxDataQ->hContext);
 
     return TI_OK;
 }
@@ -643,6 +915,7 @@ TI_STATUS txDataClsfr_SetClsfrType (TI_HANDLE hTxDataQ, EClsfrType eNewClsfrType
     context_EnterCriticalSection (pTxDataQ->hContext);
     pTxDataQ->tClsfrParams.eClsfrType = eNewClsfrType;
 	pTxDataQ->tClsfrParams.uNumActiveEntries = 0;
+    txDataClsfr_Compile (pTxDataQ);
     context_LeaveCriticalSection (pTxDataQ->hContext);
 
     return TI_OK;
@@ -660,11 +933,15 @@ TI_STATUS txDataClsfr_GetClsfrType (TI_HANDLE hTxDataQ, EClsfrType *pClsfrType)
 
 #ifdef TI_DBG
 
+#define CLSFR_BENCH_ITERATIONS      100000
+#define CLSFR_BENCH_PORT_BASE       5000
+#define CLSFR_BENCH_IP_BASE         0x0A000001
+
 /** 
  * \fn     txDataClsfr_PrintClsfrTable 
  * \brief  Print classifier table
  * 
- * Print the classifier table for debug
+ * Print the classifier table and its compiled lookup structures for debug
  *
  * \note   
  * \param  hTxDataQ  - The object handle                                         
@@ -673,42 +950,269 @@ TI_STATUS txDataClsfr_GetClsfrType (TI_HANDLE hTxDataQ, EClsfrType *pClsfrType)
  */ 
 void txDataClsfr_PrintClsfrTable (TI_HANDLE hTxDataQ)
 {
-    TTxDataQ      *pTxDataQ     = (TTxDataQ *)hTxDataQ;
-    TClsfrParams  *pClsfrParams = &pTxDataQ->tClsfrParams;
-	TI_UINT32      uIpAddr, i;
+    TTxDataQ       *pTxDataQ     = (TTxDataQ *)hTxDataQ;
+    TClsfrParams   *pClsfrParams = &pTxDataQ->tClsfrParams;
+    TClsfrCompiled *pCompiled    = pTxDataQ->pClsfrActive;
+	TI_UINT32       uIpAddr, i;
+    TI_UINT32       uUsedSlots = 0;
+
+    WLAN_OS_REPORT(("Classifier type = %d, Number of entries = %d\n", pClsfrParams->eClsfrType, pClsfrParams->uNumActiveEntries));
 
 	if (pClsfrParams->eClsfrType == D_TAG_CLSFR)
 	{
 		return;
 	}
 
-
 	switch (pClsfrParams->eClsfrType)
 	{
 		case DSCP_CLSFR:
-
-			break;
+			WLAN_OS_REPORT(("  DSCP  D-Tag\n"));
+			for (i = 0; i < pClsfrParams->uNumActiveEntries; i++)  
+            {
+				WLAN_OS_REPORT(("  %4d  %5d\n", pClsfrParams->ClsfrTable[i].Dscp.CodePoint, pClsfrParams->ClsfrTable[i].DTag));
+			}
+			WLAN_OS_REPORT(("Compiled DSCP map (DSCP:D-Tag):"));
+			for (i = 0; i < CLSFR_DSCP_MAP_SIZE; i++)  
+            {
+				if (pCompiled->aDscpToDtag[i] != CLSFR_NO_MATCH)
+				{
+					WLAN_OS_REPORT((" %d:%d", i, pCompiled->aDscpToDtag[i]));
+				}
+			}
+			WLAN_OS_REPORT(("\n"));
+			return;
 
 		case PORT_CLSFR:
-
+			WLAN_OS_REPORT(("  Port   D-Tag\n"));
+			for (i = 0; i < pClsfrParams->uNumActiveEntries; i++)  
+            {
+				WLAN_OS_REPORT(("  %5d  %5d\n", pClsfrParams->ClsfrTable[i].Dscp.DstPortNum, pClsfrParams->ClsfrTable[i].DTag));
+			}
 			break;
 
 		case IPPORT_CLSFR:
-
-
+			WLAN_OS_REPORT(("  IP Address       Port   D-Tag\n"));
 			for (i = 0; i < pClsfrParams->uNumActiveEntries; i++)  
             {
 				uIpAddr = pClsfrParams->ClsfrTable[i].Dscp.DstIPPort.DstIPAddress;
+				WLAN_OS_REPORT(("  %3d.%3d.%3d.%3d  %5d  %5d\n", 
+                                (uIpAddr & 0xFF), ((uIpAddr >> 8) & 0xFF), ((uIpAddr >> 16) & 0xFF), ((uIpAddr >> 24) & 0xFF),
+                                pClsfrParams->ClsfrTable[i].Dscp.DstIPPort.DstPortNum, pClsfrParams->ClsfrTable[i].DTag));
 			}
-
 			break;
 
 		default:
-			break;
+			return;
 	}
+
+    /* Print the hash occupancy (entry index per slot) */
+	WLAN_OS_REPORT(("Compiled hash (slot:entry):"));
+	for (i = 0; i < CLSFR_HASH_SIZE; i++)  
+    {
+		if (pCompiled->aHash[i] != 0)
+		{
+			WLAN_OS_REPORT((" %d:%d", i, pCompiled->aHash[i] - 1));
+            uUsedSlots++;
+		}
+	}
+	WLAN_OS_REPORT(("\nUsed slots = %d of %d\n", uUsedSlots, CLSFR_HASH_SIZE));
 }
 
-#endif  /* TI_DBG */
 
+/** 
+ * \fn     txDataClsfr_ClassifyLinear 
+ * \brief  Reference classification by linear table search
+ * 
+ * Classify a packet by searching the classifier table entries one by one, 
+ *   as done before the lookup structures were compiled. Used only by the benchmark.
+ *
+ * \note   
+ * \param  pTxDataQ    - The object
+ * \param  pPktCtrlBlk - Pointer to the classified packet
+ * \return void
+ * \sa     txDataClsfr_Benchmark
+ */ 
+static void txDataClsfr_ClassifyLinear (TTxDataQ *pTxDataQ, TTxCtrlBlk *pPktCtrlBlk)
+{
+    TClsfrParams *pClsfrParams = &pTxDataQ->tClsfrParams;
+    TI_UINT8     *pUdpHeader = NULL;
+    TI_UINT8     *pIpHeader = NULL;
+    TI_BOOL       bIpv6;
+    TI_UINT8      uDscp;
+    TI_UINT16     uDstUdpPort = 0;
+    TI_UINT32     uDstIpAdd = 0;
+    TI_UINT32     i;
+
+    pPktCtrlBlk->tTxDescriptor.tid = 0;
+
+    if ((getIpAndUdpHeader(pTxDataQ, pPktCtrlBlk, &pIpHeader, &pUdpHeader, &bIpv6) != TI_OK) || (pIpHeader == NULL))
+    {
+        return;
+    }
+
+    if (bIpv6)
+    {
+        uDscp = (TI_UINT8)(((pIpHeader[0] & 0x0F) << 4) | (pIpHeader[1] >> 4)) >> 2;
+    }
+    else 
+    {
+        uDscp = pIpHeader[1] >> 2;
+        uDstIpAdd = *((TI_UINT32 *)(pIpHeader + 16));
+    }
+    if (pUdpHeader != NULL)
+    {
+        uDstUdpPort = HTOWLANS(*((TI_UINT16 *)(pUdpHeader + 2)));
+    }
+
+    for (i = 0; i < pClsfrParams->uNumActiveEntries; i++)
+    {
+        if (((pClsfrParams->eClsfrType == DSCP_CLSFR) && (pClsfrParams->ClsfrTable[i].Dscp.CodePoint == uDscp)) ||
+            ((pClsfrParams->eClsfrType == PORT_CLSFR) && (pUdpHeader != NULL) && 
+             (pClsfrParams->ClsfrTable[i].Dscp.DstPortNum == uDstUdpPort)) ||
+            ((pClsfrParams->eClsfrType == IPPORT_CLSFR) && (pUdpHeader != NULL) && !bIpv6 &&
+             (pClsfrParams->ClsfrTable[i].Dscp.DstIPPort.DstIPAddress == uDstIpAdd) && 
+             (pClsfrParams->ClsfrTable[i].Dscp.DstIPPort.DstPortNum == uDstUdpPort)))
+        {
+            pPktCtrlBlk->tTxDescriptor.tid = pClsfrParams->ClsfrTable[i].DTag;
+            break;
+        }
+    }
+}
 
 
+/** 
+ * \fn     txDataClsfr_Benchmark 
+ * \brief  Measure the per packet classification cost
+ * 
+ * For each classifier type, fill a full classifier table and classify IPv4 and IPv6 UDP
+ *   packets matching the last table entry (the worst case of a table search), 
+ *   once with the compiled lookup and once with a linear table search.
+ * Runs on a private classifier object, so the active classifier is not affected.
+ *
+ * \note   
+ * \param  hTxDataQ  - The object handle                                         
+ * \return void
+ * \sa     txDataClsfr_PrintClsfrTable
+ */ 
+void txDataClsfr_Benchmark (TI_HANDLE hTxDataQ)
+{
+    TTxDataQ       *pTxDataQ = (TTxDataQ *)hTxDataQ;
+    TTxDataQ       *pBench;
+    TTxCtrlBlk     *pPkt;
+    TEthernetHeader tEthHeader;
+    TI_UINT32       aIpBuf[(IPV6_HEADER_LEN + 8) / 4];
+    TI_UINT8       *pIp = (TI_UINT8 *)aIpBuf;
+    TClsfrTableEntry *pLast;
+    EClsfrType      eType;
+    TI_UINT32       uVersion, i;
+    TI_UINT32       uStartUs, uCompiledUs, uLinearUs;
+    TI_UINT8        uCompiledTid, uLinearTid;
+    TI_UINT16       uPort;
+
+    pBench = os_memoryAlloc (pTxDataQ->hOs, sizeof(TTxDataQ));
+    pPkt   = os_memoryAlloc (pTxDataQ->hOs, sizeof(TTxCtrlBlk));
+    if ((pBench == NULL) || (pPkt == NULL))
+    {
+        WLAN_OS_REPORT(("txDataClsfr_Benchmark: memory allocation failed\n"));
+        if (pBench) 
+            os_memoryFree (pTxDataQ->hOs, pBench, sizeof(TTxDataQ));
+        if (pPkt) 
+            os_memoryFree (pTxDataQ->hOs, pPkt, sizeof(TTxCtrlBlk));
+        return;
+    }
+    os_memoryZero (pTxDataQ->hOs, pBench, sizeof(TTxDataQ));
+    os_memoryZero (pTxDataQ->hOs, pPkt, sizeof(TTxCtrlBlk));
+    pBench->hOs = pTxDataQ->hOs;
+
+    WLAN_OS_REPORT(("Classifier benchmark: %d entries, %d packets per test\n", NUM_OF_CLSFR_TABLE_ENTRIES, CLSFR_BENCH_ITERATIONS));
+    WLAN_OS_REPORT(("Type    IP  Compiled(ns/pkt)  Linear(ns/pkt)  TID\n"));
+
+    for (eType = DSCP_CLSFR; eType <= IPPORT_CLSFR; eType++)
+    {
+        /* Fill a full table with unique keys */
+        pBench->tClsfrParams.eClsfrType = eType;
+        pBench->tClsfrParams.uNumActiveEntries = NUM_OF_CLSFR_TABLE_ENTRIES;
+        for (i = 0; i < NUM_OF_CLSFR_TABLE_ENTRIES; i++)
+        {
+            TClsfrTableEntry *pEntry = &pBench->tClsfrParams.ClsfrTable[i];
+
+            pEntry->DTag = (TI_UINT8)(i % MAX_NUM_OF_802_1d_TAGS);
+            if (eType == DSCP_CLSFR)
+            {
+                pEntry->Dscp.CodePoint = (TI_UINT8)((i * 4) % CLSFR_DSCP_MAP_SIZE);
+            }
+            else if (eType == PORT_CLSFR)
+            {
+                pEntry->Dscp.DstPortNum = (TI_UINT16)(CLSFR_BENCH_PORT_BASE + i * 7);
+            }
+            else 
+            {
+                pEntry->Dscp.DstIPPort.DstIPAddress = CLSFR_BENCH_IP_BASE + i;
+                pEntry->Dscp.DstIPPort.DstPortNum   = (TI_UINT16)(CLSFR_BENCH_PORT_BASE + i * 7);
+            }
+        }
+        pBench->pClsfrActive = NULL;
+        txDataClsfr_Compile (pBench);
+
+        pLast = &pBench->tClsfrParams.ClsfrTable[NUM_OF_CLSFR_TABLE_ENTRIES - 1];
+        uPort = (eType == IPPORT_CLSFR) ? pLast->Dscp.DstIPPort.DstPortNum : pLast->Dscp.DstPortNum;
+
+        for (uVersion = 4; uVersion <= 6; uVersion += 2)
+        {
+            /* Build a UDP packet matching the last entry */
+            os_memoryZero (pTxDataQ->hOs, aIpBuf, sizeof(aIpBuf));
+            os_memoryZero (pTxDataQ->hOs, &tEthHeader, sizeof(tEthHeader));
+            if (uVersion == 4)
+            {
+                tEthHeader.type = HTOWLANS(ETHERTYPE_IP);
+                pIp[0] = 0x45;
+                pIp[1] = (TI_UINT8)(pLast->Dscp.CodePoint << 2);
+                pIp[9] = IP_PROTOCOL_UDP;
+                aIpBuf[4] = pLast->Dscp.DstIPPort.DstIPAddress;
+                pPkt->tTxnStruct.aLen[1] = 20 + 8;
+                *((TI_UINT16 *)(pIp + 20 + 2)) = HTOWLANS(uPort);
+            }
+            else 
+            {
+                tEthHeader.type = HTOWLANS(ETHERTYPE_IPV6);
+                pIp[0] = (TI_UINT8)(0x60 | (pLast->Dscp.CodePoint >> 2));
+                pIp[1] = (TI_UINT8)(pLast->Dscp.CodePoint << 6);
+                pIp[IPV6_NEXT_HEADER_OFFSET] = IP_PROTOCOL_UDP;
+                pPkt->tTxnStruct.aLen[1] = IPV6_HEADER_LEN + 8;
+                *((TI_UINT16 *)(pIp + IPV6_HEADER_LEN + 2)) = HTOWLANS(uPort);
+            }
+            pPkt->tTxnStruct.aBuf[0] = (TI_UINT8 *)&tEthHeader;
+            pPkt->tTxnStruct.aLen[0] = sizeof(tEthHeader);
+            pPkt->tTxnStruct.aBuf[1] = pIp;
+
+            uStartUs = os_timeStampUs (pTxDataQ->hOs);
+            for (i = 0; i < CLSFR_BENCH_ITERATIONS; i++)
+            {
+                txDataClsfr_ClassifyTxPacket ((TI_HANDLE)pBench, pPkt, 0);
+            }
+            uCompiledUs  = os_timeStampUs (pTxDataQ->hOs) - uStartUs;
+            uCompiledTid = pPkt->tTxDescriptor.tid;
+
+            uStartUs = os_timeStampUs (pTxDataQ->hOs);
+            for (i = 0; i < CLSFR_BENCH_ITERATIONS; i++)
+            {
+                txDataClsfr_ClassifyLinear (pBench, pPkt);
+            }
+            uLinearUs  = os_timeStampUs (pTxDataQ->hOs) - uStartUs;
+            uLinearTid = pPkt->tTxDescriptor.tid;
+
+            WLAN_OS_REPORT(("%-6s  v%d  %16d  %14d  %d%s\n", 
+                            (eType == DSCP_CLSFR) ? "DSCP" : ((eType == PORT_CLSFR) ? "Port" : "IPPort"),
+                            uVersion,
+                            (uCompiledUs * 1000) / CLSFR_BENCH_ITERATIONS,
+                            (uLinearUs * 1000) / CLSFR_BENCH_ITERATIONS,
+                            uCompiledTid,
+                            (uCompiledTid == uLinearTid) ? "" : " (MISMATCH!)"));
+        }
+    }
+
+    os_memoryFree (pTxDataQ->hOs, pPkt, sizeof(TTxCtrlBlk));
+    os_memoryFree (pTxDataQ->hOs, pBench, sizeof(TTxDataQ));
+}
+
+#endif  /* TI_DBG */
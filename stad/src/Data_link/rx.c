@@ -96,6 +96,8 @@ static void rxData_discardPacketVlan (TI_HANDLE hRxData, void *pBuffer, TRxAttr*
 static void rxData_rcvPacketInOpenNotify (TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxAttr);
 static void rxData_rcvPacketEapol (TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxAttr);
 static void rxData_rcvPacketData (TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxAttr);
+static TI_BOOL rxData_AcceptDataPacket (rxData_t *pRxData, TEthernetHeader *pEthernetHeader, TI_UINT32 uEthLen, TRxAttr* pRxAttr);
+static void *rxData_CopyAmsduSubframe (rxData_t *pRxData, void *pBuffer, TI_UINT8 *pAddr, TI_UINT8 *pTypeAndPayload, TI_UINT16 uEthLen);
 
 static TI_STATUS rxData_enableDisableRxDataFilters(TI_HANDLE hRxData, TI_BOOL enabled);
 static TI_STATUS rxData_addRxDataFilter(TI_HANDLE hRxData, TRxDataFilterRequest* request);
@@ -1135,36 +1137,32 @@ static void rxData_rcvPacketEapol(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRx
 }
 
 /***************************************************************************
-*                       rxData_rcvPacketData                                 *
+*                       rxData_AcceptDataPacket                              *
 ****************************************************************************
-* DESCRIPTION:  this function is called upon receving data "data" packet type
-*               while rx port status is "open"
+* DESCRIPTION:  this function checks the encryption status of a received 
+*               data packet, and if accepted updates the Rx counters and 
+*               notifies the Rx event registrants
 *
-* INPUTS:       hRxData - the object
-*               pBuffer - the received Buffer.
-*               pRxAttr - Rx attributes
+* INPUTS:       pRxData    - the object
+*               pEthHeader - the packet in ethernet format
+*               uEthLen    - the packet length in ethernet format
+*               pRxAttr    - Rx attributes
 *
 * OUTPUT:
 *
-* RETURNS:
+* RETURNS:      TI_TRUE if the packet should be passed to the OS, TI_FALSE if excluded
 ***************************************************************************/
-static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxAttr)
+static TI_BOOL rxData_AcceptDataPacket (rxData_t *pRxData, TEthernetHeader *pEthernetHeader, TI_UINT32 uEthLen, TRxAttr* pRxAttr)
 {
-    rxData_t *pRxData = (rxData_t *)hRxData;
-    TEthernetHeader *pEthernetHeader;
     TI_UINT16 EventMask = 0;
 
     /* check encryption status */
-    pEthernetHeader = (TEthernetHeader *)RX_ETH_PKT_DATA(pBuffer);
     if (!MAC_MULTICAST (pEthernetHeader->dst))
     {  /* unicast frame */
         if((pRxData->rxDataExcludeUnencrypted) && (!(pRxAttr->packetInfo & RX_DESC_ENCRYPT_MASK)))
         {
             pRxData->rxDataDbgCounters.excludedFrameCounter++;
-            /* free Buffer */
-
-            RxBufFree(pRxData->hOs, pBuffer);
-            return;
+            return TI_FALSE;
         }
     }
     else
@@ -1172,10 +1170,7 @@ static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxA
         if ((pRxData->rxDataExludeBroadcastUnencrypted) && (!(pRxAttr->packetInfo & RX_DESC_ENCRYPT_MASK)))
         {
             pRxData->rxDataDbgCounters.excludedFrameCounter++;
-            /* free Buffer */
-
-            RxBufFree(pRxData->hOs, pBuffer);
-            return;
+            return TI_FALSE;
         }
     }
 
@@ -1187,7 +1182,7 @@ static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxA
     {
         /* Directed frame */
         pRxData->rxDataCounters.DirectedFramesRecv++;
-        pRxData->rxDataCounters.DirectedBytesRecv += RX_ETH_PKT_LEN(pBuffer);
+        pRxData->rxDataCounters.DirectedBytesRecv += uEthLen;
         EventMask |= DIRECTED_BYTES_RECV;
         EventMask |= DIRECTED_FRAMES_RECV;
     }
@@ -1195,7 +1190,7 @@ static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxA
     {
         /* Broadcast frame */
         pRxData->rxDataCounters.BroadcastFramesRecv++;
-        pRxData->rxDataCounters.BroadcastBytesRecv += RX_ETH_PKT_LEN(pBuffer);
+        pRxData->rxDataCounters.BroadcastBytesRecv += uEthLen;
         EventMask |= BROADCAST_BYTES_RECV;
         EventMask |= BROADCAST_FRAMES_RECV;
     }
@@ -1203,18 +1198,46 @@ static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxA
     {
         /* Multicast Address */
         pRxData->rxDataCounters.MulticastFramesRecv++;
-        pRxData->rxDataCounters.MulticastBytesRecv += RX_ETH_PKT_LEN(pBuffer);
+        pRxData->rxDataCounters.MulticastBytesRecv += uEthLen;
         EventMask |= MULTICAST_BYTES_RECV;
         EventMask |= MULTICAST_FRAMES_RECV;
     }
-    pRxData->rxDataCounters.LastSecBytesRecv += RX_ETH_PKT_LEN(pBuffer);
+    pRxData->rxDataCounters.LastSecBytesRecv += uEthLen;
 
     /*Handle PREAUTH_EAPOL_PACKET*/
     if (HTOWLANS(pEthernetHeader->type) == PREAUTH_EAPOL_PACKET)
     {
     }
 
-    rxData_DistributorRxEvent (pRxData, EventMask, RX_ETH_PKT_LEN(pBuffer));
+    rxData_DistributorRxEvent (pRxData, EventMask, uEthLen);
+
+    return TI_TRUE;
+}
+
+/***************************************************************************
+*                       rxData_rcvPacketData                                 *
+****************************************************************************
+* DESCRIPTION:  this function is called upon receving data "data" packet type
+*               while rx port status is "open"
+*
+* INPUTS:       hRxData - the object
+*               pBuffer - the received Buffer.
+*               pRxAttr - Rx attributes
+*
+* OUTPUT:
+*
+* RETURNS:
+***************************************************************************/
+static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxAttr)
+{
+    rxData_t *pRxData = (rxData_t *)hRxData;
+
+    if (!rxData_AcceptDataPacket (pRxData, (TEthernetHeader *)RX_ETH_PKT_DATA(pBuffer), RX_ETH_PKT_LEN(pBuffer), pRxAttr))
+    {
+        /* free Buffer */
+        RxBufFree(pRxData->hOs, pBuffer);
+        return;
+    }
 
     /* deliver packet to os */
     os_receivePacket (pRxData->hOs, (struct RxIfDescriptor_t*)pBuffer, pBuffer, (TI_UINT16)RX_ETH_PKT_LEN(pBuffer));
@@ -1360,6 +1383,59 @@ static TI_STATUS rxData_convertWlanToEthHeader (TI_HANDLE hRxData, void *pBuffer
 }
 
 
+/**
+ * \brief Copy an A-MSDU subframe to a new Rx buffer
+ *
+ * \param pRxData         - the object
+ * \param pBuffer         - the received Buffer in A-MSDU 802.11n format
+ * \param pAddr           - the subframe DA and SA
+ * \param pTypeAndPayload - the subframe Ethernet type (from its SNAP header) followed by its payload
+ * \param uEthLen         - the subframe length in Ethernet format
+ * \return The new Rx buffer with its Ethernet packet data and length set, or NULL if allocation failed
+ *
+ * \par Description
+ * Static function
+ * The A-MSDU Rx descriptor is copied to the new buffer (with updated length).
+ *
+ * \sa rxData_ConvertAmsduToEthPackets
+ */
+static void *rxData_CopyAmsduSubframe (rxData_t *pRxData, void *pBuffer, TI_UINT8 *pAddr, TI_UINT8 *pTypeAndPayload, TI_UINT16 uEthLen)
+{
+    void                *pDataBuf;
+    TI_UINT8            *pEthHeader;
+    TI_UINT32            uBufLen = sizeof(RxIfDescriptor_t) + WLAN_SNAP_HDR_LEN + PADDING_ETH_PACKET_SIZE + uEthLen;
+
+    /* allocate a new buffer */
+    /* RxBufAlloc() add an extra word for alignment the MAC payload */
+    rxData_RequestForBuffer ((TI_HANDLE)pRxData, &pDataBuf, (TI_UINT16)uBufLen, 0, TAG_CLASS_AMSDU);
+    if (NULL == pDataBuf)
+    {
+        return NULL;
+    }
+
+    /* copy the RxIfDescriptor */
+    os_memoryCopy (pRxData->hOs, pDataBuf, pBuffer, sizeof(RxIfDescriptor_t));
+
+    /* update length, in the RxIfDescriptor the Len in words (4B) */
+    ((RxIfDescriptor_t *)pDataBuf)->length = uBufLen >> 2;
+    ((RxIfDescriptor_t *)pDataBuf)->extraBytes = 4 - (uBufLen & 0x3);
+
+    /* Prepare the Ethernet header pointer. */
+    /* add padding in the start of the buffer in order to align ETH payload */
+    pEthHeader = (TI_UINT8 *)(RX_BUF_DATA(pDataBuf)) + WLAN_SNAP_HDR_LEN + PADDING_ETH_PACKET_SIZE;
+
+    /* copy the addresses, and the type and payload after them */
+    os_memoryCopy (pRxData->hOs, pEthHeader, pAddr, 2 * MAC_ADDR_LEN);
+    os_memoryCopy (pRxData->hOs, pEthHeader + 2 * MAC_ADDR_LEN, pTypeAndPayload, uEthLen - 2 * MAC_ADDR_LEN);
+
+    /* save the ETH packet address and size */
+    RX_ETH_PKT_DATA(pDataBuf) = pEthHeader;
+    RX_ETH_PKT_LEN(pDataBuf)  = uEthLen;
+
+    return pDataBuf;
+}
+
+
 /**
  * \brief convert A-MSDU to several ethernet packets
  *
@@ -1373,21 +1449,28 @@ static TI_STATUS rxData_convertWlanToEthHeader (TI_HANDLE hRxData, void *pBuffer
  * This function convert the A-MSDU Packet from A-MSDU 802.11n packet
  * format to several ethernet packets format and pass them to the OS layer
  *
+ * Data subframes received while the port is open are passed to the OS without copy:
+ *   the Ethernet header is rewritten in place over the subframe header and SNAP, and the
+ *   OS delivers a packet sharing the A-MSDU buffer (freed when its last subframe is consumed).
+ * Other subframes, or if the OS failed to share the buffer, are copied to new Rx buffers.
+ *
  * \sa
  */
 static TI_STATUS rxData_ConvertAmsduToEthPackets (TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxAttr)
 {
 
     TEthernetHeader     *pMsduEthHeader;
-    TEthernetHeader     *pEthHeader;
     Wlan_LlcHeader_T    *pWlanSnapHeader;
     TI_UINT8            *pAmsduDataBuf;
+    TI_UINT8            *pEthHeader;
     TI_UINT16            uAmsduDataLen;
     void                *pDataBuf;
     TI_UINT16            uDataLen;
+    TI_UINT16            uEthLen;
     TI_UINT32            lengthDelta;
     TI_UINT16            swapedTypeLength;
     TI_UINT32            headerLength;
+    TI_BOOL              bLastMsdu;
     rxDataPacketType_e   DataPacketType;
     rxData_t            *pRxData = (rxData_t *)hRxData;
 
@@ -1406,56 +1489,24 @@ static TI_STATUS rxData_ConvertAmsduToEthPackets (TI_HANDLE hRxData, void *pBuff
     /* ETH length, in A-MSDU the MSDU header type contain the MSDU length and not the type */
     uDataLen = WLANTOHS(pMsduEthHeader->type);
 
+    pRxData->rxDataDbgCounters.uAmsduFrames++;
+
     /* if we have another packet at the AMSDU */
     while((uDataLen < uAmsduDataLen) && (uAmsduDataLen > ETHERNET_HDR_LEN + FCS_SIZE))
     {
-        /* allocate a new buffer */
-        /* RxBufAlloc() add an extra word for alignment the MAC payload */
-        rxData_RequestForBuffer (hRxData, &pDataBuf, sizeof(RxIfDescriptor_t) + WLAN_SNAP_HDR_LEN + ETHERNET_HDR_LEN + uDataLen, 0, TAG_CLASS_AMSDU);
-        if (NULL == pDataBuf)
-        {
-            rxData_discardPacket (hRxData, pBuffer, pRxAttr);
-            return TI_NOK;
-        }
-
         /* read packet type from LLC */
         pWlanSnapHeader = (Wlan_LlcHeader_T*)((TI_UINT8*)pMsduEthHeader + ETHERNET_HDR_LEN);
         swapedTypeLength = WLANTOHS (pWlanSnapHeader->Type);
 
-        /* copy the RxIfDescriptor */
-        os_memoryCopy (pRxData->hOs, pDataBuf, pBuffer, sizeof(RxIfDescriptor_t));
-
-        /* update length, in the RxIfDescriptor the Len in words (4B) */
-        ((RxIfDescriptor_t *)pDataBuf)->length = (sizeof(RxIfDescriptor_t) + WLAN_SNAP_HDR_LEN + ETHERNET_HDR_LEN + uDataLen) >> 2;
-        ((RxIfDescriptor_t *)pDataBuf)->extraBytes = 4 - ((sizeof(RxIfDescriptor_t) + WLAN_SNAP_HDR_LEN + ETHERNET_HDR_LEN + uDataLen) & 0x3);
-
-        /* Prepare the Ethernet header pointer. */
-        /* add padding in the start of the buffer in order to align ETH payload */
-        pEthHeader = (TEthernetHeader *)((TI_UINT8 *)(RX_BUF_DATA(pDataBuf)) +
-                                         WLAN_SNAP_HDR_LEN +
-                                         PADDING_ETH_PACKET_SIZE);
-
-        /* copy the Ethernet header */
-        os_memoryCopy (pRxData->hOs, pEthHeader, pMsduEthHeader, ETHERNET_HDR_LEN);
-
-        /* The LEN/TYPE bytes are set to TYPE */
-        pEthHeader->type = pWlanSnapHeader->Type;
-
-        /* Delta length for the next packet */
-        lengthDelta = ETHERNET_HDR_LEN + uDataLen;
-
-        /* copy the packet payload */
-        os_memoryCopy (pRxData->hOs,
-                       (((TI_UINT8*)pEthHeader) + ETHERNET_HDR_LEN),
-                       ((TI_UINT8*)pMsduEthHeader) + ETHERNET_HDR_LEN + WLAN_SNAP_HDR_LEN,
-                       uDataLen - WLAN_SNAP_HDR_LEN);
+        /* the subframe length in Ethernet format (the SNAP header is removed) */
+        uEthLen = uDataLen + ETHERNET_HDR_LEN - WLAN_SNAP_HDR_LEN;
 
         /* set the packet type */
         if (swapedTypeLength == ETHERTYPE_802_1D)
         {
             DataPacketType = DATA_VLAN_PACKET;
         }
-        else if (HTOWLANS(pEthHeader->type) == EAPOL_PACKET)
+        else if (swapedTypeLength == EAPOL_PACKET)
         {
             DataPacketType = DATA_EAPOL_PACKET;
         }
@@ -1464,23 +1515,78 @@ static TI_STATUS rxData_ConvertAmsduToEthPackets (TI_HANDLE hRxData, void *pBuff
             DataPacketType = DATA_DATA_PACKET;
         }
 
-        /* update buffer setting */
-        /* save the ETH packet address */
-        RX_ETH_PKT_DATA(pDataBuf) = pEthHeader;
-        /* save the ETH packet size */
-        RX_ETH_PKT_LEN(pDataBuf) = uDataLen + ETHERNET_HDR_LEN - WLAN_SNAP_HDR_LEN;
+        /* Delta length for the next packet */
+        lengthDelta = ETHERNET_HDR_LEN + uDataLen;
 
         /* star of MSDU packet always align acceding to 11n spec */
         lengthDelta = (lengthDelta + ALIGN_4BYTE_MASK) & ~ALIGN_4BYTE_MASK;
-        pMsduEthHeader = (TEthernetHeader *)(((TI_UINT8*)pMsduEthHeader) + lengthDelta);
 
-        if(uAmsduDataLen > lengthDelta)
+        bLastMsdu = (uAmsduDataLen > lengthDelta) ? TI_FALSE : TI_TRUE;
+
+        if (DataPacketType == DATA_DATA_PACKET  &&  
+            pRxData->rxData_dispatchBuffer[pRxData->rxDataPortStatus][DATA_DATA_PACKET] == rxData_rcvPacketData)
         {
-            /* swich to the next MSDU */
-            uAmsduDataLen = uAmsduDataLen - lengthDelta;
+            /* 
+             * Zero-copy: the Ethernet header ends where the SNAP header ends (its type is already there), 
+             *   so move SA and then DA forward over the subframe length and SNAP fields.
+             */
+            pEthHeader = (TI_UINT8 *)pMsduEthHeader + WLAN_SNAP_HDR_LEN;
+            os_memoryCopy (pRxData->hOs, pEthHeader + MAC_ADDR_LEN, pMsduEthHeader->src, MAC_ADDR_LEN);
+            os_memoryCopy (pRxData->hOs, pEthHeader, pMsduEthHeader->dst, MAC_ADDR_LEN);
+
+            if (rxData_AcceptDataPacket (pRxData, (TEthernetHeader *)pEthHeader, uEthLen, pRxAttr))
+            {
+                if (os_receiveSubPacket (pRxData->hOs, pBuffer, pEthHeader, uEthLen))
+                {
+                    pRxData->rxDataDbgCounters.uAmsduZeroCopySubframes++;
+                }
+                else 
+                {
+                    /* Fallback: copy the subframe (from its rewritten header) and pass it to the OS */
+                    pRxData->rxDataDbgCounters.uAmsduShareFailures++;
+                    pDataBuf = rxData_CopyAmsduSubframe (pRxData, pBuffer, pEthHeader, pEthHeader + 2 * MAC_ADDR_LEN, uEthLen);
+                    if (NULL == pDataBuf)
+                    {
+                        rxData_discardPacket (hRxData, pBuffer, pRxAttr);
+                        return TI_NOK;
+                    }
+                    if (!bLastMsdu)
+                    {
+                        ((RxIfDescriptor_t *)pDataBuf)->driverFlags &= ~DRV_RX_FLAG_END_OF_BURST;
+                    }
+                    pRxData->rxDataDbgCounters.uAmsduCopySubframes++;
+                    os_receivePacket (pRxData->hOs, (struct RxIfDescriptor_t*)pDataBuf, pDataBuf, uEthLen);
+                }
+            }
+        }
+        else 
+        {
+            pDataBuf = rxData_CopyAmsduSubframe (pRxData, pBuffer, (TI_UINT8 *)pMsduEthHeader, (TI_UINT8 *)&pWlanSnapHeader->Type, uEthLen);
+            if (NULL == pDataBuf)
+            {
+                rxData_discardPacket (hRxData, pBuffer, pRxAttr);
+                return TI_NOK;
+            }
 
             /* Clear the EndOfBurst flag for all packets except the last one */
-            ((RxIfDescriptor_t *)pDataBuf)->driverFlags &= ~DRV_RX_FLAG_END_OF_BURST;
+            if (!bLastMsdu)
+            {
+                ((RxIfDescriptor_t *)pDataBuf)->driverFlags &= ~DRV_RX_FLAG_END_OF_BURST;
+            }
+
+            pRxData->rxDataDbgCounters.uAmsduCopySubframes++;
+
+            /* dispatch Buffer according to packet type and current rx data port status */
+            pRxData->rxData_dispatchBuffer[pRxData->rxDataPortStatus][DataPacketType] (hRxData, pDataBuf, pRxAttr);
+        }
+
+        if (!bLastMsdu)
+        {
+            /* swich to the next MSDU */
+            uAmsduDataLen = uAmsduDataLen - lengthDelta;
+            pMsduEthHeader = (TEthernetHeader *)(((TI_UINT8*)pMsduEthHeader) + lengthDelta);
+            /* in A-MSDU the MSDU header type contain the MSDU length and not the type */
+            uDataLen = WLANTOHS(pMsduEthHeader->type);
         }
         else
         {
@@ -1488,18 +1594,10 @@ static TI_STATUS rxData_ConvertAmsduToEthPackets (TI_HANDLE hRxData, void *pBuff
             uAmsduDataLen = 0;
         }
 
-
-        /* in A-MSDU the MSDU header type contain the MSDU length and not the type */
-        uDataLen = WLANTOHS(pMsduEthHeader->type);
-
-
-        /* dispatch Buffer according to packet type and current rx data port status */
-        pRxData->rxData_dispatchBuffer[pRxData->rxDataPortStatus][DataPacketType] (hRxData, pDataBuf, pRxAttr);
-
     } /* while end */
 
 
-    /* free the A-MSDU packet */
+    /* free the A-MSDU packet (the data is kept until the OS consumes its last shared subframe) */
     RxBufFree(pRxData->hOs, pBuffer);
 
     return TI_OK;
@@ -1669,6 +1767,34 @@ static ERxBufferStatus rxData_RequestForBuffer (TI_HANDLE   hRxData,
 }
 
 
+/***************************************************************************
+*                        rxData_PublishStats                               *
+****************************************************************************
+* DESCRIPTION:  Copy the Rx counters to the statistics page section.
+*               Called in the driver context within the page update.
+*
+* INPUTS:       hRxData - the object
+*
+* OUTPUT:       pRx - the statistics page Rx section
+*
+* RETURNS:      void
+***************************************************************************/
+void rxData_PublishStats (TI_HANDLE hRxData, TStatsPageRx *pRx)
+{
+    rxData_t *pRxData = (rxData_t *)hRxData;
+
+    pRx->uRecvOk              = pRxData->rxDataCounters.RecvOk;
+    pRx->uDirectedFramesRecv  = pRxData->rxDataCounters.DirectedFramesRecv;
+    pRx->uDirectedBytesRecv   = pRxData->rxDataCounters.DirectedBytesRecv;
+    pRx->uMulticastFramesRecv = pRxData->rxDataCounters.MulticastFramesRecv;
+    pRx->uMulticastBytesRecv  = pRxData->rxDataCounters.MulticastBytesRecv;
+    pRx->uBroadcastFramesRecv = pRxData->rxDataCounters.BroadcastFramesRecv;
+    pRx->uBroadcastBytesRecv  = pRxData->rxDataCounters.BroadcastBytesRecv;
+    pRx->uExcludedFrames      = pRxData->rxDataDbgCounters.excludedFrameCounter;
+    pRx->uLastDataPktRate     = pRxData->uLastDataPktRate;
+}
+
+
 /*******************************************************************
 *                        DEBUG FUNCTIONS                           *
 *******************************************************************/
@@ -1718,6 +1844,24 @@ void rxData_resetDbgCounters(TI_HANDLE hRxData)
 ***************************************************************************/
 void rxData_printRxCounters (TI_HANDLE hRxData)
 {
+    rxData_t *pRxData = (rxData_t *)hRxData;
+
+    WLAN_OS_REPORT(("RecvOk = %d, DirectedFrames = %d, MulticastFrames = %d, BroadcastFrames = %d\n",
+                    pRxData->rxDataCounters.RecvOk,
+                    pRxData->rxDataCounters.DirectedFramesRecv,
+                    pRxData->rxDataCounters.MulticastFramesRecv,
+                    pRxData->rxDataCounters.BroadcastFramesRecv));
+    WLAN_OS_REPORT(("Excluded = %d, VlanDropped = %d, WrongBssType = %d, WrongBssId = %d, UnicastInOpenNotify = %d\n",
+                    pRxData->rxDataDbgCounters.excludedFrameCounter,
+                    pRxData->rxDataDbgCounters.rxDroppedDueToVLANIncludedCnt,
+                    pRxData->rxDataDbgCounters.rxWrongBssTypeCounter,
+                    pRxData->rxDataDbgCounters.rxWrongBssIdCounter,
+                    pRxData->rxDataDbgCounters.rcvUnicastFrameInOpenNotify));
+    WLAN_OS_REPORT(("A-MSDU: Frames = %d, ZeroCopySubframes = %d, CopySubframes = %d, ShareFailures = %d\n",
+                    pRxData->rxDataDbgCounters.uAmsduFrames,
+                    pRxData->rxDataDbgCounters.uAmsduZeroCopySubframes,
+                    pRxData->rxDataDbgCounters.uAmsduCopySubframes,
+                    pRxData->rxDataDbgCounters.uAmsduShareFailures));
 }
 
 
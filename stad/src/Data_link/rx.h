@@ -55,6 +55,10 @@ typedef struct
     TI_UINT32		rxWrongBssTypeCounter;
 	TI_UINT32		rxWrongBssIdCounter;
     TI_UINT32      rcvUnicastFrameInOpenNotify;
+    TI_UINT32      uAmsduFrames;                /* A-MSDU frames received */
+    TI_UINT32      uAmsduZeroCopySubframes;     /* A-MSDU subframes passed to the OS sharing the A-MSDU buffer */
+    TI_UINT32      uAmsduCopySubframes;         /* A-MSDU subframes copied to a new Rx buffer */
+    TI_UINT32      uAmsduShareFailures;         /* A-MSDU subframes copied since the OS couldn't share the buffer (misaligned or clone failure) */
 }rxDataDbgCounters_t;
 
 
@@ -68,7 +68,14 @@
 
 /* Note: put here and not in txCtrl.h to avoid warning in the txCtrl submodules that include txCtrl.h */ 
  
-static void   txCtrl_TxCompleteCb (TI_HANDLE hTxCtrl, TxResultDescriptor_t *pTxResultInfo);
+static void   txCtrl_TxCompleteBatchCb (TI_HANDLE hTxCtrl, 
+                                        TxResultDescriptor_t *pTxResultQueue, 
+                                        TI_UINT32 uFirstIndex, 
+                                        TI_UINT32 uNumResults);
+static void   txCtrl_TxCompletePkt (txCtrl_t *pTxCtrl, TxResultDescriptor_t *pTxResultInfo, TTxCtrlBlk *pPktCtrlBlk);
+static void   txCtrl_FreePacketBuf (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_STATUS eStatus);
+static TI_UINT32 txCtrl_BuildWlanHdr (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk, AckPolicy_e eAckPolicy, 
+                                      TI_BOOL bEncrypt, TI_UINT32 *pHdrAlignPad);
 static void   txCtrl_BuildDataPkt (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk,
                                    TI_UINT32 uAc, TI_UINT32 uBackpressure);
 static void	  txCtrl_BuildMgmtPkt (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uAc);
@@ -232,10 +239,10 @@ void txCtrl_Init (TStadHandlesList *pStadHandles)
     /* Reset counters */
     txCtrlParams_resetCounters (pStadHandles->hTxCtrl);
 
-    /* Register the Tx-Complete callback function. */
+    /* Register the Tx-Complete callback function (called once with all new Tx results). */
 	TWD_RegisterCb (pTxCtrl->hTWD, 
-                    TWD_EVENT_TX_RESULT_SEND_PKT_COMPLETE, 
-					(void*)txCtrl_TxCompleteCb, 
+                    TWD_EVENT_TX_RESULT_SEND_PKT_COMPLETE_BATCH, 
+					(void*)txCtrl_TxCompleteBatchCb, 
                     pStadHandles->hTxCtrl);
 
 	/* Register the Update-Busy-Map callback function. */
@@ -265,6 +272,8 @@ TI_STATUS txCtrl_SetDefaults (TI_HANDLE hTxCtrl, txDataInitParams_t *txDataInitP
 
     pTxCtrl->creditCalculationTimeout = txDataInitParams->creditCalculationTimeout;
 	pTxCtrl->bCreditCalcTimerEnabled  = txDataInitParams->bCreditCalcTimerEnabled;
+	pTxCtrl->bHdrCacheEnabled         = txDataInitParams->bHdrCacheEnabled;
+    txCtrl_InvalidateHdrCache (hTxCtrl);
 
     /* Update queues mapping (AC/TID/Backpressure) after module init. */
 	txCtrl_UpdateQueuesMapping (hTxCtrl); 
@@ -498,6 +507,29 @@ void txCtrl_FreePacket (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_STATUS eS
 {
     txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
+    /* Free the packet */
+    txCtrl_FreePacketBuf (pTxCtrl, pPktCtrlBlk, eStatus);
+
+    /* Free the CtrlBlk */
+    TWD_txCtrlBlk_Free (pTxCtrl->hTWD, pPktCtrlBlk);
+}
+
+
+
+/********************************************************************************
+*																				*
+*                       LOCAL  FUNCTIONS  IMPLEMENTATION						*
+*																				*
+*********************************************************************************/
+
+
+/***************************************************************************
+*                           txCtrl_FreePacketBuf 
+****************************************************************************
+* DESCRIPTION:  Free the packet (raw buffer or OS packet), not including the CtrlBlk
+***************************************************************************/
+static void txCtrl_FreePacketBuf (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_STATUS eStatus)
+{
     /* If the packet is in a raw buffer, free its memory */
     if (pPktCtrlBlk->tTxPktParams.uFlags & TX_CTRL_FLAG_PKT_IN_RAW_BUF)
     {
@@ -510,55 +542,106 @@ void txCtrl_FreePacket (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_STATUS eS
     {
         wlanDrvIf_FreeTxPacket (pTxCtrl->hOs, pPktCtrlBlk, eStatus);
     }
-
-    /* Free the CtrlBlk */
-    TWD_txCtrlBlk_Free (pTxCtrl->hTWD, pPktCtrlBlk);
 }
 
 
+/*************************************************************************
+*                        txCtrl_TxCompleteBatchCb	                             *
+**************************************************************************
+* DESCRIPTION:  Called by the TWD upon Tx-complete with all the new Tx results.
+*				Handle the packets results:
+*				- Update counters (statistics and medium-usage) per packet
+*				- Free the packets (Wbuf) per packet
+*				- Update the security sequence number once, from the last result
+*				- Free the packets CtrlBlks together (one critical section)
+*
+* INPUT:    hTxCtrl -  The module object.
+*		    pTxResultQueue - The Tx results cyclic table.   
+*		    uFirstIndex - The table index of the first new result.   
+*		    uNumResults - The number of new results.   
+*              
+*************************************************************************/
+static void txCtrl_TxCompleteBatchCb (TI_HANDLE hTxCtrl, 
+                                      TxResultDescriptor_t *pTxResultQueue, 
+                                      TI_UINT32 uFirstIndex, 
+                                      TI_UINT32 uNumResults)
+{
+    txCtrl_t    *pTxCtrl = (txCtrl_t *)hTxCtrl;
+	TTxCtrlBlk  *apPktCtrlBlk[TRQ_DEPTH];
+	TTxCtrlBlk  *pPktCtrlBlk;
+	TxResultDescriptor_t *pTxResultInfo = NULL;
+	TI_UINT32	uNumCtrlBlks = 0;
+	TI_UINT32	i;
+#ifdef TI_DBG
+	TI_UINT32	aBatchDescIds[(CTRL_BLK_ENTRIES_NUM + 31) / 32];
+
+	os_memoryZero (pTxCtrl->hOs, aBatchDescIds, sizeof(aBatchDescIds));
+#endif
+
+	for (i = 0; i < uNumResults; i++)
+	{
+		pTxResultInfo = &(pTxResultQueue[(uFirstIndex + i) & (TRQ_DEPTH - 1)]);
 
-/********************************************************************************
-*																				*
-*                       LOCAL  FUNCTIONS  IMPLEMENTATION						*
-*																				*
-*********************************************************************************/
+		/* Get packet ctrl-block by desc-ID. */
+		pPktCtrlBlk = TWD_txCtrlBlk_GetPointer (pTxCtrl->hTWD, pTxResultInfo->descID);
+
+#ifdef TI_DBG
+		/* If the pointed entry is already free, skip it (not expected to happen). */
+		if (pPktCtrlBlk->pNextFreeEntry != NULL)
+		{
+			continue;
+		}
+		/* The CtrlBlks are freed after the batch, so also skip a desc-ID repeated in this batch */
+		if (aBatchDescIds[pTxResultInfo->descID >> 5] & (1 << (pTxResultInfo->descID & 0x1F)))
+		{
+			continue;
+		}
+		aBatchDescIds[pTxResultInfo->descID >> 5] |= (1 << (pTxResultInfo->descID & 0x1F));
+#endif
+		/* Update counters and free the packet */
+		txCtrl_TxCompletePkt (pTxCtrl, pTxResultInfo, pPktCtrlBlk);
+
+		apPktCtrlBlk[uNumCtrlBlks++] = pPktCtrlBlk;
+		if (uNumCtrlBlks == TRQ_DEPTH)
+		{
+			TWD_txCtrlBlk_FreeBatch (pTxCtrl->hTWD, apPktCtrlBlk, uNumCtrlBlks);
+			uNumCtrlBlks = 0;
+		}
+	}
+
+	/* Update the TKIP/AES sequence-number according to the last Tx packet security-seq-num. */
+	/* Note: The FW always provides the last used seq-num so no need to check if the current 
+			 packet is data and WEP is on. The results are in Tx order and a batch is shorter 
+			 than the 8 LSB wrap around, so the last result is enough. */
+	if (pTxResultInfo != NULL)
+	{
+		TWD_SetSecuritySeqNum (pTxCtrl->hTWD, pTxResultInfo->lsbSecuritySequenceNumber);
+	}
+
+	/* Free the packets CtrlBlks */
+	TWD_txCtrlBlk_FreeBatch (pTxCtrl->hTWD, apPktCtrlBlk, uNumCtrlBlks);
+}
 
 
 /*************************************************************************
-*                        txCtrl_TxCompleteCb		                             *
+*                        txCtrl_TxCompletePkt		                             *
 **************************************************************************
-* DESCRIPTION:  Called by the TWD upon Tx-complete of one packet.
-*				Handle packet result:
+* DESCRIPTION:  Handle the Tx result of one packet:
 *				- Update counters (statistics and medium-usage)
-*				- Free the packet resources (Wbuf and CtrlBlk)
+*				- Free the packet (Wbuf). The CtrlBlk is freed by the caller.
 *
-* INPUT:    hTWD -  The Tnetw-Driver handle.
+* INPUT:    pTxCtrl -  The module object.
 *		    pTxResultInfo - The packet's Tx result information.   
+*		    pPktCtrlBlk - The packet's CtrlBlk.   
 *              
 *************************************************************************/
-static void txCtrl_TxCompleteCb (TI_HANDLE hTxCtrl, TxResultDescriptor_t *pTxResultInfo)
+static void txCtrl_TxCompletePkt (txCtrl_t *pTxCtrl, TxResultDescriptor_t *pTxResultInfo, TTxCtrlBlk *pPktCtrlBlk)
 {
-    txCtrl_t    *pTxCtrl = (txCtrl_t *)hTxCtrl;
-	TTxCtrlBlk  *pPktCtrlBlk;
 	TI_UINT32	ac;
 	TI_BOOL	    bIsDataPkt;
 
-	/* Get packet ctrl-block by desc-ID. */
-	pPktCtrlBlk = TWD_txCtrlBlk_GetPointer (pTxCtrl->hTWD, pTxResultInfo->descID);
 	ac = WMEQosTagToACTable[pPktCtrlBlk->tTxDescriptor.tid];
 
-#ifdef TI_DBG
-	/* If the pointed entry is already free, print error and exit (not expected to happen). */
-	if (pPktCtrlBlk->pNextFreeEntry != NULL)
-	{
-		return;
-	}
-#endif
-	/* Update the TKIP/AES sequence-number according to the Tx data packet security-seq-num. */
-	/* Note: The FW always provides the last used seq-num so no need to check if the current 
-			 packet is data and WEP is on. */
-	TWD_SetSecuritySeqNum (pTxCtrl->hTWD, pTxResultInfo->lsbSecuritySequenceNumber);
-
 	bIsDataPkt = ( (pPktCtrlBlk->tTxPktParams.uPktType == TX_PKT_TYPE_ETHER) || 
 		           (pPktCtrlBlk->tTxPktParams.uPktType == TX_PKT_TYPE_WLAN_DATA) );
 
@@ -578,8 +661,8 @@ static void txCtrl_TxCompleteCb (TI_HANDLE hTxCtrl, TxResultDescriptor_t *pTxRes
         txCtrl_UpdateTxCounters (pTxCtrl, pTxResultInfo, pPktCtrlBlk, ac, bIsDataPkt);
     }
 
-	/* Free the packet resources (packet and CtrlBlk)  */
-    txCtrl_FreePacket (pTxCtrl, pPktCtrlBlk, TI_OK);
+	/* Free the packet (the CtrlBlk is freed by the caller) */
+    txCtrl_FreePacketBuf (pTxCtrl, pPktCtrlBlk, TI_OK);
 }
 
 
@@ -588,6 +671,10 @@ static void txCtrl_TxCompleteCb (TI_HANDLE hTxCtrl, TxResultDescriptor_t *pTxRes
 ****************************************************************************
 * DESCRIPTION:  this function builds the WLAN header from ethernet format, 
 *               including 802.11-MAC, LLC/SNAP, security padding, alignment padding.
+*               If the header cache is enabled, the header is copied from the template 
+*               of the packet flow (destination, TID, Ethertype and encryption), and only 
+*               the source address is patched. Else (or on cache miss) it is built from 
+*               scratch (and saved as the flow template).
 *
 * INPUTS:       hTxCtrl - the object
 *               pPktCtrlBlk - data packet control block (Ethernet header)
@@ -598,6 +685,111 @@ static void txCtrl_TxCompleteCb (TI_HANDLE hTxCtrl, TxResultDescriptor_t *pTxRes
 TI_UINT32 txCtrl_BuildDataPktHdr (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, AckPolicy_e eAckPolicy)
 {
     txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;    
+    TEthernetHeader     *pEthHeader;
+    dot11_header_t      *pDot11Header;
+    TTxHdrCacheEntry    *pEntry;
+	TI_UINT32			uHdrLen;
+	TI_UINT32			uHdrAlignPad;
+	TI_UINT8			uTid = pPktCtrlBlk->tTxDescriptor.tid;
+	TI_UINT8			uKeyFlags = 0;
+	TI_BOOL				bEncrypt;
+
+    /* Before the header translation the first buf-pointer points to the Ethernet header. */	
+	pEthHeader = (TEthernetHeader *)(pPktCtrlBlk->tTxnStruct.aBuf[0]);
+
+	/* 
+	 * Encryption is needed for data or EAPOL according to the decision done at RSN.
+	 */
+	bEncrypt = ( ( (pPktCtrlBlk->tTxPktParams.uPktType == TX_PKT_TYPE_EAPOL)
+				   &&
+				   pTxCtrl->eapolEncryptionStatus) 
+				 ||
+				 ((pPktCtrlBlk->tTxPktParams.uPktType != TX_PKT_TYPE_EAPOL)
+				   &&
+				   pTxCtrl->currentPrivacyInvokedMode ) );
+
+	if (bEncrypt)
+	{
+		uKeyFlags |= TX_HDR_CACHE_KEY_ENCRYPT;
+	}
+	if ( TI_UNLIKELY(eAckPolicy == ACK_POLICY_NO_ACK) )
+	{
+		uKeyFlags |= TX_HDR_CACHE_KEY_NO_ACK;
+	}
+
+	pEntry = &(pTxCtrl->aHdrCache[(pEthHeader->dst[5] ^ uTid) & (TX_HDR_CACHE_SIZE - 1)]);
+
+	/* If the flow header template is cached, copy it and patch the source address. */
+	if (pEntry->bValid                              && 
+		pTxCtrl->bHdrCacheEnabled                   &&
+		(pEntry->uTid == uTid)                      &&
+		(pEntry->uKeyFlags == uKeyFlags)            &&
+		(pEntry->uEtherType == pEthHeader->type)    &&
+		MAC_EQUAL (pEntry->tDstAddr, pEthHeader->dst))
+	{
+		uHdrLen      = pEntry->uHdrLen;
+		uHdrAlignPad = pEntry->uHdrAlignPad;
+		os_memoryCopy (pTxCtrl->hOs, pPktCtrlBlk->aPktHdr, pEntry->aHdr, uHdrLen);
+
+		/* The source address is address2 in both Independent and Infrastructure BSS. */
+		pDot11Header = (dot11_header_t *)&(pPktCtrlBlk->aPktHdr[uHdrAlignPad]);
+		MAC_COPY (pDot11Header->address2, pEthHeader->src);
+
+		pPktCtrlBlk->tTxPktParams.uFlags |= pEntry->uPktFlags;
+#ifdef TI_DBG
+		pTxCtrl->uHdrCacheHits++;
+#endif
+	}
+	else
+	{
+		uHdrLen = txCtrl_BuildWlanHdr (pTxCtrl, pPktCtrlBlk, eAckPolicy, bEncrypt, &uHdrAlignPad);
+
+		/* Save the header as the flow template */
+		if (pTxCtrl->bHdrCacheEnabled)
+		{
+			MAC_COPY (pEntry->tDstAddr, pEthHeader->dst);
+			pEntry->uEtherType   = pEthHeader->type;
+			pEntry->uTid         = uTid;
+			pEntry->uKeyFlags    = uKeyFlags;
+			pEntry->uHdrLen      = (TI_UINT8)uHdrLen;
+			pEntry->uHdrAlignPad = (TI_UINT8)uHdrAlignPad;
+			pEntry->uPktFlags    = pPktCtrlBlk->tTxPktParams.uFlags & (TX_CTRL_FLAG_MULTICAST | TX_CTRL_FLAG_BROADCAST);
+			os_memoryCopy (pTxCtrl->hOs, pEntry->aHdr, pPktCtrlBlk->aPktHdr, uHdrLen);
+			pEntry->bValid       = TI_TRUE;
+		}
+#ifdef TI_DBG
+		pTxCtrl->uHdrCacheMisses++;
+#endif
+	}
+
+    /* Replace first buffer pointer and length to the descriptor and WLAN-header (instead of Ether header) */
+    pPktCtrlBlk->tTxnStruct.aBuf[0] = (TI_UINT8 *)&(pPktCtrlBlk->tTxDescriptor);
+    pPktCtrlBlk->tTxnStruct.aLen[0] = sizeof(TxIfDescriptor_t) + uHdrLen;
+    pPktCtrlBlk->tTxDescriptor.length += pPktCtrlBlk->tTxnStruct.aLen[0] - ETHERNET_HDR_LEN;
+
+	/* Return the number of bytes (0 or 2) added at the header's beginning for 4-bytes alignment. */
+    return uHdrAlignPad;
+}
+
+
+/***************************************************************************
+*                   txCtrl_BuildWlanHdr                                    *
+****************************************************************************
+* DESCRIPTION:  Build the WLAN header from ethernet format in the packet header buffer, 
+*               including 802.11-MAC, LLC/SNAP, security padding, alignment padding.
+*
+* INPUTS:       pTxCtrl - the object
+*               pPktCtrlBlk - data packet control block (Ethernet header)
+*               eAckPolicy - the packet AC ack policy
+*               bEncrypt - if the packet is encrypted
+*
+* OUTPUT:       pHdrAlignPad - Num of bytes (0 or 2) added at the header's beginning for 4-bytes alignment.
+*
+* RETURNS:      uHdrLen - The header length (including the alignment pad).
+***************************************************************************/
+static TI_UINT32 txCtrl_BuildWlanHdr (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk, AckPolicy_e eAckPolicy, 
+                                      TI_BOOL bEncrypt, TI_UINT32 *pHdrAlignPad)
+{
     TEthernetHeader     *pEthHeader;
     dot11_header_t      *pDot11Header;
     Wlan_LlcHeader_T    *pWlanSnapHeader;
@@ -614,14 +806,7 @@ TI_UINT32 txCtrl_BuildDataPktHdr (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, Ac
 	 *   - Set WEP bit in header.
 	 *   - Add padding for FW security overhead: 4 bytes for TKIP, 8 for AES.  
 	 */
-
-       	if (( (pPktCtrlBlk->tTxPktParams.uPktType == TX_PKT_TYPE_EAPOL)
-			  &&
-			  pTxCtrl->eapolEncryptionStatus) 
-		 ||
-			((pPktCtrlBlk->tTxPktParams.uPktType != TX_PKT_TYPE_EAPOL)
-			  &&
-			  pTxCtrl->currentPrivacyInvokedMode ))
+	if (bEncrypt)
         {
         
 			fc |= DOT11_FC_WEP;
@@ -747,13 +932,26 @@ TI_UINT32 txCtrl_BuildDataPktHdr (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, Ac
         uHdrLen += sizeof(Wlan_LlcHeader_T);
     }
 
-    /* Replace first buffer pointer and length to the descriptor and WLAN-header (instead of Ether header) */
-    pPktCtrlBlk->tTxnStruct.aBuf[0] = (TI_UINT8 *)&(pPktCtrlBlk->tTxDescriptor);
-    pPktCtrlBlk->tTxnStruct.aLen[0] = sizeof(TxIfDescriptor_t) + uHdrLen;
-    pPktCtrlBlk->tTxDescriptor.length += pPktCtrlBlk->tTxnStruct.aLen[0] - ETHERNET_HDR_LEN;
+	*pHdrAlignPad = uHdrAlignPad;
+    return uHdrLen;
+}
 
-	/* Return the number of bytes (0 or 2) added at the header's beginning for 4-bytes alignment. */
-    return uHdrAlignPad;
+
+/***************************************************************************
+*                   txCtrl_InvalidateHdrCache                              *
+****************************************************************************
+* DESCRIPTION:  Invalidate the data WLAN header templates. 
+*               Called upon changes of the header parameters (BSS, security, QoS, HT).
+***************************************************************************/
+void txCtrl_InvalidateHdrCache (TI_HANDLE hTxCtrl)
+{
+    txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
+	TI_UINT32 i;
+
+	for (i = 0; i < TX_HDR_CACHE_SIZE; i++)
+	{
+		pTxCtrl->aHdrCache[i].bValid = TI_FALSE;
+	}
 }
 
 
@@ -1263,3 +1461,225 @@ TI_STATUS txCtrl_CheckForTxStuck (TI_HANDLE hTxCtrl)
 
 
 
+
+
+#ifdef TI_DBG
+
+#define TX_CMPLT_BENCH_PACKETS      1600
+#define TX_CMPLT_BENCH_BUF_SIZE     64
+
+/*************************************************************************
+*                        txCtrl_TxCompleteBenchmark	                             *
+**************************************************************************
+* DESCRIPTION:  Measure the Tx-complete throughput for several Tx results batch sizes,
+*				once handling and freeing each packet separately (as per result callback), 
+*				and once handling the packets and freeing their CtrlBlks together (as the 
+*				batch callback).
+*				Uses management packets in raw buffers, so the data statistics are not 
+*				affected. The security sequence number update is not measured since it 
+*				would change the connection state.
+*
+* INPUT:    hTxCtrl -  The module object.
+*              
+*************************************************************************/
+void txCtrl_TxCompleteBenchmark (TI_HANDLE hTxCtrl)
+{
+    txCtrl_t    *pTxCtrl = (txCtrl_t *)hTxCtrl;
+	static const TI_UINT32 aBatchSize[] = {1, 4, 8, 16};
+	TxResultDescriptor_t aTxResults[TRQ_DEPTH];
+	TTxCtrlBlk  *apPktCtrlBlk[TRQ_DEPTH];
+	TTxCtrlBlk  *pPktCtrlBlk;
+	TI_UINT32	uTest, uBatch, uRound, uPath, i;
+	TI_UINT32	uStartUs;
+	TI_UINT32	aPathUs[2];
+
+	os_memoryZero (pTxCtrl->hOs, aTxResults, sizeof(aTxResults));
+
+	WLAN_OS_REPORT(("Tx-complete benchmark: %d packets per test\n", TX_CMPLT_BENCH_PACKETS));
+	WLAN_OS_REPORT(("Batch  Per-packet(ns/pkt)  Batched(ns/pkt)\n"));
+
+	for (uTest = 0; uTest < sizeof(aBatchSize) / sizeof(aBatchSize[0]); uTest++)
+	{
+		uBatch = aBatchSize[uTest];
+
+		for (uPath = 0; uPath < 2; uPath++)
+		{
+			aPathUs[uPath] = 0;
+
+			for (uRound = 0; uRound < TX_CMPLT_BENCH_PACKETS / uBatch; uRound++)
+			{
+				/* Prepare the batch packets and results (not measured) */
+				for (i = 0; i < uBatch; i++)
+				{
+					pPktCtrlBlk = TWD_txCtrlBlk_Alloc (pTxCtrl->hTWD);
+					if (pPktCtrlBlk == NULL)
+					{
+						break;
+					}
+					pPktCtrlBlk->tTxPktParams.pInputPkt = os_memoryAlloc (pTxCtrl->hOs, TX_CMPLT_BENCH_BUF_SIZE);
+					if (pPktCtrlBlk->tTxPktParams.pInputPkt == NULL)
+					{
+						TWD_txCtrlBlk_Free (pTxCtrl->hTWD, pPktCtrlBlk);
+						break;
+					}
+					pPktCtrlBlk->tTxPktParams.uInputPktLen = TX_CMPLT_BENCH_BUF_SIZE;
+					pPktCtrlBlk->tTxPktParams.uFlags = TX_CTRL_FLAG_PKT_IN_RAW_BUF;
+					pPktCtrlBlk->tTxPktParams.uPktType = TX_PKT_TYPE_MGMT;
+					pPktCtrlBlk->tTxDescriptor.tid = 0;
+					aTxResults[i].descID = pPktCtrlBlk->tTxDescriptor.descID;
+					aTxResults[i].status = TX_SUCCESS;
+				}
+				if (i < uBatch)
+				{
+					WLAN_OS_REPORT(("txCtrl_TxCompleteBenchmark: allocation failed\n"));
+					while (i-- > 0)
+					{
+						txCtrl_FreePacket (pTxCtrl, TWD_txCtrlBlk_GetPointer (pTxCtrl->hTWD, aTxResults[i].descID), TI_OK);
+					}
+					return;
+				}
+
+				uStartUs = os_timeStampUs (pTxCtrl->hOs);
+				if (uPath == 0)
+				{
+					/* Per packet - handle the result and free the packet and its CtrlBlk */
+					for (i = 0; i < uBatch; i++)
+					{
+						pPktCtrlBlk = TWD_txCtrlBlk_GetPointer (pTxCtrl->hTWD, aTxResults[i].descID);
+						txCtrl_TxCompletePkt (pTxCtrl, &aTxResults[i], pPktCtrlBlk);
+						TWD_txCtrlBlk_Free (pTxCtrl->hTWD, pPktCtrlBlk);
+					}
+				}
+				else
+				{
+					/* Batched - handle the results and free the CtrlBlks together */
+					for (i = 0; i < uBatch; i++)
+					{
+						apPktCtrlBlk[i] = TWD_txCtrlBlk_GetPointer (pTxCtrl->hTWD, aTxResults[i].descID);
+						txCtrl_TxCompletePkt (pTxCtrl, &aTxResults[i], apPktCtrlBlk[i]);
+					}
+					TWD_txCtrlBlk_FreeBatch (pTxCtrl->hTWD, apPktCtrlBlk, uBatch);
+				}
+				aPathUs[uPath] += os_timeStampUs (pTxCtrl->hOs) - uStartUs;
+			}
+		}
+
+		WLAN_OS_REPORT(("%5d  %18d  %15d\n", 
+						uBatch, 
+						(aPathUs[0] * 1000) / TX_CMPLT_BENCH_PACKETS, 
+						(aPathUs[1] * 1000) / TX_CMPLT_BENCH_PACKETS));
+	}
+}
+
+
+
+#define TX_HDR_BENCH_PACKETS        10000
+#define TX_HDR_BENCH_PAYLOAD_LEN    1472
+
+/*************************************************************************
+*                        txCtrl_HdrCacheBenchmark	                             *
+**************************************************************************
+* DESCRIPTION:  Measure the data WLAN header build time per packet, with and without
+*				the header templates cache, using a synthetic Tx generator of Ethernet
+*				IP packets to a number of flows (destination and TID).
+*				Uses the current BSS, security and QoS settings. The cache is invalidated 
+*				at the end, so the benchmark flows don't stay in it.
+*
+* INPUT:    hTxCtrl -  The module object.
+*              
+*************************************************************************/
+void txCtrl_HdrCacheBenchmark (TI_HANDLE hTxCtrl)
+{
+    txCtrl_t    *pTxCtrl = (txCtrl_t *)hTxCtrl;
+	static const TI_UINT32 aNumFlows[] = {1, 4, 16};
+	TTxCtrlBlk  *pPkt;
+	TEthernetHeader *pEthHeader;
+	TI_UINT8    aHdr[MAX_HEADER_SIZE];
+	TI_UINT32   uTest, uFlow, uNumFlows, uPath, i;
+	TI_UINT32   uStartUs;
+	TI_UINT32   aPathUs[2];
+	TI_UINT32   uHdrLen = 0;
+	TI_BOOL     bMatch;
+	TI_BOOL     bHdrCacheEnabled = pTxCtrl->bHdrCacheEnabled;
+	TI_UINT32   uHdrCacheHits   = pTxCtrl->uHdrCacheHits;
+	TI_UINT32   uHdrCacheMisses = pTxCtrl->uHdrCacheMisses;
+
+	pPkt       = os_memoryAlloc (pTxCtrl->hOs, sizeof(TTxCtrlBlk));
+	pEthHeader = os_memoryAlloc (pTxCtrl->hOs, sizeof(TEthernetHeader));
+	if ((pPkt == NULL) || (pEthHeader == NULL))
+	{
+		WLAN_OS_REPORT(("txCtrl_HdrCacheBenchmark: memory allocation failed\n"));
+		if (pPkt) 
+			os_memoryFree (pTxCtrl->hOs, pPkt, sizeof(TTxCtrlBlk));
+		if (pEthHeader) 
+			os_memoryFree (pTxCtrl->hOs, pEthHeader, sizeof(TEthernetHeader));
+		return;
+	}
+	os_memoryZero (pTxCtrl->hOs, pPkt, sizeof(TTxCtrlBlk));
+	os_memoryZero (pTxCtrl->hOs, pEthHeader, sizeof(TEthernetHeader));
+	pEthHeader->dst[1] = 0x11;
+	pEthHeader->src[1] = 0x22;
+	pEthHeader->type   = HTOWLANS(ETHERTYPE_IP);
+
+	WLAN_OS_REPORT(("Tx header cache benchmark: %d packets per test, cache hits = %d, misses = %d\n", 
+					TX_HDR_BENCH_PACKETS, uHdrCacheHits, uHdrCacheMisses));
+	WLAN_OS_REPORT(("Flows  Build(ns/pkt)  Cached(ns/pkt)  Header\n"));
+
+	for (uTest = 0; uTest < sizeof(aNumFlows) / sizeof(aNumFlows[0]); uTest++)
+	{
+		uNumFlows = aNumFlows[uTest];
+		bMatch = TI_TRUE;
+
+		for (uPath = 0; uPath < 2; uPath++)
+		{
+			pTxCtrl->bHdrCacheEnabled = (uPath == 1);
+			txCtrl_InvalidateHdrCache (hTxCtrl);
+
+			uStartUs = os_timeStampUs (pTxCtrl->hOs);
+			for (i = 0; i < TX_HDR_BENCH_PACKETS; i++)
+			{
+				/* Generate the next packet - flows differ by destination and TID */
+				uFlow = i % uNumFlows;
+				pEthHeader->dst[5] = (TI_UINT8)uFlow;
+				pPkt->tTxDescriptor.tid = (TI_UINT8)(uFlow % MAX_NUM_OF_802_1d_TAGS);
+				pPkt->tTxDescriptor.length = ETHERNET_HDR_LEN + TX_HDR_BENCH_PAYLOAD_LEN;
+				pPkt->tTxPktParams.uPktType = TX_PKT_TYPE_ETHER;
+				pPkt->tTxPktParams.uFlags = 0;
+				pPkt->tTxnStruct.aBuf[0] = (TI_UINT8 *)pEthHeader;
+				pPkt->tTxnStruct.aLen[0] = ETHERNET_HDR_LEN;
+
+				txCtrl_BuildDataPktHdr (hTxCtrl, pPkt, pTxCtrl->ackPolicy[WMEQosTagToACTable[pPkt->tTxDescriptor.tid]]);
+			}
+			aPathUs[uPath] = os_timeStampUs (pTxCtrl->hOs) - uStartUs;
+
+			/* Compare the last packet header built from scratch and copied from the template */
+			if (uPath == 0)
+			{
+				uHdrLen = pPkt->tTxnStruct.aLen[0] - sizeof(TxIfDescriptor_t);
+				os_memoryCopy (pTxCtrl->hOs, aHdr, pPkt->aPktHdr, uHdrLen);
+			}
+			else 
+			{
+				bMatch = ((pPkt->tTxnStruct.aLen[0] - sizeof(TxIfDescriptor_t)) == uHdrLen) &&
+						 (os_memoryCompare (pTxCtrl->hOs, aHdr, pPkt->aPktHdr, (TI_INT32)uHdrLen) == 0);
+			}
+		}
+
+		WLAN_OS_REPORT(("%5d  %13d  %14d  %s\n", 
+						uNumFlows, 
+						(aPathUs[0] * 1000) / TX_HDR_BENCH_PACKETS, 
+						(aPathUs[1] * 1000) / TX_HDR_BENCH_PACKETS,
+						bMatch ? "match" : "MISMATCH"));
+	}
+
+	/* Restore the cache state and counters */
+	pTxCtrl->bHdrCacheEnabled = bHdrCacheEnabled;
+	txCtrl_InvalidateHdrCache (hTxCtrl);
+	pTxCtrl->uHdrCacheHits   = uHdrCacheHits;
+	pTxCtrl->uHdrCacheMisses = uHdrCacheMisses;
+
+	os_memoryFree (pTxCtrl->hOs, pPkt, sizeof(TTxCtrlBlk));
+	os_memoryFree (pTxCtrl->hOs, pEthHeader, sizeof(TEthernetHeader));
+}
+
+#endif /* TI_DBG */
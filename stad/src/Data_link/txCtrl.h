@@ -54,6 +54,11 @@ extern void wlanDrvIf_FreeTxPacket (TI_HANDLE hOs, TTxCtrlBlk *pPktCtrlBlk, TI_S
 #define DEF_EAPOL_ENCRYPTION_STATUS     TI_FALSE
 #define HEADER_PAD_SIZE                 2       /* 2-byte pad before header with QoS, for 4-byte alignment */
 #define MGMT_PKT_LIFETIME_TU            2000    /* Mgmt pkts lifetime in TUs (1024 usec). */
+#define TX_HDR_CACHE_SIZE               8       /* Data WLAN header templates cache entries (power of 2) */
+
+/* The header template key flags (beside the destination, TID and Ethertype) */
+#define TX_HDR_CACHE_KEY_ENCRYPT        0x01    /* The packet is encrypted */
+#define TX_HDR_CACHE_KEY_NO_ACK         0x02    /* The packet is sent with no-ack policy */
 
 /* defined in qosMngr.c - standard WMM translation from TID to AC. */
 extern int WMEQosTagToACTable[MAX_NUM_OF_802_1d_TAGS];
@@ -83,6 +88,25 @@ typedef struct
 } txDataDbgCounters_t;
 
 
+/* 
+ *  Data WLAN header template - the header built for the first packet of a flow 
+ *    (destination, TID, Ethertype and encryption), copied to the next packets of the flow.
+ *  Only the source address is patched per packet (the sequence number and duration are set by the FW).
+ */
+typedef struct 
+{
+    TMacAddr    tDstAddr;           /* Key: the Ethernet destination address */
+    TI_UINT16   uEtherType;         /* Key: the Ethernet type/length field (as in the packet) */
+    TI_UINT8    uTid;               /* Key: the packet TID */
+    TI_UINT8    uKeyFlags;          /* Key: TX_HDR_CACHE_KEY_xxx */
+    TI_BOOL     bValid;
+    TI_UINT8    uHdrLen;            /* The template length, including the alignment pad */
+    TI_UINT8    uHdrAlignPad;       /* Num of bytes (0 or 2) added at the header's beginning */
+    TI_UINT16   uPktFlags;          /* The TX_CTRL_FLAG_MULTICAST/BROADCAST flags of the flow */
+    TI_UINT8    aHdr[MAX_HEADER_SIZE];
+} TTxHdrCacheEntry;
+
+
 
 /* 
  *  Module object structure. 
@@ -119,6 +143,14 @@ typedef struct
     TtxCtrlHtControl    tTxCtrlHtControl;
 	TI_UINT16           genericEthertype;
 
+    /* Data WLAN header templates, invalidated upon association, security and QoS changes */
+    TI_BOOL             bHdrCacheEnabled;
+    TTxHdrCacheEntry    aHdrCache[TX_HDR_CACHE_SIZE];
+#ifdef TI_DBG
+    TI_UINT32           uHdrCacheHits;
+    TI_UINT32           uHdrCacheMisses;
+#endif
+
     /* ACs admission and busy mapping */
     TI_UINT32           busyAcBitmap;   /* Current bitmap of busy ACs (in HW-Q backpressure format). */
     TI_UINT32           busyTidBitmap;  /* Current bitmap of busy TIDs reflected from admitted ACs. */
@@ -452,6 +452,7 @@ void txCtrlParams_setBssId (TI_HANDLE hTxCtrl, TMacAddr *pCurrBssId)
 	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
 	MAC_COPY (pTxCtrl->currBssId, *pCurrBssId);
+	txCtrl_InvalidateHdrCache (hTxCtrl);
 }
 
 
@@ -465,6 +466,7 @@ void txCtrlParams_setBssType (TI_HANDLE hTxCtrl, ScanBssType_e currBssType)
 	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
 	pTxCtrl->currBssType = currBssType;
+	txCtrl_InvalidateHdrCache (hTxCtrl);
 }
 
 
@@ -478,6 +480,7 @@ void txCtrlParams_setQosHeaderConverMode (TI_HANDLE hTxCtrl, EHeaderConvertMode
 	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
 	pTxCtrl->headerConverMode = headerConverMode;
+	txCtrl_InvalidateHdrCache (hTxCtrl);
 
 	updateDataPktPrototype(pTxCtrl);  /* Needed due to QoS mode change. */
 }
@@ -497,6 +500,7 @@ TI_STATUS txCtrlParams_SetHtControl (TI_HANDLE hTxCtrl, TtxCtrlHtControl *pHtCon
     txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
  
     pTxCtrl->tTxCtrlHtControl.bHtEnable = pHtControl->bHtEnable;
+    txCtrl_InvalidateHdrCache (hTxCtrl);
 
     return TI_OK;
 }
@@ -511,6 +515,7 @@ void txCtrlParams_setCurrentPrivacyInvokedMode (TI_HANDLE hTxCtrl, TI_BOOL curre
 	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
 	pTxCtrl->currentPrivacyInvokedMode = currentPrivacyInvokedMode;
+	txCtrl_InvalidateHdrCache (hTxCtrl);
 }
 
 
@@ -524,6 +529,7 @@ void txCtrlParams_setEapolEncryptionStatus (TI_HANDLE hTxCtrl, TI_BOOL eapolEncr
 	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
 	pTxCtrl->eapolEncryptionStatus = eapolEncryptionStatus;
+	txCtrl_InvalidateHdrCache (hTxCtrl);
 }
 
 
@@ -537,6 +543,7 @@ void txCtrlParams_setEncryptionFieldSizes (TI_HANDLE hTxCtrl, TI_UINT8 encryptio
 	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
 
 	pTxCtrl->encryptionFieldSize = encryptionFieldSize;
+	txCtrl_InvalidateHdrCache (hTxCtrl);
 }
 
 
@@ -657,6 +664,41 @@ void txCtrlParams_updateTxSessionCount(TI_HANDLE hTxCtrl, TI_UINT16 txSessionCou
 }
 
 
+/***********************************************************************
+ *                     txCtrlParams_PublishStats
+ ***********************************************************************
+DESCRIPTION:    Copy the per AC Tx counters and queues state to the statistics 
+                    page section (called in the driver context within the page update).
+************************************************************************/
+void txCtrlParams_PublishStats(TI_HANDLE hTxCtrl, TStatsPageTxAc *pTx)
+{
+	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
+	TTxDataCounters *pCounters;
+	TI_UINT32 ac;
+
+	for (ac = 0; ac < MAX_NUM_OF_AC; ac++)
+	{
+		pCounters = &pTxCtrl->txDataCounters[ac];
+
+		pTx[ac].uXmitOk              = pCounters->XmitOk;
+		pTx[ac].uDirectedFramesXmit  = pCounters->DirectedFramesXmit;
+		pTx[ac].uDirectedBytesXmit   = pCounters->DirectedBytesXmit;
+		pTx[ac].uMulticastFramesXmit = pCounters->MulticastFramesXmit;
+		pTx[ac].uMulticastBytesXmit  = pCounters->MulticastBytesXmit;
+		pTx[ac].uBroadcastFramesXmit = pCounters->BroadcastFramesXmit;
+		pTx[ac].uBroadcastBytesXmit  = pCounters->BroadcastBytesXmit;
+		pTx[ac].uRetryFailCounter    = pCounters->RetryFailCounter;
+		pTx[ac].uTxTimeoutCounter    = pCounters->TxTimeoutCounter;
+		pTx[ac].uNoLinkCounter       = pCounters->NoLinkCounter;
+		pTx[ac].uOtherFailCounter    = pCounters->OtherFailCounter;
+		pTx[ac].uNumPackets          = pCounters->NumPackets;
+		pTx[ac].uSumTotalDelayMs     = pTxCtrl->SumTotalDelayUs[ac] / 1000;
+		pTx[ac].bBusy                = (pTxCtrl->busyAcBitmap & (1 << ac)) ? TI_TRUE : TI_FALSE;
+		pTx[ac].bAdmitted            = (pTxCtrl->admissionState[ac] == AC_ADMITTED) ? TI_TRUE : TI_FALSE;
+	}
+}
+
+
 
 
 /********************************************************************************
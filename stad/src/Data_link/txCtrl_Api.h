@@ -43,6 +43,7 @@
 
 #include "GeneralUtilApi.h"
 #include "DrvMainModules.h"
+#include "TI_StatsPage.h"
 
 /* TxCtrl Xmit results */
 typedef enum
@@ -89,6 +90,7 @@ void      txCtrl_FreePacket (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_STAT
 TI_STATUS txCtrl_NotifyFwReset(TI_HANDLE hTxCtrl);
 TI_STATUS txCtrl_CheckForTxStuck(TI_HANDLE hTxCtrl);
 TI_UINT32 txCtrl_BuildDataPktHdr (TI_HANDLE hTxCtrl, TTxCtrlBlk *pPktCtrlBlk, AckPolicy_e ackPolicy);
+void      txCtrl_InvalidateHdrCache (TI_HANDLE hTxCtrl);
 
 
 /* 
@@ -129,10 +131,13 @@ void txCtrlParams_setAcAckPolicy (TI_HANDLE hTxCtrl, TI_UINT8 ac, AckPolicy_e ac
 void txCtrlParams_updateMgmtRateAttributes(TI_HANDLE hTxCtrl, TI_UINT8 ratePolicyId, TI_UINT8 ac);
 void txCtrlParams_updateDataRateAttributes(TI_HANDLE hTxCtrl, TI_UINT8 ratePolicyId, TI_UINT8 ac);
 void txCtrlParams_updateTxSessionCount(TI_HANDLE hTxCtrl, TI_UINT16 txSessionCount);
+void txCtrlParams_PublishStats(TI_HANDLE hTxCtrl, TStatsPageTxAc *pTx);
 #ifdef TI_DBG
 void txCtrlParams_printInfo(TI_HANDLE hTxCtrl);
 void txCtrlParams_printDebugCounters(TI_HANDLE hTxCtrl);
 void txCtrlParams_resetDbgCounters(TI_HANDLE hTxCtrl);
+void txCtrl_TxCompleteBenchmark(TI_HANDLE hTxCtrl);
+void txCtrl_HdrCacheBenchmark(TI_HANDLE hTxCtrl);
 #endif /* TI_DBG */
 
 
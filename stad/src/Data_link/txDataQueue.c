@@ -45,6 +45,7 @@
 #include "report.h"
 #include "timer.h"
 #include "queue.h"
+#include "ring.h"
 #include "context.h"
 #include "Ethernet.h"
 #include "TWDriver.h"
@@ -56,10 +57,21 @@
 
 /* Internal Functions prototypes */
 static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ);
+static void txDataQ_RunBurstScheduler (TTxDataQ *pTxDataQ);
+static TI_UINT32 txDataQ_DequeueBurst (TTxDataQ *pTxDataQ, TI_UINT32 uQueId, TTxCtrlBlk **aBurst, TI_BOOL *pQueEmpty);
+static TI_STATUS txDataQ_InsertPacketLockFree (TTxDataQ *pTxDataQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 uPacketDtag);
+static TI_UINT32 txDataQ_PktQueId (TTxDataQ *pTxDataQ, TTxCtrlBlk *pPktCtrlBlk);
+static void txDataQ_CheckRingWake (TTxDataQ *pTxDataQ, TI_UINT32 uQueId);
+static void txDataQ_Lock (TTxDataQ *pTxDataQ);
+static void txDataQ_Unlock (TTxDataQ *pTxDataQ);
+static TTxCtrlBlk *txDataQ_QueDequeue (TTxDataQ *pTxDataQ, TI_UINT32 uQueId);
+static TTxCtrlBlk *txDataQ_QuePeek (TTxDataQ *pTxDataQ, TI_UINT32 uQueId);
+static TI_STATUS txDataQ_QueRequeue (TTxDataQ *pTxDataQ, TI_UINT32 uQueId, TTxCtrlBlk *pPktCtrlBlk);
+static TI_UINT32 txDataQ_QueSize (TTxDataQ *pTxDataQ, TI_UINT32 uQueId);
 static void txDataQ_UpdateQueuesBusyState (TTxDataQ *pTxDataQ, TI_UINT32 uTidBitMap);
 static void txDataQ_TxSendPaceTimeout (TI_HANDLE hTxDataQ, TI_BOOL bTwdInitOccured);
-extern void wlanDrvIf_StopTx (TI_HANDLE hOs);
-extern void wlanDrvIf_ResumeTx (TI_HANDLE hOs);
+extern void wlanDrvIf_StopTx (TI_HANDLE hOs, TI_UINT32 uQueId);
+extern void wlanDrvIf_ResumeTx (TI_HANDLE hOs, TI_UINT32 uQueId);
 
 
 
@@ -170,6 +182,8 @@ void txDataQ_Init (TStadHandlesList *pStadHandles)
                                                    txDataQ_RunScheduler,
                                                    (TI_HANDLE)pTxDataQ,
                                                    TI_TRUE,
+                                                   CONTEXT_PRIORITY_MEDIUM,
+                                                   TX_DATA_CONTEXT_BUDGET,
                                                    "TX_DATA",
                                                    sizeof("TX_DATA"));
 	
@@ -193,6 +207,7 @@ TI_STATUS txDataQ_SetDefaults (TI_HANDLE  hTxDataQ, txDataInitParams_t *pTxDataI
 {
     TTxDataQ  *pTxDataQ = (TTxDataQ *)hTxDataQ;
 	TI_STATUS  eStatus;
+    TI_UINT32  uQueId;
 
     /* configure the classifier sub-module */
     eStatus = txDataClsfr_Config (hTxDataQ, &pTxDataInitParams->ClsfrInitParam);
@@ -207,6 +222,32 @@ TI_STATUS txDataQ_SetDefaults (TI_HANDLE  hTxDataQ, txDataInitParams_t *pTxDataI
 	pTxDataQ->aTxSendPaceThresh[QOS_AC_BK] = pTxDataInitParams->uTxSendPaceThresh;
 	pTxDataQ->aTxSendPaceThresh[QOS_AC_VI] = pTxDataInitParams->uTxSendPaceThresh;
 	pTxDataQ->aTxSendPaceThresh[QOS_AC_VO] = 1;     /* Don't delay voice packts! */
+
+    /* Burst scheduler settings */
+	pTxDataQ->bBurstSched                  = pTxDataInitParams->bTxBurstSched;
+	pTxDataQ->uBurstMaxPkts                = pTxDataInitParams->uTxBurstMaxPkts;
+	pTxDataQ->aBurstQuantum[QOS_AC_BE]     = pTxDataInitParams->aTxBurstQuantum[QOS_AC_BE];
+	pTxDataQ->aBurstQuantum[QOS_AC_BK]     = pTxDataInitParams->aTxBurstQuantum[QOS_AC_BK];
+	pTxDataQ->aBurstQuantum[QOS_AC_VI]     = pTxDataInitParams->aTxBurstQuantum[QOS_AC_VI];
+	pTxDataQ->aBurstQuantum[QOS_AC_VO]     = pTxDataInitParams->aTxBurstQuantum[QOS_AC_VO];
+    os_memoryZero (pTxDataQ->hOs, pTxDataQ->aBurstDeficit, sizeof(pTxDataQ->aBurstDeficit));
+
+    /* If configured, create the lock-free rings (used instead of the queues created in txDataQ_Init) */
+	pTxDataQ->bLockFree = pTxDataInitParams->bTxLockFree;
+    if (pTxDataQ->bLockFree)
+    {
+        for (uQueId = 0; uQueId < pTxDataQ->uNumQueues; uQueId++)
+        {
+            pTxDataQ->aRings[uQueId] = ring_Create (pTxDataQ->hOs, pTxDataQ->aQueueMaxSize[uQueId]);
+            if (pTxDataQ->aRings[uQueId] == NULL)
+            {
+                return TI_NOK;
+            }
+            pTxDataQ->aRingWakeThresh[uQueId] = 
+                pTxDataQ->aQueueMaxSize[uQueId] * pTxDataInitParams->uTxRingWakePercent / 100;
+            pTxDataQ->aHeldPktsNum[uQueId] = 0;
+        }
+    }
     
 	
     return TI_OK;
@@ -240,6 +281,10 @@ TI_STATUS txDataQ_Destroy (TI_HANDLE hTxDataQ)
 		{
 			status = TI_NOK;
 		}
+        if (pTxDataQ->aRings[uQueId])
+        {
+            ring_Destroy (pTxDataQ->aRings[uQueId]);
+        }
     }
 
     /* free timer */
@@ -277,9 +322,9 @@ void txDataQ_ClearQueues (TI_HANDLE hTxDataQ)
     {
         while (1)
         {
-            context_EnterCriticalSection (pTxDataQ->hContext);
-            pPktCtrlBlk = (TTxCtrlBlk *) que_Dequeue (pTxDataQ->aQueues[uQueId]);
-            context_LeaveCriticalSection (pTxDataQ->hContext);
+            txDataQ_Lock (pTxDataQ);
+            pPktCtrlBlk = txDataQ_QueDequeue (pTxDataQ, uQueId);
+            txDataQ_Unlock (pTxDataQ);
             if (pPktCtrlBlk == NULL) 
             {
                 break;
@@ -298,6 +343,7 @@ void txDataQ_ClearQueues (TI_HANDLE hTxDataQ)
  * If the packet it an EAPOL, forward it to the Mgmt-Queue.
  * Otherwise, classify the packet, enqueue it and request 
  *   context switch for handling it in the driver's context.
+ * In lock-free mode the packet is handled by txDataQ_InsertPacketLockFree.
  *
  * \note   
  * \param  hTxDataQ    - The object                                          
@@ -331,19 +377,29 @@ TI_STATUS txDataQ_InsertPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrlBlk, TI_
     
     pPktCtrlBlk->tTxPktParams.uPktType = TX_PKT_TYPE_ETHER;
 
-    /* Enter critical section to protect classifier data and queue access */
-    context_EnterCriticalSection (pTxDataQ->hContext);
+    if (pTxDataQ->bLockFree)
+    {
+        return txDataQ_InsertPacketLockFree (pTxDataQ, pPktCtrlBlk, uPacketDtag);
+    }
 
-	/* Call the Classify function to set the TID field */
-	if (txDataClsfr_ClassifyTxPacket (hTxDataQ, pPktCtrlBlk, uPacketDtag) != TI_OK)
+	/* Call the Classify function to set the TID field (unless set by the OAL Tx queue selection) */
+    /* Note: No need for critical section since it uses a compiled classifier copy (see txDataClsfr_Compile) */
+	if (pPktCtrlBlk->tTxPktParams.uFlags & TX_CTRL_FLAG_CLASSIFIED)
+	{
+		pPktCtrlBlk->tTxDescriptor.tid = uPacketDtag;
+	}
+	else if (txDataClsfr_ClassifyTxPacket (hTxDataQ, pPktCtrlBlk, uPacketDtag) != TI_OK)
 	{
 #ifdef TI_DBG
 		pTxDataQ->uClsfrMismatchCount++;
 #endif /* TI_DBG */
 	}
 
-	/* Enqueue the packet in the appropriate Queue */
-    uQueId = aTidToQueueTable[pPktCtrlBlk->tTxDescriptor.tid];
+    /* Enter critical section to protect queue access */
+    context_EnterCriticalSection (pTxDataQ->hContext);
+
+	/* Enqueue the packet in the queue of its OS subqueue (so the same subqueue is stopped and resumed) */
+    uQueId = txDataQ_PktQueId (pTxDataQ, pPktCtrlBlk);
     eStatus = que_Enqueue (pTxDataQ->aQueues[uQueId], (TI_HANDLE)pPktCtrlBlk);
 
     /* Get number of packets in current queue */
@@ -392,7 +448,7 @@ TI_STATUS txDataQ_InsertPacket (TI_HANDLE hTxDataQ, TTxCtrlBlk *pPktCtrlBlk, TI_
 	{
 		/* Stop the network stack from sending Tx packets as we have at least one date queue full.
 		Note that in some of the OS's (e.g Win Mobile) it is implemented by blocking the thread! */
-		wlanDrvIf_StopTx (pTxDataQ->hOs);
+		wlanDrvIf_StopTx (pTxDataQ->hOs, uQueId);
     }
 
 	if (eStatus != TI_OK)
@@ -508,6 +564,69 @@ void txDataQ_WakeAll (TI_HANDLE hTxDataQ)
 }
 
 
+/** 
+ * \fn     txDataQ_SelectQueue
+ * \brief  Classify an OS packet and return its Tx queue (AC)
+ * 
+ * Called by the OAL when the network stack selects the interface Tx subqueue for a packet,
+ *     so the stack queues are per AC and follow our own classification.
+ * The resulting TID is returned in pPacketDtag, and is later passed back to txDataQ_InsertPacket
+ *     together with the TX_CTRL_FLAG_CLASSIFIED flag, so the packet isn't classified twice.
+ *
+ * \note   May be called in any context (uses the compiled classifier copy)
+ * \param  hTxDataQ    - The object                                          
+ * \param  pEthPkt     - The packet Ethernet header (followed by the rest of the packet)
+ * \param  uPktLen     - The packet length including the Ethernet header
+ * \param  pPacketDtag - In: the packet D-tag from the OS.  Out: the classified TID
+ * \return The Tx queue (AC) index
+ * \sa     txDataQ_TidToQueue, txDataQ_InsertPacket
+ */ 
+TI_UINT32 txDataQ_SelectQueue (TI_HANDLE hTxDataQ, TI_UINT8 *pEthPkt, TI_UINT32 uPktLen, TI_UINT8 *pPacketDtag)
+{
+    TTxCtrlBlk tPktCtrlBlk;
+
+    if (uPktLen <= ETHERNET_HDR_LEN)
+    {
+        *pPacketDtag = 0;
+        return aTidToQueueTable[0];
+    }
+
+    /* Describe the packet as the OAL does in its Tx CtrlBlk (only the buffers are used by the classifier) */
+	tPktCtrlBlk.tTxnStruct.aBuf[0] = pEthPkt;
+	tPktCtrlBlk.tTxnStruct.aLen[0] = ETHERNET_HDR_LEN;
+	tPktCtrlBlk.tTxnStruct.aBuf[1] = pEthPkt + ETHERNET_HDR_LEN;
+	tPktCtrlBlk.tTxnStruct.aLen[1] = (TI_UINT16)(uPktLen - ETHERNET_HDR_LEN);
+	tPktCtrlBlk.tTxnStruct.aLen[2] = 0;
+
+    /* On failure the TID is left 0 (BE), as done in txDataQ_InsertPacket */
+	if (txDataClsfr_ClassifyTxPacket (hTxDataQ, &tPktCtrlBlk, *pPacketDtag) != TI_OK)
+	{
+#ifdef TI_DBG
+		((TTxDataQ *)hTxDataQ)->uClsfrMismatchCount++;
+#endif /* TI_DBG */
+	}
+
+    *pPacketDtag = tPktCtrlBlk.tTxDescriptor.tid;
+
+    return aTidToQueueTable[tPktCtrlBlk.tTxDescriptor.tid];
+}
+
+
+/** 
+ * \fn     txDataQ_TidToQueue
+ * \brief  Return the Tx queue (AC) of a TID
+ * 
+ * \note   
+ * \param  uTid - The TID (0-7)
+ * \return The Tx queue (AC) index
+ * \sa     txDataQ_SelectQueue
+ */ 
+TI_UINT32 txDataQ_TidToQueue (TI_UINT8 uTid)
+{
+    return aTidToQueueTable[uTid & (MAX_NUM_OF_802_1d_TAGS - 1)];
+}
+
+
 /***************************************************************************
 *                       DEBUG  FUNCTIONS  IMPLEMENTATION			       *
 ****************************************************************************/
@@ -532,7 +651,14 @@ void txDataQ_PrintModuleParams (TI_HANDLE hTxDataQ)
 
 	for (qIndex = 0; qIndex < MAX_NUM_OF_AC; qIndex++)
     {
-        que_Print (pTxDataQ->aQueues[qIndex]);
+        if (pTxDataQ->bLockFree)
+        {
+            ring_Print (pTxDataQ->aRings[qIndex]);
+        }
+        else
+        {
+            que_Print (pTxDataQ->aQueues[qIndex]);
+        }
     }
 }
 
@@ -550,6 +676,30 @@ void txDataQ_PrintModuleParams (TI_HANDLE hTxDataQ)
  */ 
 void txDataQ_PrintQueueStatistics (TI_HANDLE hTxDataQ)
 {
+	TTxDataQ *pTxDataQ = (TTxDataQ *)hTxDataQ;
+	TI_UINT32 uQueId;
+	TI_UINT32 uBurstSize;
+
+    if (!pTxDataQ->bBurstSched)
+    {
+        return;
+    }
+
+    WLAN_OS_REPORT(("Burst scheduler: MaxPkts = %d, Quantum (BE,BK,VI,VO) = %d, %d, %d, %d\n", 
+                    pTxDataQ->uBurstMaxPkts, 
+                    pTxDataQ->aBurstQuantum[QOS_AC_BE], pTxDataQ->aBurstQuantum[QOS_AC_BK], 
+                    pTxDataQ->aBurstQuantum[QOS_AC_VI], pTxDataQ->aBurstQuantum[QOS_AC_VO]));
+    WLAN_OS_REPORT(("Batch size histogram:\n"));
+    WLAN_OS_REPORT(("Size:    BE      BK      VI      VO\n"));
+    for (uBurstSize = 1; uBurstSize <= pTxDataQ->uBurstMaxPkts; uBurstSize++)
+    {
+        WLAN_OS_REPORT(("%4d:", uBurstSize));
+        for (uQueId = 0; uQueId < MAX_NUM_OF_AC; uQueId++)
+        {
+            WLAN_OS_REPORT(("%8d", pTxDataQ->aBurstSizeHist[uQueId][uBurstSize]));
+        }
+        WLAN_OS_REPORT(("\n"));
+    }
 }
 
 
@@ -570,6 +720,7 @@ void txDataQ_ResetQueueStatistics (TI_HANDLE hTxDataQ)
 
     os_memoryZero(pTxDataQ->hOs, &pTxDataQ->aQueueCounters, sizeof(pTxDataQ->aQueueCounters));
     pTxDataQ->uTxSendPaceTimeoutsCount = 0;
+    os_memoryZero(pTxDataQ->hOs, &pTxDataQ->aBurstSizeHist, sizeof(pTxDataQ->aBurstSizeHist));
 }
 
 
@@ -589,6 +740,7 @@ void txDataQ_ResetQueueStatistics (TI_HANDLE hTxDataQ)
  * This function is the Data-Queue scheduler.
  * It selects a packet to transmit from the tx queues and sends it to the TxCtrl.
  * The queues are selected in a round-robin order.
+ * If the burst scheduler is enabled, it is used instead (see txDataQ_RunBurstScheduler).
  * The function is called by one of:
  *     txDataQ_Run()
  *     txDataQ_UpdateBusyMap()
@@ -607,6 +759,12 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
 	EStatusXmit eStatus;  /* The return status of the txCtrl_xmitData function */
     TTxCtrlBlk *pPktCtrlBlk; /* Pointer to the packet to be dequeued and sent */
 
+    if (pTxDataQ->bBurstSched)
+    {
+        txDataQ_RunBurstScheduler (pTxDataQ);
+        return;
+    }
+
 	while(1)
 	{
 		/* If the Data port is closed or the scheduler couldn't send packets from 
@@ -635,9 +793,9 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
         }
 
 		/* Dequeue a packet in a critical section */
-        context_EnterCriticalSection (pTxDataQ->hContext);
-		pPktCtrlBlk = (TTxCtrlBlk *) que_Dequeue (pTxDataQ->aQueues[uQueId]);
-        context_LeaveCriticalSection (pTxDataQ->hContext);
+        txDataQ_Lock (pTxDataQ);
+		pPktCtrlBlk = txDataQ_QueDequeue (pTxDataQ, uQueId);
+        txDataQ_Unlock (pTxDataQ);
 
 		/* If the queue was empty, continue to the next queue */
 		if (pPktCtrlBlk == NULL)
@@ -646,7 +804,7 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
 			{
 				pTxDataQ->aNetStackQueueStopped[uQueId] = TI_FALSE;
 				/*Resume the TX process as our date queues are empty*/
-				wlanDrvIf_ResumeTx (pTxDataQ->hOs);
+				wlanDrvIf_ResumeTx (pTxDataQ->hOs, uQueId);
 			}
 
 			continue;
@@ -668,8 +826,8 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
             TI_STATUS eQueStatus;
 
             /* Requeue the packet in a critical section */
-            context_EnterCriticalSection (pTxDataQ->hContext);
-			eQueStatus = que_Requeue (pTxDataQ->aQueues[uQueId], (TI_HANDLE)pPktCtrlBlk);
+            txDataQ_Lock (pTxDataQ);
+			eQueStatus = txDataQ_QueRequeue (pTxDataQ, uQueId, pPktCtrlBlk);
             if (eQueStatus != TI_OK) 
             {
                 /* If the packet can't be queued drop it */
@@ -680,7 +838,7 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
                 pTxDataQ->aQueueCounters[uQueId].uDroppedPacket++;
 #endif /* TI_DBG */
             }
-            context_LeaveCriticalSection (pTxDataQ->hContext);
+            txDataQ_Unlock (pTxDataQ);
 
 #ifdef TI_DBG
 			pTxDataQ->aQueueCounters[uQueId].uRequeuePacket++;
@@ -692,6 +850,12 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
 		/* If we reach this point, a packet was sent successfully so reset the idle iterations counter. */
 		uIdleIterationsCount = 0;
 
+        /* In lock-free mode, resume the network stack if the queue dropped below its low watermark */
+        if (pTxDataQ->bLockFree)
+        {
+            txDataQ_CheckRingWake (pTxDataQ, uQueId);
+        }
+
 #ifdef TI_DBG
 		pTxDataQ->aQueueCounters[uQueId].uXmittedPacket++;
 #endif /* TI_DBG */
@@ -702,6 +866,221 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
 }
 
 
+/** 
+ * \fn     txDataQ_RunBurstScheduler
+ * \brief  The module's Tx burst scheduler
+ * 
+ * A deficit round robin scheduler over the Tx queues.
+ * In each round the queues are visited in priority order (VO, VI, BE, BK), and each 
+ *     non-busy queue gets its quantum (in bytes) added to its deficit.
+ * A batch of packets that fits in the deficit is dequeued in one critical section 
+ *     (see txDataQ_DequeueBurst), and sent to the TxCtrl back-to-back so the
+ *     Xfer layer can aggregate them.
+ * Packets that the TxCtrl couldn't send are requeued and their length is returned to the deficit.
+ * A queue whose head packet doesn't fit in its deficit yet is not empty, so the rounds go on 
+ *     (adding the quantum) until it is sent, and its network stack queue is not resumed.
+ * The scheduler exits when the data port is closed, or when a whole round sent no packet and 
+ *     no non-busy queue is left with packets.
+ *
+ * \note   
+ * \param  pTxDataQ - The object                                          
+ * \return void 
+ * \sa     txDataQ_RunScheduler, txDataQ_DequeueBurst
+ */ 
+static void txDataQ_RunBurstScheduler (TTxDataQ *pTxDataQ)
+{
+    TTxCtrlBlk *aBurst[TX_BURST_MAX_PKTS_MAX]; /* The packets dequeued in current batch */
+	TI_UINT32   uBurstSize;
+	TI_UINT32   uBurstIdx;
+	TI_UINT32   uOrderIdx;
+	TI_UINT32   uQueId;
+	TI_BOOL     bPktSent;
+	TI_BOOL     bPktPending;
+	TI_BOOL     bQueEmpty;
+	EStatusXmit eStatus;
+
+	while (1)
+	{
+        bPktSent    = TI_FALSE;
+        bPktPending = TI_FALSE;
+
+        for (uOrderIdx = 0; uOrderIdx < MAX_NUM_OF_AC; uOrderIdx++)
+        {
+            /* If the Data port is closed, indicate end of current packets burst and exit */
+            if (!pTxDataQ->bDataPortEnable)
+            {
+                TWD_txXfer_EndOfBurst (pTxDataQ->hTWD);
+                return;
+            }
+
+            uQueId = aBurstQueueOrder[uOrderIdx];
+
+            /* If the queue is busy (AC is full), continue to next queue. */
+            if (pTxDataQ->aQueueBusy[uQueId])
+            {
+                continue;
+            }
+
+            /* Dequeue a batch of packets within the queue's deficit */
+            uBurstSize = txDataQ_DequeueBurst (pTxDataQ, uQueId, aBurst, &bQueEmpty);
+
+            if (uBurstSize == 0)
+            {
+                /* If the head packet didn't fit the deficit, another round is needed to add the quantum */
+                if (!bQueEmpty)
+                {
+                    bPktPending = TI_TRUE;
+                }
+
+                /* If the queue is really empty, resume its network stack queue */
+                else if ((pTxDataQ->bStopNetStackTx) && pTxDataQ->aNetStackQueueStopped[uQueId])
+                {
+                    pTxDataQ->aNetStackQueueStopped[uQueId] = TI_FALSE;
+                    /*Resume the TX process as our date queues are empty*/
+                    wlanDrvIf_ResumeTx (pTxDataQ->hOs, uQueId);
+                }
+
+                continue;
+            }
+
+#ifdef TI_DBG
+            pTxDataQ->aBurstSizeHist[uQueId][uBurstSize]++;
+            pTxDataQ->aQueueCounters[uQueId].uDequeuePacket += uBurstSize;
+#endif /* TI_DBG */
+
+            /* Send the batch packets back-to-back */
+            for (uBurstIdx = 0; uBurstIdx < uBurstSize; uBurstIdx++)
+            {
+                /* Stop sending if the AC became busy or the port was closed during the batch */
+                if (pTxDataQ->aQueueBusy[uQueId] || !pTxDataQ->bDataPortEnable)
+                {
+                    break;
+                }
+
+                eStatus = txCtrl_XmitData (pTxDataQ->hTxCtrl, aBurst[uBurstIdx]);
+
+                if (eStatus == STATUS_XMIT_BUSY)
+                {
+                    break;
+                }
+
+                bPktSent = TI_TRUE;
+
+#ifdef TI_DBG
+                pTxDataQ->aQueueCounters[uQueId].uXmittedPacket++;
+#endif /* TI_DBG */
+            }
+
+            /* If not all packets were sent, requeue the rest (last first) and return their length to the deficit */
+            if (uBurstIdx < uBurstSize)
+            {
+                TI_UINT32 uPktIdx;
+
+                txDataQ_Lock (pTxDataQ);
+                for (uPktIdx = uBurstSize; uPktIdx > uBurstIdx; uPktIdx--)
+                {
+                    TTxCtrlBlk *pPktCtrlBlk = aBurst[uPktIdx - 1];
+
+                    pTxDataQ->aBurstDeficit[uQueId] += pPktCtrlBlk->tTxDescriptor.length;
+                    if (txDataQ_QueRequeue (pTxDataQ, uQueId, pPktCtrlBlk) != TI_OK) 
+                    {
+                        /* If the packet can't be queued drop it (see txDataQ_RunScheduler) */
+                        txCtrl_FreePacket (pTxDataQ->hTxCtrl, pPktCtrlBlk, TI_NOK);
+#ifdef TI_DBG
+                        pTxDataQ->aQueueCounters[uQueId].uDroppedPacket++;
+#endif /* TI_DBG */
+                    }
+#ifdef TI_DBG
+                    pTxDataQ->aQueueCounters[uQueId].uRequeuePacket++;
+#endif /* TI_DBG */
+                }
+                txDataQ_Unlock (pTxDataQ);
+            }
+
+            /* In lock-free mode, resume the network stack if the queue dropped below its low watermark */
+            if (pTxDataQ->bLockFree && bPktSent)
+            {
+                txDataQ_CheckRingWake (pTxDataQ, uQueId);
+            }
+        }
+
+        /* If no packet was sent in a whole round and no packet waits for more deficit, 
+             indicate end of current packets burst and exit */
+        if (!bPktSent && !bPktPending)
+        {
+            TWD_txXfer_EndOfBurst (pTxDataQ->hTWD);
+            return;
+        }
+	}
+}
+
+
+/** 
+ * \fn     txDataQ_DequeueBurst
+ * \brief  Dequeue a batch of packets from one queue
+ * 
+ * Add the queue's quantum to its deficit, and dequeue packets as long as 
+ *     the first queued packet fits in the deficit (up to the max batch size).
+ * All dequeues are done in one critical section (no lock is taken in lock-free mode).
+ * If the queue is emptied its deficit is cleared (so idle queues don't accumulate credit).
+ * Note that zero dequeued packets doesn't mean the queue is empty (the head packet may be 
+ *     longer than the deficit), so the queue state is returned separately.
+ *
+ * \note   
+ * \param  pTxDataQ  - The object                                          
+ * \param  uQueId    - The queue to dequeue from                                          
+ * \param  aBurst    - The array to fill with the dequeued packets                                          
+ * \param  pQueEmpty - Output: TI_TRUE if no packets are left in the queue                                          
+ * \return The number of dequeued packets 
+ * \sa     txDataQ_RunBurstScheduler
+ */ 
+static TI_UINT32 txDataQ_DequeueBurst (TTxDataQ *pTxDataQ, TI_UINT32 uQueId, TTxCtrlBlk **aBurst, TI_BOOL *pQueEmpty)
+{
+    TI_UINT32   uBurstSize = 0;
+    TTxCtrlBlk *pPktCtrlBlk;
+
+    *pQueEmpty = TI_FALSE;
+
+    txDataQ_Lock (pTxDataQ);
+
+    if (txDataQ_QueSize (pTxDataQ, uQueId) == 0)
+    {
+        pTxDataQ->aBurstDeficit[uQueId] = 0;
+        txDataQ_Unlock (pTxDataQ);
+        *pQueEmpty = TI_TRUE;
+        return 0;
+    }
+
+    pTxDataQ->aBurstDeficit[uQueId] += pTxDataQ->aBurstQuantum[uQueId];
+
+    while (uBurstSize < pTxDataQ->uBurstMaxPkts)
+    {
+        pPktCtrlBlk = txDataQ_QuePeek (pTxDataQ, uQueId);
+
+        /* If the queue is empty, clear its deficit */
+        if (pPktCtrlBlk == NULL)
+        {
+            pTxDataQ->aBurstDeficit[uQueId] = 0;
+            *pQueEmpty = TI_TRUE;
+            break;
+        }
+
+        /* If the packet doesn't fit in the deficit, leave it for next round */
+        if (pPktCtrlBlk->tTxDescriptor.length > pTxDataQ->aBurstDeficit[uQueId])
+        {
+            break;
+        }
+
+        pTxDataQ->aBurstDeficit[uQueId] -= pPktCtrlBlk->tTxDescriptor.length;
+        aBurst[uBurstSize++] = txDataQ_QueDequeue (pTxDataQ, uQueId);
+    }
+
+    txDataQ_Unlock (pTxDataQ);
+
+    return uBurstSize;
+}
+
+
 /** 
  * \fn     txDataQ_UpdateQueuesBusyState
  * \brief  Update queues' busy state
@@ -757,3 +1136,250 @@ static void txDataQ_TxSendPaceTimeout (TI_HANDLE hTxDataQ, TI_BOOL bTwdInitOccur
 
 
 
+
+
+/** 
+ * \fn     txDataQ_PktQueId
+ * \brief  Get the queue of a Tx packet
+ * 
+ * The packet is queued by the OS Tx subqueue it was sent from (skb_get_queue_mapping in Linux)
+ *     if known, so the network stack subqueue that is stopped when the queue is full is the one 
+ *     resumed when it drains. Otherwise, by its classified TID.
+ *
+ * \note   
+ * \param  pTxDataQ    - The object                                          
+ * \param  pPktCtrlBlk - Pointer to the packet (classified)
+ * \return The packet's queue ID 
+ * \sa     txDataQ_InsertPacket, txDataQ_InsertPacketLockFree
+ */ 
+static TI_UINT32 txDataQ_PktQueId (TTxDataQ *pTxDataQ, TTxCtrlBlk *pPktCtrlBlk)
+{
+    if ((pPktCtrlBlk->tTxPktParams.uFlags & TX_CTRL_FLAG_OS_QUEUE) && 
+        (pPktCtrlBlk->tTxPktParams.uOsQueId < pTxDataQ->uNumQueues))
+    {
+        return pPktCtrlBlk->tTxPktParams.uOsQueId;
+    }
+
+    return aTidToQueueTable[pPktCtrlBlk->tTxDescriptor.tid];
+}
+
+
+/** 
+ * \fn     txDataQ_InsertPacketLockFree
+ * \brief  Insert packet in a lock-free ring and schedule task
+ * 
+ * The lock-free version of txDataQ_InsertPacket, called in the network stack Tx context 
+ *     which is the single producer of the rings (the driver task is the single consumer).
+ * With per-AC OS Tx subqueues, the stack serializes the producers of each subqueue separately, 
+ *     so the packet is put in the ring of its OS subqueue even if its TID maps to another AC 
+ *     (else two CPUs could produce into the same ring).
+ * The classifier and the ring are accessed without the context lock.
+ * Tx-Send pacing isn't used (its timer requires the lock), so the driver task is requested 
+ *     on each packet (requests are coalesced by the context module pending flag).
+ * If the ring is full (high watermark) the network stack is stopped, and it is resumed by 
+ *     the consumer when the ring drains to its low watermark (see txDataQ_CheckRingWake).
+ *
+ * \note   
+ * \param  pTxDataQ    - The object                                          
+ * \param  pPktCtrlBlk - Pointer to the packet                                         
+ * \param  uPacketDtag - The packet priority optionaly set by the OAL
+ * \return TI_OK - if the packet was queued, TI_NOK - if the packet was dropped. 
+ * \sa     txDataQ_InsertPacket, txDataQ_CheckRingWake
+ */ 
+static TI_STATUS txDataQ_InsertPacketLockFree (TTxDataQ *pTxDataQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 uPacketDtag)
+{
+    TI_HANDLE   hRing;
+	TI_STATUS   eStatus;
+    TI_UINT32   uQueId;
+
+	/* Call the Classify function to set the TID field (unless set by the OAL Tx queue selection) */
+	if (pPktCtrlBlk->tTxPktParams.uFlags & TX_CTRL_FLAG_CLASSIFIED)
+	{
+		pPktCtrlBlk->tTxDescriptor.tid = uPacketDtag;
+	}
+	else if (txDataClsfr_ClassifyTxPacket ((TI_HANDLE)pTxDataQ, pPktCtrlBlk, uPacketDtag) != TI_OK)
+	{
+#ifdef TI_DBG
+		pTxDataQ->uClsfrMismatchCount++;
+#endif /* TI_DBG */
+	}
+
+	/* Put the packet in the ring of its OS subqueue */
+    uQueId  = txDataQ_PktQueId (pTxDataQ, pPktCtrlBlk);
+    hRing   = pTxDataQ->aRings[uQueId];
+    eStatus = ring_Put (hRing, (TI_HANDLE)pPktCtrlBlk);
+
+	if (eStatus != TI_OK)
+    {
+        /* If the packet can't be queued drop it */
+        txCtrl_FreePacket (pTxDataQ->hTxCtrl, pPktCtrlBlk, TI_NOK);
+#ifdef TI_DBG
+		pTxDataQ->aQueueCounters[uQueId].uDroppedPacket++;
+#endif /* TI_DBG */
+        return eStatus;
+    }
+
+#ifdef TI_DBG
+	pTxDataQ->aQueueCounters[uQueId].uEnqueuePacket++;
+#endif /* TI_DBG */
+
+    /* If the queue is not stopped, request switch to driver context for handling the packet 
+         (if it is stopped, the scheduler is called when the busy state is cleared) */
+    if (pTxDataQ->aQueueBusy[uQueId] == TI_FALSE)
+    {
+        context_RequestSchedule (pTxDataQ->hContext, pTxDataQ->uContextId);
+    }
+
+    /* If allowed to stop network stack and the ring is full, stop the network stack Tx */
+	if ((pTxDataQ->bStopNetStackTx) && (ring_Size (hRing) >= pTxDataQ->aQueueMaxSize[uQueId]))
+	{
+		wlanDrvIf_StopTx (pTxDataQ->hOs, uQueId);
+        context_RequestSchedule (pTxDataQ->hContext, pTxDataQ->uContextId);
+
+        /* Indicate the stop only after it was done, so the consumer can't resume before it */
+        os_memoryBarrierRelease (pTxDataQ->hOs);
+		pTxDataQ->aNetStackQueueStopped[uQueId] = TI_TRUE;
+
+        /* 
+         * If the consumer drained the ring before it could see the stop indication, 
+         *   resume here (resuming twice is harmless).
+         */
+        os_memoryBarrierRelease (pTxDataQ->hOs);
+        if (ring_Size (hRing) <= pTxDataQ->aRingWakeThresh[uQueId])
+        {
+            pTxDataQ->aNetStackQueueStopped[uQueId] = TI_FALSE;
+            wlanDrvIf_ResumeTx (pTxDataQ->hOs, uQueId);
+        }
+    }
+
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     txDataQ_CheckRingWake
+ * \brief  Resume the network stack if the ring drained to its low watermark
+ * 
+ * Called by the consumer (driver task) in lock-free mode after packets were sent.
+ *
+ * \note   
+ * \param  pTxDataQ - The object                                          
+ * \param  uQueId   - The queue that was handled                                          
+ * \return void 
+ * \sa     txDataQ_InsertPacketLockFree
+ */ 
+static void txDataQ_CheckRingWake (TTxDataQ *pTxDataQ, TI_UINT32 uQueId)
+{
+    if (!pTxDataQ->bStopNetStackTx)
+    {
+        return;
+    }
+
+    /* Order the ring head update before reading the producer's stop indication */
+    os_memoryBarrierRelease (pTxDataQ->hOs);
+
+    if (pTxDataQ->aNetStackQueueStopped[uQueId] && 
+        (txDataQ_QueSize (pTxDataQ, uQueId) <= pTxDataQ->aRingWakeThresh[uQueId]))
+    {
+        pTxDataQ->aNetStackQueueStopped[uQueId] = TI_FALSE;
+        wlanDrvIf_ResumeTx (pTxDataQ->hOs, uQueId);
+    }
+}
+
+
+/*
+ * \brief   Lock / Unlock the Tx queues access
+ * 
+ * \param  pTxDataQ - The object
+ * \return void
+ * 
+ * \par Description
+ * Enter/leave the context critical section, unless in lock-free mode where the 
+ *   queues are SPSC rings that don't need it.
+ * 
+ * \sa 
+ */
+static void txDataQ_Lock (TTxDataQ *pTxDataQ)
+{
+    if (!pTxDataQ->bLockFree)
+    {
+        context_EnterCriticalSection (pTxDataQ->hContext);
+    }
+}
+
+static void txDataQ_Unlock (TTxDataQ *pTxDataQ)
+{
+    if (!pTxDataQ->bLockFree)
+    {
+        context_LeaveCriticalSection (pTxDataQ->hContext);
+    }
+}
+
+
+/*
+ * \brief   Tx queues access by the consumer (driver context)
+ * 
+ * \param  pTxDataQ    - The object
+ * \param  uQueId      - The queue index
+ * \param  pPktCtrlBlk - The requeued packet
+ * 
+ * \par Description
+ * Access the queue or the ring (in lock-free mode) of the given AC.
+ * Should be called between txDataQ_Lock and txDataQ_Unlock.
+ * A ring can't be requeued by its consumer, so in lock-free mode requeued packets 
+ *   are held in a per-AC stack which is served before the ring.
+ * 
+ * \sa 
+ */
+static TTxCtrlBlk *txDataQ_QueDequeue (TTxDataQ *pTxDataQ, TI_UINT32 uQueId)
+{
+    if (pTxDataQ->bLockFree)
+    {
+        if (pTxDataQ->aHeldPktsNum[uQueId])
+        {
+            return pTxDataQ->aHeldPkts[uQueId][--pTxDataQ->aHeldPktsNum[uQueId]];
+        }
+        return (TTxCtrlBlk *) ring_Get (pTxDataQ->aRings[uQueId]);
+    }
+
+    return (TTxCtrlBlk *) que_Dequeue (pTxDataQ->aQueues[uQueId]);
+}
+
+static TTxCtrlBlk *txDataQ_QuePeek (TTxDataQ *pTxDataQ, TI_UINT32 uQueId)
+{
+    if (pTxDataQ->bLockFree)
+    {
+        if (pTxDataQ->aHeldPktsNum[uQueId])
+        {
+            return pTxDataQ->aHeldPkts[uQueId][pTxDataQ->aHeldPktsNum[uQueId] - 1];
+        }
+        return (TTxCtrlBlk *) ring_Peek (pTxDataQ->aRings[uQueId]);
+    }
+
+    return (TTxCtrlBlk *) que_Peek (pTxDataQ->aQueues[uQueId]);
+}
+
+static TI_STATUS txDataQ_QueRequeue (TTxDataQ *pTxDataQ, TI_UINT32 uQueId, TTxCtrlBlk *pPktCtrlBlk)
+{
+    if (pTxDataQ->bLockFree)
+    {
+        if (pTxDataQ->aHeldPktsNum[uQueId] >= TX_BURST_MAX_PKTS_MAX)
+        {
+            return TI_NOK;
+        }
+        pTxDataQ->aHeldPkts[uQueId][pTxDataQ->aHeldPktsNum[uQueId]++] = pPktCtrlBlk;
+        return TI_OK;
+    }
+
+    return que_Requeue (pTxDataQ->aQueues[uQueId], (TI_HANDLE)pPktCtrlBlk);
+}
+
+static TI_UINT32 txDataQ_QueSize (TTxDataQ *pTxDataQ, TI_UINT32 uQueId)
+{
+    if (pTxDataQ->bLockFree)
+    {
+        return ring_Size (pTxDataQ->aRings[uQueId]) + pTxDataQ->aHeldPktsNum[uQueId];
+    }
+
+    return que_Size (pTxDataQ->aQueues[uQueId]);
+}
@@ -48,6 +48,9 @@
 
 #define TX_SEND_PACE_TIMEOUT_MSEC   1
 
+/* Max Tx scheduler invocations per driver task run, so Rx and other clients are not starved by Tx */
+#define TX_DATA_CONTEXT_BUDGET      8
+
 /* Max number of packets in each queue */
 #define DATA_QUEUE_DEPTH_BE  60
 #define DATA_QUEUE_DEPTH_BK  10
@@ -60,6 +63,25 @@
     #error  Not enough TxCtrlBlks for all users !!
 #endif
 
+/* Compiled classifier - direct lookup structures rebuilt from the classifier table on every change */
+#define CLSFR_DSCP_MAP_SIZE     64   /* all 6-bit DSCP values */
+#define CLSFR_HASH_BITS         5
+#define CLSFR_HASH_SIZE         (1 << CLSFR_HASH_BITS) /* at least twice NUM_OF_CLSFR_TABLE_ENTRIES */
+#define CLSFR_HASH_MASK         (CLSFR_HASH_SIZE - 1)
+#define CLSFR_NO_MATCH          0xFF /* DSCP map value for a code point without an entry */
+
+#if (CLSFR_HASH_SIZE < 2 * NUM_OF_CLSFR_TABLE_ENTRIES)
+    #error  CLSFR_HASH_SIZE too small for the classifier table !!
+#endif
+
+typedef struct
+{
+	EClsfrType           eClsfrType;  /* The classifier type this copy was compiled for */
+	TI_UINT8             aDscpToDtag[CLSFR_DSCP_MAP_SIZE]; /* DSCP_CLSFR: D-tag per code point */
+	TI_UINT8             aHash[CLSFR_HASH_SIZE]; /* PORT_CLSFR / IPPORT_CLSFR: open addressing hash, index in aEntries + 1 (0 = empty) */
+	TClsfrTableEntry     aEntries[NUM_OF_CLSFR_TABLE_ENTRIES]; /* The keys of the hashed entries */
+} TClsfrCompiled;
+
 /* Tx packets handling statistics */
 typedef struct
 {
@@ -81,6 +103,9 @@ typedef struct
 	TI_HANDLE            hTWD;
 			             
 	TClsfrParams		 tClsfrParams;  /* The classifier sub-module parameters */
+	TClsfrCompiled       aClsfrCompiled[2]; /* Classifier lookup structures - the active copy and the one being rebuilt */
+	TClsfrCompiled      *pClsfrActive;  /* The copy used for classification (switched after rebuild) */
+	volatile TI_UINT32   uClsfrSeq;     /* Odd while a copy is rebuilt - a lock-free classification that saw it change is retried */
 
 	TI_BOOL              bDataPortEnable; /* Data port open or not */
     TI_UINT32            uContextId;  /* ID allocated to this module on registration to context module */
@@ -96,10 +121,24 @@ typedef struct
 	TI_BOOL				 aNetStackQueueStopped[MAX_NUM_OF_AC];/*indicate if the current queue was full and caused Tx network stack stop*/
 	TI_BOOL				 bStopNetStackTx;/*Flag to enable/disable Tx stop*/
 
+	/* Burst scheduler (per-AC deficit round robin) */
+	TI_BOOL              bBurstSched;  /* If TRUE, dequeue a batch per AC in one critical section (see txDataQ_RunBurstScheduler) */
+	TI_UINT32            uBurstMaxPkts; /* Max packets dequeued from one queue in one batch */
+	TI_UINT32            aBurstQuantum[MAX_NUM_OF_AC]; /* Bytes added to the queue's deficit in each round */
+	TI_UINT32            aBurstDeficit[MAX_NUM_OF_AC]; /* Bytes the queue may still send in current round */
+
+	/* Lock-free backend (SPSC ring per AC: producer is the network stack Tx, consumer is the driver task) */
+	TI_BOOL              bLockFree;    /* If TRUE, the rings are used instead of aQueues and the context lock isn't taken */
+	TI_HANDLE            aRings[MAX_NUM_OF_AC]; /* The Tx rings handles */
+	TI_UINT32            aRingWakeThresh[MAX_NUM_OF_AC]; /* Resume the network stack when ring occupancy drops to this level */
+	TTxCtrlBlk          *aHeldPkts[MAX_NUM_OF_AC][TX_BURST_MAX_PKTS_MAX]; /* Packets requeued by the consumer (stack, top is next) */
+	TI_UINT32            aHeldPktsNum[MAX_NUM_OF_AC]; /* Number of held packets per queue */
+
 	/* Counters */
 	TTxDataQueueDebugCnt aQueueCounters[MAX_NUM_OF_AC]; /* Save Tx statistics per Tx-queue. */
 	TI_UINT32			 uClsfrMismatchCount;
 	TI_UINT32			 uTxSendPaceTimeoutsCount;
+	TI_UINT32            aBurstSizeHist[MAX_NUM_OF_AC][TX_BURST_MAX_PKTS_MAX + 1]; /* Batch size histogram per queue */
 
 
 
@@ -109,5 +148,8 @@ typedef struct
 /* TIDs Mapping to Queues */
 static const TI_UINT32 aTidToQueueTable[MAX_NUM_OF_802_1d_TAGS] = {0, 1, 1, 0, 2, 2, 3, 3};
 
+/* Queues service order of the burst scheduler in each round (high priority first) */
+static const TI_UINT32 aBurstQueueOrder[MAX_NUM_OF_AC] = {QOS_AC_VO, QOS_AC_VI, QOS_AC_BE, QOS_AC_BK};
+
 
 #endif /* _TX_DATA_QUEUE_H_ */
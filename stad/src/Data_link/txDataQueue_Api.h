@@ -60,6 +60,8 @@ void      txDataQ_StopQueue (TI_HANDLE hTxDataQ, TI_UINT32 tidBitMap);
 void      txDataQ_UpdateBusyMap (TI_HANDLE hTxDataQ, TI_UINT32 tidBitMap);
 void      txDataQ_StopAll (TI_HANDLE hTxDataQ);
 void      txDataQ_WakeAll (TI_HANDLE hTxDataQ);
+TI_UINT32 txDataQ_SelectQueue (TI_HANDLE hTxDataQ, TI_UINT8 *pEthPkt, TI_UINT32 uPktLen, TI_UINT8 *pPacketDtag);
+TI_UINT32 txDataQ_TidToQueue (TI_UINT8 uTid);
 
 #ifdef TI_DBG
 void      txDataQ_PrintModuleParams    (TI_HANDLE hTxDataQ);
@@ -80,6 +82,7 @@ TI_STATUS txDataClsfr_GetClsfrType     (TI_HANDLE hTxDataQ, EClsfrType *pClsfrTy
 
 #ifdef TI_DBG
 void      txDataClsfr_PrintClsfrTable  (TI_HANDLE hTxDataQ);
+void      txDataClsfr_Benchmark        (TI_HANDLE hTxDataQ);
 #endif /* TI_DBG */
 
 
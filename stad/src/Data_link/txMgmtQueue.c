@@ -243,6 +243,8 @@ void txMgmtQ_Init (TStadHandlesList *pStadHandles)
                                                    txMgmtQ_QueuesNotEmpty,
                                                    (TI_HANDLE)pTxMgmtQ,
                                                    TI_TRUE,
+                                                   CONTEXT_PRIORITY_MEDIUM,
+                                                   CONTEXT_BUDGET_UNLIMITED,
                                                    "TX_MGMT",
                                                    sizeof("TX_MGMT"));
 }
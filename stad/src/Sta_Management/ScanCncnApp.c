@@ -209,6 +209,35 @@ TI_STATUS scanCncnApp_GetParam (TI_HANDLE hScanCncn, paramInfo_t *pParam)
                                              &pParam->paramLength, TI_TRUE);
         break;
 
+    case SCAN_CNCN_BSSID_LIST_GENERATION_PARAM:
+        /* retrieves the app scan result table generation, to check if it changed since the last read */
+        pParam->paramLength = sizeof(TI_UINT32);
+        pParam->content.uBssidListGeneration = scanResultTable_GetGeneration (pScanCncn->hScanResultTable);
+        break;
+
+    case SCAN_CNCN_BSSID_LIST_DELTA_PARAM:
+        {
+            TScanBssidListDelta *pDelta = &(pParam->content.tBssidListDelta);
+
+            pParam->paramLength = sizeof(TScanBssidListDelta);
+
+            /* no buffer - only retrieve the size to allocate for the changed entries and the generation */
+            if (NULL == pDelta->pBssidList)
+            {
+                pDelta->uGeneration = scanResultTable_GetGeneration (pScanCncn->hScanResultTable);
+                pDelta->uListSize = scanResultTable_CalculateBssidListDeltaSize (pScanCncn->hScanResultTable,
+                                                                                 pDelta->uSinceGeneration,
+                                                                                 TI_TRUE,
+                                                                                 &(pDelta->bFullList));
+                break;
+            }
+
+            /* retrieve the app scan result table entries changed since the given generation */
+            return scanResultTable_GetBssidListDelta (pScanCncn->hScanResultTable, pDelta->uSinceGeneration,
+                                                      pDelta->pBssidList, &(pDelta->uListSize), TI_TRUE,
+                                                      &(pDelta->bFullList), &(pDelta->uGeneration));
+        }
+
     default:
         return PARAM_NOT_SUPPORTED;
     }
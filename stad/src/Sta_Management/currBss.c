@@ -87,6 +87,7 @@
 #include "EvHandler.h"
 #include "DrvMainModules.h"
 #include "siteMgrApi.h"
+#include "mlmeApi.h"
 #include "roamingMngrTypes.h"
 
 /* Constants */
@@ -620,6 +621,45 @@ bssEntry_t *currBSS_getBssInfo(TI_HANDLE hCurrBSS)
 }
 
 
+/**
+*
+* currBSS_PublishStats
+*
+* \b Description: 
+*
+* Copy the current link state to the statistics page link section.
+* Called in the driver context within the page update.
+*
+* \b ARGS:
+*
+*  I   - hCurrBSS - Current BSS handle \n
+*  O   - pLink - statistics page link section \n
+*  
+* \b RETURNS:
+*
+*  None.
+*
+* \sa 
+*/
+void currBSS_PublishStats(TI_HANDLE hCurrBSS, TStatsPageLink *pLink)
+{
+    currBSS_t   *pCurrBSS = (currBSS_t *)hCurrBSS;
+
+    pLink->bConnected = (TI_UINT32)pCurrBSS->isConnected;
+    if (pCurrBSS->isConnected)
+    {
+        pLink->uBand    = (TI_UINT32)pCurrBSS->currAPInfo.band;
+        pLink->uChannel = pCurrBSS->currAPInfo.channel;
+        pLink->iRssi    = pCurrBSS->currAPInfo.RSSI;
+        MAC_COPY (pLink->aBssid, pCurrBSS->currAPInfo.BSSID);
+    }
+    else
+    {
+        os_memoryZero (pCurrBSS->hOs, pLink, sizeof(TStatsPageLink));
+    }
+}
+
+
 /**
 *
 * currBSS_probRespReceivedCallb
@@ -741,6 +781,65 @@ TI_STATUS currBSS_beaconReceivedCallb(TI_HANDLE hCurrBSS,
 }
 
 
+/**
+*
+* currBSS_beaconUnchangedCallb
+*
+* \b Description: 
+*
+* Callback function, provided to MLME module. Called instead of currBSS_beaconReceivedCallb
+* when the Beacon content is identical to the last Beacon received from the same BSSID
+* (TSF and TIM excluded), so its IEs weren't parsed.
+* Only the beacon time and buffer of the current AP are updated.
+* The current BSS type and BSSID are taken from the module's own connection info, 
+* so nothing is allocated or queried on this per-beacon path.
+*
+* \b ARGS:
+*
+*  I   - hCurrBSS - Current BSS handle \n
+*  
+* \b RETURNS:
+*
+*  TI_OK if the current AP was updated, TI_NOK if the Beacon has to be fully handled.
+*
+* \sa currBSS_beaconReceivedCallb
+*/
+TI_STATUS currBSS_beaconUnchangedCallb(TI_HANDLE hCurrBSS,
+                                       TRxAttr *pRxAttr,
+                                       TMacAddr *bssid,
+                                       mlmeFrameInfo_t *pFrameInfo,
+                                       TI_UINT8 *dataBuffer,
+                                       TI_UINT16 bufLength)
+{
+    currBSS_t           *pCurrBSS = (currBSS_t *)hCurrBSS;
+    ScanBssType_e       eFrameBssType;
+    TI_STATUS           status = TI_NOK;
+
+    eFrameBssType = ((pFrameInfo->content.iePacket.capabilities >> CAP_ESS_SHIFT) & CAP_ESS_MASK) ? BSS_INFRASTRUCTURE : BSS_INDEPENDENT;
+
+    if (pCurrBSS->isConnected && (pCurrBSS->type == eFrameBssType))
+    {
+        /* Beacons from other BSSIDs (IBSS merge) are always fully handled */
+        if (MAC_EQUAL(pCurrBSS->currAPInfo.BSSID, *bssid))
+        {
+            status = siteMgr_updateSiteBeaconTime(pCurrBSS->hSiteMgr, bssid, pFrameInfo);
+            if (status == TI_OK)
+            {
+                /* Save the IE part of the beacon buffer (the TIM may have changed) */
+                siteMgr_saveBeaconBuffer(pCurrBSS->hSiteMgr, bssid, (TI_UINT8 *)dataBuffer, bufLength);
+            }
+        }
+    }
+    else
+    {
+        /* not connected - nothing to update */
+        status = TI_OK;
+    }
+
+    return status;
+}
+
+
 /**
 *
 * currBSS_updateConnectedState
@@ -768,6 +867,9 @@ void currBSS_updateConnectedState(TI_HANDLE hCurrBSS, TI_BOOL isConnected, ScanB
     pCurrBSS->type = type;
     pCurrBSS->isConnected = isConnected;
 
+    /* The site entries are (re)initialized on connection changes, so fully parse the next beacons */
+    mlmeParser_InvalidateBeaconCache (pCurrBSS->hMlme);
+
     if (isConnected) 
     {
         /*** Store the info of current AP ***/
@@ -50,6 +50,7 @@
 #include "siteMgrApi.h"
 #include "roamingMngrTypes.h"
 #include "paramOut.h"
+#include "TI_StatsPage.h"
 
 /* Constants */
 
@@ -161,6 +162,7 @@ TI_STATUS currBSS_updateRoamingTriggers(TI_HANDLE hCurrBSS,
 void currBSS_SGconfigureBSSLoss(TI_HANDLE hCurrBSS,
                                         TI_UINT32 SGcompensationPercent , TI_BOOL bUseSGParams);
 bssEntry_t *currBSS_getBssInfo(TI_HANDLE hCurrBSS);
+void currBSS_PublishStats(TI_HANDLE hCurrBSS, TStatsPageLink *pLink);
 
 TI_STATUS currBSS_getRoamingParams(TI_HANDLE hCurrBSS,
                                    TI_UINT8 * aNumExpectedTbttForBSSLoss,
@@ -181,6 +183,13 @@ TI_STATUS currBSS_beaconReceivedCallb(TI_HANDLE hCurrBSS,
 										TI_UINT8 *dataBuffer,
                                         TI_UINT16 bufLength);
 
+TI_STATUS currBSS_beaconUnchangedCallb(TI_HANDLE hCurrBSS,
+                                       TRxAttr *pRxAttr,
+                                       TMacAddr *bssid,
+                                       mlmeFrameInfo_t *pFrameInfo,
+                                       TI_UINT8 *dataBuffer,
+                                       TI_UINT16 bufLength);
+
 void currBSS_restartRssiCounting(TI_HANDLE hCurrBSS);
 
 void currBSS_GetDefaultKeepAlivePeriod(TI_HANDLE hCurrBSS, TI_UINT8* uDefaultKeepAlivePeriod);
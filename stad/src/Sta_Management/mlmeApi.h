@@ -283,6 +283,7 @@ TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
                               TI_INT32 bodyDataLen,
                               mlmeIEParsingParams_t *params);
 TI_BOOL mlmeParser_ParseIeBuffer (TI_HANDLE hMlme, TI_UINT8 *pIeBuffer, TI_UINT32 length, TI_UINT8 desiredIeId, TI_UINT8 **pDesiredIe, TI_UINT8 *pMatchBuffer, TI_UINT32 matchBufferLen);
+TI_BOOL mlmeParser_GetIe (TI_HANDLE hMlme, TI_UINT8 ieId, TI_UINT8 **pIe);
 
 #ifdef XCC_MODULE_INCLUDED
 void mlmeParser_readXCCOui (TI_UINT8 *pData, 
@@ -293,6 +294,13 @@ void mlmeParser_readXCCOui (TI_UINT8 *pData,
 
 mlmeIEParsingParams_t *mlmeParser_getParseIEsBuffer(TI_HANDLE *hMlme);
 
+void mlmeParser_InvalidateBeaconCache (TI_HANDLE hMlme);
+
+#ifdef TI_DBG
+void mlmeParser_Benchmark (TI_HANDLE hMlme);
+void mlmeParser_PrintBeaconCacheStats (TI_HANDLE hMlme);
+#endif
+
 /* Association SM API */
 
 TI_HANDLE assoc_create(TI_HANDLE pOs);
@@ -89,6 +89,23 @@
 
 #define CHECK_PARSING_ERROR_CONDITION_PRINT 0
 
+/* 
+ * The frame info isn't cleared as a whole per frame (see mlmeParser_resetFrameInfo),
+ *   so clear an IE structure only when the IE is found, before reading it.
+ */
+#define MLME_PARSER_CLEAR_IE(pMlme, pIe)    os_memoryZero ((pMlme)->hOs, (void *)(pIe), sizeof(*(pIe)))
+
+#define IE_INDEX_IS_PRESENT(pIndex, id)     ((pIndex)->aPresent[(id) >> 5] & (1 << ((id) & 0x1F)))
+#define IE_INDEX_SET_PRESENT(pIndex, id)    ((pIndex)->aPresent[(id) >> 5] |= (1 << ((id) & 0x1F)))
+
+/* FNV-1a hash used for the beacons fingerprint */
+#define BEACON_FP_INIT                      2166136261UL
+#define BEACON_FP_ADD(uHash, uByte)         (uHash) = ((uHash) ^ (uByte)) * 16777619UL
+
+static void mlmeParser_resetFrameInfo (mlme_t *pHandle, mlmeIEParsingParams_t *pFrameInfo);
+static TI_STATUS mlmeParser_parseFrameIEs (TI_HANDLE hMlme, TI_UINT8 *pData, TI_INT32 bodyDataLen, mlmeIEParsingParams_t *params, TI_BOOL bPublishIndex);
+static TMlmeBeaconCacheEntry *mlmeParser_beaconCacheLookup (mlme_t *pHandle, TMacAddr *pBssid, TI_UINT8 *pIes, TI_INT32 iesLen, TI_BOOL *pHit);
+
 extern int WMEQosTagToACTable[MAX_NUM_OF_802_1d_TAGS];
 
 TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
@@ -101,7 +118,7 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
     dot11_eleHdr_t         *pEleHdr;
     dot11_mgmtFrame_t      *pMgmtFrame;
     dot11MgmtSubType_e     msgType;
-    paramInfo_t            *pParam;
+    paramInfo_t            *pParam = &pHandle->tParseCtx.tParam;
     TMacAddr               recvBssid;
     TMacAddr               recvSa;
     TI_UINT8               rsnIeIdx = 0;
@@ -111,14 +128,19 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
 	XCCv4IEs_t			   *pXCCIeParameter;
 #endif
     TI_BOOL				   ciscoIEPresent = TI_FALSE;
+    TMlmeBeaconCacheEntry  *pCacheEntry = NULL;
+    TI_BOOL                bCacheHit;
+#ifdef TI_DBG
+    TI_UINT32              uCacheStartUs = 0;
+#endif
 
     if ((hMlme == NULL) || (pBuffer == NULL))
     {
 		return TI_NOK;
     }
 
-    /* zero frame content */
-	os_memoryZero (pHandle->hOs, &(pHandle->tempFrameInfo), sizeof(mlmeIEParsingParams_t));
+    /* reset frame content (only the parts not overwritten by the parsing) */
+	mlmeParser_resetFrameInfo (pHandle, &(pHandle->tempFrameInfo));
 
     pMgmtFrame = (dot11_mgmtFrame_t*)RX_BUF_DATA(pBuffer);
 
@@ -130,12 +152,6 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
         return TI_NOK;
     }
 
-    pParam = (paramInfo_t *)os_memoryAlloc(pHandle->hOs, sizeof(paramInfo_t));
-    if (!pParam)
-    {
-        return TI_NOK;
-    }
-
     pHandle->tempFrameInfo.frame.subType = msgType;
 
     /* We have to ignore management frames from other BSSIDs (except beacons & probe responses) */
@@ -438,7 +454,7 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
             status = TI_NOK;
             goto mlme_recv_end;
         }
-        if (mlmeParser_parseIEs(hMlme, pData, bodyDataLen, &(pHandle->tempFrameInfo)) != TI_OK)
+        if (mlmeParser_parseFrameIEs(hMlme, pData, bodyDataLen, &(pHandle->tempFrameInfo), TI_TRUE) != TI_OK)
         {
             /* Error in parsing Probe response packet - exit */
             if ((pRxAttr->eScanTag > SCAN_RESULT_TAG_CURENT_BSS) && (pRxAttr->eScanTag != SCAN_RESULT_TAG_MEASUREMENT))
@@ -558,7 +574,42 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
 		pHandle->tempFrameInfo.band = pRxAttr->band;
 		pHandle->tempFrameInfo.rxChannel = pRxAttr->channel;
 
-        if (mlmeParser_parseIEs(hMlme, pData, bodyDataLen, &(pHandle->tempFrameInfo)) != TI_OK)
+        /* A current BSS beacon identical to the last one (TSF and TIM excluded) isn't parsed again */
+        if ((SCAN_RESULT_TAG_CURENT_BSS == pRxAttr->eScanTag) && 
+            (pHandle->tempFrameInfo.myBssid) && 
+            (pHandle->tBeaconCache.uMaxHits != 0))
+        {
+#ifdef TI_DBG
+            uCacheStartUs = os_timeStampUs (pHandle->hOs);
+#endif
+            pCacheEntry = mlmeParser_beaconCacheLookup (pHandle, &(pHandle->tempFrameInfo.bssid), pData, bodyDataLen, &bCacheHit);
+
+            if ((pCacheEntry != NULL) && bCacheHit)
+            {
+                if (currBSS_beaconUnchangedCallb (pHandle->hCurrBss, pRxAttr,
+                                                  &(pHandle->tempFrameInfo.bssid),
+                                                  &(pHandle->tempFrameInfo.frame),
+                                                  (TI_UINT8 *)pMgmtFrame->body+TIME_STAMP_LEN+4,
+                                                  RX_BUF_LEN(pBuffer)-WLAN_HDR_LEN-TIME_STAMP_LEN-4) == TI_OK)
+                {
+                    pHandle->BeaconsCounterPS++;
+
+                    /* Cached beacons have no channel switch IE */
+                    switchChannel_recvCmd(pHandle->hSwitchChannel, NULL, pRxAttr->channel);
+#ifdef TI_DBG
+                    pHandle->tBeaconCache.uHits++;
+                    pHandle->tBeaconCache.uHitUs += os_timeStampUs (pHandle->hOs) - uCacheStartUs;
+#endif
+                    status = TI_OK;
+                    goto mlme_recv_end;
+                }
+
+                /* The current BSS can't take the beacon as is (e.g. its site was removed) - handle it fully */
+                pCacheEntry->bValid = TI_FALSE;
+            }
+        }
+
+        if (mlmeParser_parseFrameIEs(hMlme, pData, bodyDataLen, &(pHandle->tempFrameInfo), TI_TRUE) != TI_OK)
         {
             /* Error in parsing Probe response packet - exit */
             if ((pRxAttr->eScanTag > SCAN_RESULT_TAG_CURENT_BSS) && (pRxAttr->eScanTag != SCAN_RESULT_TAG_MEASUREMENT))
@@ -623,6 +674,16 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
 			switchChannel_recvCmd(pHandle->hSwitchChannel, NULL, pRxAttr->channel);
 		}
 
+        /* The next identical beacons may skip the parsing (unless a channel switch is announced) */
+        if (pCacheEntry != NULL)
+        {
+            pCacheEntry->bValid = !pHandle->tempFrameInfo.recvChannelSwitchAnnoncIE;
+#ifdef TI_DBG
+            pHandle->tBeaconCache.uFullParses++;
+            pHandle->tBeaconCache.uFullParseUs += os_timeStampUs (pHandle->hOs) - uCacheStartUs;
+#endif
+        }
+
         break;
     case ATIM:
         if (!pHandle->tempFrameInfo.myBssid)
@@ -778,8 +839,8 @@ TI_STATUS mlmeParser_recv(TI_HANDLE hMlme, void *pBuffer, TRxAttr* pRxAttr)
     }
 
 mlme_recv_end:
-    /* release BUF */
-    os_memoryFree(pHandle->hOs, pParam, sizeof(paramInfo_t));
+    /* the IE index refers to the frame buffer, so invalidate it before releasing the BUF */
+    pHandle->tParseCtx.tIeIndex.pIeBuf = NULL;
 	RxBufFree(pHandle->hOs, pBuffer);
     return status;
 }
@@ -867,6 +928,8 @@ TI_STATUS mlmeParser_readERP(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen,
 
 TI_STATUS mlmeParser_readRates(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_RATES_t *pRates)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pRates);
+
     pRates->hdr[0] = *pData;
     pRates->hdr[1] = *(pData+1);
 
@@ -890,6 +953,8 @@ TI_STATUS mlmeParser_readRates(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen
 
 TI_STATUS mlmeParser_readSsid(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_SSID_t *pSsid)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pSsid);
+
     pSsid->hdr[0] = *pData;
     pSsid->hdr[1] = *(pData+1);
 
@@ -1000,6 +1065,8 @@ TI_STATUS mlmeParser_readIbssParams(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 da
 
 TI_STATUS mlmeParser_readTim(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_TIM_t *pTim)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pTim);
+
     pTim->hdr[0] = *pData;
     pTim->hdr[1] = *(pData+1);
 
@@ -1024,6 +1091,8 @@ TI_STATUS mlmeParser_readCountry(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT32 dataLe
 {
 	TI_INT32 i, j;
 
+    MLME_PARSER_CLEAR_IE(pMlme, countryIE);
+
     countryIE->hdr[0] = *pData;
     countryIE->hdr[1] = *(pData+1);
 
@@ -1062,6 +1131,8 @@ TI_STATUS mlmeParser_readWMEParams(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT32 data
 
 	/* Note:  This function actually reads either the WME-Params IE or the WME-Info IE! */
 
+    MLME_PARSER_CLEAR_IE(pMlme, pWMEParamIE);
+
     pWMEParamIE->hdr[0] = *pData;
     pWMEParamIE->hdr[1] = *(pData+1);
 
@@ -1140,6 +1211,8 @@ static TI_UINT32 mlmeParser_getWSCReadLen(TI_UINT8 *pData)
 
 static TI_STATUS mlmeParser_readWSCParams(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_WSC_t *pWSC_IE)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pWSC_IE);
+
 	pWSC_IE->hdr[0] = *pData;
 	pWSC_IE->hdr[1] = *(pData+1);
 
@@ -1211,6 +1284,8 @@ TI_STATUS mlmeParser_readHtCapabilitiesIE(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT
 
 TI_STATUS mlmeParser_readHtInformationIE(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, Tdot11HtInformationUnparse *pHtInformation)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pHtInformation);
+
     pHtInformation->tHdr[0] = *pData;
     pHtInformation->tHdr[1] = *(pData+1);
 
@@ -1234,6 +1309,8 @@ TI_STATUS mlmeParser_readHtInformationIE(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT3
 
 TI_STATUS mlmeParser_readChallange(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_CHALLENGE_t *pChallange)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pChallange);
+
     if (dataLen < 2)
     {
         return TI_NOK;
@@ -1262,6 +1339,8 @@ TI_STATUS mlmeParser_readChallange(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dat
 
 TI_STATUS mlmeParser_readRsnIe(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_RSN_t *pRsnIe)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, pRsnIe);
+
     pRsnIe->hdr[0] = *pData;
     pRsnIe->hdr[1] = *(pData+1);
     pData += 2;
@@ -1280,6 +1359,8 @@ TI_STATUS mlmeParser_readRsnIe(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLen
 
 TI_STATUS mlmeParser_readPowerConstraint(mlme_t *pMlme,TI_UINT8 *pData, TI_UINT32 dataLen, TI_UINT32 *pReadLen, dot11_POWER_CONSTRAINT_t *powerConstraintIE)
 {
+    MLME_PARSER_CLEAR_IE(pMlme, powerConstraintIE);
+
     powerConstraintIE->hdr[0] = *pData;
     powerConstraintIE->hdr[1] = *(pData+1);
 
@@ -1382,6 +1463,8 @@ TI_STATUS mlmeParser_readCellTP(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLe
 {
     TI_UINT8 XCC_OUI[] = XCC_OUI;
 
+    MLME_PARSER_CLEAR_IE(pMlme, cellTP);
+
     cellTP->hdr[0] = *pData++;
     cellTP->hdr[1] = *pData++;
 
@@ -1421,10 +1504,28 @@ TI_STATUS mlmeParser_readCellTP(mlme_t *pMlme, TI_UINT8 *pData, TI_UINT32 dataLe
          if ((x)) return TI_NOK;
 #endif
 
+/*
+ * Parse an IEs buffer that is not a frame handled by mlmeParser_recv (e.g. a scan table entry).
+ * Such buffers may be rewritten after parsing, so their IE index is not published.
+ */
 TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
 							  TI_UINT8 *pData,
 							  TI_INT32 bodyDataLen,
 							  mlmeIEParsingParams_t *params)
+{
+	return mlmeParser_parseFrameIEs (hMlme, pData, bodyDataLen, params, TI_FALSE);
+}
+
+/*
+ * Parse the IEs and record their offsets. The index is published for mlmeParser_GetIe and
+ *   mlmeParser_ParseIeBuffer only if bPublishIndex is set, i.e. for the frame being handled
+ *   by mlmeParser_recv, which invalidates it before releasing the frame.
+ */
+static TI_STATUS mlmeParser_parseFrameIEs(TI_HANDLE hMlme,
+							  TI_UINT8 *pData,
+							  TI_INT32 bodyDataLen,
+							  mlmeIEParsingParams_t *params,
+							  TI_BOOL bPublishIndex)
 {
     dot11_eleHdr_t 		*pEleHdr;
     TI_UINT32 			 readLen;
@@ -1433,6 +1534,9 @@ TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
     TI_UINT8 			 wpaIeOuiIe[4] = { 0x00, 0x50, 0xf2, 0x01};
 	beacon_probeRsp_t 	*frame = &(params->frame.content.iePacket);
 	mlme_t 				*pHandle = (mlme_t *)hMlme;
+	TMlmeIeIndex		*pIndex = &pHandle->tParseCtx.tIeIndex;
+	TI_UINT8			*pIeStart = pData;
+	TI_UINT8			 ieId;
 #ifdef XCC_MODULE_INCLUDED
 	TI_BOOL				allowCellTP = TI_TRUE;
 #endif
@@ -1443,10 +1547,25 @@ TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
 
 	params->recvChannelSwitchAnnoncIE = TI_FALSE;
 
+	/* Start a new IE index (valid only if the whole buffer is parsed) */
+	pIndex->pIeBuf  = NULL;
+	pIndex->uIeLen  = (bodyDataLen > 0) ? (TI_UINT32)bodyDataLen : 0;
+	pIndex->uNumIes = 0;
+	os_memoryZero (pHandle->hOs, pIndex->aPresent, sizeof(pIndex->aPresent));
+
 	while (bodyDataLen > 1)
 	{
 		pEleHdr = (dot11_eleHdr_t *)pData;
 
+		/* Record the first occurrence of each element ID */
+		ieId = (*pEleHdr)[0];
+		if (!IE_INDEX_IS_PRESENT(pIndex, ieId))
+		{
+			IE_INDEX_SET_PRESENT(pIndex, ieId);
+			pIndex->aOffset[ieId] = (TI_UINT16)(pData - pIeStart);
+		}
+		pIndex->uNumIes++;
+
 #if CHECK_PARSING_ERROR_CONDITION_PRINT
 		/* CHECK_PARSING_ERROR_CONDITION(((*pEleHdr)[1] > (bodyDataLen - 2)), ("MLME_PARSER: IE %d with length %d out of bounds %d\n", (*pEleHdr)[0], (*pEleHdr)[1], (bodyDataLen - 2)), TI_TRUE); */
 		if ((*pEleHdr)[1] > (bodyDataLen - 2))
@@ -1555,6 +1674,10 @@ TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
 					 */
 				}
 			}
+			else
+			{
+				readLen = (*pEleHdr)[1] + 2;
+			}
 			break;
 
 		/* read Quiet IE */
@@ -1684,6 +1807,10 @@ TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
 				status = mlmeParser_readCellTP(pHandle, pData, bodyDataLen, &readLen, frame->cellTP);
 				CHECK_PARSING_ERROR_CONDITION((status != TI_OK), ("MLME_PARSER: error reading Cell Transmit Power params.\n"),TI_TRUE);
 			}
+			else
+			{
+				readLen = (*pEleHdr)[1] + 2;
+			}
 			break;
 #endif
 
@@ -1707,6 +1834,16 @@ TI_STATUS mlmeParser_parseIEs(TI_HANDLE hMlme,
 		}
 #endif
 	}
+
+	if (bPublishIndex)
+	{
+		pIndex->pIeBuf = pIeStart;
+	}
+#ifdef TI_DBG
+	pHandle->tParseCtx.uFramesParsed++;
+	pHandle->tParseCtx.uIesIndexed += pIndex->uNumIes;
+#endif
+
 	return TI_OK;
 }
 
@@ -1716,6 +1853,89 @@ mlmeIEParsingParams_t *mlmeParser_getParseIEsBuffer(TI_HANDLE *hMlme)
 }
 
 
+/**
+*
+* mlmeParser_resetFrameInfo  - Prepare the frame info for parsing a new frame.
+*
+* \b Description:
+*
+* Instead of zeroing the whole frame info per frame, clear only the frame
+* structure (all IE pointers and lengths) and the per frame flags.
+* The IE structures are reachable only through the frame pointers, and each
+* one is cleared by its read function when the IE is found (MLME_PARSER_CLEAR_IE).
+*
+* \b ARGS:
+*
+*  I   - pHandle - MLME handle  \n
+*  I   - pFrameInfo - the frame info to reset
+*
+* \b RETURNS:
+*
+*  None.
+*
+* \sa
+*/
+static void mlmeParser_resetFrameInfo (mlme_t *pHandle, mlmeIEParsingParams_t *pFrameInfo)
+{
+	os_memoryZero (pHandle->hOs, &(pFrameInfo->frame), sizeof(mlmeFrameInfo_t));
+
+	pFrameInfo->rxChannel = 0;
+	pFrameInfo->band      = 0;
+	pFrameInfo->myBssid   = TI_FALSE;
+	pFrameInfo->myDst     = TI_FALSE;
+	pFrameInfo->mySa      = TI_FALSE;
+	pFrameInfo->recvChannelSwitchAnnoncIE = TI_FALSE;
+}
+
+
+/**
+*
+* mlmeParser_GetIe  - Get an IE of the frame currently handled.
+*
+* \b Description:
+*
+* Returns the first IE with the given element ID in the frame being handled,
+* using the IE offsets recorded while parsing it, without scanning the IEs.
+* Valid only for the beacon or probe response while it is being handled
+* (i.e. from the MLME result callbacks).
+*
+* \b ARGS:
+*
+*  I   - hMlme - MLME handle  \n
+*  I   - ieId - the desired IE ID
+*  O   - pIe - a pointer to the desired IE (element header included)
+*
+* \b RETURNS:
+*
+* TI_TRUE if the IE was found, TI_FALSE if not or if no frame is handled.
+*
+* \sa mlmeParser_ParseIeBuffer
+*/
+TI_BOOL mlmeParser_GetIe (TI_HANDLE hMlme, TI_UINT8 ieId, TI_UINT8 **pIe)
+{
+    mlme_t       *pMlme = (mlme_t *)hMlme;
+    TMlmeIeIndex *pIndex = &pMlme->tParseCtx.tIeIndex;
+    TI_UINT8     *pCurIe;
+
+    *pIe = NULL;
+
+    if ((pIndex->pIeBuf == NULL) || !IE_INDEX_IS_PRESENT(pIndex, ieId))
+    {
+        return TI_FALSE;
+    }
+
+    /* The parsing doesn't reject a truncated last IE, so verify the IE is within the buffer */
+    pCurIe = pIndex->pIeBuf + pIndex->aOffset[ieId];
+    if ((TI_UINT32)pIndex->aOffset[ieId] + pCurIe[1] + 2 > pIndex->uIeLen)
+    {
+        return TI_FALSE;
+    }
+
+    *pIe = pCurIe;
+    return TI_TRUE;
+}
+
+
 /**
 *
 * parseIeBuffer  - Parse a required information element.
@@ -1763,6 +1983,31 @@ TI_BOOL mlmeParser_ParseIeBuffer (TI_HANDLE hMlme, TI_UINT8 *pIeBuffer, TI_UINT3
 
     pCurIe = pIeBuffer;
 
+    /* If this is the frame currently handled, use its IE index */
+    if ((pIeBuffer == pMlme->tParseCtx.tIeIndex.pIeBuf) && (length == pMlme->tParseCtx.tIeIndex.uIeLen))
+    {
+        TMlmeIeIndex *pIndex = &pMlme->tParseCtx.tIeIndex;
+
+#ifdef TI_DBG
+        pMlme->tParseCtx.uIndexLookups++;
+#endif
+        if (!IE_INDEX_IS_PRESENT(pIndex, desiredIeId))
+        {
+            return TI_FALSE;
+        }
+#ifdef TI_DBG
+        pMlme->tParseCtx.uIndexHits++;
+#endif
+
+        /* Without a matching buffer the first occurrence is the answer, else search from it */
+        if ((matchBufferLen == 0) || (pMatchBuffer == NULL))
+        {
+            return mlmeParser_GetIe (hMlme, desiredIeId, (pDesiredIe != NULL) ? pDesiredIe : &pCurIe);
+        }
+        pCurIe += pIndex->aOffset[desiredIeId];
+        length -= pIndex->aOffset[desiredIeId];
+    }
+
     while (length>0)
     {
         eleHdr = (dot11_eleHdr_t*)pCurIe;
@@ -1793,3 +2038,418 @@ TI_BOOL mlmeParser_ParseIeBuffer (TI_HANDLE hMlme, TI_UINT8 *pIeBuffer, TI_UINT3
 }
 
 
+
+
+/**
+*
+* mlmeParser_beaconCacheLookup  - Look up a beacon in the beacon fingerprint cache
+*
+* \b Description:
+*
+* Computes the beacon fingerprint - a hash of the fixed fields that follow the TSF 
+* and of the IEs, with the TIM IE content excluded (but its DTIM period).
+* Then compares the fingerprints with the cache entry (taken over if the
+* BSSID differs, i.e. the current BSS changed). On a miss, the entry is updated with the new fingerprint but is 
+* valid only after the beacon is fully handled.
+*
+* \b ARGS:
+*
+*  I   - pHandle - MLME handle
+*  I   - pBssid - The beacon BSSID
+*  I   - pIes - The beacon IEs (preceded by the beacon interval and capabilities)
+*  I   - iesLen - The IEs length
+*  O   - pHit - TI_TRUE if the beacon is unchanged since the last handled beacon
+*
+* \b RETURNS:
+*
+*  The cache entry, NULL if the IEs are malformed (the beacon isn't cached).
+*
+* \sa
+*/
+static TMlmeBeaconCacheEntry *mlmeParser_beaconCacheLookup (mlme_t *pHandle, TMacAddr *pBssid, TI_UINT8 *pIes, TI_INT32 iesLen, TI_BOOL *pHit)
+{
+    TMlmeBeaconCache      *pCache = &pHandle->tBeaconCache;
+    TMlmeBeaconCacheEntry *pEntry = &pCache->tEntry;
+    TI_UINT8              *pFixed = pIes - 4;
+    TI_UINT32              uHash = BEACON_FP_INIT;
+    TI_UINT32              uLen = 4;
+    TI_UINT32              uIeLen, i;
+
+    *pHit = TI_FALSE;
+
+    /* beacon interval and capabilities */
+    for (i = 0; i < 4; i++)
+    {
+        BEACON_FP_ADD(uHash, pFixed[i]);
+    }
+
+    while (iesLen >= 2)
+    {
+        uIeLen = pIes[1];
+        if ((TI_INT32)(uIeLen + 2) > iesLen)
+        {
+            return NULL;
+        }
+
+        if (pIes[0] == TIM_IE_ID)
+        {
+            /* the DTIM count and the virtual bitmap change every beacon - only the DTIM period counts */
+            BEACON_FP_ADD(uHash, pIes[0]);
+            if (uIeLen >= 2)
+            {
+                BEACON_FP_ADD(uHash, pIes[3]);
+            }
+        }
+        else
+        {
+            for (i = 0; i < uIeLen + 2; i++)
+            {
+                BEACON_FP_ADD(uHash, pIes[i]);
+            }
+            uLen += uIeLen + 2;
+        }
+
+        pIes   += uIeLen + 2;
+        iesLen -= uIeLen + 2;
+    }
+
+#ifdef TI_DBG
+    pCache->uLookups++;
+#endif
+
+    if (!MAC_EQUAL (pEntry->tBssid, *pBssid))
+    {
+        /* new current BSS - take over the entry */
+        MAC_COPY (pEntry->tBssid, *pBssid);
+        pEntry->bValid = TI_FALSE;
+    }
+    else if (pEntry->bValid && (pEntry->uFingerprint == uHash) && (pEntry->uBodyLen == uLen))
+    {
+        /* force a full parse once in a while */
+        if (pEntry->uHits < pCache->uMaxHits)
+        {
+            pEntry->uHits++;
+            *pHit = TI_TRUE;
+            return pEntry;
+        }
+    }
+#ifdef TI_DBG
+    else if (pEntry->bValid)
+    {
+        pCache->uChanged++;
+    }
+#endif
+
+    pEntry->uFingerprint = uHash;
+    pEntry->uBodyLen = uLen;
+    pEntry->uHits = 0;
+    pEntry->bValid = TI_FALSE;
+
+    return pEntry;
+}
+
+
+/**
+*
+* mlmeParser_InvalidateBeaconCache  - Invalidate the beacon fingerprint cache
+*
+* \b Description:
+*
+* The next beacon of the current BSS is fully parsed. 
+* Called when the current BSS changes, as the site information is then reinitialized.
+*
+* \b ARGS:
+*
+*  I   - hMlme - MLME handle
+*
+* \b RETURNS:
+*
+*  None.
+*
+* \sa
+*/
+void mlmeParser_InvalidateBeaconCache (TI_HANDLE hMlme)
+{
+    mlme_t    *pHandle = (mlme_t *)hMlme;
+
+    pHandle->tBeaconCache.tEntry.bValid = TI_FALSE;
+}
+
+
+#ifdef TI_DBG
+
+#define MLME_PARSER_BENCH_ITERATIONS    1000
+
+/* A beacon of the benchmark corpus (IEs only, from the SSID IE on) */
+typedef struct
+{
+    TI_UINT8        uChannel;
+    const TI_UINT8  *pIes;
+    TI_UINT32       uLen;
+} TMlmeBenchBeacon;
+
+/* WPA2-PSK home AP, channel 6, HT */
+static const TI_UINT8 aBenchBeaconHome[] =
+{
+    0x00, 0x08, 'H', 'o', 'm', 'e', 'N', 'e', 't', '1',
+    0x01, 0x08, 0x82, 0x84, 0x8b, 0x96, 0x0c, 0x12, 0x18, 0x24,
+    0x03, 0x01, 0x06,
+    0x05, 0x04, 0x00, 0x03, 0x00, 0x00,
+    0x07, 0x06, 'U', 'S', ' ', 0x01, 0x0b, 0x1e,
+    0x2a, 0x01, 0x04,
+    0x32, 0x04, 0x30, 0x48, 0x60, 0x6c,
+    0x30, 0x14, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04,
+                0x01, 0x00, 0x00, 0x0f, 0xac, 0x02, 0x0c, 0x00,
+    0x2d, 0x1a, 0xef, 0x11, 0x1b, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3d, 0x16, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7f, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+    0xdd, 0x18, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x01, 0x80, 0x00, 0x03, 0xa4, 0x00, 0x00,
+                0x27, 0xa4, 0x00, 0x00, 0x42, 0x43, 0x5e, 0x00, 0x62, 0x32, 0x2f, 0x00,
+    0xdd, 0x09, 0x00, 0x10, 0x18, 0x02, 0x00, 0x00, 0x1c, 0x00, 0x00
+};
+
+/* Open hotspot with WPS and several vendor IEs, channel 1 */
+static const TI_UINT8 aBenchBeaconHotspot[] =
+{
+    0x00, 0x10, 'C', 'o', 'f', 'f', 'e', 'e', 'S', 'h', 'o', 'p', '_', 'G', 'u', 'e', 's', 't',
+    0x01, 0x04, 0x82, 0x84, 0x8b, 0x96,
+    0x03, 0x01, 0x01,
+    0x05, 0x06, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x2a, 0x01, 0x00,
+    0x32, 0x08, 0x0c, 0x12, 0x18, 0x24, 0x30, 0x48, 0x60, 0x6c,
+    0x2d, 0x1a, 0x2c, 0x01, 0x1b, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3d, 0x16, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xdd, 0x0e, 0x00, 0x50, 0xf2, 0x04, 0x10, 0x4a, 0x00, 0x01, 0x10, 0x10, 0x44, 0x00, 0x01, 0x02,
+    0xdd, 0x18, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x01, 0x00, 0x00, 0x03, 0xa4, 0x00, 0x00,
+                0x27, 0xa4, 0x00, 0x00, 0x42, 0x43, 0x5e, 0x00, 0x62, 0x32, 0x2f, 0x00,
+    0xdd, 0x07, 0x00, 0x0c, 0x43, 0x04, 0x00, 0x00, 0x00,
+    0xdd, 0x06, 0x00, 0xe0, 0x4c, 0x02, 0x01, 0x10
+};
+
+/* Hidden SSID enterprise AP (WPA and WPA2) with Cisco IEs, channel 11 */
+static const TI_UINT8 aBenchBeaconEnterprise[] =
+{
+    0x00, 0x00,
+    0x01, 0x08, 0x82, 0x84, 0x8b, 0x96, 0x0c, 0x12, 0x18, 0x24,
+    0x03, 0x01, 0x0b,
+    0x05, 0x04, 0x00, 0x01, 0x00, 0x00,
+    0x07, 0x06, 'U', 'S', ' ', 0x01, 0x0b, 0x14,
+    0x0b, 0x05, 0x02, 0x00, 0x0f, 0x12, 0x7a,
+    0x2a, 0x01, 0x00,
+    0x32, 0x04, 0x30, 0x48, 0x60, 0x6c,
+    0x30, 0x14, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04,
+                0x01, 0x00, 0x00, 0x0f, 0xac, 0x01, 0x28, 0x00,
+    0xdd, 0x16, 0x00, 0x50, 0xf2, 0x01, 0x01, 0x00, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x00,
+                0x00, 0x50, 0xf2, 0x02, 0x01, 0x00, 0x00, 0x50, 0xf2, 0x01,
+    0xdd, 0x18, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x01, 0x81, 0x00, 0x03, 0xa4, 0x00, 0x00,
+                0x27, 0xa4, 0x00, 0x00, 0x42, 0x43, 0x5e, 0x00, 0x62, 0x32, 0x2f, 0x00,
+    0xdd, 0x06, 0x00, 0x40, 0x96, 0x01, 0x01, 0x00,
+    0xdd, 0x05, 0x00, 0x40, 0x96, 0x03, 0x04,
+    0xdd, 0x05, 0x00, 0x40, 0x96, 0x14, 0x01
+};
+
+static const TMlmeBenchBeacon aBenchCorpus[] =
+{
+    { 6,  aBenchBeaconHome,       sizeof(aBenchBeaconHome) },
+    { 1,  aBenchBeaconHotspot,    sizeof(aBenchBeaconHotspot) },
+    { 11, aBenchBeaconEnterprise, sizeof(aBenchBeaconEnterprise) }
+};
+
+#define MLME_PARSER_BENCH_BEACONS       (sizeof(aBenchCorpus) / sizeof(TMlmeBenchBeacon))
+
+
+/**
+*
+* mlmeParser_BenchLookups  - The IE lookups done by the benchmark per beacon
+*
+* \b Description:
+*
+* Look up the RSN, HT information and WME IEs, as the consumers of a beacon do.
+*
+* \b RETURNS:
+*
+* The number of IEs found.
+*
+* \sa mlmeParser_Benchmark
+*/
+static TI_UINT32 mlmeParser_BenchLookups (mlme_t *pHandle, TI_UINT8 *pIes, TI_UINT32 uLen)
+{
+    TI_UINT8  aWmeOui[] = { 0x00, 0x50, 0xf2, dot11_WME_OUI_TYPE };
+    TI_UINT8 *pIe;
+    TI_UINT32 uFound = 0;
+
+    uFound += mlmeParser_ParseIeBuffer (pHandle, pIes, uLen, RSN_IE_ID, &pIe, NULL, 0);
+    uFound += mlmeParser_ParseIeBuffer (pHandle, pIes, uLen, HT_INFORMATION_IE_ID, &pIe, NULL, 0);
+    uFound += mlmeParser_ParseIeBuffer (pHandle, pIes, uLen, WPA_IE_ID, &pIe, aWmeOui, sizeof(aWmeOui));
+
+    return uFound;
+}
+
+
+/**
+*
+* mlmeParser_Benchmark  - Replay a beacon corpus through the parser
+*
+* \b Description:
+*
+* Parses the corpus beacons MLME_PARSER_BENCH_ITERATIONS times in two ways:
+*   Legacy - allocate a parameters block and clear the whole frame info per beacon,
+*            and look up IEs by scanning the IEs buffer.
+*   Pooled - reset the frame info only and look up IEs in the IE index.
+* Uses a private frame info, so the frames handling isn't affected.
+*
+* \b ARGS:
+*
+*  I   - hMlme - MLME handle
+*
+* \b RETURNS:
+*
+*  None.
+*
+* \sa
+*/
+void mlmeParser_Benchmark (TI_HANDLE hMlme)
+{
+    mlme_t                *pHandle = (mlme_t *)hMlme;
+    mlmeIEParsingParams_t *pFrameInfo;
+    paramInfo_t           *pParam;
+    TI_UINT8              *pIes;
+    TI_UINT32              uLen, uBeacon, i;
+    TI_UINT32              uStartUs, uLegacyUs, uPooledUs;
+    TI_UINT32              uLegacyFound = 0, uPooledFound = 0, uErrors = 0;
+    TI_UINT32              uFrames = MLME_PARSER_BENCH_ITERATIONS * MLME_PARSER_BENCH_BEACONS;
+
+    pFrameInfo = os_memoryAlloc (pHandle->hOs, sizeof(mlmeIEParsingParams_t));
+    if (pFrameInfo == NULL)
+    {
+        WLAN_OS_REPORT(("mlmeParser_Benchmark: memory allocation failed\n"));
+        return;
+    }
+    os_memoryZero (pHandle->hOs, pFrameInfo, sizeof(mlmeIEParsingParams_t));
+
+    /* Legacy: per beacon allocation, full frame info clear and IE scans */
+    uStartUs = os_timeStampUs (pHandle->hOs);
+    for (i = 0; i < MLME_PARSER_BENCH_ITERATIONS; i++)
+    {
+        for (uBeacon = 0; uBeacon < MLME_PARSER_BENCH_BEACONS; uBeacon++)
+        {
+            pIes = (TI_UINT8 *)aBenchCorpus[uBeacon].pIes;
+            uLen = aBenchCorpus[uBeacon].uLen;
+
+            pParam = (paramInfo_t *)os_memoryAlloc (pHandle->hOs, sizeof(paramInfo_t));
+            if (pParam == NULL)
+            {
+                uErrors++;
+                continue;
+            }
+            os_memoryZero (pHandle->hOs, pFrameInfo, sizeof(mlmeIEParsingParams_t));
+            pFrameInfo->frame.subType = BEACON;
+            pFrameInfo->band = RADIO_BAND_2_4_GHZ;
+            pFrameInfo->rxChannel = aBenchCorpus[uBeacon].uChannel;
+
+            if (mlmeParser_parseIEs (hMlme, pIes, uLen, pFrameInfo) != TI_OK)
+            {
+                uErrors++;
+            }
+            uLegacyFound += mlmeParser_BenchLookups (pHandle, pIes, uLen);
+
+            os_memoryFree (pHandle->hOs, pParam, sizeof(paramInfo_t));
+        }
+    }
+    uLegacyUs = os_timeStampUs (pHandle->hOs) - uStartUs;
+
+    /* Pooled: frame info reset and IE index lookups */
+    uStartUs = os_timeStampUs (pHandle->hOs);
+    for (i = 0; i < MLME_PARSER_BENCH_ITERATIONS; i++)
+    {
+        for (uBeacon = 0; uBeacon < MLME_PARSER_BENCH_BEACONS; uBeacon++)
+        {
+            pIes = (TI_UINT8 *)aBenchCorpus[uBeacon].pIes;
+            uLen = aBenchCorpus[uBeacon].uLen;
+
+            mlmeParser_resetFrameInfo (pHandle, pFrameInfo);
+            pFrameInfo->frame.subType = BEACON;
+            pFrameInfo->band = RADIO_BAND_2_4_GHZ;
+            pFrameInfo->rxChannel = aBenchCorpus[uBeacon].uChannel;
+
+            if (mlmeParser_parseFrameIEs (hMlme, pIes, uLen, pFrameInfo, TI_TRUE) != TI_OK)
+            {
+                uErrors++;
+            }
+            uPooledFound += mlmeParser_BenchLookups (pHandle, pIes, uLen);
+        }
+    }
+    uPooledUs = os_timeStampUs (pHandle->hOs) - uStartUs;
+
+    pHandle->tParseCtx.tIeIndex.pIeBuf = NULL;
+    os_memoryFree (pHandle->hOs, pFrameInfo, sizeof(mlmeIEParsingParams_t));
+
+    WLAN_OS_REPORT(("MLME parser benchmark: %d beacons x %d iterations\n", MLME_PARSER_BENCH_BEACONS, MLME_PARSER_BENCH_ITERATIONS));
+    WLAN_OS_REPORT(("Legacy (alloc, full clear, IE scan) : %d ns/beacon, %d IEs found\n", (uLegacyUs * 1000) / uFrames, uLegacyFound));
+    WLAN_OS_REPORT(("Pooled (reset, IE index)            : %d ns/beacon, %d IEs found\n", (uPooledUs * 1000) / uFrames, uPooledFound));
+    WLAN_OS_REPORT(("Cleared per beacon: %d bytes (legacy), %d bytes + read IEs (pooled)\n", sizeof(mlmeIEParsingParams_t), sizeof(mlmeFrameInfo_t)));
+    WLAN_OS_REPORT(("Errors: %d\n", uErrors));
+    WLAN_OS_REPORT(("Parser counters: frames %d, IEs indexed %d, index lookups %d, index hits %d\n", 
+                    pHandle->tParseCtx.uFramesParsed, pHandle->tParseCtx.uIesIndexed,
+                    pHandle->tParseCtx.uIndexLookups, pHandle->tParseCtx.uIndexHits));
+}
+
+
+/**
+*
+* mlmeParser_PrintBeaconCacheStats  - Print the beacon fingerprint cache statistics
+*
+* \b Description:
+*
+* Prints the hit ratio and the parsing time saved by the beacon fingerprint cache.
+* The saved time is estimated by the average time of a fully handled current BSS beacon.
+*
+* \b ARGS:
+*
+*  I   - hMlme - MLME handle
+*
+* \b RETURNS:
+*
+*  None.
+*
+* \sa
+*/
+void mlmeParser_PrintBeaconCacheStats (TI_HANDLE hMlme)
+{
+    mlme_t           *pHandle = (mlme_t *)hMlme;
+    TMlmeBeaconCache *pCache = &pHandle->tBeaconCache;
+    TMlmeBeaconCacheEntry *pEntry = &pCache->tEntry;
+    TI_UINT32         uFullAvgUs = 0, uHitAvgUs = 0, uSavedUs = 0;
+
+    if (pCache->uFullParses != 0)
+    {
+        uFullAvgUs = pCache->uFullParseUs / pCache->uFullParses;
+    }
+    if (pCache->uHits != 0)
+    {
+        uHitAvgUs = pCache->uHitUs / pCache->uHits;
+    }
+    if (pCache->uHits * uFullAvgUs > pCache->uHitUs)
+    {
+        uSavedUs = pCache->uHits * uFullAvgUs - pCache->uHitUs;
+    }
+
+    WLAN_OS_REPORT(("------------------ Beacon fingerprint cache ------------------\n"));
+    WLAN_OS_REPORT(("Max hits before full parse = %d %s\n", pCache->uMaxHits, (pCache->uMaxHits == 0) ? "(disabled)" : ""));
+    WLAN_OS_REPORT(("Lookups = %d, Hits = %d (%d%%), Changed = %d\n", 
+                    pCache->uLookups, pCache->uHits, 
+                    (pCache->uLookups != 0) ? (pCache->uHits * 100) / pCache->uLookups : 0,
+                    pCache->uChanged));
+    WLAN_OS_REPORT(("Full parse: %d beacons, avg %d us. Hit: avg %d us\n", pCache->uFullParses, uFullAvgUs, uHitAvgUs));
+    WLAN_OS_REPORT(("Estimated parse time saved = %d us\n", uSavedUs));
+    WLAN_OS_REPORT(("Entry: BSSID %02x:%02x:%02x:%02x:%02x:%02x, valid %d, fingerprint 0x%08x, len %d, hits %d\n",
+                    pEntry->tBssid[0], pEntry->tBssid[1], pEntry->tBssid[2],
+                    pEntry->tBssid[3], pEntry->tBssid[4], pEntry->tBssid[5],
+                    pEntry->bValid, pEntry->uFingerprint, pEntry->uBodyLen, pEntry->uHits));
+}
+
+#endif /* TI_DBG */
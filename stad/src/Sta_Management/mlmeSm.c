@@ -266,6 +266,7 @@ void mlme_SetDefaults (TI_HANDLE hMlmeSm, TMlmeInitParams *pMlmeInitParams)
 
     /* set default values */
     pMlme->bParseBeaconWSC = pMlmeInitParams->parseWSCInBeacons;
+    pMlme->tBeaconCache.uMaxHits = pMlmeInitParams->uBeaconCacheMaxHits;
 }
 
 TI_STATUS mlme_setParam(TI_HANDLE           hMlmeSm,
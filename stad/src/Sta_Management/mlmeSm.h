@@ -83,8 +83,68 @@ typedef enum
 
 
 
+/* IE offset index size - one entry per element ID */
+#define MLME_IE_INDEX_SIZE              256
+#define MLME_IE_INDEX_NOT_PRESENT       0xFFFF
+
 /* Typedefs */
 
+/* 
+ * Offsets of the IEs of the frame being parsed, recorded in the single parsing pass.
+ * Published only for the frame handled by mlmeParser_recv, and valid only while it is
+ *   handled (pIeBuf is NULL otherwise).
+ */
+typedef struct
+{
+    TI_UINT8            *pIeBuf;                            /* The IEs buffer the index refers to */
+    TI_UINT32           uIeLen;                             /* The IEs buffer length */
+    TI_UINT32           aPresent[MLME_IE_INDEX_SIZE / 32];  /* Bitmap of the element IDs found */
+    TI_UINT16           aOffset[MLME_IE_INDEX_SIZE];        /* First occurrence offset per element ID */
+    TI_UINT32           uNumIes;                            /* Number of IEs in the buffer */
+} TMlmeIeIndex;
+
+/* Per-module frame parse context, preallocated so the Rx path doesn't allocate per frame */
+typedef struct
+{
+    paramInfo_t         tParam;         /* Parameters block for ctrlData and regDomain accesses */
+    TMlmeIeIndex        tIeIndex;       /* IE offsets of the current frame */
+#ifdef TI_DBG
+    TI_UINT32           uFramesParsed;  /* Frames with IEs parsed */
+    TI_UINT32           uIesIndexed;    /* IEs recorded in the index */
+    TI_UINT32           uIndexLookups;  /* IE lookups served by the index */
+    TI_UINT32           uIndexHits;     /* Index lookups that found the IE */
+#endif
+} TMlmeParseCtx;
+
+/* Fingerprint of the last fully parsed beacon of a BSSID */
+typedef struct
+{
+    TMacAddr            tBssid;
+    TI_UINT32           uFingerprint;   /* Hash of the beacon body, TSF and TIM excluded */
+    TI_UINT32           uBodyLen;       /* Beacon body length, TIM excluded */
+    TI_UINT32           uHits;          /* Hits since the last full parse */
+    TI_BOOL             bValid;
+} TMlmeBeaconCacheEntry;
+
+/* 
+ * Beacons of the current BSS that match its fingerprint skip the IEs parsing and the
+ *   site update - only the TSF and the beacon buffer (TIM) are updated.
+ * Only the current BSS beacons are cached, so a single entry is kept.
+ */
+typedef struct
+{
+    TMlmeBeaconCacheEntry tEntry;       /* The current BSS entry (taken over by a new BSSID) */
+    TI_UINT32           uMaxHits;       /* Hits allowed before a full parse is forced (0 = cache disabled) */
+#ifdef TI_DBG
+    TI_UINT32           uLookups;       /* Beacons looked up in the cache */
+    TI_UINT32           uHits;          /* Beacons handled without parsing */
+    TI_UINT32           uChanged;       /* Beacons whose content changed since the last parse */
+    TI_UINT32           uFullParses;    /* Current BSS beacons fully parsed */
+    TI_UINT32           uFullParseUs;   /* Time spent on the fully parsed beacons */
+    TI_UINT32           uHitUs;         /* Time spent on the cache hits */
+#endif
+} TMlmeBeaconCache;
+
 typedef struct
 {
     mgmtStatus_e mgmtStatus;
@@ -105,6 +165,12 @@ typedef struct
 
     /* temporary frame info */
     mlmeIEParsingParams_t tempFrameInfo;
+
+    /* frame parse context */
+    TMlmeParseCtx       tParseCtx;
+
+    /* beacon fingerprint cache */
+    TMlmeBeaconCache    tBeaconCache;
     
     /* debug info - start */
     TI_UINT32           debug_lastProbeRspTSFTime;
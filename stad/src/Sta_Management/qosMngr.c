@@ -406,6 +406,7 @@ TI_STATUS qosMngr_SetDefaults (TI_HANDLE hQosMngr, QosMngrInitParams_t *pQosMngr
         pQosMngr->aBaPolicy[uTid] = pQosMngrInitParams->aBaPolicy[uTid];
         pQosMngr->aBaInactivityTimeout[uTid] = pQosMngrInitParams->aBaInactivityTimeout[uTid];
     }
+    pQosMngr->uBaRxWinSize = pQosMngrInitParams->uBaRxWinSize;
 
     
 
@@ -710,7 +711,7 @@ void qosMngr_SetBaPolicies(TI_HANDLE hQosMngr)
                                       uTidIndex,
                                       TI_TRUE,
                                       param.content.ctrlDataCurrentBSSID,
-                                      RX_QUEUE_WIN_SIZE);
+                                      pQosMngr->uBaRxWinSize);
             }
         }
     }
@@ -185,6 +185,7 @@ typedef struct
     /* 802.11n BA session */
     TI_UINT8               aBaPolicy[MAX_NUM_OF_802_1d_TAGS];
     TI_UINT16              aBaInactivityTimeout[MAX_NUM_OF_802_1d_TAGS];
+    TI_UINT16              uBaRxWinSize;
 	TI_BOOL				bEnableBurstMode;
 } qosMngr_t;
 
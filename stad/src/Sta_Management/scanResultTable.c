@@ -48,6 +48,18 @@
 
 #define TABLE_ENTRIES_NUMBER    80
 
+/* (BSSID, SSID) hash index - open addressing with linear probing, kept at most about a third full */
+#define TABLE_HASH_SIZE         256 /* must be a power of 2 */
+#define TABLE_HASH_MASK         (TABLE_HASH_SIZE - 1)
+#define TABLE_HASH_EMPTY        0   /* a used slot holds the table index + 1 */
+
+#if (TABLE_HASH_SIZE < 2 * TABLE_ENTRIES_NUMBER) || (TABLE_ENTRIES_NUMBER > 255)
+#error "TABLE_HASH_SIZE must be at least twice the table size, and table indexes must fit a TI_UINT8 slot"
+#endif
+
+/* generation numbers wrap around, so compare them by signed distance */
+#define GENERATION_AFTER(uGen1, uGen2)                  ((TI_INT32)((uGen1) - (uGen2)) > 0)
+
 #define UPDATE_BSSID(pSite, pFrame)                     MAC_COPY((pSite)->bssid, *((pFrame)->bssId))
 #define UPDATE_BAND(pSite, pFrame)                      (pSite)->eBand = (pFrame)->band
 #define UPDATE_BEACON_INTERVAL(pSite, pFrame)           pSite->beaconInterval = (pFrame)->parsedIEs->content.iePacket.beaconInerval
@@ -143,6 +155,10 @@ typedef struct
     TI_UINT32       uCurrentSiteNumber;     /**< number of sites currently in the table */
     TI_UINT32       uIterator;              /**< table iterator used for getFirst / getNext */
     TI_BOOL         bStable;                /**< table status (updating / stable) */
+    TI_UINT8        aHash[ TABLE_HASH_SIZE ];   /**< (BSSID, SSID) hash index into the site table */
+    TI_UINT32       uGeneration;            /**< incremented on every table change */
+    TI_UINT32       uClearGeneration;       /**< generation at which the table was last cleared */
+    TI_UINT32       aEntryGeneration[ TABLE_ENTRIES_NUMBER ]; /**< generation of each entry's last change */
 } TScanResultTable;
 
 static TSiteEntry  *scanResultTbale_AllocateNewEntry (TI_HANDLE hScanResultTable);
@@ -150,6 +166,16 @@ static void         scanResultTable_UpdateSiteData (TI_HANDLE hScanResultTable,
 static void         scanResultTable_updateRates(TI_HANDLE hScanResultTable, TSiteEntry *pSite, TScanFrameInfo *pFrame);
 static void         scanResultTable_UpdateWSCParams (TSiteEntry *pSite, TScanFrameInfo *pFrame);
 static TI_STATUS scanResultTable_CheckRxSignalValidity(TScanResultTable *pScanResultTable, siteEntry_t *pSite, TI_INT8 rxLevel, TI_UINT8 channel);
+static void         scanResultTable_Clear (TScanResultTable *pScanResultTable);
+static TI_UINT32    scanResultTable_Hash (TSsid *pSsid, TMacAddr *pBssid);
+static void         scanResultTable_HashInsert (TScanResultTable *pScanResultTable, TI_UINT32 uIndex);
+static TI_UINT32    scanResultTable_CalculateSiteSize (TSiteEntry *pSiteEntry, TI_BOOL bAllVarIes);
+static TI_STATUS    scanResultTable_CopySite (TScanResultTable *pScanResultTable, TSiteEntry *pSiteEntry,
+                                              OS_802_11_BSSID_EX *pBssid, TI_BOOL bAllVarIes);
+static TI_UINT32    scanResultTable_CalculateListSize (TScanResultTable *pScanResultTable, TI_UINT32 uSinceGeneration,
+                                                       TI_BOOL bAllVarIes);
+static TI_STATUS    scanResultTable_GetList (TScanResultTable *pScanResultTable, TI_UINT32 uSinceGeneration,
+                                             OS_802_11_BSSID_LIST_EX *pBssidList, TI_UINT32 *pLength, TI_BOOL bAllVarIes);
 
 
 /**
@@ -208,9 +234,12 @@ void        scanResultTable_Init (TI_HANDLE hScanResultTable, TStadHandlesList *
     pScanResultTable->hSiteMgr = pStadHandles->hSiteMgr;
 
     /* initialize other parameters */
-    pScanResultTable->uCurrentSiteNumber = 0;
     pScanResultTable->bStable = TI_TRUE;
     pScanResultTable->uIterator = 0;
+
+    /* A reader which holds no list requests the full list, so the generation count may start anywhere */
+    pScanResultTable->uGeneration = 0;
+    scanResultTable_Clear (pScanResultTable);
 }
 
 
@@ -265,7 +294,7 @@ TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBs
         /* move the table to updating state */
         pScanResultTable->bStable = TI_FALSE;
         /* and clear its contents */
-        pScanResultTable->uCurrentSiteNumber = 0;
+        scanResultTable_Clear (pScanResultTable);
     }
 
     if (NULL == pFrame->parsedIEs->content.iePacket.pSsid)
@@ -305,6 +334,10 @@ TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBs
         {
             /* BSSID exists: update its data */
             scanResultTable_UpdateSiteData (hScanResultTable, pSite, pFrame);
+
+            /* and mark it as changed */
+            pScanResultTable->uGeneration++;
+            pScanResultTable->aEntryGeneration[ pSite - pScanResultTable->pTable ] = pScanResultTable->uGeneration;
         }
     }
     else
@@ -320,6 +353,11 @@ TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBs
         scanResultTable_UpdateSiteData (hScanResultTable,
                                         pSite,
                                         pFrame);
+
+        /* index the new entry by the BSSID and SSID it now holds, and mark it as changed */
+        scanResultTable_HashInsert (pScanResultTable, pSite - pScanResultTable->pTable);
+        pScanResultTable->uGeneration++;
+        pScanResultTable->aEntryGeneration[ pSite - pScanResultTable->pTable ] = pScanResultTable->uGeneration;
     }
 
     return TI_OK;
@@ -342,7 +380,7 @@ void        scanResultTable_SetStableState (TI_HANDLE hScanResultTable)
     /* if also asked to clear the table, if it is at Stable mode means that no results were received, clear it! */
     if (TI_TRUE == pScanResultTable->bStable)
     {
-        pScanResultTable->uCurrentSiteNumber = 0;
+        scanResultTable_Clear (pScanResultTable);
     }
 
     /* set stable state */
@@ -399,7 +437,7 @@ TSiteEntry  *scanResultTable_GetNext (TI_HANDLE hScanResultTable)
  * \fn     scanResultTable_GetByBssid
  * \brief  retreives an entry according to its SSID and BSSID
  *
- * retreives an entry according to its BSSID
+ * retreives an entry according to its BSSID, by probing the (BSSID, SSID) hash index
  *
  * \param  hScanResultTable - handle to the scan result table object
  * \param  pSsid - SSID to search for
@@ -409,20 +447,32 @@ TSiteEntry  *scanResultTable_GetNext (TI_HANDLE hScanResultTable)
 TSiteEntry  *scanResultTable_GetBySsidBssidPair (TI_HANDLE hScanResultTable, TSsid *pSsid, TMacAddr *pBssid)
 {
     TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
-    TI_UINT32           uIndex;
+    TI_UINT32           uSlot, uProbe;
+    TSiteEntry          *pSite;
 
-    /* check all entries in the table */
-    for (uIndex = 0; uIndex < pScanResultTable->uCurrentSiteNumber; uIndex++)
+    uSlot = scanResultTable_Hash (pSsid, pBssid);
+
+    /* probe from the home slot until the site or an empty slot is found */
+    for (uProbe = 0; uProbe < TABLE_HASH_SIZE; uProbe++)
     {
+        if (TABLE_HASH_EMPTY == pScanResultTable->aHash[ uSlot ])
+        {
+            break;
+        }
+
+        pSite = &(pScanResultTable->pTable[ pScanResultTable->aHash[ uSlot ] - 1 ]);
+
         /* if the BSSID and SSID match */
-        if (MAC_EQUAL (*pBssid, pScanResultTable->pTable[ uIndex ].bssid) &&
-            ((pSsid->len == pScanResultTable->pTable[ uIndex ].ssid.len) &&
+        if (MAC_EQUAL (*pBssid, pSite->bssid) &&
+            ((pSsid->len == pSite->ssid.len) &&
              (0 == os_memoryCompare (pScanResultTable->hOS, &(pSsid->str[ 0 ]),
-                                     &(pScanResultTable->pTable[ uIndex ].ssid.str[ 0 ]),
+                                     &(pSite->ssid.str[ 0 ]),
                                      pSsid->len))))
         {
-            return &(pScanResultTable->pTable[ uIndex ]);
+            return pSite;
         }
+
+        uSlot = (uSlot + 1) & TABLE_HASH_MASK;
     }
 
     /* site wasn't found: return NULL */
@@ -708,88 +758,232 @@ void scanResultTable_UpdateWSCParams (TSiteEntry *pSite, TScanFrameInfo *pFrame)
 TI_UINT32 scanResultTable_CalculateBssidListSize (TI_HANDLE hScanResultTable, TI_BOOL bAllVarIes)
 {
     TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
-    TI_UINT32           uSiteIndex, uSiteLength, uLength = 0;
-    TSiteEntry          *pSiteEntry;
 
-    /* set the length of the list header (sites count) */
-    uLength = sizeof(OS_802_11_BSSID_LIST_EX) - sizeof(OS_802_11_BSSID_EX);
+    return scanResultTable_CalculateListSize (pScanResultTable, pScanResultTable->uClearGeneration, bAllVarIes);
+}
 
-    /* check lengthes of all sites in the table */
-    for (uSiteIndex = 0; uSiteIndex < pScanResultTable->uCurrentSiteNumber; uSiteIndex++)
+/**
+ * \fn     scanResultTable_GetBssidList
+ * \brief  Retrieves the site table content
+ *
+ * Retrieves the site table content
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \param  pBssidList - pointer to a buffer large enough to hols the BSSID list
+ * \param  plength - length of the supplied buffer, will be overwritten with the actual list length
+ * \param  bAllVarIes - whether to include all variable size IEs
+ * \return None
+ * \sa     scanResultTable_CalculateBssidListSize
+ */
+TI_STATUS scanResultTable_GetBssidList (TI_HANDLE hScanResultTable,
+                                        OS_802_11_BSSID_LIST_EX *pBssidList,
+                                        TI_UINT32 *pLength,
+                                        TI_BOOL bAllVarIes)
+{
+    TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
+
+    return scanResultTable_GetList (pScanResultTable, pScanResultTable->uClearGeneration, pBssidList, pLength, bAllVarIes);
+}
+
+/**
+ * \fn     scanResultTable_GetGeneration
+ * \brief  Retrieves the table generation
+ *
+ * Retrieves the table generation. The generation changes whenever an entry is added or updated,
+ * or the table is cleared, so a reader may skip re-reading the list while it doesn't change.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \return The current table generation
+ * \sa     scanResultTable_GetBssidListDelta
+ */
+TI_UINT32 scanResultTable_GetGeneration (TI_HANDLE hScanResultTable)
+{
+    TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
+
+    return pScanResultTable->uGeneration;
+}
+
+/**
+ * \fn     scanResultTable_CalculateBssidListDeltaSize
+ * \brief  Calculates the size required for the list of entries changed since a given generation
+ *
+ * Calculates the size required for the list of entries changed since a given generation.
+ * If the full list is requested or the table was cleared since that generation, this is 
+ * the size of the full list.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \param  uSinceGeneration - the generation returned by the previous read
+ * \param  bAllVarIes - whether to include all variable size IEs
+ * \param  pFullList - in: TI_TRUE to request the full list (the reader holds no list), 
+ *                     out: set to TI_TRUE if the full list is returned
+ * \return The total length required
+ * \sa     scanResultTable_GetBssidListDelta
+ */
+TI_UINT32 scanResultTable_CalculateBssidListDeltaSize (TI_HANDLE hScanResultTable, TI_UINT32 uSinceGeneration,
+                                                       TI_BOOL bAllVarIes, TI_BOOL *pFullList)
+{
+    TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
+
+    /* if the reader holds no list or the table was cleared since the last read, the reader has to replace its whole list */
+    if (*pFullList || GENERATION_AFTER (pScanResultTable->uClearGeneration, uSinceGeneration))
     {
-        pSiteEntry = &(pScanResultTable->pTable[ uSiteIndex ]);
-        /* if full list is requested */
-        if (bAllVarIes)
-        {
-            /* set length of all IEs for this site */
-            uSiteLength = sizeof(OS_802_11_BSSID_EX) + sizeof(OS_802_11_FIXED_IEs);
-            /* and add beacon or probe response length */
-            if (TI_TRUE == pSiteEntry->probeRecv)
-            {
-                uSiteLength += pSiteEntry->probeRespLength;
-            }
-            else
-            {
-                uSiteLength += pSiteEntry->beaconLength;
-            }
+        uSinceGeneration = pScanResultTable->uClearGeneration;
+        *pFullList = TI_TRUE;
+    }
+    else
+    {
+        *pFullList = TI_FALSE;
+    }
+
+    return scanResultTable_CalculateListSize (pScanResultTable, uSinceGeneration, bAllVarIes);
+}
+
+/**
+ * \fn     scanResultTable_GetBssidListDelta
+ * \brief  Retrieves the entries changed since a given generation
+ *
+ * Retrieves the entries added or updated since a given generation, in the same format as
+ * scanResultTable_GetBssidList. If the full list is requested or the table was cleared since 
+ * that generation, the full list is retrieved and the reader should drop the entries it holds.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \param  uSinceGeneration - the generation returned by the previous read
+ * \param  pBssidList - pointer to a buffer large enough to hold the list
+ * \param  plength - length of the supplied buffer, will be overwritten with the actual list length
+ * \param  bAllVarIes - whether to include all variable size IEs
+ * \param  pFullList - in: TI_TRUE to request the full list (the reader holds no list), 
+ *                     out: set to TI_TRUE if the full list is returned
+ * \param  pGeneration - set to the generation to pass on the next read
+ * \return TI_OK if the list was retrieved, TI_NOK if the buffer is too small
+ * \sa     scanResultTable_CalculateBssidListDeltaSize
+ */
+TI_STATUS scanResultTable_GetBssidListDelta (TI_HANDLE hScanResultTable, TI_UINT32 uSinceGeneration,
+                                             OS_802_11_BSSID_LIST_EX *pBssidList, TI_UINT32 *pLength,
+                                             TI_BOOL bAllVarIes, TI_BOOL *pFullList, TI_UINT32 *pGeneration)
+{
+    TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
+
+    if (*pFullList || GENERATION_AFTER (pScanResultTable->uClearGeneration, uSinceGeneration))
+    {
+        uSinceGeneration = pScanResultTable->uClearGeneration;
+        *pFullList = TI_TRUE;
+    }
+    else
+    {
+        *pFullList = TI_FALSE;
+    }
+
+    *pGeneration = pScanResultTable->uGeneration;
+
+    return scanResultTable_GetList (pScanResultTable, uSinceGeneration, pBssidList, pLength, bAllVarIes);
+}
+
+/**
+ * \fn     scanResultTable_CalculateSiteSize
+ * \brief  Calculates the size of a single site in the BSSID list
+ *
+ * Calculates the size of a single site in the BSSID list, 4 bytes aligned
+ *
+ * \param  pSiteEntry - the site entry
+ * \param  bAllVarIes - whether to include all variable size IEs
+ * \return The site length
+ * \sa     scanResultTable_CalculateListSize
+ */
+static TI_UINT32 scanResultTable_CalculateSiteSize (TSiteEntry *pSiteEntry, TI_BOOL bAllVarIes)
+{
+    TI_UINT32           uSiteLength;
 
+    /* if full list is requested */
+    if (bAllVarIes)
+    {
+        /* set length of all IEs for this site */
+        uSiteLength = sizeof(OS_802_11_BSSID_EX) + sizeof(OS_802_11_FIXED_IEs);
+        /* and add beacon or probe response length */
+        if (TI_TRUE == pSiteEntry->probeRecv)
+        {
+            uSiteLength += pSiteEntry->probeRespLength;
         }
-        /* partial list is requested */
         else
         {
-            uSiteLength = (sizeof(OS_802_11_BSSID_EX) + sizeof(OS_802_11_FIXED_IEs) +
-                           (pSiteEntry->ssid.len + 2) + (DOT11_MAX_SUPPORTED_RATES + 2) +
-                           + (DOT11_DS_PARAMS_ELE_LEN +2) + pSiteEntry->rsnIeLen + pSiteEntry->unknownIeLen);
-
-            /* QOS_WME information element */
-            if (pSiteEntry->WMESupported)
-            {
-                /* length of element + header */
-                uSiteLength += (DOT11_WME_PARAM_ELE_LEN + 2);
-            }
+            uSiteLength += pSiteEntry->beaconLength;
         }
 
-        /* make sure length is 4 bytes aligned */
-        if (uSiteLength % 4)
+    }
+    /* partial list is requested */
+    else
+    {
+        uSiteLength = (sizeof(OS_802_11_BSSID_EX) + sizeof(OS_802_11_FIXED_IEs) +
+                       (pSiteEntry->ssid.len + 2) + (DOT11_MAX_SUPPORTED_RATES + 2) +
+                       + (DOT11_DS_PARAMS_ELE_LEN +2) + pSiteEntry->rsnIeLen + pSiteEntry->unknownIeLen);
+
+        /* QOS_WME information element */
+        if (pSiteEntry->WMESupported)
         {
-            uSiteLength += (4 - (uSiteLength % 4));
+            /* length of element + header */
+            uSiteLength += (DOT11_WME_PARAM_ELE_LEN + 2);
         }
+    }
 
-        /* add this site length to the total length */
-        uLength += uSiteLength;
+    /* make sure length is 4 bytes aligned */
+    if (uSiteLength % 4)
+    {
+        uSiteLength += (4 - (uSiteLength % 4));
     }
 
-    return uLength;
+    return uSiteLength;
 }
 
 /**
- * \fn     scanResultTable_GetBssidList
- * \brief  Retrieves the site table content
+ * \fn     scanResultTable_CalculateListSize
+ * \brief  Calculates the size required for the list of sites changed after a given generation
  *
- * Retrieves the site table content
+ * \param  pScanResultTable - the scan result table object
+ * \param  uSinceGeneration - only sites changed after this generation are counted
+ * \param  bAllVarIes - whether to include all variable size IEs
+ * \return The total length required
+ * \sa     scanResultTable_GetList
+ */
+static TI_UINT32 scanResultTable_CalculateListSize (TScanResultTable *pScanResultTable, TI_UINT32 uSinceGeneration,
+                                                    TI_BOOL bAllVarIes)
+{
+    TI_UINT32           uSiteIndex, uLength;
+
+    /* set the length of the list header (sites count) */
+    uLength = sizeof(OS_802_11_BSSID_LIST_EX) - sizeof(OS_802_11_BSSID_EX);
+
+    /* add the lengthes of all sites changed since the given generation */
+    for (uSiteIndex = 0; uSiteIndex < pScanResultTable->uCurrentSiteNumber; uSiteIndex++)
+    {
+        if (GENERATION_AFTER (pScanResultTable->aEntryGeneration[ uSiteIndex ], uSinceGeneration))
+        {
+            uLength += scanResultTable_CalculateSiteSize (&(pScanResultTable->pTable[ uSiteIndex ]), bAllVarIes);
+        }
+    }
+
+    return uLength;
+}
+
+/**
+ * \fn     scanResultTable_GetList
+ * \brief  Retrieves the list of sites changed after a given generation
  *
- * \param  hScanResultTable - handle to the scan result table object
+ * \param  pScanResultTable - the scan result table object
+ * \param  uSinceGeneration - only sites changed after this generation are retrieved
  * \param  pBssidList - pointer to a buffer large enough to hols the BSSID list
  * \param  plength - length of the supplied buffer, will be overwritten with the actual list length
  * \param  bAllVarIes - whether to include all variable size IEs
- * \return None
- * \sa     scanResultTable_CalculateBssidListSize
+ * \return TI_OK if the list was retrieved, TI_NOK otherwise
+ * \sa     scanResultTable_CalculateListSize
  */
-TI_STATUS scanResultTable_GetBssidList (TI_HANDLE hScanResultTable,
-                                        OS_802_11_BSSID_LIST_EX *pBssidList,
-                                        TI_UINT32 *pLength,
-                                        TI_BOOL bAllVarIes)
+static TI_STATUS scanResultTable_GetList (TScanResultTable *pScanResultTable, TI_UINT32 uSinceGeneration,
+                                          OS_802_11_BSSID_LIST_EX *pBssidList, TI_UINT32 *pLength, TI_BOOL bAllVarIes)
 {
-    TScanResultTable        *pScanResultTable = (TScanResultTable*)hScanResultTable;
-    TI_UINT32                uLength, uSiteIndex, rsnIndex, rsnIeLength, len, firstOFDMloc = 0;
-    TSiteEntry              *pSiteEntry;
+    TI_UINT32                uLength, uSiteIndex;
     OS_802_11_BSSID_EX      *pBssid;
-    OS_802_11_FIXED_IEs     *pFixedIes;
-    OS_802_11_VARIABLE_IEs  *pVarIes;
     TI_UINT8                *pData;
 
     /* verify the supplied length is enough */
-    uLength = scanResultTable_CalculateBssidListSize (hScanResultTable, bAllVarIes);
+    uLength = scanResultTable_CalculateListSize (pScanResultTable, uSinceGeneration, bAllVarIes);
     if (uLength > *pLength)
     {
         *pLength = uLength;
@@ -807,159 +1001,196 @@ TI_STATUS scanResultTable_GetBssidList (TI_HANDLE hScanResultTable,
 
     for (uSiteIndex = 0; uSiteIndex < pScanResultTable->uCurrentSiteNumber; uSiteIndex++)
     {
+        /* skip sites which didn't change since the given generation */
+        if (!GENERATION_AFTER (pScanResultTable->aEntryGeneration[ uSiteIndex ], uSinceGeneration))
+        {
+            continue;
+        }
+
         /* set BSSID entry pointer to current location in buffer */
         pBssid = (OS_802_11_BSSID_EX*)pData;
 
-        /* set pointer to site entry */
-        pSiteEntry = &(pScanResultTable->pTable[ uSiteIndex ]);
+        if (TI_OK != scanResultTable_CopySite (pScanResultTable, &(pScanResultTable->pTable[ uSiteIndex ]),
+                                               pBssid, bAllVarIes))
+        {
+            return TI_NOK;
+        }
+
+        pData += pBssid->Length;
+        uLength += pBssid->Length;
+        pBssidList->NumberOfItems++;
+    }
+
+    *pLength = uLength;
+
+    return TI_OK;
+}
+
+/**
+ * \fn     scanResultTable_CopySite
+ * \brief  Copies a single site entry to the BSSID list format
+ *
+ * \param  pScanResultTable - the scan result table object
+ * \param  pSiteEntry - the site entry
+ * \param  pBssid - the BSSID list item to fill
+ * \param  bAllVarIes - whether to include all variable size IEs
+ * \return TI_OK if the site was copied, TI_NOK if its frame length is invalid
+ * \sa     scanResultTable_GetList
+ */
+static TI_STATUS scanResultTable_CopySite (TScanResultTable *pScanResultTable, TSiteEntry *pSiteEntry,
+                                           OS_802_11_BSSID_EX *pBssid, TI_BOOL bAllVarIes)
+{
+    TI_UINT32                rsnIndex, rsnIeLength, len, firstOFDMloc = 0;
+    OS_802_11_FIXED_IEs     *pFixedIes;
+    OS_802_11_VARIABLE_IEs  *pVarIes;
+
+    /* start copy stuff: */
+    /* MacAddress */
+    MAC_COPY (pBssid->MacAddress, pSiteEntry->bssid);
+
+    /* Capabilities */
+    pBssid->Capabilities = pSiteEntry->capabilities;
+
+    /* SSID */
+    os_memoryZero (pScanResultTable->hOS, &(pBssid->Ssid.Ssid), MAX_SSID_LEN);
+    if (pSiteEntry->ssid.len > MAX_SSID_LEN)
+    {
+        pSiteEntry->ssid.len = MAX_SSID_LEN;
+    }
+    os_memoryCopy (pScanResultTable->hOS,
+                   (void *)pBssid->Ssid.Ssid,
+                   (void *)pSiteEntry->ssid.str,
+                   pSiteEntry->ssid.len);
+    pBssid->Ssid.SsidLength = pSiteEntry->ssid.len;
+
+    /* privacy */
+    pBssid->Privacy = pSiteEntry->privacy;
 
-        /* start copy stuff: */
-        /* MacAddress */
-        MAC_COPY (pBssid->MacAddress, pSiteEntry->bssid);
+    /* RSSI */
+    pBssid->Rssi = pSiteEntry->rssi;
 
-        /* Capabilities */
-        pBssid->Capabilities = pSiteEntry->capabilities;
+    pBssid->Configuration.Length = sizeof(OS_802_11_CONFIGURATION);
+    pBssid->Configuration.BeaconPeriod = pSiteEntry->beaconInterval;
+    pBssid->Configuration.ATIMWindow = pSiteEntry->atimWindow;
+    pBssid->Configuration.Union.channel = Chan2Freq(pSiteEntry->channel);
 
-        /* SSID */
-        os_memoryZero (pScanResultTable->hOS, &(pBssid->Ssid.Ssid), MAX_SSID_LEN);
-        if (pSiteEntry->ssid.len > MAX_SSID_LEN)
+    if  (pSiteEntry->bssType == BSS_INDEPENDENT)
+        pBssid->InfrastructureMode = os802_11IBSS;
+    else
+        pBssid->InfrastructureMode = os802_11Infrastructure;
+    /* Supported Rates */
+    os_memoryZero (pScanResultTable->hOS, (void *)pBssid->SupportedRates, sizeof(OS_802_11_RATES_EX));
+    rate_DrvBitmapToNetStr (pSiteEntry->rateMask.supportedRateMask,
+                            pSiteEntry->rateMask.basicRateMask,
+                            (TI_UINT8*)pBssid->SupportedRates,
+                            &len,
+                            &firstOFDMloc);
+
+    /* set network type acording to band and rates */
+    if (RADIO_BAND_2_4_GHZ == pSiteEntry->eBand)
+    {
+        if (firstOFDMloc == len)
         {
-            pSiteEntry->ssid.len = MAX_SSID_LEN;
+            pBssid->NetworkTypeInUse = os802_11DS;
+        } else {
+            pBssid->NetworkTypeInUse = os802_11OFDM24;
         }
-        os_memoryCopy (pScanResultTable->hOS,
-                       (void *)pBssid->Ssid.Ssid,
-                       (void *)pSiteEntry->ssid.str,
-                       pSiteEntry->ssid.len);
-        pBssid->Ssid.SsidLength = pSiteEntry->ssid.len;
+    }
+    else
+    {
+        pBssid->NetworkTypeInUse = os802_11OFDM5;
+    }
 
-        /* privacy */
-        pBssid->Privacy = pSiteEntry->privacy;
+    /* start copy IE's: first nullify length */
+    pBssid->IELength = 0;
 
-        /* RSSI */
-        pBssid->Rssi = pSiteEntry->rssi;
+    /* copy fixed IEs from site entry */
+    pFixedIes = (OS_802_11_FIXED_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
+    os_memoryCopy (pScanResultTable->hOS, (void*)pFixedIes->TimeStamp,
+                   &(pSiteEntry->tsfTimeStamp[ 0 ]), TIME_STAMP_LEN);
+    pFixedIes->BeaconInterval = pSiteEntry->beaconInterval;
+    pFixedIes->Capabilities = pSiteEntry->capabilities;
+    pBssid->IELength += sizeof(OS_802_11_FIXED_IEs);
 
-        pBssid->Configuration.Length = sizeof(OS_802_11_CONFIGURATION);
-        pBssid->Configuration.BeaconPeriod = pSiteEntry->beaconInterval;
-        pBssid->Configuration.ATIMWindow = pSiteEntry->atimWindow;
-        pBssid->Configuration.Union.channel = Chan2Freq(pSiteEntry->channel);
+    /* set pointer for variable length IE's */
+    pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
 
-        if  (pSiteEntry->bssType == BSS_INDEPENDENT)
-            pBssid->InfrastructureMode = os802_11IBSS;
-        else
-            pBssid->InfrastructureMode = os802_11Infrastructure;
-        /* Supported Rates */
-        os_memoryZero (pScanResultTable->hOS, (void *)pBssid->SupportedRates, sizeof(OS_802_11_RATES_EX));
+    if (!bAllVarIes)
+    {   /* copy only some variable IEs */
+
+        /* copy SSID */
+        pVarIes->ElementID = SSID_IE_ID;
+        pVarIes->Length = pSiteEntry->ssid.len;
+        os_memoryCopy (pScanResultTable->hOS,
+                       (void *)pVarIes->data,
+                       (void *)pSiteEntry->ssid.str,
+                       pSiteEntry->ssid.len);
+        pBssid->IELength += (pVarIes->Length + 2);
+
+        /* copy RATES */
+        pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
+        pVarIes->ElementID = SUPPORTED_RATES_IE_ID;
         rate_DrvBitmapToNetStr (pSiteEntry->rateMask.supportedRateMask,
                                 pSiteEntry->rateMask.basicRateMask,
-                                (TI_UINT8*)pBssid->SupportedRates,
+                                (TI_UINT8 *)pVarIes->data,
                                 &len,
                                 &firstOFDMloc);
+        pVarIes->Length = len;
+        pBssid->IELength += (pVarIes->Length + 2);
 
-        /* set network type acording to band and rates */
-        if (RADIO_BAND_2_4_GHZ == pSiteEntry->eBand)
+        /* copy DS */
+        pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
+        pVarIes->ElementID = DS_PARAMETER_SET_IE_ID;
+        pVarIes->Length = DOT11_DS_PARAMS_ELE_LEN;
+        os_memoryCopy (pScanResultTable->hOS, (void *)pVarIes->data,
+                       &(pSiteEntry->channel), DOT11_DS_PARAMS_ELE_LEN);
+        pBssid->IELength += (pVarIes->Length + 2);
+
+        /* copy RSN information elements */
+        if (0 < pSiteEntry->rsnIeLen)
         {
-            if (firstOFDMloc == len)
+            rsnIeLength = 0;
+            for (rsnIndex=0; rsnIndex < MAX_RSN_IE && pSiteEntry->pRsnIe[ rsnIndex ].hdr[1] > 0; rsnIndex++)
             {
-                pBssid->NetworkTypeInUse = os802_11DS;
-            } else {
-                pBssid->NetworkTypeInUse = os802_11OFDM24;
+                pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength + rsnIeLength ]);
+                pVarIes->ElementID = pSiteEntry->pRsnIe[ rsnIndex ].hdr[0];
+                pVarIes->Length = pSiteEntry->pRsnIe[ rsnIndex ].hdr[1];
+                os_memoryCopy (pScanResultTable->hOS, (void *)pVarIes->data,
+                               (void *)pSiteEntry->pRsnIe[ rsnIndex ].rsnIeData,
+                               pSiteEntry->pRsnIe[ rsnIndex ].hdr[1]);
+                rsnIeLength += pSiteEntry->pRsnIe[ rsnIndex ].hdr[1] + 2;
             }
+            pBssid->IELength += pSiteEntry->rsnIeLen;
         }
-        else
-        {
-            pBssid->NetworkTypeInUse = os802_11OFDM5;
-        }
-
-        /* start copy IE's: first nullify length */
-        pBssid->IELength = 0;
 
-        /* copy fixed IEs from site entry */
-        pFixedIes = (OS_802_11_FIXED_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
-        os_memoryCopy (pScanResultTable->hOS, (void*)pFixedIes->TimeStamp,
-                       &(pSiteEntry->tsfTimeStamp[ 0 ]), TIME_STAMP_LEN);
-        pFixedIes->BeaconInterval = pSiteEntry->beaconInterval;
-        pFixedIes->Capabilities = pSiteEntry->capabilities;
-        pBssid->IELength += sizeof(OS_802_11_FIXED_IEs);
+        /* QOS_WME/XCC */
+        if (TI_TRUE == pSiteEntry->WMESupported)
+        {
+            /* oui */
+            TI_UINT8            ouiWME[3] = {0x50, 0xf2, 0x01};
+            dot11_WME_PARAM_t   *pWMEParams;
 
-        /* set pointer for variable length IE's */
-        pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
+            /* fill in the general element  parameters */
+            pVarIes =  (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
+            pVarIes->ElementID = DOT11_WME_ELE_ID;
+            pVarIes->Length = DOT11_WME_PARAM_ELE_LEN;
 
-        if (!bAllVarIes)
-        {   /* copy only some variable IEs */
+            /* fill in the specific element  parameters */
+            pWMEParams = (dot11_WME_PARAM_t*)pVarIes;
+            os_memoryCopy (pScanResultTable->hOS, (void *)pWMEParams->OUI, ouiWME, 3);
+            pWMEParams->OUIType = dot11_WME_OUI_TYPE;
+            pWMEParams->OUISubType = dot11_WME_OUI_SUB_TYPE_PARAMS_IE;
+            pWMEParams->version = dot11_WME_VERSION;
+            pWMEParams->ACInfoField = dot11_WME_ACINFO_MASK & pSiteEntry->lastWMEParameterCnt;
 
-            /* copy SSID */
-            pVarIes->ElementID = SSID_IE_ID;
-            pVarIes->Length = pSiteEntry->ssid.len;
-            os_memoryCopy (pScanResultTable->hOS,
-                           (void *)pVarIes->data,
-                           (void *)pSiteEntry->ssid.str,
-                           pSiteEntry->ssid.len);
-            pBssid->IELength += (pVarIes->Length + 2);
+            /* fill in the data  */
+            os_memoryCopy (pScanResultTable->hOS, &(pWMEParams->WME_ACParameteres),
+                           &(pSiteEntry->WMEParameters), sizeof(dot11_ACParameters_t));
 
-            /* copy RATES */
-            pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
-            pVarIes->ElementID = SUPPORTED_RATES_IE_ID;
-            rate_DrvBitmapToNetStr (pSiteEntry->rateMask.supportedRateMask,
-                                    pSiteEntry->rateMask.basicRateMask,
-                                    (TI_UINT8 *)pVarIes->data,
-                                    &len,
-                                    &firstOFDMloc);
-            pVarIes->Length = len;
-            pBssid->IELength += (pVarIes->Length + 2);
 
-            /* copy DS */
-            pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
-            pVarIes->ElementID = DS_PARAMETER_SET_IE_ID;
-            pVarIes->Length = DOT11_DS_PARAMS_ELE_LEN;
-            os_memoryCopy (pScanResultTable->hOS, (void *)pVarIes->data,
-                           &(pSiteEntry->channel), DOT11_DS_PARAMS_ELE_LEN);
+            /* update the general length */
             pBssid->IELength += (pVarIes->Length + 2);
-
-            /* copy RSN information elements */
-            if (0 < pSiteEntry->rsnIeLen)
-            {
-                rsnIeLength = 0;
-                for (rsnIndex=0; rsnIndex < MAX_RSN_IE && pSiteEntry->pRsnIe[ rsnIndex ].hdr[1] > 0; rsnIndex++)
-                {
-                    pVarIes = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength + rsnIeLength ]);
-                    pVarIes->ElementID = pSiteEntry->pRsnIe[ rsnIndex ].hdr[0];
-                    pVarIes->Length = pSiteEntry->pRsnIe[ rsnIndex ].hdr[1];
-                    os_memoryCopy (pScanResultTable->hOS, (void *)pVarIes->data,
-                                   (void *)pSiteEntry->pRsnIe[ rsnIndex ].rsnIeData,
-                                   pSiteEntry->pRsnIe[ rsnIndex ].hdr[1]);
-                    rsnIeLength += pSiteEntry->pRsnIe[ rsnIndex ].hdr[1] + 2;
-                }
-                pBssid->IELength += pSiteEntry->rsnIeLen;
-            }
-
-            /* QOS_WME/XCC */
-            if (TI_TRUE == pSiteEntry->WMESupported)
-            {
-                /* oui */
-                TI_UINT8            ouiWME[3] = {0x50, 0xf2, 0x01};
-                dot11_WME_PARAM_t   *pWMEParams;
-
-                /* fill in the general element  parameters */
-                pVarIes =  (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[ pBssid->IELength ]);
-                pVarIes->ElementID = DOT11_WME_ELE_ID;
-                pVarIes->Length = DOT11_WME_PARAM_ELE_LEN;
-
-                /* fill in the specific element  parameters */
-                pWMEParams = (dot11_WME_PARAM_t*)pVarIes;
-                os_memoryCopy (pScanResultTable->hOS, (void *)pWMEParams->OUI, ouiWME, 3);
-                pWMEParams->OUIType = dot11_WME_OUI_TYPE;
-                pWMEParams->OUISubType = dot11_WME_OUI_SUB_TYPE_PARAMS_IE;
-                pWMEParams->version = dot11_WME_VERSION;
-                pWMEParams->ACInfoField = dot11_WME_ACINFO_MASK & pSiteEntry->lastWMEParameterCnt;
-
-                /* fill in the data  */
-                os_memoryCopy (pScanResultTable->hOS, &(pWMEParams->WME_ACParameteres),
-                               &(pSiteEntry->WMEParameters), sizeof(dot11_ACParameters_t));
-
-
-                /* update the general length */
-                pBssid->IELength += (pVarIes->Length + 2);
-            }
+        }
 
 			/* Copy the unknown IEs */
 			if ( 0 < pSiteEntry->unknownIeLen  ) {
@@ -969,53 +1200,46 @@ TI_STATUS scanResultTable_GetBssidList (TI_HANDLE hScanResultTable,
 					pBssid->IELength += pSiteEntry->unknownIeLen;
 			}
 
-        }
-        else
-        {   /* Copy all variable IEs */
-            if (pSiteEntry->probeRecv)
+    }
+    else
+    {   /* Copy all variable IEs */
+        if (pSiteEntry->probeRecv)
+        {
+            /* It looks like it never happens. Anyway decided to check */
+            if ( pSiteEntry->probeRespLength > MAX_BEACON_BODY_LENGTH )
+               /* it may have sense to check the Len here for 0 or MIN_BEACON_BODY_LENGTH also */
             {
-                /* It looks like it never happens. Anyway decided to check */
-                if ( pSiteEntry->probeRespLength > MAX_BEACON_BODY_LENGTH )
-                   /* it may have sense to check the Len here for 0 or MIN_BEACON_BODY_LENGTH also */
-                {
-                    handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
-                    return TI_NOK;
-                }
-                os_memoryCopy (pScanResultTable->hOS, pVarIes,
-                               pSiteEntry->probeRespBuffer, pSiteEntry->probeRespLength);
-                pBssid->IELength += pSiteEntry->probeRespLength;
+                handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
+                return TI_NOK;
             }
-            else
+            os_memoryCopy (pScanResultTable->hOS, pVarIes,
+                           pSiteEntry->probeRespBuffer, pSiteEntry->probeRespLength);
+            pBssid->IELength += pSiteEntry->probeRespLength;
+        }
+        else
+        {
+            /* It looks like it never happens. Anyway decided to check */
+            if ( pSiteEntry->beaconLength > MAX_BEACON_BODY_LENGTH )
+               /* it may have sense to check the Len here for 0 or MIN_BEACON_BODY_LENGTH also */
             {
-                /* It looks like it never happens. Anyway decided to check */
-                if ( pSiteEntry->beaconLength > MAX_BEACON_BODY_LENGTH )
-                   /* it may have sense to check the Len here for 0 or MIN_BEACON_BODY_LENGTH also */
-                {
-                    handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
-                    return TI_NOK;
-                }
-                os_memoryCopy (pScanResultTable->hOS, pVarIes,
-                               pSiteEntry->beaconBuffer, pSiteEntry->beaconLength);
-                pBssid->IELength += pSiteEntry->beaconLength;
+                handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
+                return TI_NOK;
             }
+            os_memoryCopy (pScanResultTable->hOS, pVarIes,
+                           pSiteEntry->beaconBuffer, pSiteEntry->beaconLength);
+            pBssid->IELength += pSiteEntry->beaconLength;
         }
+    }
 
-        /* -1 to remove the IEs[1] placeholder in OS_802_11_BSSID_EX which is taken into account in pBssid->IELength */
-        pBssid->Length = sizeof(OS_802_11_BSSID_EX) + pBssid->IELength - 1;
-
-        /* make sure length is 4 bytes aligned */
-        if (pBssid->Length % 4)
-        {
-            pBssid->Length += (4 - (pBssid->Length % 4));
-        }
+    /* -1 to remove the IEs[1] placeholder in OS_802_11_BSSID_EX which is taken into account in pBssid->IELength */
+    pBssid->Length = sizeof(OS_802_11_BSSID_EX) + pBssid->IELength - 1;
 
-        pData += pBssid->Length;
-        uLength += pBssid->Length;
+    /* make sure length is 4 bytes aligned */
+    if (pBssid->Length % 4)
+    {
+        pBssid->Length += (4 - (pBssid->Length % 4));
     }
 
-    pBssidList->NumberOfItems = pScanResultTable->uCurrentSiteNumber;
-    *pLength = uLength;
-
     return TI_OK;
 }
 
@@ -1067,3 +1291,78 @@ static TI_STATUS scanResultTable_CheckRxSignalValidity(TScanResultTable *pScanRe
 
 
 
+
+/**
+ * \fn     scanResultTable_Clear
+ * \brief  Clears the table contents
+ *
+ * Clears the table contents and its hash index, and records the clear generation
+ * so incremental readers know they have to drop their lists.
+ *
+ * \param  pScanResultTable - scan result table object
+ * \return None
+ * \sa     scanResultTable_UpdateEntry, scanResultTable_SetStableState
+ */
+static void scanResultTable_Clear (TScanResultTable *pScanResultTable)
+{
+    pScanResultTable->uCurrentSiteNumber = 0;
+    os_memoryZero (pScanResultTable->hOS, pScanResultTable->aHash, sizeof (pScanResultTable->aHash));
+
+    pScanResultTable->uGeneration++;
+    pScanResultTable->uClearGeneration = pScanResultTable->uGeneration;
+}
+
+/**
+ * \fn     scanResultTable_Hash
+ * \brief  Computes the hash index home slot of a (BSSID, SSID) pair
+ *
+ * FNV-1a over the BSSID and SSID bytes, folded to the hash index size.
+ *
+ * \param  pSsid - the site SSID
+ * \param  pBssid - the site BSSID
+ * \return The home slot in the hash index
+ * \sa     scanResultTable_GetBySsidBssidPair, scanResultTable_HashInsert
+ */
+static TI_UINT32 scanResultTable_Hash (TSsid *pSsid, TMacAddr *pBssid)
+{
+    TI_UINT32   uHash = 2166136261U;
+    TI_UINT32   uLen = TI_MIN (pSsid->len, MAX_SSID_LEN);
+    TI_UINT32   i;
+
+    for (i = 0; i < MAC_ADDR_LEN; i++)
+    {
+        uHash = (uHash ^ (*pBssid)[ i ]) * 16777619U;
+    }
+    for (i = 0; i < uLen; i++)
+    {
+        uHash = (uHash ^ (TI_UINT8)pSsid->str[ i ]) * 16777619U;
+    }
+
+    return (uHash ^ (uHash >> 16)) & TABLE_HASH_MASK;
+}
+
+/**
+ * \fn     scanResultTable_HashInsert
+ * \brief  Adds a table entry to the hash index
+ *
+ * Adds a table entry to the hash index, according to the BSSID and SSID it holds.
+ * The index is larger than the table, so a free slot always exists. Entries are
+ * only removed by clearing the whole table, so no deletion is needed.
+ *
+ * \param  pScanResultTable - scan result table object
+ * \param  uIndex - the entry index in the table
+ * \return None
+ * \sa     scanResultTable_GetBySsidBssidPair
+ */
+static void scanResultTable_HashInsert (TScanResultTable *pScanResultTable, TI_UINT32 uIndex)
+{
+    TSiteEntry  *pSite = &(pScanResultTable->pTable[ uIndex ]);
+    TI_UINT32   uSlot = scanResultTable_Hash (&(pSite->ssid), &(pSite->bssid));
+
+    while (TABLE_HASH_EMPTY != pScanResultTable->aHash[ uSlot ])
+    {
+        uSlot = (uSlot + 1) & TABLE_HASH_MASK;
+    }
+
+    pScanResultTable->aHash[ uSlot ] = (TI_UINT8)(uIndex + 1);
+}
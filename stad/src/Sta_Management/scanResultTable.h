@@ -148,6 +148,12 @@ TSiteEntry  *scanResultTable_GetBySsidBssidPair (TI_HANDLE hScanResultTable, TSs
 TI_UINT32   scanResultTable_CalculateBssidListSize (TI_HANDLE hScanResultTable, TI_BOOL bAllVarIes);
 TI_STATUS   scanResultTable_GetBssidList (TI_HANDLE hScanResultTable, OS_802_11_BSSID_LIST_EX *pBssidList, 
                                           TI_UINT32 *pLength, TI_BOOL bAllVarIes);
+TI_UINT32   scanResultTable_GetGeneration (TI_HANDLE hScanResultTable);
+TI_UINT32   scanResultTable_CalculateBssidListDeltaSize (TI_HANDLE hScanResultTable, TI_UINT32 uSinceGeneration,
+                                                         TI_BOOL bAllVarIes, TI_BOOL *pFullList);
+TI_STATUS   scanResultTable_GetBssidListDelta (TI_HANDLE hScanResultTable, TI_UINT32 uSinceGeneration,
+                                               OS_802_11_BSSID_LIST_EX *pBssidList, TI_UINT32 *pLength,
+                                               TI_BOOL bAllVarIes, TI_BOOL *pFullList, TI_UINT32 *pGeneration);
 
 #endif /* __SCAN_RESULT_TABLE_H__ */
 
@@ -1787,6 +1787,45 @@ TI_STATUS siteMgr_updateSite(TI_HANDLE          hSiteMgr,
     return TI_OK;
 }
 
+/***********************************************************************
+ *                        siteMgr_updateSiteBeaconTime
+ ***********************************************************************
+DESCRIPTION: Called upon receiving a beacon whose content is identical to the
+            last beacon received from the site (TSF and TIM excluded).
+            Updates only the site's beacon reception time and TSF, the rest of
+            the site information is up to date.
+
+INPUT:      hSiteMgr    -   site mgr handle.
+            bssid       -   BSSID received
+            pFrameInfo  -   Frame fixed fields (time stamp)
+
+OUTPUT:
+
+RETURN:     TI_OK on success, TI_NOK if the site isn't in the site table
+
+************************************************************************/
+TI_STATUS siteMgr_updateSiteBeaconTime(TI_HANDLE          hSiteMgr,
+                                    TMacAddr          *bssid,
+                                    mlmeFrameInfo_t   *pFrameInfo)
+{
+    siteEntry_t *pSite;
+    siteMgr_t   *pSiteMgr = (siteMgr_t *)hSiteMgr;
+
+    pSite = findSiteEntry(pSiteMgr, bssid);
+    if (pSite == NULL)
+    {
+        return TI_NOK;
+    }
+
+    UPDATE_LOCAL_TIME_STAMP(pSiteMgr, pSite, pFrameInfo);
+
+    UPDATE_BEACON_RECV(pSite);
+
+    UPDATE_BEACON_TIMESTAMP(pSiteMgr, pSite, pFrameInfo);
+
+    return TI_OK;
+}
+
 /***********************************************************************
  *                        siteMgr_start
  ***********************************************************************
@@ -178,6 +178,8 @@ TI_STATUS siteMgr_saveProbeRespBuffer(TI_HANDLE hSiteMgr, TMacAddr	*bssid, TI_UI
 
 TI_STATUS siteMgr_saveBeaconBuffer(TI_HANDLE hSiteMgr, TMacAddr *bssid, TI_UINT8 *pBeaconBuffer, TI_UINT32 length);
 
+TI_STATUS siteMgr_updateSiteBeaconTime(TI_HANDLE hSiteMgr, TMacAddr *bssid, mlmeFrameInfo_t *pFrameInfo);
+
 void siteMgr_UpdatHtParams (TI_HANDLE hSiteMgr, siteEntry_t *pSite, mlmeFrameInfo_t *pFrameInfo);
 
 
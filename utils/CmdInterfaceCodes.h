@@ -658,6 +658,26 @@ typedef enum
 																														* GET Bit: ON	\n
 																														* SET Bit: OFF	\n
 																														*/
+    SCAN_CNCN_BSSID_LIST_GENERATION_PARAM       =   GET_BIT |           SCAN_CNCN_PARAM | 0x08,							/**< Scan Concentrator BSSID List Generation Parameter (Scan Concentrator Module Get Command): \n  
+																														* Used for retrieving the application scan result table generation, which changes on every table update\n
+																														* Done Sync with no memory allocation\n 
+																														* Parameter Number:	0x08	\n
+																														* Module Number: Scan Concentrator Module Number \n
+																														* Async Bit: OFF	\n
+																														* Allocate Bit: OFF	\n
+																														* GET Bit: ON	\n
+																														* SET Bit: OFF	\n
+																														*/
+    SCAN_CNCN_BSSID_LIST_DELTA_PARAM            =   GET_BIT |           SCAN_CNCN_PARAM | 0x09,							/**< Scan Concentrator BSSID List Delta Parameter (Scan Concentrator Module Get Command): \n  
+																														* Used for retrieving the application scan result table entries changed since a given generation\n
+																														* Done Sync with no memory allocation\n 
+																														* Parameter Number:	0x09	\n
+																														* Module Number: Scan Concentrator Module Number \n
+																														* Async Bit: OFF	\n
+																														* Allocate Bit: OFF	\n
+																														* GET Bit: ON	\n
+																														* SET Bit: OFF	\n
+																														*/
 
 	/* Scan Manager module */
     SCAN_MNGR_SET_CONFIGURATION                 =	SET_BIT |           SCAN_MNGR_PARAM | 0x01 | ALLOC_NEEDED_PARAM,	/**< Scan Manager Set Configuration Parameter (Scan Manager Module Set Command): \n  
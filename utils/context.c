@@ -60,6 +60,17 @@ typedef struct
     TI_UINT32       uSize;                  /* Clients' name string size */
     char            sName [MAX_NAME_SIZE];  /* Clients' name string      */
 } TClientName;	
+
+/* Clients' run-time and latency statistics (in Usec) */
+typedef struct 
+{
+    TI_UINT32       uRequestTime;           /* Time of the first request since last invocation */
+    TI_UINT32       uTotalRunTime;          /* Total time spent in the client's callback       */
+    TI_UINT32       uMaxRunTime;            /* Max time spent in one callback invocation       */
+    TI_UINT32       uTotalLatency;          /* Total request to invocation latency             */
+    TI_UINT32       uMaxLatency;            /* Max request to invocation latency               */
+    TI_UINT32       uBudgetExceeded;        /* Times the client was deferred by its budget     */
+} TClientStat;
 #endif /* TI_DBG */
 
 /* context module structure */
@@ -76,11 +87,21 @@ typedef struct
     TI_HANDLE        aClientCbHndl [MAX_CLIENTS];  /* Clients' callback handles         */
     TI_BOOL          aClientEnabled[MAX_CLIENTS];  /* Clients' enable/disable flags     */
     TI_BOOL          aClientPending[MAX_CLIENTS];  /* Clients' pending flags            */
+    TI_BOOL          aClientStarved[MAX_CLIENTS];  /* Left pending and not served when the task yielded */
+    EContextPriority aClientPriority[MAX_CLIENTS]; /* Clients' priorities               */
+    TI_UINT32        aClientBudget [MAX_CLIENTS];  /* Clients' max invocations per task */
+    TI_UINT32        aServiceOrder [MAX_CLIENTS];  /* Clients' IDs sorted by priority   */
+    TI_UINT32        uTaskBudget;                  /* Max invocations per driver task   */
 
 #ifdef TI_DBG
     TClientName      aClientName   [MAX_CLIENTS];  /* Clients' name string              */
     TI_UINT32        aRequestCount [MAX_CLIENTS];  /* Clients' schedule requests counter*/
     TI_UINT32        aInvokeCount  [MAX_CLIENTS];  /* Clients' invocations counter      */
+    TClientStat      aClientStat   [MAX_CLIENTS];  /* Clients' run-time and latency     */
+    TI_UINT32        uTaskRuns;                    /* Driver task runs counter          */
+    TI_UINT32        uTaskYields;                  /* Driver task yields on budget      */
+    TI_UINT32        uStarvedRuns;                 /* Invocations of starved clients    */
+    TI_UINT32        uMaxInvokesPerTask;           /* Max invocations in one task run   */
 #endif
 
 } TContext;	
@@ -186,6 +207,7 @@ TI_STATUS context_SetDefaults (TI_HANDLE hContext, TContextInitParams *pContextI
 
     /* Set parameters */
     pContext->bContextSwitchRequired = pContextInitParams->bContextSwitchRequired;
+    pContext->uTaskBudget            = pContextInitParams->uTaskBudget;
 	
     return TI_OK;
 }
@@ -205,6 +227,10 @@ TI_STATUS context_SetDefaults (TI_HANDLE hContext, TContextInitParams *pContextI
  * \param  fCbFunc  - The client's callback function.
  * \param  hCbHndl  - The client's callback function handle.
  * \param  bEnable  - TRUE = Enabled.
+ * \param  ePriority - The client's priority (higher priority clients are served first).
+ * \param  uBudget  - Max client invocations per driver task run (CONTEXT_BUDGET_UNLIMITED = no limit).
+ * \param  sName    - The client's name (for debug).
+ * \param  uNameSize - The client's name string size.
  * \return TI_UINT32 - The index allocated for the client
  * \sa     
  */ 
@@ -212,11 +238,14 @@ TI_UINT32 context_RegisterClient (TI_HANDLE       hContext,
                                   TContextCbFunc  fCbFunc,
                                   TI_HANDLE       hCbHndl,
                                   TI_BOOL         bEnable,
+                                  EContextPriority ePriority,
+                                  TI_UINT32       uBudget,
                                   char           *sName,
                                   TI_UINT32       uNameSize)
 {
 	TContext *pContext = (TContext *)hContext;
     TI_UINT32 uClientId = pContext->uNumClients;
+    TI_UINT32 i;
 
     /* If max number of clients is exceeded, report error and exit. */
     if (uClientId == MAX_CLIENTS) 
@@ -229,6 +258,19 @@ TI_UINT32 context_RegisterClient (TI_HANDLE       hContext,
     pContext->aClientCbHndl[uClientId]  = hCbHndl;
     pContext->aClientEnabled[uClientId] = bEnable;
     pContext->aClientPending[uClientId] = TI_FALSE;
+    pContext->aClientPriority[uClientId] = ePriority;
+    pContext->aClientBudget[uClientId]  = uBudget;
+
+    /* Insert the client to the service order after all clients with the same or higher priority */
+    for (i = uClientId; i > 0; i--)
+    {
+        if (pContext->aClientPriority[pContext->aServiceOrder[i - 1]] <= ePriority)
+        {
+            break;
+        }
+        pContext->aServiceOrder[i] = pContext->aServiceOrder[i - 1];
+    }
+    pContext->aServiceOrder[i] = uClientId;
 
 #ifdef TI_DBG
     if (uNameSize <= MAX_NAME_SIZE) 
@@ -268,6 +310,10 @@ void context_RequestSchedule (TI_HANDLE hContext, TI_UINT32 uClientId)
 
 #ifdef TI_DBG
     pContext->aRequestCount[uClientId]++; 
+    if (!pContext->aClientPending[uClientId])
+    {
+        pContext->aClientStat[uClientId].uRequestTime = os_timeStampUs (pContext->hOs);
+    }
 #endif /* TI_DBG */
 
     /* Set client's Pending flag */
@@ -293,6 +339,52 @@ void context_RequestSchedule (TI_HANDLE hContext, TI_UINT32 uClientId)
 }
 
 
+/** 
+ * \fn     context_InvokeClient
+ * \brief  Invoke a pending client's callback
+ * 
+ * Clear the client's pending flag and call its callback (with run-time and latency statistics).
+ * 
+ * \note   
+ * \param  pContext  - The module object
+ * \param  uClientId - The client's ID
+ * \return void 
+ * \sa     context_DriverTask
+ */ 
+static void context_InvokeClient (TContext *pContext, TI_UINT32 uClientId)
+{
+#ifdef TI_DBG
+    TI_UINT32       uStartTime;
+    TI_UINT32       uRunTime;
+    TI_UINT32       uLatency;
+
+    pContext->aInvokeCount[uClientId]++;
+    uStartTime = os_timeStampUs (pContext->hOs);
+    uLatency   = uStartTime - pContext->aClientStat[uClientId].uRequestTime;
+    pContext->aClientStat[uClientId].uTotalLatency += uLatency;
+    if (uLatency > pContext->aClientStat[uClientId].uMaxLatency)
+    {
+        pContext->aClientStat[uClientId].uMaxLatency = uLatency;
+    }
+#endif /* TI_DBG */
+
+    /* Clear client's pending flag */
+    pContext->aClientPending[uClientId] = TI_FALSE;
+
+    /* Call client's callback function */
+    pContext->aClientCbFunc[uClientId] (pContext->aClientCbHndl[uClientId]);
+
+#ifdef TI_DBG
+    uRunTime = os_timeStampUs (pContext->hOs) - uStartTime;
+    pContext->aClientStat[uClientId].uTotalRunTime += uRunTime;
+    if (uRunTime > pContext->aClientStat[uClientId].uMaxRunTime)
+    {
+        pContext->aClientStat[uClientId].uMaxRunTime = uRunTime;
+    }
+#endif /* TI_DBG */
+}
+
+
 /** 
  * \fn     context_DriverTask
  * \brief  The driver task
@@ -300,6 +392,12 @@ void context_RequestSchedule (TI_HANDLE hContext, TI_UINT32 uClientId)
  * This function is the driver's main task that always runs in the driver's 
  * single context, scheduled through the OS (the driver's workqueue in Linux). 
  * Only one instantiation of this task may run at a time!
+ * First, the clients that were left pending and not served when the previous run yielded 
+ *   are invoked once each, so high priority clients that keep requesting can't starve them.
+ * Then, after each client invocation the clients are scanned again from the highest priority,
+ *   so a client that became pending meanwhile is served in the same run.
+ * The task returns when no enabled client is pending. When switching context, it also 
+ *   yields (and reschedules itself) if the task budget or a client's budget is exhausted.
  * 
  * \note   
  * \param  hContext   - The module handle
@@ -309,28 +407,107 @@ void context_RequestSchedule (TI_HANDLE hContext, TI_UINT32 uClientId)
 void context_DriverTask (TI_HANDLE hContext)
 {
 	TContext       *pContext = (TContext *)hContext;
-    TContextCbFunc  fCbFunc;
-    TI_HANDLE       hCbHndl;
+    TI_UINT32       aRunCount[MAX_CLIENTS];
+    TI_UINT32       uTotalRuns = 0;
+    TI_BOOL         bBudgets   = pContext->bContextSwitchRequired;
+    TI_BOOL         bDeferred  = TI_FALSE;
+    TI_UINT32       uOrder;
     TI_UINT32       i;
 
-    /* For all registered clients do: */
-	for (i = 0; i < pContext->uNumClients; i++)
+    os_memoryZero (pContext->hOs, aRunCount, sizeof(aRunCount));
+
+#ifdef TI_DBG
+    pContext->uTaskRuns++;
+#endif /* TI_DBG */
+
+    /* First serve the clients starved by the previous run, in priority order */
+    for (uOrder = 0; uOrder < pContext->uNumClients; uOrder++)
     {
-        /* If client is pending and enabled */
-        if (pContext->aClientPending[i]  &&  pContext->aClientEnabled[i])
+        i = pContext->aServiceOrder[uOrder];
+
+        if (pContext->aClientStarved[i])
+        {
+            pContext->aClientStarved[i] = TI_FALSE;
+            if (pContext->aClientPending[i]  &&  pContext->aClientEnabled[i])
+            {
+                #ifdef TI_DBG
+                    pContext->uStarvedRuns++;
+                #endif /* TI_DBG */
+                context_InvokeClient (pContext, i);
+                aRunCount[i]++;
+                uTotalRuns++;
+            }
+        }
+    }
+
+    /* Invoke the highest priority pending and enabled client, until none is left */
+    uOrder = 0;
+	while (uOrder < pContext->uNumClients)
+    {
+        i = pContext->aServiceOrder[uOrder];
+
+        /* If client is not pending or disabled, check the next one */
+        if (!pContext->aClientPending[i]  ||  !pContext->aClientEnabled[i])
+        {
+            uOrder++;
+            continue;
+        }
+
+        /* If the client has exhausted its budget, leave it pending for the next task run */
+        if (bBudgets  &&  pContext->aClientBudget[i] != CONTEXT_BUDGET_UNLIMITED  &&  
+            aRunCount[i] >= pContext->aClientBudget[i])
         {
             #ifdef TI_DBG
-                pContext->aInvokeCount[i]++;
+                pContext->aClientStat[i].uBudgetExceeded++;
             #endif /* TI_DBG */
+            bDeferred = TI_TRUE;
+            uOrder++;
+            continue;
+        }
 
-            /* Clear client's pending flag */
-            pContext->aClientPending[i] = TI_FALSE;
-
-            /* Call client's callback function */
-            fCbFunc = pContext->aClientCbFunc[i];
-            hCbHndl = pContext->aClientCbHndl[i];
-            fCbFunc(hCbHndl);
+        /* If the task budget is exhausted, mark the pending clients not served in this run and yield */
+        if (bBudgets  &&  uTotalRuns >= pContext->uTaskBudget)
+        {
+            for (uOrder = 0; uOrder < pContext->uNumClients; uOrder++)
+            {
+                i = pContext->aServiceOrder[uOrder];
+                if (pContext->aClientPending[i]  &&  pContext->aClientEnabled[i]  &&  (aRunCount[i] == 0))
+                {
+                    pContext->aClientStarved[i] = TI_TRUE;
+                }
+            }
+            bDeferred = TI_TRUE;
+            break;
         }
+
+        context_InvokeClient (pContext, i);
+
+        aRunCount[i]++;
+        uTotalRuns++;
+
+        /* Restart the scan from the highest priority client */
+        uOrder = 0;
+    }
+
+#ifdef TI_DBG
+    if (uTotalRuns > pContext->uMaxInvokesPerTask)
+    {
+        pContext->uMaxInvokesPerTask = uTotalRuns;
+    }
+#endif /* TI_DBG */
+
+    /* If clients were left pending due to budgets, reschedule the driver task to serve them */
+    if (bDeferred)
+    {
+        #ifdef TI_DBG
+            pContext->uTaskYields++;
+        #endif /* TI_DBG */
+
+        /* Prevent system from going to sleep */
+        os_wake_lock(pContext->hOs);
+
+        if (os_RequestSchedule(pContext->hOs) != TI_OK)
+            os_wake_unlock(pContext->hOs);
     }
 }
 
@@ -446,6 +623,42 @@ void context_LeaveCriticalSection (TI_HANDLE hContext)
 
 void context_Print(TI_HANDLE hContext)
 {
+    TContext    *pContext = (TContext *)hContext;
+    TClientStat *pStat;
+    TI_UINT32    uInvokes;
+    TI_UINT32    uOrder;
+    TI_UINT32    i;
+
+    WLAN_OS_REPORT(("context_Print:  %d Clients, ContextSwitch=%d, TaskBudget=%d\n", 
+                    pContext->uNumClients, pContext->bContextSwitchRequired, pContext->uTaskBudget));
+    WLAN_OS_REPORT(("TaskRuns=%d, TaskYields=%d, StarvedRuns=%d, MaxInvokesPerTask=%d\n", 
+                    pContext->uTaskRuns, pContext->uTaskYields, pContext->uStarvedRuns, pContext->uMaxInvokesPerTask));
+    WLAN_OS_REPORT(("-------------------------------------------------------------------------------------------------------\n"));
+    WLAN_OS_REPORT(("Id Name             Pri Budget En Pend Requests  Invokes  Deferred AvgRunUs MaxRunUs AvgLatUs MaxLatUs\n"));
+    WLAN_OS_REPORT(("-------------------------------------------------------------------------------------------------------\n"));
+
+    /* Print the clients in their service order */
+    for (uOrder = 0; uOrder < pContext->uNumClients; uOrder++)
+    {
+        i        = pContext->aServiceOrder[uOrder];
+        pStat    = &pContext->aClientStat[i];
+        uInvokes = pContext->aInvokeCount[i] ? pContext->aInvokeCount[i] : 1;
+
+        WLAN_OS_REPORT(("%2d %-16s %3d %6d %2d %4d %8d %8d %8d %8d %8d %8d %8d\n", 
+                        i,
+                        pContext->aClientName[i].sName,
+                        pContext->aClientPriority[i],
+                        pContext->aClientBudget[i],
+                        pContext->aClientEnabled[i],
+                        pContext->aClientPending[i],
+                        pContext->aRequestCount[i],
+                        pContext->aInvokeCount[i],
+                        pStat->uBudgetExceeded,
+                        pStat->uTotalRunTime / uInvokes,
+                        pStat->uMaxRunTime,
+                        pStat->uTotalLatency / uInvokes,
+                        pStat->uMaxLatency));
+    }
 }
 
 #endif /* TI_DBG */
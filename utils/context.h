@@ -47,11 +47,29 @@
 /* The callback function type for context clients */
 typedef void (*TContextCbFunc)(TI_HANDLE hCbHndl);
 
+/* 
+ * The context clients priorities (served from high to low). 
+ * Clients with the same priority are served in their registration order.
+ */
+typedef enum
+{
+    CONTEXT_PRIORITY_HIGH   = 0,    /* FW events (Rx) and bus transactions completion */
+    CONTEXT_PRIORITY_MEDIUM = 1,    /* Tx and timers */
+    CONTEXT_PRIORITY_LOW    = 2,    /* Driver actions and user commands */
+    CONTEXT_NUM_PRIORITIES
+
+} EContextPriority;
+
+/* A client budget value for no limit on the client invocations per driver task run */
+#define CONTEXT_BUDGET_UNLIMITED    0
+
 /* The context init parameters */
 typedef struct
 {
     /* Indicate if the driver should switch to its own context or not before handling events */
     TI_BOOL   bContextSwitchRequired;  
+    /* Max clients invocations in one driver task run before yielding (if switching context) */
+    TI_UINT32 uTaskBudget;
 } TContextInitParams;
 
 
@@ -67,6 +85,8 @@ TI_UINT32 context_RegisterClient (TI_HANDLE       hContext,
                                   TContextCbFunc  fCbFunc,
                                   TI_HANDLE       hCbHndl,
                                   TI_BOOL         bEnable,
+                                  EContextPriority ePriority,
+                                  TI_UINT32       uBudget,
                                   char           *sName,
                                   TI_UINT32       uNameSize);
 
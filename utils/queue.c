@@ -303,6 +303,31 @@ TI_HANDLE que_Dequeue (TI_HANDLE hQue)
 }
 
 
+/** 
+ * \fn     que_Peek
+ * \brief  Get the first item without dequeuing it 
+ * 
+ * Return the item at the queue's tail (first in queue), leaving it in the queue.
+ * 
+ * \note   
+ * \param  hQue - The queue object
+ * \return pointer to the first item or NULL if queue is empty
+ * \sa     que_Dequeue
+ */ 
+TI_HANDLE que_Peek (TI_HANDLE hQue)
+{
+    TQueue *pQue = (TQueue *)hQue;
+
+    if (pQue->uCount)
+    {
+        return (TI_HANDLE)((TI_UINT8*)pQue->tHead.pPrev - pQue->uNodeHeaderOffset);
+    }
+
+    /* Queue is empty */
+    return NULL;
+}
+
+
 /** 
  * \fn     que_Requeue
  * \brief  Requeue an item 
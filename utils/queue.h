@@ -61,6 +61,7 @@ TI_HANDLE que_Create  (TI_HANDLE hOs, TI_HANDLE hReport, TI_UINT32 uLimit, TI_UI
 TI_STATUS que_Destroy (TI_HANDLE hQue);
 TI_STATUS que_Enqueue (TI_HANDLE hQue, TI_HANDLE hItem);
 TI_HANDLE que_Dequeue (TI_HANDLE hQue);
+TI_HANDLE que_Peek    (TI_HANDLE hQue);
 TI_STATUS que_Requeue (TI_HANDLE hQue, TI_HANDLE hItem);
 TI_UINT32 que_Size    (TI_HANDLE hQue);
 
@@ -210,6 +210,8 @@ typedef enum
     FILE_ID_136	   ,    /*   roamingMngr_manualSM     */
 	FILE_ID_137	   ,    /*   cmdinterpretoid          */
     FILE_ID_138	   ,    /*   wlandrvif                */
+    FILE_ID_139	   ,    /*   ring                     */
+    FILE_ID_140	   ,    /*   StatsPage                */
 	REPORT_FILES_NUM	/*   Number of files with trace reports   */
 
 } EReportFiles;
@@ -0,0 +1,310 @@
+/*
+ * ring.c
+ *
+ * Copyright(c) 1998 - 2009 Texas Instruments. All rights reserved.      
+ * All rights reserved.                                                  
+ *                                                                       
+ * Redistribution and use in source and binary forms, with or without    
+ * modification, are permitted provided that the following conditions    
+ * are met:                                                              
+ *                                                                       
+ *  * Redistributions of source code must retain the above copyright     
+ *    notice, this list of conditions and the following disclaimer.      
+ *  * Redistributions in binary form must reproduce the above copyright  
+ *    notice, this list of conditions and the following disclaimer in    
+ *    the documentation and/or other materials provided with the         
+ *    distribution.                                                      
+ *  * Neither the name Texas Instruments nor the names of its            
+ *    contributors may be used to endorse or promote products derived    
+ *    from this software without specific prior written permission.      
+ *                                                                       
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS   
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT     
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT      
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT   
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file   ring.c 
+ *  \brief  This module provides a bounded lock-free ring of item handles, for one producer 
+ *            context and one consumer context that may run concurrently on different CPUs.
+ *
+ *  The producer owns the tail index and the consumer owns the head index (both are free running).
+ *  Each side only reads the other side's index, with acquire/release barriers around the index
+ *    updates, so no lock is needed as long as there is a single producer and a single consumer.
+ *  The two indexes are kept in separate cache lines to avoid false sharing between the CPUs.
+ *
+ *  \see    ring.h
+ */
+
+
+
+#define __FILE_ID__  FILE_ID_139
+#include "report.h"
+#include "ring.h"
+
+
+/* Ring structure */
+typedef struct 
+{
+    /* Read-only after creation */
+    TI_HANDLE           *aItems;        /* The items array (size is a power of 2) */
+    TI_UINT32           uMask;          /* Items array size - 1 */
+    TI_UINT32           uLimit;         /* Upper limit of items in ring */
+    TI_UINT32           uArraySize;     /* Allocated items array size in bytes */
+	TI_HANDLE           hOs;
+    TI_UINT8            aPad0[RING_CACHE_LINE_SIZE];
+
+    /* Producer side */
+    volatile TI_UINT32  uTail;          /* Next index to write (written by producer only) */
+    TI_UINT32           uMaxCount;      /* Maximum items count (for debug) */
+    TI_UINT32           uOverflow;      /* Number of overflow occurences - couldn't insert item (for debug) */
+    TI_UINT8            aPad1[RING_CACHE_LINE_SIZE - 3 * sizeof(TI_UINT32)];
+
+    /* Consumer side */
+    volatile TI_UINT32  uHead;          /* Next index to read (written by consumer only) */
+    TI_UINT8            aPad2[RING_CACHE_LINE_SIZE - sizeof(TI_UINT32)];
+} TRing;	
+
+
+
+/*
+ *              EXTERNAL  FUNCTIONS 
+ *        =============================== 
+ */
+
+
+/** 
+ * \fn     ring_Create 
+ * \brief  Create a ring. 
+ * 
+ * Allocate and init a ring object.
+ * The items array size is rounded up to a power of 2, so indexes are wrapped with a mask.
+ * 
+ * \note    
+ * \param  hOs    - Handle to Os Abstraction Layer
+ * \param  uLimit - Maximum items to store in ring
+ * \return Handle to the allocated ring 
+ * \sa     ring_Destroy
+ */ 
+TI_HANDLE ring_Create (TI_HANDLE hOs, TI_UINT32 uLimit)
+{
+	TRing     *pRing;
+    TI_UINT32  uSize = 1;
+
+    if (uLimit == 0)
+    {
+        return NULL;
+    }
+
+    while (uSize < uLimit)
+    {
+        uSize <<= 1;
+    }
+
+	/* allocate ring module */
+	pRing = os_memoryAlloc (hOs, sizeof(TRing));
+	if (!pRing)
+	{
+		return NULL;
+	}
+    os_memoryZero (hOs, pRing, sizeof(TRing));
+
+	/* allocate items array */
+    pRing->uArraySize = uSize * sizeof(TI_HANDLE);
+    pRing->aItems = os_memoryAlloc (hOs, pRing->uArraySize);
+	if (!pRing->aItems)
+	{
+        os_memoryFree (hOs, pRing, sizeof(TRing));
+		return NULL;
+	}
+    os_memoryZero (hOs, pRing->aItems, pRing->uArraySize);
+
+	/* Set the ring parameters */
+    pRing->hOs    = hOs;
+    pRing->uMask  = uSize - 1;
+	pRing->uLimit = uLimit;
+
+	return (TI_HANDLE)pRing;
+}
+
+
+/** 
+ * \fn     ring_Destroy
+ * \brief  Destroy the ring. 
+ * 
+ * Free the ring memory.
+ * 
+ * \note   The ring's owner should first free the items in the ring!
+ * \param  hRing - The ring object
+ * \return TI_OK on success or TI_NOK on failure 
+ * \sa     ring_Create
+ */ 
+TI_STATUS ring_Destroy (TI_HANDLE hRing)
+{
+    TRing *pRing = (TRing *)hRing;
+
+    os_memoryFree (pRing->hOs, pRing->aItems, pRing->uArraySize);
+	os_memoryFree (pRing->hOs, pRing, sizeof(TRing));
+	
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     ring_Put
+ * \brief  Put item in ring tail. 
+ * 
+ * Write the item to the tail slot and then publish it by advancing the tail index.
+ * 
+ * \note   May be called only from the producer context!
+ * \param  hRing - The ring object
+ * \param  hItem - Handle to the item to put in the ring
+ * \return TI_OK if item was inserted, or TI_NOK if the ring is full
+ * \sa     ring_Get
+ */ 
+TI_STATUS ring_Put (TI_HANDLE hRing, TI_HANDLE hItem)
+{
+    TRing     *pRing = (TRing *)hRing;
+    TI_UINT32  uTail = pRing->uTail;
+    TI_UINT32  uCount;
+
+    /* Read the consumer index before reusing its slots */
+    uCount = uTail - pRing->uHead;
+    os_memoryBarrierAcquire (pRing->hOs);
+
+    if (uCount >= pRing->uLimit)
+    {
+#ifdef TI_DBG
+        pRing->uOverflow++;
+#endif /* TI_DBG */
+        return TI_NOK;
+    }
+
+    pRing->aItems[uTail & pRing->uMask] = hItem;
+
+    /* Publish the item only after it is written */
+    os_memoryBarrierRelease (pRing->hOs);
+    pRing->uTail = uTail + 1;
+
+#ifdef TI_DBG
+    if (uCount + 1 > pRing->uMaxCount)
+    {
+        pRing->uMaxCount = uCount + 1;
+    }
+#endif /* TI_DBG */
+
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     ring_Get
+ * \brief  Get item from ring head. 
+ * 
+ * Read the item in the head slot and then release the slot by advancing the head index.
+ * 
+ * \note   May be called only from the consumer context!
+ * \param  hRing - The ring object
+ * \return Handle to the item from the ring head, or NULL if the ring is empty
+ * \sa     ring_Put, ring_Peek
+ */ 
+TI_HANDLE ring_Get (TI_HANDLE hRing)
+{
+    TRing     *pRing = (TRing *)hRing;
+    TI_UINT32  uHead = pRing->uHead;
+    TI_HANDLE  hItem;
+
+    if (pRing->uTail == uHead)
+    {
+        return NULL;
+    }
+
+    /* Read the item only after the tail index that published it */
+    os_memoryBarrierAcquire (pRing->hOs);
+    hItem = pRing->aItems[uHead & pRing->uMask];
+
+    /* Release the slot to the producer only after the item is read */
+    os_memoryBarrierRelease (pRing->hOs);
+    pRing->uHead = uHead + 1;
+
+    return hItem;
+}
+
+
+/** 
+ * \fn     ring_Peek
+ * \brief  Get the item in the ring head without removing it. 
+ * 
+ * \note   May be called only from the consumer context!
+ * \param  hRing - The ring object
+ * \return Handle to the item in the ring head, or NULL if the ring is empty
+ * \sa     ring_Get
+ */ 
+TI_HANDLE ring_Peek (TI_HANDLE hRing)
+{
+    TRing     *pRing = (TRing *)hRing;
+    TI_UINT32  uHead = pRing->uHead;
+
+    if (pRing->uTail == uHead)
+    {
+        return NULL;
+    }
+
+    os_memoryBarrierAcquire (pRing->hOs);
+
+    return pRing->aItems[uHead & pRing->uMask];
+}
+
+
+/** 
+ * \fn     ring_Size
+ * \brief  Return number of items in ring. 
+ * 
+ * \note   When called from one side, the value may only grow (consumer) or shrink (producer) 
+ *           concurrently by the other side.
+ * \param  hRing - The ring object
+ * \return TI_UINT32 - the items count
+ * \sa     
+ */ 
+TI_UINT32 ring_Size (TI_HANDLE hRing)
+{
+    TRing     *pRing = (TRing *)hRing;
+    TI_UINT32  uHead = pRing->uHead;
+
+    return pRing->uTail - uHead;
+}
+
+	
+/** 
+ * \fn     ring_Print
+ * \brief  Print ring status
+ * 
+ * Print the ring's parameters (not the content).
+ * 
+ * \note   
+ * \param  hRing - The ring object
+ * \return void
+ * \sa     
+ */ 
+
+#ifdef TI_DBG
+
+void ring_Print(TI_HANDLE hRing)
+{
+    TRing *pRing = (TRing *)hRing;
+
+    WLAN_OS_REPORT(("ring_Print: Count=%u, MaxCount=%u, Limit=%u, Overflow=%u, Head=%u, Tail=%u\n", 
+                    pRing->uTail - pRing->uHead, pRing->uMaxCount, pRing->uLimit, 
+                    pRing->uOverflow, pRing->uHead, pRing->uTail));
+}
+
+#endif /* TI_DBG */
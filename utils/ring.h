@@ -0,0 +1,67 @@
+/*
+ * ring.h
+ *
+ * Copyright(c) 1998 - 2009 Texas Instruments. All rights reserved.      
+ * All rights reserved.                                                  
+ *                                                                       
+ * Redistribution and use in source and binary forms, with or without    
+ * modification, are permitted provided that the following conditions    
+ * are met:                                                              
+ *                                                                       
+ *  * Redistributions of source code must retain the above copyright     
+ *    notice, this list of conditions and the following disclaimer.      
+ *  * Redistributions in binary form must reproduce the above copyright  
+ *    notice, this list of conditions and the following disclaimer in    
+ *    the documentation and/or other materials provided with the         
+ *    distribution.                                                      
+ *  * Neither the name Texas Instruments nor the names of its            
+ *    contributors may be used to endorse or promote products derived    
+ *    from this software without specific prior written permission.      
+ *                                                                       
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS   
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT     
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT      
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT   
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file   ring.h 
+ *  \brief  Lock-free single-producer/single-consumer ring module header file.                                  
+ *
+ *  \see    ring.c
+ */
+
+
+#ifndef _RING_H_
+#define _RING_H_
+
+
+/* The cache line size used to separate the producer and consumer fields of the ring */
+#define RING_CACHE_LINE_SIZE    64
+
+
+
+/* External Functions Prototypes */
+/* ============================= */
+TI_HANDLE ring_Create  (TI_HANDLE hOs, TI_UINT32 uLimit);
+TI_STATUS ring_Destroy (TI_HANDLE hRing);
+TI_STATUS ring_Put     (TI_HANDLE hRing, TI_HANDLE hItem);
+TI_HANDLE ring_Get     (TI_HANDLE hRing);
+TI_HANDLE ring_Peek    (TI_HANDLE hRing);
+TI_UINT32 ring_Size    (TI_HANDLE hRing);
+
+#ifdef TI_DBG
+void      ring_Print   (TI_HANDLE hRing);
+#endif /* TI_DBG */
+
+
+
+#endif  /* _RING_H_ */
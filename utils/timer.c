@@ -49,6 +49,27 @@
 
 #define EXPIRY_QUE_SIZE  QUE_UNLIMITED_SIZE
 
+#define INIT_TICK_MSEC   10  /* The tick used until configured (see tmr_SetDefaults) */
+
+/* 
+ * Timer wheel:
+ * All timers are kept in a two level hashed wheel driven by a single OS timer.
+ * Level 0 has a slot per tick for the next WHEEL0_SLOTS ticks, and level 1 has a slot per 
+ *   WHEEL0_SLOTS ticks. A level 1 slot is cascaded into level 0 when level 0 wraps.
+ * The OS timer is armed only for the nearest expiry (or cascade), so no ticks run while idle.
+ */
+#define WHEEL0_BITS     8
+#define WHEEL0_SLOTS    (1 << WHEEL0_BITS)
+#define WHEEL0_MASK     (WHEEL0_SLOTS - 1)
+#define WHEEL1_BITS     6
+#define WHEEL1_SLOTS    (1 << WHEEL1_BITS)
+#define WHEEL1_MASK     (WHEEL1_SLOTS - 1)
+
+/* Signed distance in ticks from uTick1 to uTick2 (wrap safe) */
+#define TICKS_DIFF(uTick2, uTick1)  ((TI_INT32)((uTick2) - (uTick1)))
+
+struct _TTimerInfo;
+
 /* The timer module structure (common to all timers) */
 typedef struct 
 {
@@ -61,13 +82,39 @@ typedef struct
     TI_BOOL     bOperState;     /* TRUE when the driver is in operational state (not init or recovery) */
     TI_UINT32   uTwdInitCount;  /* Increments on each TWD init (i.e. recovery) */
     TI_UINT32   uTimersCount;   /* Number of created timers */
+
+    /* Timer wheel */
+    TI_HANDLE   hWheelLock;     /* Protects the wheel (nested inside the context critical section if both are used) */
+    TI_HANDLE   hOsTimerObj;    /* The single OS-API timer driving the wheel */
+    TI_UINT32   uTickMsec;      /* The wheel tick duration in Msec */
+    TI_UINT32   uNewTickMsec;   /* A configured tick duration applied when the wheel is empty */
+    TI_UINT32   uTickBaseMs;    /* The OS monotonic time stamp of the start of uNowTick */
+    TI_UINT32   uNowTick;       /* The current tick according to the OS time */
+    TI_UINT32   uCurrTick;      /* The last tick processed by the wheel */
+    TI_BOOL     bOsTimerArmed;  /* TRUE if the OS timer is running */
+    TI_UINT32   uArmedTick;     /* The tick the OS timer is armed for */
+    TI_UINT32   aLevelCount[2]; /* Number of timers in each wheel level */
+    struct _TTimerInfo *aWheel0[WHEEL0_SLOTS];
+    struct _TTimerInfo *aWheel1[WHEEL1_SLOTS];
+
+#ifdef TI_DBG
+    TI_UINT32   uOsTimerStarts; /* Number of OS timer (re)starts */
+    TI_UINT32   uTickPasses;    /* Number of OS timer expiries handled */
+    TI_UINT32   uExpiries;      /* Number of timers expiries */
+    TI_UINT32   uMaxExpiriesPerPass; /* Max timers expired in a single OS timer expiry */
+    TI_UINT32   uCascades;      /* Number of timers moved from level 1 to level 0 */
+#endif
 } TTimerModule;	
 
 /* Per timer structure */
-typedef struct 
+typedef struct _TTimerInfo
 {
     TI_HANDLE    hTimerModule;             /* The timer module handle (see TTimerModule, needed on expiry) */
-    TI_HANDLE    hOsTimerObj;              /* The OS-API timer object handle */
+    struct _TTimerInfo  *pNext;            /* Next timer in the same wheel slot */
+    struct _TTimerInfo **ppPrevNext;       /* Pointer to the pointer to this timer in the slot list (NULL if not in the wheel) */
+    struct _TTimerInfo  *pNextExpired;     /* Next timer in the list of timers expired in the same OS timer expiry */
+    TI_UINT32    uExpiryTick;              /* The wheel tick on which the timer expires */
+    TI_UINT32    uWheelLevel;              /* The wheel level the timer is linked in */
     TQueNodeHdr  tQueNodeHdr;              /* The header used for queueing the timer */
     TTimerCbFunc fExpiryCbFunc;            /* The CB-function provided by the timer user for expiration */
     TI_HANDLE    hExpiryCbHndl;            /* The CB-function handle */
@@ -84,28 +131,40 @@ typedef struct
  * \fn     tmr_Create 
  * \brief  Create the timer module
  * 
- * Allocate and clear the timer module object.
+ * Allocate and clear the timer module object, and create the timer wheel lock.
  * 
  * \note   This is NOT a specific timer creation! (see tmr_CreateTimer)
  * \param  hOs - Handle to Os Abstraction Layer
- * \return Handle of the allocated object 
+ * \return Handle of the allocated object, or NULL on failure 
  * \sa     tmr_Destroy
  */ 
 TI_HANDLE tmr_Create (TI_HANDLE hOs)
 {
-	TI_HANDLE hTimerModule;
+	TTimerModule *pTimerModule;
 
 	/* allocate module object */
-	hTimerModule = os_memoryAlloc (hOs, sizeof(TTimerModule));
+	pTimerModule = os_memoryAlloc (hOs, sizeof(TTimerModule));
 	
-	if (!hTimerModule)
+	if (!pTimerModule)
 	{
 		return NULL;
 	}
 	
-    os_memoryZero (hOs, hTimerModule, (sizeof(TTimerModule)));
+    os_memoryZero (hOs, pTimerModule, (sizeof(TTimerModule)));
 
-	return (hTimerModule);
+    /* 
+     * The wheel needs its own lock - the shared driver lock (used if no lock is created) may 
+     *   be held around the timers callbacks, so fail instead of falling back to it.
+     */
+    pTimerModule->hOs        = hOs;
+    pTimerModule->hWheelLock = os_protectCreate (hOs);
+    if (!pTimerModule->hWheelLock)
+    {
+        os_memoryFree (hOs, pTimerModule, sizeof(TTimerModule));
+        return NULL;
+    }
+
+	return ((TI_HANDLE)pTimerModule);
 }
 
 
@@ -133,6 +192,17 @@ TI_STATUS tmr_Destroy (TI_HANDLE hTimerModule)
 //    tmr_ClearInitQueue (hTimerModule);
 //    tmr_ClearOperQueue (hTimerModule);
 
+    /* Stop and free the wheel OS timer and lock */
+    if (pTimerModule->hOsTimerObj)
+    {
+        os_timerStop (pTimerModule->hOs, pTimerModule->hOsTimerObj);
+        os_timerDestroy (pTimerModule->hOs, pTimerModule->hOsTimerObj);
+    }
+    if (pTimerModule->hWheelLock)
+    {
+        os_protectDestroy (pTimerModule->hOs, pTimerModule->hWheelLock);
+    }
+
     /* Destroy the module's queues (protect in critical section)) */
     context_EnterCriticalSection (pTimerModule->hContext);
     que_Destroy (pTimerModule->hInitQueue);
@@ -158,6 +228,11 @@ TI_STATUS tmr_Free(TI_HANDLE hTimerModule)
 {
     TTimerModule *pTimerModule = (TTimerModule *)hTimerModule;
 
+    if (pTimerModule->hWheelLock)
+    {
+        os_protectDestroy (pTimerModule->hOs, pTimerModule->hWheelLock);
+    }
+
     /* free module object */
 	os_memoryFree (pTimerModule->hOs, pTimerModule, sizeof(TTimerModule));
 	
@@ -200,7 +275,7 @@ void tmr_ClearOperQueue (TI_HANDLE hTimerModule)
  * \brief  Init required handles 
  * 
  * Init required handles and module variables, create the init-queue and 
- *     operational-queue, and register as the context-engine client.
+ *     operational-queue, create the OS timer, and register as the context-engine client.
  * 
  * \note    
  * \param  hTimerModule  - The queue object
@@ -223,6 +298,15 @@ void tmr_Init (TI_HANDLE hTimerModule, TI_HANDLE hOs, TI_HANDLE hReport, TI_HAND
     pTimerModule->uTimersCount  = 0;
     pTimerModule->uTwdInitCount = 0;
 
+    /* Init the timer wheel with the default tick until configured (see tmr_SetDefaults) */
+    pTimerModule->uTickMsec     = INIT_TICK_MSEC;
+    pTimerModule->uNewTickMsec  = INIT_TICK_MSEC;
+    pTimerModule->uTickBaseMs   = os_timeStampMonoMs (hOs);
+    pTimerModule->uNowTick      = 0;
+    pTimerModule->uCurrTick     = 0;
+    pTimerModule->bOsTimerArmed = TI_FALSE;
+    pTimerModule->hOsTimerObj   = os_timerCreate (hOs, tmr_GetExpiry, hTimerModule);
+
     /* The offset of the queue-node-header from timer structure entry is needed by the queue */
     uNodeHeaderOffset = TI_FIELD_OFFSET(TTimerInfo, tQueNodeHdr); 
 
@@ -241,11 +325,64 @@ void tmr_Init (TI_HANDLE hTimerModule, TI_HANDLE hOs, TI_HANDLE hReport, TI_HAND
                                                        tmr_HandleExpiry,
                                                        hTimerModule,
                                                        TI_TRUE,
+                                                       CONTEXT_PRIORITY_MEDIUM,
+                                                       CONTEXT_BUDGET_UNLIMITED,
                                                        "TIMER",
                                                        sizeof("TIMER"));
 }
 
 
+/** 
+ * \fn     tmr_SetDefaults 
+ * \brief  Configure the timer module 
+ * 
+ * Set the timer wheel tick duration.
+ * If timers are already running, the new tick is applied once the wheel is empty
+ *   (the running timers expiry ticks are based on the current tick).
+ * 
+ * \note    
+ * \param  hTimerModule      - The timer module object
+ * \param  pTimerInitParams  - The timer module init parameters
+ * \return TI_OK
+ * \sa     
+ */ 
+TI_STATUS tmr_SetDefaults (TI_HANDLE hTimerModule, TTimerInitParams *pTimerInitParams)
+{
+	TTimerModule *pTimerModule = (TTimerModule *)hTimerModule;
+
+    os_protectLock (pTimerModule->hOs, pTimerModule->hWheelLock);
+
+    pTimerModule->uNewTickMsec = pTimerInitParams->uTickMsec;
+    if ((pTimerModule->aLevelCount[0] == 0) && (pTimerModule->aLevelCount[1] == 0))
+    {
+        pTimerModule->uTickMsec = pTimerModule->uNewTickMsec;
+    }
+
+    os_protectUnlock (pTimerModule->hOs, pTimerModule->hWheelLock);
+
+    return TI_OK;
+}
+
+
+/** 
+ * \fn     tmr_GetTickMsec 
+ * \brief  Get the timers expiry resolution 
+ * 
+ * Return the configured wheel tick duration. Timers intervals are rounded up to it.
+ * 
+ * \note    
+ * \param  hTimerModule - The timer module object
+ * \return The tick duration in Msec  
+ * \sa     tmr_SetDefaults
+ */ 
+TI_UINT32 tmr_GetTickMsec (TI_HANDLE hTimerModule)
+{
+	TTimerModule *pTimerModule = (TTimerModule *)hTimerModule;
+
+    return pTimerModule->uNewTickMsec;
+}
+
+
 /** 
  * \fn     tmr_UpdateDriverState 
  * \brief  Update driver state 
@@ -299,11 +436,132 @@ void tmr_UpdateDriverState (TI_HANDLE hTimerModule, TI_BOOL bOperState)
 
 
 
+/** 
+ * \fn     tmr_WheelUpdateNow
+ * \brief  Update the current tick according to the OS time
+ * 
+ * \note   Called within the wheel lock.
+ * \param  pTimerModule - The timer module object
+ * \return void
+ * \sa     
+ */ 
+static void tmr_WheelUpdateNow (TTimerModule *pTimerModule)
+{
+    TI_UINT32 uTicks = (os_timeStampMonoMs (pTimerModule->hOs) - pTimerModule->uTickBaseMs) / pTimerModule->uTickMsec;
+
+    pTimerModule->uNowTick    += uTicks;
+    pTimerModule->uTickBaseMs += uTicks * pTimerModule->uTickMsec;
+}
+
+
+/** 
+ * \fn     tmr_WheelInsert / tmr_WheelRemove
+ * \brief  Link / Unlink a timer in the wheel slot of its expiry tick
+ * 
+ * A timer expiring in less than WHEEL0_SLOTS ticks from the last processed tick is put in level 0,
+ *   else in level 1 (the farthest slot if beyond the level 1 span, and reinserted on cascade).
+ * 
+ * \note   Called within the wheel lock.
+ * \param  pTimerModule - The timer module object
+ * \param  pTimerInfo   - The timer
+ * \return void
+ * \sa     
+ */ 
+static void tmr_WheelInsert (TTimerModule *pTimerModule, TTimerInfo *pTimerInfo)
+{
+    TI_UINT32    uDelta = pTimerInfo->uExpiryTick - pTimerModule->uCurrTick;
+    TTimerInfo **ppSlot;
+
+    if (uDelta < WHEEL0_SLOTS)
+    {
+        ppSlot = &pTimerModule->aWheel0[pTimerInfo->uExpiryTick & WHEEL0_MASK];
+        pTimerInfo->uWheelLevel = 0;
+    }
+    else 
+    {
+        if ((uDelta >> WHEEL0_BITS) < WHEEL1_SLOTS)
+        {
+            ppSlot = &pTimerModule->aWheel1[(pTimerInfo->uExpiryTick >> WHEEL0_BITS) & WHEEL1_MASK];
+        }
+        else 
+        {
+            /* The current level 1 slot is the last to be cascaded */
+            ppSlot = &pTimerModule->aWheel1[(pTimerModule->uCurrTick >> WHEEL0_BITS) & WHEEL1_MASK];
+        }
+        pTimerInfo->uWheelLevel = 1;
+    }
+    pTimerModule->aLevelCount[pTimerInfo->uWheelLevel]++;
+
+    /* Add to the slot list head */
+    pTimerInfo->pNext = *ppSlot;
+    if (pTimerInfo->pNext)
+    {
+        pTimerInfo->pNext->ppPrevNext = &pTimerInfo->pNext;
+    }
+    *ppSlot = pTimerInfo;
+    pTimerInfo->ppPrevNext = ppSlot;
+}
+
+static void tmr_WheelRemove (TTimerModule *pTimerModule, TTimerInfo *pTimerInfo)
+{
+    pTimerModule->aLevelCount[pTimerInfo->uWheelLevel]--;
+
+    *pTimerInfo->ppPrevNext = pTimerInfo->pNext;
+    if (pTimerInfo->pNext)
+    {
+        pTimerInfo->pNext->ppPrevNext = pTimerInfo->ppPrevNext;
+    }
+    pTimerInfo->pNext      = NULL;
+    pTimerInfo->ppPrevNext = NULL;
+}
+
+
+/** 
+ * \fn     tmr_WheelArm
+ * \brief  Arm the OS timer for the given tick
+ * 
+ * Start the OS timer if it is not running or is armed for a later tick.
+ * 
+ * \note   Called within the wheel lock, after tmr_WheelUpdateNow.
+ * \param  pTimerModule - The timer module object
+ * \param  uTick        - The tick to wake up on
+ * \return void
+ * \sa     
+ */ 
+static void tmr_WheelArm (TTimerModule *pTimerModule, TI_UINT32 uTick)
+{
+    TI_INT32  iTicks;
+    TI_UINT32 uDelayMs;
+
+    if (pTimerModule->bOsTimerArmed && (TICKS_DIFF(uTick, pTimerModule->uArmedTick) >= 0))
+    {
+        return;
+    }
+
+    iTicks = TICKS_DIFF(uTick, pTimerModule->uNowTick);
+    if (iTicks < 1)
+    {
+        iTicks = 1;
+    }
+
+    /* The delay is counted from the start of the current tick (uTickBaseMs) */
+    uDelayMs = (TI_UINT32)iTicks * pTimerModule->uTickMsec - 
+               (os_timeStampMonoMs (pTimerModule->hOs) - pTimerModule->uTickBaseMs);
+
+    pTimerModule->bOsTimerArmed = TI_TRUE;
+    pTimerModule->uArmedTick    = uTick;
+    os_timerStart (pTimerModule->hOs, pTimerModule->hOsTimerObj, uDelayMs);
+#ifdef TI_DBG
+    pTimerModule->uOsTimerStarts++;
+#endif
+}
+
+
 /** 
  * \fn     tmr_CreateTimer
  * \brief  Create a new timer
  * 
- * Create a new timer object, icluding creating a timer in the OS-API.  
+ * Create a new timer object (linked to the timer wheel when started).  
  * 
  * \note   This timer creation may be used only after tmr_Create() and tmr_Init() were executed!!
  * \param  hTimerModule - The module handle
@@ -323,14 +581,6 @@ TI_HANDLE tmr_CreateTimer (TI_HANDLE hTimerModule)
 	}
     os_memoryZero (pTimerModule->hOs, pTimerInfo, (sizeof(TTimerInfo)));
 
-    /* Allocate OS-API timer, providing the common expiry callback with the current timer handle */
-    pTimerInfo->hOsTimerObj = os_timerCreate(pTimerModule->hOs, tmr_GetExpiry, (TI_HANDLE)pTimerInfo);
-	if (!pTimerInfo->hOsTimerObj)
-	{
-        os_memoryFree (pTimerModule->hOs, pTimerInfo, sizeof(TTimerInfo));
-		return NULL;
-	}
-
     /* Save the timer module handle in the created timer object (needed for the expiry callback) */
     pTimerInfo->hTimerModule = hTimerModule;
     pTimerModule->uTimersCount++;  /* count created timers */
@@ -344,7 +594,7 @@ TI_HANDLE tmr_CreateTimer (TI_HANDLE hTimerModule)
  * \fn     tmr_DestroyTimer
  * \brief  Destroy the specified timer
  * 
- * Destroy the specified timer object, icluding the timer in the OS-API.  
+ * Destroy the specified timer object, after removing it from the timer wheel if running.  
  * 
  * \note   This timer destruction function should be used before tmr_Destroy() is executed!!
  * \param  hTimerInfo - The timer handle
@@ -356,8 +606,13 @@ TI_STATUS tmr_DestroyTimer (TI_HANDLE hTimerInfo)
     TTimerInfo   *pTimerInfo   = (TTimerInfo *)hTimerInfo;                 /* The timer handle */     
 	TTimerModule *pTimerModule = (TTimerModule *)pTimerInfo->hTimerModule; /* The timer module handle */
 
-    /* Free the OS-API timer */
-    os_timerDestroy (pTimerModule->hOs, pTimerInfo->hOsTimerObj);
+    /* Remove the timer from the wheel */
+    os_protectLock (pTimerModule->hOs, pTimerModule->hWheelLock);
+    if (pTimerInfo->ppPrevNext)
+    {
+        tmr_WheelRemove (pTimerModule, pTimerInfo);
+    }
+    os_protectUnlock (pTimerModule->hOs, pTimerModule->hWheelLock);
 
     /* Free the timer object */
     os_memoryFree (pTimerModule->hOs, hTimerInfo, sizeof(TTimerInfo));
@@ -374,6 +629,8 @@ TI_STATUS tmr_DestroyTimer (TI_HANDLE hTimerInfo)
  * \brief  Start a timer
  * 
  * Start the specified timer running.
+ * The timer is linked to the timer wheel slot of its expiry tick (restarted if already running),
+ *   and the wheel OS timer is re-armed only if this timer expires before its current setting.
  * 
  * \note   Periodic-Timer may be used by applications that serve the timer expiry 
  *           in a single context.
@@ -381,6 +638,7 @@ TI_STATUS tmr_DestroyTimer (TI_HANDLE hTimerInfo)
  *           e.g. periodic scan, then it isn't recommended to use the periodic timer service.
  *         If such an application uses the periodic timer then it should protect itself from cases
  *            where the timer expires again before the previous timer expiry processing is finished!!
+ *         The expiry is rounded to the wheel tick (see tmr_SetDefaults).
  * \param  hTimerInfo    - The specific timer handle
  * \param  fExpiryCbFunc - The timer's expiry callback function.
  * \param  hExpiryCbHndl - The client's expiry callback function handle.
@@ -397,6 +655,9 @@ void tmr_StartTimer (TI_HANDLE     hTimerInfo,
 {
     TTimerInfo   *pTimerInfo   = (TTimerInfo *)hTimerInfo;                 /* The timer handle */     
 	TTimerModule *pTimerModule = (TTimerModule *)pTimerInfo->hTimerModule; /* The timer module handle */
+    TI_UINT32     uTicks;
+
+    os_protectLock (pTimerModule->hOs, pTimerModule->hWheelLock);
 
     /* Save the timer parameters. */
     pTimerInfo->fExpiryCbFunc            = fExpiryCbFunc;
@@ -406,8 +667,30 @@ void tmr_StartTimer (TI_HANDLE     hTimerInfo,
     pTimerInfo->bOperStateWhenStarted    = pTimerModule->bOperState;
     pTimerInfo->uTwdInitCountWhenStarted = pTimerModule->uTwdInitCount;
 
-    /* Start OS-API timer running */
-    os_timerStart(pTimerModule->hOs, pTimerInfo->hOsTimerObj, uIntervalMsec);
+    /* If already running, remove it from its current slot */
+    if (pTimerInfo->ppPrevNext)
+    {
+        tmr_WheelRemove (pTimerModule, pTimerInfo);
+    }
+
+    /* 
+     * Link the timer to the wheel slot of its expiry tick (at least one tick from now).
+     * The interval is counted from the current time, which may be past the tick start.
+     */
+    tmr_WheelUpdateNow (pTimerModule);
+    uTicks = (uIntervalMsec + (os_timeStampMonoMs (pTimerModule->hOs) - pTimerModule->uTickBaseMs) + 
+              pTimerModule->uTickMsec - 1) / pTimerModule->uTickMsec;
+    if (uTicks == 0)
+    {
+        uTicks = 1;
+    }
+    pTimerInfo->uExpiryTick = pTimerModule->uNowTick + uTicks;
+    tmr_WheelInsert (pTimerModule, pTimerInfo);
+
+    /* Start the OS timer if this is the nearest expiry */
+    tmr_WheelArm (pTimerModule, pTimerInfo->uExpiryTick);
+
+    os_protectUnlock (pTimerModule->hOs, pTimerModule->hWheelLock);
 }
 
 
@@ -415,7 +698,8 @@ void tmr_StartTimer (TI_HANDLE     hTimerInfo,
  * \fn     tmr_StopTimer
  * \brief  Stop a running timer
  * 
- * Stop the specified timer.
+ * Stop the specified timer (remove it from the timer wheel).
+ * The wheel OS timer is left running, and if no other timer is due it expires without any effect.
  * 
  * \note   When using this function, it must be considered that timer expiry may happen
  *           right before the timer is stopped, so it can't be assumed that this completely 
@@ -429,58 +713,189 @@ void tmr_StopTimer (TI_HANDLE hTimerInfo)
     TTimerInfo   *pTimerInfo   = (TTimerInfo *)hTimerInfo;                 /* The timer handle */     
 	TTimerModule *pTimerModule = (TTimerModule *)pTimerInfo->hTimerModule; /* The timer module handle */
 
-    /* Stop OS-API timer running */
-    os_timerStop(pTimerModule->hOs, pTimerInfo->hOsTimerObj);
+    os_protectLock (pTimerModule->hOs, pTimerModule->hWheelLock);
+
+    if (pTimerInfo->ppPrevNext)
+    {
+        tmr_WheelRemove (pTimerModule, pTimerInfo);
+    }
 
     /* Clear periodic flag to prevent timer restart if we are in tmr_HandleExpiry context. */
     pTimerInfo->bPeriodic = TI_FALSE;
+
+    os_protectUnlock (pTimerModule->hOs, pTimerModule->hWheelLock);
 }
 
 
 /** 
  * \fn     tmr_GetExpiry
- * \brief  Called by OS-API upon any timer expiry
+ * \brief  Called by OS-API upon the timer wheel OS timer expiry
  * 
- * This is the common callback function called upon expiartion of any timer.
- * It is called by the OS-API in timer expiry context and handles the transition
- *   to the driver's context for handling the expiry event.
+ * This is the callback of the single OS timer that drives the timer wheel.
+ * It is called by the OS-API in timer expiry context. It advances the wheel up to the 
+ *   current tick, collects all expired timers, and handles the transition to the driver's 
+ *   context for handling all of them in one pass.
+ * Then the OS timer is re-armed for the nearest pending expiry or cascade, if any.
  * 
  * \note   
- * \param  hTimerInfo - The specific timer handle
+ * \param  hTimerModule - The module object
  * \return void
  * \sa     tmr_HandleExpiry
  */ 
-void tmr_GetExpiry (TI_HANDLE hTimerInfo)
+void tmr_GetExpiry (TI_HANDLE hTimerModule)
 {
-    TTimerInfo   *pTimerInfo   = (TTimerInfo *)hTimerInfo;                 /* The timer handle */     
-	TTimerModule *pTimerModule = (TTimerModule *)pTimerInfo->hTimerModule; /* The timer module handle */
+	TTimerModule *pTimerModule = (TTimerModule *)hTimerModule; /* The timer module handle */
+    TTimerInfo   *pTimerInfo;
+    TTimerInfo   *pNextTimer;
+    TTimerInfo   *pExpired = NULL;  /* List of the expired timers (linked by pNextExpired) */
+    TI_UINT32     uSlot;
+    TI_UINT32     uNextTick;
+    TI_UINT32     i;
+#ifdef TI_DBG
+    TI_UINT32     uExpiries = 0;
+#endif
+
+    os_protectLock (pTimerModule->hOs, pTimerModule->hWheelLock);
+
+    pTimerModule->bOsTimerArmed = TI_FALSE;
+    tmr_WheelUpdateNow (pTimerModule);
+#ifdef TI_DBG
+    pTimerModule->uTickPasses++;
+#endif
+
+    /* Process all ticks up to the current one (skipping empty level 0 rounds) */
+    while (pTimerModule->uCurrTick != pTimerModule->uNowTick)
+    {
+        if (pTimerModule->aLevelCount[0] == 0)
+        {
+            uNextTick = (pTimerModule->uCurrTick | WHEEL0_MASK) + 1;
+            if ((pTimerModule->aLevelCount[1] == 0) || (TICKS_DIFF(uNextTick, pTimerModule->uNowTick) > 0))
+            {
+                pTimerModule->uCurrTick = pTimerModule->uNowTick;
+                break;
+            }
+            pTimerModule->uCurrTick = uNextTick;
+        }
+        else 
+        {
+            pTimerModule->uCurrTick++;
+        }
+
+        /* On level 0 wrap, move the level 1 slot timers to their level 0 slots (or to the expired list) */
+        if ((pTimerModule->uCurrTick & WHEEL0_MASK) == 0)
+        {
+            uSlot = (pTimerModule->uCurrTick >> WHEEL0_BITS) & WHEEL1_MASK;
+            pTimerInfo = pTimerModule->aWheel1[uSlot];
+            pTimerModule->aWheel1[uSlot] = NULL;
+            while (pTimerInfo)
+            {
+                pNextTimer = pTimerInfo->pNext;
+                pTimerModule->aLevelCount[1]--;
+                if (TICKS_DIFF(pTimerInfo->uExpiryTick, pTimerModule->uCurrTick) <= 0)
+                {
+                    pTimerInfo->ppPrevNext   = NULL;
+                    pTimerInfo->pNext        = NULL;
+                    pTimerInfo->pNextExpired = pExpired;
+                    pExpired = pTimerInfo;
+                }
+                else 
+                {
+                    tmr_WheelInsert (pTimerModule, pTimerInfo);
+                }
+#ifdef TI_DBG
+                pTimerModule->uCascades++;
+#endif
+                pTimerInfo = pNextTimer;
+            }
+        }
+
+        /* Move the current level 0 slot timers to the expired list */
+        uSlot = pTimerModule->uCurrTick & WHEEL0_MASK;
+        pTimerInfo = pTimerModule->aWheel0[uSlot];
+        pTimerModule->aWheel0[uSlot] = NULL;
+        while (pTimerInfo)
+        {
+            pNextTimer = pTimerInfo->pNext;
+            pTimerModule->aLevelCount[0]--;
+            pTimerInfo->ppPrevNext   = NULL;
+            pTimerInfo->pNext        = NULL;
+            pTimerInfo->pNextExpired = pExpired;
+            pExpired = pTimerInfo;
+            pTimerInfo = pNextTimer;
+        }
+    }
+
+    /* Re-arm the OS timer for the nearest level 0 expiry, or the next cascade if only level 1 is used */
+    if (pTimerModule->aLevelCount[0])
+    {
+        for (i = 1; i <= WHEEL0_SLOTS; i++)
+        {
+            if (pTimerModule->aWheel0[(pTimerModule->uCurrTick + i) & WHEEL0_MASK])
+            {
+                tmr_WheelArm (pTimerModule, pTimerModule->uCurrTick + i);
+                break;
+            }
+        }
+    }
+    if (pTimerModule->aLevelCount[1])
+    {
+        tmr_WheelArm (pTimerModule, (pTimerModule->uCurrTick | WHEEL0_MASK) + 1);
+    }
+
+    /* Apply a new tick duration once the wheel is empty */
+    if ((pTimerModule->aLevelCount[0] == 0) && (pTimerModule->aLevelCount[1] == 0))
+    {
+        pTimerModule->uTickMsec = pTimerModule->uNewTickMsec;
+    }
+
+    os_protectUnlock (pTimerModule->hOs, pTimerModule->hWheelLock);
+
+    if (pExpired == NULL)
+    {
+        return;
+    }
 
     /* Enter critical section */
     context_EnterCriticalSection (pTimerModule->hContext);
 
-    /* 
-     * If the expired timer was started when the driver's state was Operational,
-     *   insert it to the Operational-queue 
-     */
-    if (pTimerInfo->bOperStateWhenStarted)
+    for (pTimerInfo = pExpired; pTimerInfo; pTimerInfo = pTimerInfo->pNextExpired)
     {
-        que_Enqueue (pTimerModule->hOperQueue, hTimerInfo);
+#ifdef TI_DBG
+        uExpiries++;
+#endif
+
+        /* 
+         * If the expired timer was started when the driver's state was Operational,
+         *   insert it to the Operational-queue 
+         */
+        if (pTimerInfo->bOperStateWhenStarted)
+        {
+            que_Enqueue (pTimerModule->hOperQueue, (TI_HANDLE)pTimerInfo);
+        }
+
+        /* 
+         * Else (started when driver's state was NOT-Operational), if now the state is still
+         *   NOT Operational insert it to the Init-queue.
+         *   (If state changed from non-operational to operational the event is ignored)
+         */
+        else if (!pTimerModule->bOperState)
+        {
+            que_Enqueue (pTimerModule->hInitQueue, (TI_HANDLE)pTimerInfo);
+        }
     }
 
-    /* 
-     * Else (started when driver's state was NOT-Operational), if now the state is still
-     *   NOT Operational insert it to the Init-queue.
-     *   (If state changed from non-operational to operational the event is ignored)
-     */
-    else if (!pTimerModule->bOperState)
+#ifdef TI_DBG
+    pTimerModule->uExpiries += uExpiries;
+    if (uExpiries > pTimerModule->uMaxExpiriesPerPass)
     {
-        que_Enqueue (pTimerModule->hInitQueue, hTimerInfo);
+        pTimerModule->uMaxExpiriesPerPass = uExpiries;
     }
+#endif
 
     /* Leave critical section */
     context_LeaveCriticalSection (pTimerModule->hContext);
 
-    /* Request switch to driver context for handling timer events */
+    /* Request switch to driver context for handling all timer events */
     context_RequestSchedule (pTimerModule->hContext, pTimerModule->uContextId);
 }
 
@@ -573,6 +988,15 @@ void tmr_PrintModule (TI_HANDLE hTimerModule)
 
     /* Print Operational Queue Info */
     que_Print(pTimerModule->hOperQueue);
+
+    /* Print Timer Wheel Info */
+    WLAN_OS_REPORT(("Timer wheel: Tick = %d ms, Timers = %d (L0 = %d, L1 = %d), CurrTick = %d, Armed = %d (tick %d)\n",
+                    pTimerModule->uTickMsec, pTimerModule->uTimersCount,
+                    pTimerModule->aLevelCount[0], pTimerModule->aLevelCount[1],
+                    pTimerModule->uCurrTick, pTimerModule->bOsTimerArmed, pTimerModule->uArmedTick));
+    WLAN_OS_REPORT(("OS timer starts = %d, OS timer expiries = %d, Timer expiries = %d, Max per expiry = %d, Cascaded = %d\n",
+                    pTimerModule->uOsTimerStarts, pTimerModule->uTickPasses, pTimerModule->uExpiries,
+                    pTimerModule->uMaxExpiriesPerPass, pTimerModule->uCascades));
 }
 
 void tmr_PrintTimer (TI_HANDLE hTimerInfo)
@@ -46,6 +46,13 @@
 /* The callback function type for timer clients */
 typedef void (*TTimerCbFunc)(TI_HANDLE hCbHndl, TI_BOOL bTwdInitOccured);
 
+/* The timer module init parameters */
+typedef struct
+{
+    /* The timer wheel tick duration in Msec (timers expiry resolution) */
+    TI_UINT32   uTickMsec;
+} TTimerInitParams;
+
 
 /* External Functions Prototypes */
 /* ============================= */
@@ -55,6 +62,8 @@ TI_STATUS tmr_Free (TI_HANDLE hTimerModule);
 void      tmr_ClearInitQueue (TI_HANDLE hTimerModule);
 void      tmr_ClearOperQueue (TI_HANDLE hTimerModule);
 void      tmr_Init (TI_HANDLE hTimerModule, TI_HANDLE hOs, TI_HANDLE hReport, TI_HANDLE hContext);
+TI_STATUS tmr_SetDefaults (TI_HANDLE hTimerModule, TTimerInitParams *pTimerInitParams);
+TI_UINT32 tmr_GetTickMsec (TI_HANDLE hTimerModule);
 void      tmr_UpdateDriverState (TI_HANDLE hTimerModule, TI_BOOL bOperState);
 TI_HANDLE tmr_CreateTimer (TI_HANDLE hTimerModule);
 TI_STATUS tmr_DestroyTimer (TI_HANDLE hTimerInfo);
@@ -64,7 +73,7 @@ void      tmr_StartTimer (TI_HANDLE     hTimerInfo,
                           TI_UINT32     uIntervalMsec,
                           TI_BOOL       bPeriodic);
 void      tmr_StopTimer (TI_HANDLE hTimerInfo);
-void      tmr_GetExpiry (TI_HANDLE hTimerInfo);
+void      tmr_GetExpiry (TI_HANDLE hTimerModule);
 void      tmr_HandleExpiry (TI_HANDLE hTimerModule);
 
 #ifdef TI_DBG
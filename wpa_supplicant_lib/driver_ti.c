@@ -193,8 +193,11 @@ static int wpa_driver_tista_driver_stop( void *priv )
 
 	if(0 != res)
 		wpa_printf(MSG_ERROR, "ERROR - Failed to stop driver!");
-	else
+	else {
+		/* The scan table generation is not kept across driver stop */
+		drv->scan_cache_num = -1;
 		wpa_printf(MSG_INFO, "wpa_driver_tista_driver_stop success");
+	}
 
 	return res;
 }
@@ -984,6 +987,11 @@ void * wpa_driver_tista_init(void *ctx, const char *ifname)
 	drv->force_merge_flag = 0;
 	scan_init(drv);
 
+	/* No scan results were read from the driver yet */
+	drv->scan_cache = NULL;
+	drv->scan_cache_num = -1;
+	drv->scan_cache_size = 0;
+
 	/* Set default amount of channels */
 	drv->scan_channels = check_and_get_build_channels();
 
@@ -1012,6 +1020,7 @@ void wpa_driver_tista_deinit(void *priv)
 	wpa_driver_wext_deinit(drv->wext);
 	close(drv->ioctl_sock);
 	scan_exit(drv);
+	os_free(drv->scan_cache);
 	os_free(drv);
 }
 
@@ -1237,6 +1246,61 @@ static int wpa_driver_tista_scan_result_compare(const void *a, const void *b)
     return( wb->level - wa->level );
 }
 
+/*-----------------------------------------------------------------------------
+Routine Name: wpa_driver_tista_get_scan_cache
+Routine Description: Read the scan results from the driver, unless its scan
+                     table did not change since the previous read - in which
+                     case the cached results are returned without rebuilding
+                     and parsing the whole wext scan list.
+Arguments:
+   drv - pointer to private data structure
+   results - buffer for the scan results
+   max_size - number of entries in results
+Return Value: number of scan results, -1 on failure
+-----------------------------------------------------------------------------*/
+static int wpa_driver_tista_get_scan_cache( struct wpa_driver_ti_data *drv,
+					    struct wpa_scan_result *results,
+					    size_t max_size )
+{
+	u32 generation;
+	int ap_num;
+
+	if (0 != wpa_driver_tista_private_send(drv, TIWLN_802_11_BSSID_LIST_GENERATION_GET,
+		NULL, 0, &generation, sizeof(generation))) {
+		/* Can't tell whether the table changed - read it */
+		drv->scan_cache_num = -1;
+		return wpa_driver_wext_get_scan_results(drv->wext, results, max_size);
+	}
+
+	if ((drv->scan_cache_num >= 0) && (generation == drv->scan_generation) &&
+	    ((size_t)drv->scan_cache_num <= max_size)) {
+		wpa_printf(MSG_DEBUG, "Scan table generation %u not changed - using cached results", generation);
+		os_memcpy(results, drv->scan_cache, drv->scan_cache_num * sizeof(struct wpa_scan_result));
+		return drv->scan_cache_num;
+	}
+
+	ap_num = wpa_driver_wext_get_scan_results(drv->wext, results, max_size);
+	if (ap_num < 0) {
+		drv->scan_cache_num = -1;
+		return ap_num;
+	}
+
+	if ((drv->scan_cache == NULL) || (drv->scan_cache_size < max_size)) {
+		os_free(drv->scan_cache);
+		drv->scan_cache = os_malloc(max_size * sizeof(struct wpa_scan_result));
+		drv->scan_cache_size = (drv->scan_cache != NULL) ? max_size : 0;
+	}
+	if (drv->scan_cache != NULL) {
+		os_memcpy(drv->scan_cache, results, ap_num * sizeof(struct wpa_scan_result));
+		drv->scan_cache_num = ap_num;
+		drv->scan_generation = generation;
+	} else {
+		drv->scan_cache_num = -1;
+	}
+
+	return ap_num;
+}
+
 static int wpa_driver_tista_get_scan_results(void *priv,
 					      struct wpa_scan_result *results,
 					      size_t max_size)
@@ -1245,7 +1309,7 @@ static int wpa_driver_tista_get_scan_results(void *priv,
 	int ap_num = 0;
 
         TI_CHECK_DRIVER( drv->driver_is_loaded, -1 );
-	ap_num = wpa_driver_wext_get_scan_results(drv->wext, results, max_size);
+	ap_num = wpa_driver_tista_get_scan_cache(drv, results, max_size);
 	wpa_printf(MSG_DEBUG, "Actual APs number %d", ap_num);
 
 	if (ap_num < 0)
@@ -79,5 +79,9 @@ struct wpa_driver_ti_data {
 	u32 btcoex_mode;		/* BtCoex Mode */
 	int last_scan;			/* Last scan type */
 	SHLIST scan_merge_list;		/* Previous scan list */
+	u32 scan_generation;		/* Driver scan table generation of scan_cache */
+	struct wpa_scan_result *scan_cache;	/* Last scan results read from the driver */
+	int scan_cache_num;		/* Number of entries in scan_cache (-1 if not valid) */
+	size_t scan_cache_size;		/* Allocated entries in scan_cache */
 };
 #endif